@@ -123,6 +123,11 @@ class BlockingQueue {
     return queue_.size() >= max_size_;
   }
 
+  bool IsEmpty() {
+    std::unique_lock<std::mutex> lock(mutex_);
+    return queue_.empty();
+  }
+
   void Clear() {
     std::unique_lock<std::mutex> lock(mutex_);
     queue_.clear();
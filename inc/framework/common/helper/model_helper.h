@@ -36,6 +36,8 @@ class ModelHelper {
                        ge::ModelBufferData& model);
   Status SaveOriginalGraphToOmModel(const ge::Graph& graph, const std::string& output_file);
   Status LoadModel(const ge::ModelData& model_data);
+  // weights and kernels of the loaded model refer to model_data in place, which is kept alive by model_data_owner
+  Status LoadModel(const ge::ModelData& model_data, const std::shared_ptr<void>& model_data_owner);
   Status GetModelBufferData(ge::ModelBufferData& model);
 
   const ModelFileHeader* GetFileHeader() const { return file_header_; }
@@ -55,6 +57,7 @@ class ModelHelper {
   uint8_t* model_addr_tmp_ = nullptr;
   uint32_t model_len_tmp_ = 0;
   GeModelPtr model_;
+  std::shared_ptr<void> model_data_owner_;
 
   ModelHelper(const ModelHelper&);
   ModelHelper& operator=(const ModelHelper&);
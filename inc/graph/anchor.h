@@ -118,6 +118,9 @@ class GE_FUNC_DEV_VISIBILITY GE_FUNC_HOST_VISIBILITY Anchor : public std::enable
   // set anchor index of the node
   void SetIdx(int index);
 
+  // Get version of the links of all anchors, raised by each link, unlink and peer replacement
+  static uint64_t GetLinkVersion();
+
  protected:
   // All peer anchors connected to current anchor
   vector<std::weak_ptr<Anchor>> peer_anchors_;
@@ -20,10 +20,12 @@
 #include <map>
 #include <memory>
 #include <string>
+#include <unordered_map>
 #include <utility>
 #include <vector>
 #include <deque>
 #include "detail/attributes_holder.h"
+#include "graph/detail/node_list.h"
 #include "graph/anchor.h"
 #include "graph/node.h"
 #include "graph/op_desc.h"
@@ -159,7 +161,10 @@ class ComputeGraph : public std::enable_shared_from_this<ComputeGraph>, public A
     params_share_map_ = params_share_map;
   }
 
-  void SetInputsOrder(const std::vector<std::string> &inputs_order) { inputs_order_ = inputs_order; }
+  void SetInputsOrder(const std::vector<std::string> &inputs_order) {
+    inputs_order_ = inputs_order;
+    is_topo_sorted_ = false;
+  }
 
   void SetGraphOutNodes(std::map<std::string, std::vector<int32_t>> out_nodes_map) { out_nodes_map_ = out_nodes_map; }
 
@@ -246,14 +251,17 @@ class ComputeGraph : public std::enable_shared_from_this<ComputeGraph>, public A
   ConstProtoAttrMapHelper GetAttrMap() const override;
 
  private:
-  graphStatus DFSTopologicalSorting(std::vector<NodePtr> &node_vec, std::map<NodePtr, uint32_t> &map_in_edge_num,
+  graphStatus DFSTopologicalSorting(std::vector<NodePtr> &node_vec,
+                                    std::unordered_map<NodePtr, uint32_t> &map_in_edge_num,
                                     std::vector<NodePtr> &stack);
-  graphStatus BFSTopologicalSorting(std::vector<NodePtr> &node_vec, std::map<NodePtr, uint32_t> &map_in_edge_num,
+  graphStatus BFSTopologicalSorting(std::vector<NodePtr> &node_vec,
+                                    std::unordered_map<NodePtr, uint32_t> &map_in_edge_num,
                                     std::deque<NodePtr> &stack);
-  graphStatus CollectBreadthOutNode(const NodePtr &node, std::map<NodePtr, uint32_t> &map_in_edge_num,
+  graphStatus CollectBreadthOutNode(const NodePtr &node, std::unordered_map<NodePtr, uint32_t> &map_in_edge_num,
                                     std::map<string, NodePtr> &breadth_node_map);
   graphStatus TopologicalSortingGraph();
-  graphStatus SortNodes(std::vector<NodePtr> &stack, std::map<NodePtr, uint32_t> &mapInEdgeNum);
+  bool IsTopoSortedWith(uint64_t link_version, const std::string &run_mode) const;
+  graphStatus SortNodes(std::vector<NodePtr> &stack, std::unordered_map<NodePtr, uint32_t> &mapInEdgeNum);
   Vistor<NodePtr> AllGraphNodes(std::vector<std::shared_ptr<ComputeGraph>> &subgraphs) const;
   size_t GetInEdgeSize(const NodePtr &node);
   size_t GetOutEdgeSize(const NodePtr &node);
@@ -272,7 +280,7 @@ class ComputeGraph : public std::enable_shared_from_this<ComputeGraph>, public A
   std::string name_;
   uint32_t graph_id_ = 0;
   ProtoAttrMapHelper attrs_;
-  std::vector<NodePtr> nodes_;
+  NodeList nodes_;
   std::map<OperatorImplPtr, NodePtr> all_nodes_infos_;
   std::vector<NodePtr> target_nodes_info_;
 
@@ -300,6 +308,12 @@ class ComputeGraph : public std::enable_shared_from_this<ComputeGraph>, public A
   ge::Format data_format_ = ge::FORMAT_ND;
   // unknown graph indicator, default is false, mean known shape
   bool is_unknown_shape_graph_ = false;
+  // Versions of nodes and links, and run mode of the last topological sorting, to skip sorting an unchanged graph.
+  // Names and types of nodes are not tracked, renaming or retyping a linked node does not make the next sorting run.
+  bool is_topo_sorted_ = false;
+  uint64_t sorted_nodes_version_ = 0;
+  uint64_t sorted_link_version_ = 0;
+  std::string sorted_run_mode_;
 };
 }  // namespace ge
 #endif  // INC_GRAPH_COMPUTE_GRAPH_H_
@@ -0,0 +1,187 @@
+/**
+ * Copyright 2019-2020 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef INC_GRAPH_DETAIL_ATTR_STORE_H_
+#define INC_GRAPH_DETAIL_ATTR_STORE_H_
+
+#include <atomic>
+#include <cstdint>
+#include <mutex>
+#include <string>
+#include <type_traits>
+#include <unordered_map>
+#include <vector>
+
+namespace google {
+namespace protobuf {
+template <typename Key, typename T>
+class Map;
+}  // namespace protobuf
+}  // namespace google
+
+namespace ge {
+namespace proto {
+class AttrDef;
+}  // namespace proto
+
+using AttrId = uint32_t;
+
+///
+/// Interns attribute names to dense integer ids. Ids are never released, so an id stays valid for the process.
+///
+class AttrNameRegistry {
+ public:
+  static AttrNameRegistry &Instance();
+
+  AttrId Intern(const std::string &name);
+
+  ///
+  /// @return false if name was never interned, so no store can hold it
+  ///
+  bool Find(const std::string &name, AttrId &id) const;
+
+  const std::string &GetName(AttrId id) const;
+
+ private:
+  AttrNameRegistry() = default;
+
+  mutable std::mutex mutex_;
+  std::atomic<size_t> name_count_{0};
+  std::unordered_map<std::string, AttrId> ids_;
+  // points to the keys of ids_, which stay in place on rehash
+  std::vector<const std::string *> names_;
+};
+
+///
+/// Typed value of a flat attribute: a scalar, a string or a list of scalars or strings, in one tagged union.
+///
+class AttrStoreValue {
+ public:
+  enum ValueType : uint8_t { VT_INT, VT_FLOAT, VT_BOOL, VT_STRING, VT_LIST_INT, VT_LIST_FLOAT, VT_LIST_STRING };
+
+  template <typename T>
+  struct IsFlatType
+      : std::integral_constant<bool, std::is_same<T, int64_t>::value || std::is_same<T, float>::value ||
+                                       std::is_same<T, bool>::value || std::is_same<T, std::string>::value ||
+                                       std::is_same<T, std::vector<int64_t>>::value ||
+                                       std::is_same<T, std::vector<float>>::value ||
+                                       std::is_same<T, std::vector<std::string>>::value> {};
+
+  explicit AttrStoreValue(int64_t value) : type_(VT_INT), int_(value) {}
+  explicit AttrStoreValue(float value) : type_(VT_FLOAT), float_(value) {}
+  explicit AttrStoreValue(bool value) : type_(VT_BOOL), bool_(value) {}
+  explicit AttrStoreValue(const std::string &value);
+  explicit AttrStoreValue(const std::vector<int64_t> &value);
+  explicit AttrStoreValue(const std::vector<float> &value);
+  explicit AttrStoreValue(const std::vector<std::string> &value);
+  AttrStoreValue(const AttrStoreValue &other);
+  AttrStoreValue(AttrStoreValue &&other) noexcept;
+  AttrStoreValue &operator=(const AttrStoreValue &other);
+  AttrStoreValue &operator=(AttrStoreValue &&other) noexcept;
+  ~AttrStoreValue();
+
+  ValueType GetValueType() const { return type_; }
+
+  ///
+  /// @return false if the value holds another type
+  ///
+  bool GetValue(int64_t &value) const;
+  bool GetValue(float &value) const;
+  bool GetValue(bool &value) const;
+  bool GetValue(std::string &value) const;
+  bool GetValue(std::vector<int64_t> &value) const;
+  bool GetValue(std::vector<float> &value) const;
+  bool GetValue(std::vector<std::string> &value) const;
+
+  ///
+  /// @return true if attr_def holds a value of the same type, an empty list of another type does not match
+  ///
+  bool IsSameType(const proto::AttrDef &attr_def) const;
+  void ToProto(proto::AttrDef &attr_def) const;
+
+ private:
+  void Destroy();
+  void CopyFrom(const AttrStoreValue &other);
+  void MoveFrom(AttrStoreValue &&other);
+
+  ValueType type_;
+  union {
+    int64_t int_;
+    float float_;
+    bool bool_;
+    std::string str_;
+    std::vector<int64_t> list_int_;
+    std::vector<float> list_float_;
+    std::vector<std::string> list_str_;
+  };
+};
+
+///
+/// Flat attributes of one holder, sorted by interned id. The proto attr map of the holder is the source of the
+/// attributes the store does not hold. Const readers never write the flat attributes into it: a reader of the
+/// whole attr map as proto gets a copy of it with the flat attributes added.
+///
+class AttrStore {
+ public:
+  using ProtoMap = ::google::protobuf::Map<std::string, proto::AttrDef>;
+
+  AttrStore() = default;
+  AttrStore(const AttrStore &other);
+  AttrStore &operator=(const AttrStore &other);
+  ~AttrStore() = default;
+
+  ///
+  /// Proto attr map checked for an attribute of the same name when a new one is set, the owner binds it before
+  /// handing out the store for writing
+  ///
+  void BindProto(ProtoMap *proto_attrs) { proto_attrs_ = proto_attrs; }
+
+  ///
+  /// @return false if the attribute is in the proto attr map or the store with another type, the caller then
+  /// sets it through the proto attr map to report the same error as before
+  ///
+  bool Set(const std::string &name, AttrStoreValue &&value);
+
+  const AttrStoreValue *Get(const std::string &name) const;
+
+  bool Empty() const { return items_.empty(); }
+  size_t Size() const { return items_.size(); }
+
+  ///
+  /// Copy all values into proto_attrs, which is not the bound proto attr map but a copy owned by the reader
+  ///
+  void CopyTo(ProtoMap &proto_attrs) const;
+
+  ///
+  /// Move all values into proto_attrs and empty the store, before proto_attrs is written directly
+  ///
+  void MoveTo(ProtoMap &proto_attrs);
+
+ private:
+  struct Item {
+    Item(AttrId item_id, AttrStoreValue &&item_value) : id(item_id), value(std::move(item_value)) {}
+    AttrId id;
+    AttrStoreValue value;
+  };
+
+  std::vector<Item>::iterator LowerBound(AttrId id);
+  std::vector<Item>::const_iterator LowerBound(AttrId id) const;
+
+  std::vector<Item> items_;
+  ProtoMap *proto_attrs_ = nullptr;
+};
+}  // namespace ge
+#endif  // INC_GRAPH_DETAIL_ATTR_STORE_H_
@@ -24,6 +24,7 @@
 #include <utility>
 #include <vector>
 #include "graph/detail/any_map.h"
+#include "graph/detail/attr_store.h"
 #include "graph/ge_error_codes.h"
 #include "graph/types.h"
 
@@ -150,8 +151,20 @@ class GE_FUNC_DEV_VISIBILITY GE_FUNC_HOST_VISIBILITY AttrHolder {
   const std::map<string, GeAttrValue> GetAllAttrs() const;  // lint !e1073
 
   virtual ProtoAttrMapHelper MutableAttrMap() = 0;
+  // Holders with a flat store return a copy of the proto attr map with the flat attributes added
   virtual ConstProtoAttrMapHelper GetAttrMap() const = 0;
 
+  ///
+  /// Flat store serving scalar and scalar list attributes without the proto attr map. Holders without one keep
+  /// all attributes in the proto attr map.
+  ///
+  virtual AttrStore *MutableAttrStore() { return nullptr; }
+  virtual const AttrStore *GetAttrStore() const { return nullptr; }
+  // Proto attr map without copying the flat attributes into it, for looking up a name the flat store does not hold
+  virtual ConstProtoAttrMapHelper GetProtoAttrMap() const { return GetAttrMap(); }
+  // Proto attr map to look up name in, a map of its own holding only name if name is a flat attribute
+  ConstProtoAttrMapHelper GetAttrMapFor(const string &name) const;
+
   friend class ModelSerializeImp;
   friend class AttrUtils;
   friend class AttrUtilsHelper;
@@ -0,0 +1,106 @@
+/**
+ * Copyright 2019-2020 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef INC_GRAPH_DETAIL_NODE_LIST_H_
+#define INC_GRAPH_DETAIL_NODE_LIST_H_
+
+#include <cstdint>
+#include <list>
+#include <memory>
+#include <unordered_map>
+#include <vector>
+
+namespace ge {
+class Node;
+using NodePtr = std::shared_ptr<Node>;
+
+///
+/// Ordered nodes of a graph. Each node keeps a handle to its position, so that finding, removing a node and
+/// inserting a node before or after another one cost O(1), while the order of the other nodes is kept.
+/// A node can be in the list only once.
+///
+class NodeList {
+ public:
+  using Iterator = std::list<NodePtr>::iterator;
+  using ConstIterator = std::list<NodePtr>::const_iterator;
+
+  NodeList();
+  NodeList(const NodeList &other);
+  NodeList &operator=(const NodeList &other);
+  ~NodeList() = default;
+
+  Iterator begin() { return nodes_.begin(); }
+  Iterator end() { return nodes_.end(); }
+  ConstIterator begin() const { return nodes_.begin(); }
+  ConstIterator end() const { return nodes_.end(); }
+
+  size_t size() const { return nodes_.size(); }
+  bool empty() const { return nodes_.empty(); }
+  const NodePtr &front() const { return nodes_.front(); }
+
+  void clear();
+  void swap(NodeList &other);
+
+  ///
+  /// @return false if node is null or already in list
+  ///
+  bool push_back(const NodePtr &node);
+  bool push_front(const NodePtr &node);
+
+  ///
+  /// @brief Insert node after pos_node
+  /// @return false if pos_node is not in list, node is null or already in list
+  ///
+  bool InsertAfter(const NodePtr &pos_node, const NodePtr &node);
+
+  ///
+  /// @brief Insert node before pos_node
+  /// @return false if pos_node is not in list, node is null or already in list
+  ///
+  bool InsertBefore(const NodePtr &pos_node, const NodePtr &node);
+
+  ///
+  /// @return false if node is not in list
+  ///
+  bool Erase(const NodePtr &node);
+
+  bool Contains(const NodePtr &node) const { return nodes_index_.count(node.get()) > 0; }
+
+  ///
+  /// @brief Replace all nodes, nodes duplicated or null are dropped
+  ///
+  void Assign(const std::vector<NodePtr> &nodes);
+
+  std::vector<NodePtr> ToVector() const { return std::vector<NodePtr>(nodes_.begin(), nodes_.end()); }
+
+  ///
+  /// @brief Get version of the list, which is changed by each change of nodes or their order
+  /// @return version unique among all lists
+  ///
+  uint64_t GetVersion() const { return version_; }
+
+ private:
+  bool Insert(ConstIterator pos, const NodePtr &node);
+  void RebuildIndex();
+  void UpdateVersion();
+
+  std::list<NodePtr> nodes_;
+  std::unordered_map<const Node *, Iterator> nodes_index_;
+  uint64_t version_ = 0;
+};
+}  // namespace ge
+
+#endif  // INC_GRAPH_DETAIL_NODE_LIST_H_
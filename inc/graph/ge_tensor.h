@@ -60,12 +60,34 @@ class GE_FUNC_DEV_VISIBILITY GE_FUNC_HOST_VISIBILITY GeShape {
   GeShape &operator=(GeShape &&other);
 
  private:
+  // Dims of a shape are kept inline if there are no more than kInlineDimNum ones.
+  // Only the shape referring to a tensor descriptor is backed by proto::ShapeDef.
+  static constexpr size_t kInlineDimNum = 8;
+
   GeIrProtoHelper<proto::ShapeDef> shape_def_;
   friend class GeTensorDesc;
   // Create from proto obj
   GeShape(const ProtoMsgOwner &protoOnwer, proto::ShapeDef *protoMsg);
 
-  void RefTo(const GeShape &shape) { shape_def_ = shape.shape_def_; }
+  void RefTo(const GeShape &shape) {
+    shape_def_ = shape.shape_def_;
+    is_ref_ = shape.is_ref_;
+  }
+
+  const int64_t *DimsData() const { return dim_num_ > kInlineDimNum ? heap_dims_.data() : inline_dims_; }
+  int64_t *MutableDimsData() { return dim_num_ > kInlineDimNum ? heap_dims_.data() : inline_dims_; }
+  void ResizeDims(size_t dim_num);
+  // Refresh shape size and unknown flags after dims changed
+  void UpdateCache();
+  void CopyDimsFrom(const GeShape &other);
+
+  bool is_ref_ = false;
+  size_t dim_num_ = 0;
+  int64_t inline_dims_[kInlineDimNum] = {};
+  std::vector<int64_t> heap_dims_;
+  int64_t shape_size_ = 0;
+  bool is_unknown_shape_ = false;
+  bool is_unknown_dim_num_ = false;
 };
 
 class GE_FUNC_DEV_VISIBILITY GE_FUNC_HOST_VISIBILITY GeTensorDesc : public AttrHolder {
@@ -272,6 +272,9 @@ class OpDesc : public std::enable_shared_from_this<OpDesc>, public AttrHolder {
  protected:
   ProtoAttrMapHelper MutableAttrMap() override;
   ConstProtoAttrMapHelper GetAttrMap() const override;
+  AttrStore *MutableAttrStore() override;
+  const AttrStore *GetAttrStore() const override { return &attr_store_; }
+  ConstProtoAttrMapHelper GetProtoAttrMap() const override;
 
  private:
   OpDesc(const ProtoMsgOwner &proto_msg_owner, ge::proto::OpDef *op_def);
@@ -280,6 +283,7 @@ class OpDesc : public std::enable_shared_from_this<OpDesc>, public AttrHolder {
   bool OpDescGenTensorDescsAreEqual(const OpDesc &r_op_desc) const;
 
   GeIrProtoHelper<ge::proto::OpDef> op_def_;
+  AttrStore attr_store_;
   std::vector<std::string> subgraph_instance_names_;
 
   // subgraph names to index, for a `if` operator:
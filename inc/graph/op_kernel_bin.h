@@ -25,19 +25,27 @@
 namespace ge {
 class OpKernelBin {
  public:
-  OpKernelBin(std::string name, std::vector<char> &&data) : name_(std::move(name)), data_(std::move(data)) {}
+  OpKernelBin(std::string name, std::vector<char> &&data)
+      : name_(std::move(name)), data_(std::move(data)), bin_data_(data_.data()), bin_size_(data_.size()) {}
+
+  // Refer to the kernel in place, data_owner keeps the memory alive, e.g. a mapped model file
+  OpKernelBin(std::string name, const char *data, size_t size, std::shared_ptr<void> data_owner)
+      : name_(std::move(name)), bin_data_(data), bin_size_(size), data_owner_(std::move(data_owner)) {}
 
   ~OpKernelBin() = default;
 
   const std::string &GetName() const { return name_; }
-  const uint8_t *GetBinData() const { return (const uint8_t *)data_.data(); }
-  size_t GetBinDataSize() const { return data_.size(); }
+  const uint8_t *GetBinData() const { return (const uint8_t *)bin_data_; }
+  size_t GetBinDataSize() const { return bin_size_; }
   OpKernelBin(const OpKernelBin &) = delete;
   const OpKernelBin &operator=(const OpKernelBin &) = delete;
 
  private:
   std::string name_;
   std::vector<char> data_;
+  const char *bin_data_ = nullptr;
+  size_t bin_size_ = 0;
+  std::shared_ptr<void> data_owner_;
 };
 
 using OpKernelBinPtr = std::shared_ptr<OpKernelBin>;
@@ -32,6 +32,7 @@ class ShapeRefiner {
   static graphStatus InferShapeAndType(const NodePtr &node);
   static graphStatus InferShapeAndType(const ConstNodePtr &node, Operator &op);
   static void ClearContextMap();
+  static void ClearContextMap(const ComputeGraphPtr &graph);
 
  private:
   static void PrintInOutTensorShape(const ge::NodePtr &node, const std::string &phase);
@@ -117,6 +117,8 @@ class GE_FUNC_DEV_VISIBILITY GE_FUNC_HOST_VISIBILITY AttrUtils {
 
   static std::string GetAllAttrsStr(ConstAttrHolderAdapter &&obj);
 
+  static std::map<string, GeAttrValue> GetAllAttrs(ConstAttrHolderAdapter &&obj);
+
   class AttrHolderAdapter {
    public:
     AttrHolderAdapter(AttrHolder *obj) : obj_(obj) {}
@@ -136,7 +138,7 @@ class GE_FUNC_DEV_VISIBILITY GE_FUNC_HOST_VISIBILITY AttrUtils {
     ConstAttrHolderAdapter(const AttrHolder *obj) : obj_(obj) {}
     ~ConstAttrHolderAdapter() {}
     template <class T>
-    ConstAttrHolderAdapter(const std::shared_ptr<T> obj) : obj_(obj.get()) {}
+    ConstAttrHolderAdapter(const std::shared_ptr<T> &obj) : obj_(obj.get()) {}
     ConstAttrHolderAdapter(const AttrHolder &obj) : obj_(&obj) {}
     operator bool() const { return obj_ != nullptr; }
     const AttrHolder *operator->() const { return obj_; }
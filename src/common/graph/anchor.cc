@@ -16,12 +16,19 @@
 
 #include "graph/anchor.h"
 #include <algorithm>
+#include <atomic>
 #include <cstring>
 #include "debug/ge_util.h"
 #include "framework/common/debug/ge_log.h"
 #include "graph/node.h"
 
 namespace ge {
+namespace {
+std::atomic<uint64_t> g_link_version(0);
+
+void RaiseLinkVersion() { (void)g_link_version.fetch_add(1); }
+}  // namespace
+
 Anchor::Anchor(const NodePtr &owner_node, int idx) : owner_node_(owner_node), idx_(idx) {}
 
 bool Anchor::IsTypeOf(TYPE type) const { return strcmp(Anchor::TypeOf<Anchor>(), type) == 0; }
@@ -79,6 +86,7 @@ graphStatus Anchor::Unlink(const AnchorPtr &peer) {
 
   (void)peer_anchors_.erase(it);
   (void)peer->peer_anchors_.erase(it_peer);
+  RaiseLinkVersion();
   return GRAPH_SUCCESS;
 }
 
@@ -105,6 +113,7 @@ graphStatus Anchor::ReplacePeer(const AnchorPtr &old_peer, const AnchorPtr &firs
   first_peer->peer_anchors_.push_back(shared_from_this());
   *old_it = second_peer;
   second_peer->peer_anchors_.push_back(old_peer);
+  RaiseLinkVersion();
   return GRAPH_SUCCESS;
 }
 
@@ -121,6 +130,8 @@ int Anchor::GetIdx() const { return idx_; }
 
 void Anchor::SetIdx(int index) { idx_ = index; }
 
+uint64_t Anchor::GetLinkVersion() { return g_link_version.load(); }
+
 DataAnchor::DataAnchor(const NodePtr &owner_node, int idx) : Anchor(owner_node, idx) {}
 
 bool DataAnchor::IsTypeOf(TYPE type) const {
@@ -148,6 +159,7 @@ graphStatus InDataAnchor::LinkFrom(const OutDataAnchorPtr &src) {
   }
   peer_anchors_.push_back(src);
   src->peer_anchors_.push_back(shared_from_this());
+  RaiseLinkVersion();
   return GRAPH_SUCCESS;
 }
 
@@ -210,6 +222,7 @@ graphStatus OutDataAnchor::LinkTo(const InDataAnchorPtr &dest) {
   }
   peer_anchors_.push_back(dest);
   dest->peer_anchors_.push_back(shared_from_this());
+  RaiseLinkVersion();
   return GRAPH_SUCCESS;
 }
 
@@ -220,6 +233,7 @@ graphStatus OutDataAnchor::LinkTo(const InControlAnchorPtr &dest) {
   }
   peer_anchors_.push_back(dest);
   dest->peer_anchors_.push_back(shared_from_this());
+  RaiseLinkVersion();
   return GRAPH_SUCCESS;
 }
 
@@ -230,6 +244,7 @@ graphStatus OutControlAnchor::LinkTo(const InDataAnchorPtr &dest) {
   }
   peer_anchors_.push_back(dest);
   dest->peer_anchors_.push_back(shared_from_this());
+  RaiseLinkVersion();
   return GRAPH_SUCCESS;
 }
 
@@ -295,6 +310,7 @@ graphStatus InControlAnchor::LinkFrom(const OutControlAnchorPtr &src) {
   }
   peer_anchors_.push_back(src);
   src->peer_anchors_.push_back(shared_from_this());
+  RaiseLinkVersion();
   return GRAPH_SUCCESS;
 }
 
@@ -349,6 +365,7 @@ graphStatus OutControlAnchor::LinkTo(const InControlAnchorPtr &dest) {
   }
   peer_anchors_.push_back(dest);
   dest->peer_anchors_.push_back(shared_from_this());
+  RaiseLinkVersion();
   return GRAPH_SUCCESS;
 }
 
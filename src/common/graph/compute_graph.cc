@@ -95,7 +95,7 @@ ComputeGraph::Vistor<NodePtr> ComputeGraph::AllGraphNodes(std::vector<std::share
     }
   }
 
-  return Vistor<NodePtr>(shared_from_this(), all_nodes);
+  return Vistor<NodePtr>(shared_from_this(), std::move(all_nodes));
 }
 
 GE_FUNC_DEV_VISIBILITY GE_FUNC_HOST_VISIBILITY ComputeGraph::Vistor<NodePtr> ComputeGraph::GetNodes(
@@ -110,7 +110,7 @@ GE_FUNC_DEV_VISIBILITY GE_FUNC_HOST_VISIBILITY ComputeGraph::Vistor<NodePtr> Com
 size_t ComputeGraph::GetDirectNodesSize() const { return nodes_.size(); }
 
 GE_FUNC_DEV_VISIBILITY GE_FUNC_HOST_VISIBILITY ComputeGraph::Vistor<NodePtr> ComputeGraph::GetDirectNode() const {
-  return Vistor<NodePtr>(shared_from_this(), nodes_);
+  return Vistor<NodePtr>(shared_from_this(), nodes_.ToVector());
 }
 
 ComputeGraph::Vistor<NodePtr> ComputeGraph::GetInputNodes() const {
@@ -259,10 +259,15 @@ NodePtr ComputeGraph::AddNodeFront(NodePtr node) {
     return nullptr;
   }
   node->GetOpDesc()->SetId(nodes_.size());
-  if (nodes_.size() > 0 && nodes_[0]->GetType() == DATA) {
-    (void)nodes_.insert(nodes_.begin() + 1, node);
+  bool inserted = false;
+  if (!nodes_.empty() && nodes_.front()->GetType() == DATA) {
+    inserted = nodes_.InsertAfter(nodes_.front(), node);
   } else {
-    (void)nodes_.insert(nodes_.begin(), node);
+    inserted = nodes_.push_front(node);
+  }
+  if (!inserted) {
+    GELOGE(GRAPH_FAILED, "The node %s is already in graph %s.", node->GetName().c_str(), name_.c_str());
+    return nullptr;
   }
   return node;
 }
@@ -285,10 +290,7 @@ NodePtr ComputeGraph::AddNodeAfter(NodePtr node, const NodePtr &pre_node) {
     return nullptr;
   }
   node->GetOpDesc()->SetId(nodes_.size());
-  auto node_iter = std::find(nodes_.begin(), nodes_.end(), pre_node);
-  if (node_iter != nodes_.end()) {
-    nodes_.insert(node_iter + 1, node);
-  } else {
+  if (!nodes_.InsertAfter(pre_node, node)) {
     GELOGE(GRAPH_FAILED, "Cannot find pre_node in nodes_.");
     return nullptr;
   }
@@ -314,7 +316,10 @@ GE_FUNC_DEV_VISIBILITY GE_FUNC_HOST_VISIBILITY NodePtr ComputeGraph::AddNode(Nod
     return nullptr;
   }
   node->GetOpDesc()->SetId((int64_t)GetDirectNodesSize());
-  nodes_.push_back(node);
+  if (!nodes_.push_back(node)) {
+    GELOGE(GRAPH_FAILED, "The node %s is already in graph %s.", node->GetName().c_str(), name_.c_str());
+    return nullptr;
+  }
   return node;
 }
 
@@ -339,7 +344,10 @@ NodePtr ComputeGraph::AddNode(OpDescPtr op, int64_t id) {  // for unserialize.
   NodePtr node = shared_ptr<Node>(new (std::nothrow) Node(op, shared_from_this()));
   GE_IF_BOOL_EXEC(node == nullptr, GELOGE(GRAPH_FAILED, "node_ptr is NULL!!!"); return nullptr);
   GE_IF_BOOL_EXEC(node->Init() != GRAPH_SUCCESS, GELOGE(GRAPH_FAILED, "node init fail."); return nullptr);
-  nodes_.push_back(node);
+  if (!nodes_.push_back(node)) {
+    GELOGE(GRAPH_FAILED, "The node %s is already in graph %s.", node->GetName().c_str(), name_.c_str());
+    return nullptr;
+  }
   return node;
 }
 
@@ -349,7 +357,7 @@ NodePtr ComputeGraph::AddInputNode(NodePtr node) {
     return nullptr;
   }
   input_nodes_.push_back(node);
-  if (std::find(nodes_.begin(), nodes_.end(), node) == nodes_.end()) {
+  if (!nodes_.Contains(node)) {
     GE_CHK_BOOL_EXEC(AddNode(node) != nullptr, return nullptr, "add node failed");
   }
   return node;
@@ -376,7 +384,7 @@ NodePtr ComputeGraph::AddOutputNode(NodePtr node) {
     output_nodes_info_.emplace_back(std::make_pair(node, 0));
   }
 
-  if (std::find(nodes_.begin(), nodes_.end(), node) == nodes_.end()) {
+  if (!nodes_.Contains(node)) {
     GE_CHK_BOOL_EXEC(AddNode(node) != nullptr, return nullptr, "add node failed");
   }
   return result;
@@ -395,10 +403,7 @@ graphStatus ComputeGraph::RemoveConstInput(const NodePtr &node) {
                              "Remove edge from const op failed.");
       if (out_anchor->GetOwnerNode()->GetOutNodes().size() == 0) {
         GELOGI("Remove const op %s.", out_anchor->GetOwnerNode()->GetName().c_str());
-        auto iter = find(nodes_.begin(), nodes_.end(), out_anchor->GetOwnerNode());
-        if (iter != nodes_.end()) {
-          (void)nodes_.erase(iter);
-        }
+        (void)nodes_.Erase(out_anchor->GetOwnerNode());
       }
     }
   }
@@ -425,9 +430,7 @@ GE_FUNC_DEV_VISIBILITY GE_FUNC_HOST_VISIBILITY graphStatus ComputeGraph::RemoveN
     return GRAPH_FAILED;
   }
 
-  auto iter = find(nodes_.begin(), nodes_.end(), node);
-  if (iter != nodes_.end()) {
-    (void)nodes_.erase(iter);
+  if (nodes_.Erase(node)) {
     return GRAPH_SUCCESS;
   }
   return GRAPH_FAILED;
@@ -667,7 +670,7 @@ ComputeGraph::UpdateOutputMapping(const std::map<uint32_t, uint32_t> &output_map
 }
 
 GE_FUNC_DEV_VISIBILITY GE_FUNC_HOST_VISIBILITY graphStatus ComputeGraph::InsertEventNodes() {
-  std::vector<NodePtr> node_vec = nodes_;
+  std::vector<NodePtr> node_vec = nodes_.ToVector();
   for (const auto &node : GetDirectNode()) {
     if (node == nullptr || node->GetOpDesc() == nullptr) {
       GELOGW("node or OpDescPtr is nullptr.");
@@ -711,7 +714,7 @@ GE_FUNC_DEV_VISIBILITY GE_FUNC_HOST_VISIBILITY graphStatus ComputeGraph::InsertE
 }
 
 graphStatus ComputeGraph::DFSTopologicalSorting(std::vector<NodePtr> &node_vec,
-                                                std::map<NodePtr, uint32_t> &map_in_edge_num,
+                                                std::unordered_map<NodePtr, uint32_t> &map_in_edge_num,
                                                 std::vector<NodePtr> &stack) {
   GELOGI("Runing_Dfs_Sort: %s", name_.c_str());
   // Record the number of non data nodes but no input nodes
@@ -756,7 +759,7 @@ graphStatus ComputeGraph::DFSTopologicalSorting(std::vector<NodePtr> &node_vec,
 }
 
 graphStatus ComputeGraph::BFSTopologicalSorting(std::vector<NodePtr> &node_vec,
-                                                std::map<NodePtr, uint32_t> &map_in_edge_num,
+                                                std::unordered_map<NodePtr, uint32_t> &map_in_edge_num,
                                                 std::deque<NodePtr> &stack) {
   GELOGI("Runing_Bfs_Sort: %s", name_.c_str());
   std::vector<NodePtr> stack_input;
@@ -788,7 +791,8 @@ graphStatus ComputeGraph::BFSTopologicalSorting(std::vector<NodePtr> &node_vec,
   return GRAPH_SUCCESS;
 }
 
-graphStatus ComputeGraph::CollectBreadthOutNode(const NodePtr &node, std::map<NodePtr, uint32_t> &map_in_edge_num,
+graphStatus ComputeGraph::CollectBreadthOutNode(const NodePtr &node,
+                                                std::unordered_map<NodePtr, uint32_t> &map_in_edge_num,
                                                 std::map<string, NodePtr> &breadth_node_map) {
   for (const auto &anchor : node->GetAllOutDataAnchors()) {
     for (const auto &peer_in_anchor : anchor->GetPeerInDataAnchors()) {
@@ -852,8 +856,24 @@ GE_FUNC_DEV_VISIBILITY GE_FUNC_HOST_VISIBILITY graphStatus ComputeGraph::Topolog
 }
 
 graphStatus ComputeGraph::TopologicalSortingGraph() {
+  // Links are read before sorting, a link changed meanwhile by another thread makes the next sorting not skipped
+  uint64_t link_version = Anchor::GetLinkVersion();
+  string run_mode;
+  (void)ge::GetContext().GetOption(ge::OPTION_GRAPH_RUN_MODE, run_mode);
+  if (IsTopoSortedWith(link_version, run_mode)) {
+    // Sorting sorted nodes gives the same order, only ids changed by sorting of the root graph are restored
+    GELOGD("Nodes and links of graph %s are not changed since last sorting, skip it.", name_.c_str());
+    int64_t id = 0;
+    for (const auto &node : nodes_) {
+      node->GetOpDesc()->SetId(id++);  // [node->GetOpDesc(): should not be null]
+    }
+    is_valid_flag_ = true;
+    return GRAPH_SUCCESS;
+  }
+
   std::vector<NodePtr> node_vec;
-  std::map<NodePtr, uint32_t> map_in_edge_num;
+  std::unordered_map<NodePtr, uint32_t> map_in_edge_num;
+  map_in_edge_num.reserve(nodes_.size());
   bool use_BFS = IsUseBFS();
   if (use_BFS) {
     std::deque<NodePtr> stack;
@@ -890,11 +910,21 @@ graphStatus ComputeGraph::TopologicalSortingGraph() {
     nodes_.push_back(node);
   }
 
+  is_topo_sorted_ = true;
+  sorted_nodes_version_ = nodes_.GetVersion();
+  sorted_link_version_ = link_version;
+  sorted_run_mode_ = run_mode;
   is_valid_flag_ = true;
   return GRAPH_SUCCESS;
 }
 
-graphStatus ComputeGraph::SortNodes(std::vector<NodePtr> &stack, std::map<NodePtr, uint32_t> &map_in_edge_num) {
+bool ComputeGraph::IsTopoSortedWith(uint64_t link_version, const std::string &run_mode) const {
+  return is_topo_sorted_ && (sorted_nodes_version_ == nodes_.GetVersion()) && (sorted_link_version_ == link_version) &&
+         (sorted_run_mode_ == run_mode);
+}
+
+graphStatus ComputeGraph::SortNodes(std::vector<NodePtr> &stack,
+                                    std::unordered_map<NodePtr, uint32_t> &map_in_edge_num) {
   // Record the number of non data nodes but no input nodes
   uint32_t spec_node_size = 0;
   bool verify_isolated = false;
@@ -1068,6 +1098,10 @@ GE_FUNC_DEV_VISIBILITY GE_FUNC_HOST_VISIBILITY void ComputeGraph::Swap(ComputeGr
   std::swap(session_id_, graph.session_id_);
   std::swap(data_format_, graph.data_format_);
   std::swap(is_unknown_shape_graph_, graph.is_unknown_shape_graph_);
+  std::swap(is_topo_sorted_, graph.is_topo_sorted_);
+  std::swap(sorted_nodes_version_, graph.sorted_nodes_version_);
+  std::swap(sorted_link_version_, graph.sorted_link_version_);
+  sorted_run_mode_.swap(graph.sorted_run_mode_);
 
   // Update Node owner.
   SetNodesOwner();
@@ -0,0 +1,366 @@
+/**
+ * Copyright 2019-2020 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "graph/detail/attr_store.h"
+#include <algorithm>
+#include <new>
+#include "proto/ge_ir.pb.h"
+
+namespace ge {
+namespace {
+const size_t kNameCacheSize = 256;
+
+struct NameCacheEntry {
+  std::string name;
+  AttrId id = 0;
+  bool valid = false;
+  bool found = false;
+  // size of the registry when the name was not found, a miss holds until a name is added
+  size_t name_count = 0;
+};
+
+// Ids never change once interned, so a per thread cache checked against the name needs no lock. It is indexed by
+// the address of the name, which hits for the attr name constants and costs no hashing.
+NameCacheEntry &GetNameCacheEntry(const std::string &name) {
+  thread_local std::vector<NameCacheEntry> cache(kNameCacheSize);
+  return cache[(reinterpret_cast<uintptr_t>(&name) / sizeof(std::string)) % kNameCacheSize];
+}
+
+template <typename T>
+void DestroyMember(T &member) {
+  member.~T();
+}
+}  // namespace
+
+AttrNameRegistry &AttrNameRegistry::Instance() {
+  static AttrNameRegistry instance;
+  return instance;
+}
+
+AttrId AttrNameRegistry::Intern(const std::string &name) {
+  auto &entry = GetNameCacheEntry(name);
+  if (entry.valid && entry.found && entry.name == name) {
+    return entry.id;
+  }
+  AttrId id = 0;
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto ret = ids_.emplace(name, static_cast<AttrId>(names_.size()));
+    if (ret.second) {
+      names_.emplace_back(&ret.first->first);
+      name_count_.store(names_.size(), std::memory_order_release);
+    }
+    id = ret.first->second;
+  }
+  entry.name = name;
+  entry.id = id;
+  entry.valid = true;
+  entry.found = true;
+  return id;
+}
+
+bool AttrNameRegistry::Find(const std::string &name, AttrId &id) const {
+  auto &entry = GetNameCacheEntry(name);
+  if (entry.valid && entry.name == name) {
+    if (entry.found) {
+      id = entry.id;
+      return true;
+    }
+    if (entry.name_count == name_count_.load(std::memory_order_acquire)) {
+      return false;
+    }
+  }
+  bool found = false;
+  size_t name_count = 0;
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto it = ids_.find(name);
+    found = (it != ids_.end());
+    id = found ? it->second : 0;
+    name_count = names_.size();
+  }
+  entry.name = name;
+  entry.id = id;
+  entry.valid = true;
+  entry.found = found;
+  entry.name_count = name_count;
+  return found;
+}
+
+const std::string &AttrNameRegistry::GetName(AttrId id) const {
+  std::lock_guard<std::mutex> lock(mutex_);
+  return *names_[id];
+}
+
+AttrStoreValue::AttrStoreValue(const std::string &value) : type_(VT_STRING) { new (&str_) std::string(value); }
+
+AttrStoreValue::AttrStoreValue(const std::vector<int64_t> &value) : type_(VT_LIST_INT) {
+  new (&list_int_) std::vector<int64_t>(value);
+}
+
+AttrStoreValue::AttrStoreValue(const std::vector<float> &value) : type_(VT_LIST_FLOAT) {
+  new (&list_float_) std::vector<float>(value);
+}
+
+AttrStoreValue::AttrStoreValue(const std::vector<std::string> &value) : type_(VT_LIST_STRING) {
+  new (&list_str_) std::vector<std::string>(value);
+}
+
+AttrStoreValue::AttrStoreValue(const AttrStoreValue &other) : type_(other.type_) { CopyFrom(other); }
+
+AttrStoreValue::AttrStoreValue(AttrStoreValue &&other) noexcept : type_(other.type_) { MoveFrom(std::move(other)); }
+
+AttrStoreValue &AttrStoreValue::operator=(const AttrStoreValue &other) {
+  if (this != &other) {
+    Destroy();
+    type_ = other.type_;
+    CopyFrom(other);
+  }
+  return *this;
+}
+
+AttrStoreValue &AttrStoreValue::operator=(AttrStoreValue &&other) noexcept {
+  if (this != &other) {
+    Destroy();
+    type_ = other.type_;
+    MoveFrom(std::move(other));
+  }
+  return *this;
+}
+
+AttrStoreValue::~AttrStoreValue() { Destroy(); }
+
+void AttrStoreValue::Destroy() {
+  switch (type_) {
+    case VT_STRING:
+      DestroyMember(str_);
+      break;
+    case VT_LIST_INT:
+      DestroyMember(list_int_);
+      break;
+    case VT_LIST_FLOAT:
+      DestroyMember(list_float_);
+      break;
+    case VT_LIST_STRING:
+      DestroyMember(list_str_);
+      break;
+    default:
+      break;
+  }
+}
+
+void AttrStoreValue::CopyFrom(const AttrStoreValue &other) {
+  switch (type_) {
+    case VT_INT:
+      int_ = other.int_;
+      break;
+    case VT_FLOAT:
+      float_ = other.float_;
+      break;
+    case VT_BOOL:
+      bool_ = other.bool_;
+      break;
+    case VT_STRING:
+      new (&str_) std::string(other.str_);
+      break;
+    case VT_LIST_INT:
+      new (&list_int_) std::vector<int64_t>(other.list_int_);
+      break;
+    case VT_LIST_FLOAT:
+      new (&list_float_) std::vector<float>(other.list_float_);
+      break;
+    case VT_LIST_STRING:
+      new (&list_str_) std::vector<std::string>(other.list_str_);
+      break;
+  }
+}
+
+void AttrStoreValue::MoveFrom(AttrStoreValue &&other) {
+  switch (type_) {
+    case VT_STRING:
+      new (&str_) std::string(std::move(other.str_));
+      break;
+    case VT_LIST_INT:
+      new (&list_int_) std::vector<int64_t>(std::move(other.list_int_));
+      break;
+    case VT_LIST_FLOAT:
+      new (&list_float_) std::vector<float>(std::move(other.list_float_));
+      break;
+    case VT_LIST_STRING:
+      new (&list_str_) std::vector<std::string>(std::move(other.list_str_));
+      break;
+    default:
+      CopyFrom(other);
+      break;
+  }
+}
+
+#define ATTR_STORE_VALUE_GET_IMP(ValType, value_type, member) \
+  bool AttrStoreValue::GetValue(ValType &value) const {       \
+    if (type_ != value_type) {                                \
+      return false;                                           \
+    }                                                         \
+    value = member;                                           \
+    return true;                                              \
+  }
+
+ATTR_STORE_VALUE_GET_IMP(int64_t, VT_INT, int_)
+ATTR_STORE_VALUE_GET_IMP(float, VT_FLOAT, float_)
+ATTR_STORE_VALUE_GET_IMP(bool, VT_BOOL, bool_)
+ATTR_STORE_VALUE_GET_IMP(std::string, VT_STRING, str_)
+ATTR_STORE_VALUE_GET_IMP(std::vector<int64_t>, VT_LIST_INT, list_int_)
+ATTR_STORE_VALUE_GET_IMP(std::vector<float>, VT_LIST_FLOAT, list_float_)
+ATTR_STORE_VALUE_GET_IMP(std::vector<std::string>, VT_LIST_STRING, list_str_)
+
+#undef ATTR_STORE_VALUE_GET_IMP
+
+bool AttrStoreValue::IsSameType(const proto::AttrDef &attr_def) const {
+  switch (type_) {
+    case VT_INT:
+      return attr_def.value_case() == proto::AttrDef::kI;
+    case VT_FLOAT:
+      return attr_def.value_case() == proto::AttrDef::kF;
+    case VT_BOOL:
+      return attr_def.value_case() == proto::AttrDef::kB;
+    case VT_STRING:
+      return attr_def.value_case() == proto::AttrDef::kS;
+    case VT_LIST_INT:
+      return attr_def.value_case() == proto::AttrDef::kList &&
+             attr_def.list().val_type() == proto::AttrDef_ListValue_ListValueType_VT_LIST_INT;
+    case VT_LIST_FLOAT:
+      return attr_def.value_case() == proto::AttrDef::kList &&
+             attr_def.list().val_type() == proto::AttrDef_ListValue_ListValueType_VT_LIST_FLOAT;
+    case VT_LIST_STRING:
+      return attr_def.value_case() == proto::AttrDef::kList &&
+             attr_def.list().val_type() == proto::AttrDef_ListValue_ListValueType_VT_LIST_STRING;
+  }
+  return false;
+}
+
+void AttrStoreValue::ToProto(proto::AttrDef &attr_def) const {
+  attr_def.Clear();
+  switch (type_) {
+    case VT_INT:
+      attr_def.set_i(int_);
+      break;
+    case VT_FLOAT:
+      attr_def.set_f(float_);
+      break;
+    case VT_BOOL:
+      attr_def.set_b(bool_);
+      break;
+    case VT_STRING:
+      attr_def.set_s(str_);
+      break;
+    case VT_LIST_INT: {
+      auto list = attr_def.mutable_list();
+      list->set_val_type(proto::AttrDef_ListValue_ListValueType_VT_LIST_INT);
+      list->mutable_i()->Reserve(static_cast<int>(list_int_.size()));
+      for (auto item : list_int_) {
+        list->add_i(item);
+      }
+      break;
+    }
+    case VT_LIST_FLOAT: {
+      auto list = attr_def.mutable_list();
+      list->set_val_type(proto::AttrDef_ListValue_ListValueType_VT_LIST_FLOAT);
+      list->mutable_f()->Reserve(static_cast<int>(list_float_.size()));
+      for (auto item : list_float_) {
+        list->add_f(item);
+      }
+      break;
+    }
+    case VT_LIST_STRING: {
+      auto list = attr_def.mutable_list();
+      list->set_val_type(proto::AttrDef_ListValue_ListValueType_VT_LIST_STRING);
+      for (const auto &item : list_str_) {
+        list->add_s(item);
+      }
+      break;
+    }
+  }
+}
+
+AttrStore::AttrStore(const AttrStore &other) : items_(other.items_) {}
+
+AttrStore &AttrStore::operator=(const AttrStore &other) {
+  if (this != &other) {
+    items_ = other.items_;
+  }
+  return *this;
+}
+
+std::vector<AttrStore::Item>::iterator AttrStore::LowerBound(AttrId id) {
+  return std::lower_bound(items_.begin(), items_.end(), id,
+                          [](const Item &item, AttrId item_id) { return item.id < item_id; });
+}
+
+std::vector<AttrStore::Item>::const_iterator AttrStore::LowerBound(AttrId id) const {
+  return std::lower_bound(items_.begin(), items_.end(), id,
+                          [](const Item &item, AttrId item_id) { return item.id < item_id; });
+}
+
+bool AttrStore::Set(const std::string &name, AttrStoreValue &&value) {
+  AttrId id = AttrNameRegistry::Instance().Intern(name);
+  auto it = LowerBound(id);
+  if (it != items_.end() && it->id == id) {
+    if (it->value.GetValueType() != value.GetValueType()) {
+      return false;
+    }
+    it->value = std::move(value);
+  } else {
+    if (proto_attrs_ != nullptr) {
+      // an attribute lives either in the store or in the proto attr map
+      auto proto_it = proto_attrs_->find(name);
+      if (proto_it != proto_attrs_->end()) {
+        if (!value.IsSameType(proto_it->second)) {
+          return false;
+        }
+        proto_attrs_->erase(proto_it);
+      }
+    }
+    (void)items_.emplace(it, id, std::move(value));
+  }
+  return true;
+}
+
+const AttrStoreValue *AttrStore::Get(const std::string &name) const {
+  if (items_.empty()) {
+    return nullptr;
+  }
+  AttrId id = 0;
+  if (!AttrNameRegistry::Instance().Find(name, id)) {
+    return nullptr;
+  }
+  auto it = LowerBound(id);
+  if (it == items_.end() || it->id != id) {
+    return nullptr;
+  }
+  return &it->value;
+}
+
+void AttrStore::CopyTo(ProtoMap &proto_attrs) const {
+  auto &registry = AttrNameRegistry::Instance();
+  for (const auto &item : items_) {
+    item.value.ToProto(proto_attrs[registry.GetName(item.id)]);
+  }
+}
+
+void AttrStore::MoveTo(ProtoMap &proto_attrs) {
+  CopyTo(proto_attrs);
+  std::vector<Item>().swap(items_);
+}
+}  // namespace ge
@@ -55,8 +55,29 @@ graphStatus AttrHolder::AddRequiredAttr(const std::string &name) {
   return GRAPH_SUCCESS;
 }
 
+ConstProtoAttrMapHelper AttrHolder::GetAttrMapFor(const std::string &name) const {
+  auto attr_store = GetAttrStore();
+  if (attr_store == nullptr) {
+    return GetAttrMap();
+  }
+  auto flat_value = attr_store->Get(name);
+  if (flat_value == nullptr) {
+    return GetProtoAttrMap();
+  }
+  // a map of its own for the flat attribute, the proto attr map of the holder is never written by a reader
+  auto attr_owner = ComGraphMakeShared<proto::OpDef>();
+  if (attr_owner == nullptr) {
+    GELOGE(GRAPH_FAILED, "proto::OpDef make shared failed");
+    return ConstProtoAttrMapHelper();
+  }
+  flat_value->ToProto((*attr_owner->mutable_attr())[name]);
+  return ConstProtoAttrMapHelper(attr_owner, &attr_owner->attr());
+}
+
 graphStatus AttrHolder::GetAttr(const std::string &name, GeAttrValue &value) const {
-  auto proto_map = GetAttrMap().GetProtoMsg();
+  // the map may be a copy owned by the helper only, so the helper is kept while the map is read
+  auto attr_map = GetAttrMapFor(name);
+  auto proto_map = attr_map.GetProtoMsg();
   auto proto_val = value.value_.GetProtoMsg();
   if (proto_map == nullptr || proto_val == nullptr) {
     return GRAPH_FAILED;
@@ -70,7 +91,11 @@ graphStatus AttrHolder::GetAttr(const std::string &name, GeAttrValue &value) con
 }
 
 bool AttrHolder::HasAttr(const std::string &name) const {
-  auto proto_map = GetAttrMap().GetProtoMsg();
+  auto attr_store = GetAttrStore();
+  if (attr_store != nullptr && attr_store->Get(name) != nullptr) {
+    return true;
+  }
+  auto proto_map = GetProtoAttrMap().GetProtoMsg();
   if (proto_map != nullptr) {
     if (proto_map->find(name) != proto_map->end()) {
       return true;
@@ -94,9 +119,10 @@ graphStatus AttrHolder::DelAttr(const std::string &name) {
 
 const std::map<string, GeAttrValue> AttrHolder::GetAllAttrs() const {
   std::map<string, GeAttrValue> attr_value_map;
-  auto proto_map = GetAttrMap().GetProtoMsg();
+  auto attr_map = GetAttrMap();
+  auto proto_map = attr_map.GetProtoMsg();
   if (proto_map != nullptr) {
-    auto proto_owner = GetAttrMap().GetProtoOwner();
+    auto proto_owner = attr_map.GetProtoOwner();
     GE_CHK_BOOL_EXEC(proto_owner != nullptr, return attr_value_map, "proto_owner is nullptr");
     for (const auto &it : *proto_map) {
       attr_value_map[it.first] = GeAttrValue(proto_owner, const_cast<proto::AttrDef *>(&it.second));
@@ -107,7 +133,8 @@ const std::map<string, GeAttrValue> AttrHolder::GetAllAttrs() const {
 
 const std::unordered_set<string> AttrHolder::GetAllAttrNames() const {
   std::unordered_set<string> names;
-  auto proto_map = GetAttrMap().GetProtoMsg();
+  auto attr_map = GetAttrMap();
+  auto proto_map = attr_map.GetProtoMsg();
   if (proto_map != nullptr) {
     for (const auto &it : *proto_map) {
       (void)names.insert(it.first);
@@ -0,0 +1,116 @@
+/**
+ * Copyright 2019-2020 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "graph/detail/node_list.h"
+
+#include <atomic>
+#include <utility>
+
+namespace ge {
+namespace {
+std::atomic<uint64_t> g_node_list_version(0);
+}  // namespace
+
+NodeList::NodeList() { UpdateVersion(); }
+
+NodeList::NodeList(const NodeList &other) : nodes_(other.nodes_) {
+  RebuildIndex();
+  UpdateVersion();
+}
+
+NodeList &NodeList::operator=(const NodeList &other) {
+  if (this != &other) {
+    nodes_ = other.nodes_;
+    RebuildIndex();
+    UpdateVersion();
+  }
+  return *this;
+}
+
+void NodeList::clear() {
+  nodes_.clear();
+  nodes_index_.clear();
+  UpdateVersion();
+}
+
+void NodeList::swap(NodeList &other) {
+  // iterators of std::list stay valid after swap, so do the indexes
+  nodes_.swap(other.nodes_);
+  nodes_index_.swap(other.nodes_index_);
+  std::swap(version_, other.version_);
+}
+
+bool NodeList::push_back(const NodePtr &node) { return Insert(nodes_.end(), node); }
+
+bool NodeList::push_front(const NodePtr &node) { return Insert(nodes_.begin(), node); }
+
+bool NodeList::InsertAfter(const NodePtr &pos_node, const NodePtr &node) {
+  auto iter = nodes_index_.find(pos_node.get());
+  if (iter == nodes_index_.end()) {
+    return false;
+  }
+  auto pos = iter->second;
+  return Insert(++pos, node);
+}
+
+bool NodeList::InsertBefore(const NodePtr &pos_node, const NodePtr &node) {
+  auto iter = nodes_index_.find(pos_node.get());
+  if (iter == nodes_index_.end()) {
+    return false;
+  }
+  return Insert(iter->second, node);
+}
+
+bool NodeList::Erase(const NodePtr &node) {
+  auto iter = nodes_index_.find(node.get());
+  if (iter == nodes_index_.end()) {
+    return false;
+  }
+  (void)nodes_.erase(iter->second);
+  (void)nodes_index_.erase(iter);
+  UpdateVersion();
+  return true;
+}
+
+void NodeList::Assign(const std::vector<NodePtr> &nodes) {
+  clear();
+  nodes_index_.reserve(nodes.size());
+  for (const auto &node : nodes) {
+    (void)push_back(node);
+  }
+}
+
+bool NodeList::Insert(ConstIterator pos, const NodePtr &node) {
+  if (node == nullptr || nodes_index_.count(node.get()) > 0) {
+    return false;
+  }
+  auto iter = nodes_.insert(pos, node);
+  nodes_index_[node.get()] = iter;
+  UpdateVersion();
+  return true;
+}
+
+void NodeList::RebuildIndex() {
+  nodes_index_.clear();
+  nodes_index_.reserve(nodes_.size());
+  for (auto iter = nodes_.begin(); iter != nodes_.end(); ++iter) {
+    nodes_index_[iter->get()] = iter;
+  }
+}
+
+// versions are drawn from a counter shared by all lists, so that a list never gets the version of another content
+void NodeList::UpdateVersion() { version_ = g_node_list_version.fetch_add(1) + 1; }
+}  // namespace ge
@@ -277,7 +277,7 @@ class AttrUtilsHelper {
 
   inline static bool GetValueCheckListType(
     const proto::AttrDef &attr_def, proto::AttrDef_ListValue_ListValueType proto_list_case,
-    const std::function<bool(const proto::AttrDef &proto_attr_val)> item_check_fun) {
+    const std::function<bool(const proto::AttrDef &proto_attr_val)> &item_check_fun) {
     if (attr_def.value_case() != proto::AttrDef::kList) {
       GELOGW("Check ListType Failed, value_case %u", attr_def.value_case());
       return false;
@@ -322,12 +322,19 @@ class AttrUtilsHelper {
     return true;
   }
 
-  static bool GetAttrMapItem(const AttrHolder *obj, const string &name, const proto::AttrDef *&attr_def) {
+  // Attr map of obj, whose proto owner is needed when getting the value. Empty if obj is nullptr
+  static ConstProtoAttrMapHelper GetAttrMap(const AttrHolder *obj, const string &name) {
     if (obj == nullptr) {
       GELOGE(FAILED, "%s obj is nullptr", name.c_str());
-      return false;
+      return ConstProtoAttrMapHelper();
     }
-    auto attr_map = obj->GetAttrMap().GetProtoMsg();
+    return obj->GetAttrMapFor(name);
+  }
+
+  // Look up in the attr map got by the caller, so that GetAttrMap is called only once for one attr
+  static bool GetAttrMapItem(const ConstProtoAttrMapHelper &attr_map_helper, const string &name,
+                             const proto::AttrDef *&attr_def) {
+    auto attr_map = attr_map_helper.GetProtoMsg();
     if (attr_map == nullptr) {
       GELOGE(FAILED, "%s attr map is nullptr", name.c_str());
       return false;
@@ -340,6 +347,48 @@ class AttrUtilsHelper {
     return true;
   }
 
+  // The flat store of obj, if any, serves the scalar and scalar list types. It refuses an attribute of another
+  // type of the same name, which then goes through the proto attr map to get the same result as before.
+  template <typename T>
+  static typename std::enable_if<AttrStoreValue::IsFlatType<T>::value, bool>::type SetFlatValue(
+    AttrHolder *obj, const string &name, const T &value) {
+    auto attr_store = (obj == nullptr) ? nullptr : obj->MutableAttrStore();
+    return (attr_store != nullptr) && attr_store->Set(name, AttrStoreValue(value));
+  }
+
+  template <typename T>
+  static typename std::enable_if<!AttrStoreValue::IsFlatType<T>::value, bool>::type SetFlatValue(AttrHolder *,
+                                                                                                  const string &,
+                                                                                                  const T &) {
+    return false;
+  }
+
+  static bool SetFlatValue(AttrHolder *obj, const string &name, const vector<int32_t> &value) {
+    return SetFlatValue(obj, name, vector<int64_t>(value.begin(), value.end()));
+  }
+
+  static bool SetFlatValue(AttrHolder *obj, const string &name, const vector<uint32_t> &value) {
+    return SetFlatValue(obj, name, vector<int64_t>(value.begin(), value.end()));
+  }
+
+  template <typename T>
+  static typename std::enable_if<AttrStoreValue::IsFlatType<T>::value, bool>::type GetFlatValue(
+    const AttrHolder *obj, const string &name, T &value) {
+    auto attr_store = (obj == nullptr) ? nullptr : obj->GetAttrStore();
+    if (attr_store == nullptr) {
+      return false;
+    }
+    auto flat_value = attr_store->Get(name);
+    return (flat_value != nullptr) && flat_value->GetValue(value);
+  }
+
+  template <typename T>
+  static typename std::enable_if<!AttrStoreValue::IsFlatType<T>::value, bool>::type GetFlatValue(const AttrHolder *,
+                                                                                                  const string &,
+                                                                                                  T &) {
+    return false;
+  }
+
   inline static bool MutableAttrMapItem(AttrHolder *obj, const string &name, proto::AttrDef *&attr_def) {
     if (obj == nullptr) {
       GELOGE(FAILED, " %s obj is nullptr", name.c_str());
@@ -642,6 +691,7 @@ bool GeAttrValueImp::SetValue(proto::AttrDef &proto_attr_val, const ge::DataType
       return false;                                                                                                    \
     }                                                                                                                  \
     auto &list = proto_attr_val.list();                                                                                \
+    value.reserve(list.protoItem##_size());                                                                            \
     for (const auto &item : list.protoItem()) {                                                                        \
       value.push_back(item);                                                                                           \
     }                                                                                                                  \
@@ -932,6 +982,9 @@ bool AttrUtils::HasAttr(ConstAttrHolderAdapter &&obj, const string &name) {
 #define ATTR_UTILS_SET_IMP(FuncName, Type)                                                                    \
   GE_FUNC_DEV_VISIBILITY GE_FUNC_HOST_VISIBILITY bool AttrUtils::Set##FuncName(                               \
     AttrHolderAdapter &&obj, const string &name, const Type &value) {                                         \
+    if (AttrUtilsHelper::SetFlatValue(obj.get(), name, value)) {                                              \
+      return true;                                                                                            \
+    }                                                                                                         \
     proto::AttrDef *proto_attr_val = nullptr;                                                                 \
     if (!AttrUtilsHelper::MutableAttrMapItem(obj.get(), name, proto_attr_val) || proto_attr_val == nullptr) { \
       return false;                                                                                           \
@@ -946,11 +999,15 @@ bool AttrUtils::HasAttr(ConstAttrHolderAdapter &&obj, const string &name) {
 #define ATTR_UTILS_GET_IMP(FuncName, Type)                                                                        \
   GE_FUNC_DEV_VISIBILITY GE_FUNC_HOST_VISIBILITY bool AttrUtils::Get##FuncName(ConstAttrHolderAdapter &&obj,      \
                                                                                const string &name, Type &value) { \
+    if (AttrUtilsHelper::GetFlatValue(obj.get(), name, value)) {                                                  \
+      return true;                                                                                                \
+    }                                                                                                             \
+    auto attr_map = AttrUtilsHelper::GetAttrMap(obj.get(), name);                                                 \
     const proto::AttrDef *proto_attr_val = nullptr;                                                               \
-    if (!AttrUtilsHelper::GetAttrMapItem(obj.get(), name, proto_attr_val) || proto_attr_val == nullptr) {         \
+    if (!AttrUtilsHelper::GetAttrMapItem(attr_map, name, proto_attr_val) || proto_attr_val == nullptr) {          \
       return false;                                                                                               \
     }                                                                                                             \
-    if (!GeAttrValueImp::GetValue(*proto_attr_val, obj->GetAttrMap().GetProtoOwner(), value)) {                   \
+    if (!GeAttrValueImp::GetValue(*proto_attr_val, attr_map.GetProtoOwner(), value)) {                            \
       GELOGW("Get" #FuncName " failed key %s", name.c_str());                                                     \
       return false;                                                                                               \
     }                                                                                                             \
@@ -998,12 +1055,13 @@ bool AttrUtils::SetListTensor(AttrHolderAdapter &&obj, const string &name,
 }
 
 bool AttrUtils::GetTensor(ConstAttrHolderAdapter &&obj, const string &name, ConstGeTensorPtr &value) {
+  auto attr_map = AttrUtilsHelper::GetAttrMap(obj.get(), name);
   const proto::AttrDef *proto_attr_val = nullptr;
-  if (!AttrUtilsHelper::GetAttrMapItem(obj.get(), name, proto_attr_val) || proto_attr_val == nullptr) {
+  if (!AttrUtilsHelper::GetAttrMapItem(attr_map, name, proto_attr_val) || proto_attr_val == nullptr) {
     return false;
   }
   GeTensorPtr tensor;
-  if (!GeAttrValueImp::GetValue(*proto_attr_val, obj->GetAttrMap().GetProtoOwner(), tensor)) {
+  if (!GeAttrValueImp::GetValue(*proto_attr_val, attr_map.GetProtoOwner(), tensor)) {
     return false;
   }
   value = tensor;
@@ -1012,12 +1070,13 @@ bool AttrUtils::GetTensor(ConstAttrHolderAdapter &&obj, const string &name, Cons
 
 bool AttrUtils::GetListTensor(ConstAttrHolderAdapter &&obj, const string &name, vector<ConstGeTensorPtr> &value) {
   value.clear();
+  auto attr_map = AttrUtilsHelper::GetAttrMap(obj.get(), name);
   const proto::AttrDef *proto_attr_val = nullptr;
-  if (!AttrUtilsHelper::GetAttrMapItem(obj.get(), name, proto_attr_val) || proto_attr_val == nullptr) {
+  if (!AttrUtilsHelper::GetAttrMapItem(attr_map, name, proto_attr_val) || proto_attr_val == nullptr) {
     return false;
   }
   vector<GeTensorPtr> tensor;
-  if (!GeAttrValueImp::GetValue(*proto_attr_val, obj->GetAttrMap().GetProtoOwner(), tensor)) {
+  if (!GeAttrValueImp::GetValue(*proto_attr_val, attr_map.GetProtoOwner(), tensor)) {
     return false;
   }
   value.insert(value.begin(), tensor.begin(), tensor.end());
@@ -1026,23 +1085,28 @@ bool AttrUtils::GetListTensor(ConstAttrHolderAdapter &&obj, const string &name,
 
 GE_FUNC_DEV_VISIBILITY GE_FUNC_HOST_VISIBILITY bool AttrUtils::MutableTensor(AttrHolderAdapter &&obj,
                                                                              const string &name, GeTensorPtr &value) {
+  auto attr_map = AttrUtilsHelper::GetAttrMap(obj.get(), name);
   const proto::AttrDef *proto_attr_val = nullptr;
-  if (!AttrUtilsHelper::GetAttrMapItem(obj.get(), name, proto_attr_val) || proto_attr_val == nullptr) {
+  if (!AttrUtilsHelper::GetAttrMapItem(attr_map, name, proto_attr_val) || proto_attr_val == nullptr) {
     return false;
   }
-  return GeAttrValueImp::GetValue(*proto_attr_val, obj->GetAttrMap().GetProtoOwner(), value);
+  return GeAttrValueImp::GetValue(*proto_attr_val, attr_map.GetProtoOwner(), value);
 }
 
 bool AttrUtils::MutableListTensor(AttrHolderAdapter &&obj, const string &name, vector<GeTensorPtr> &value) {
   value.clear();
+  auto attr_map = AttrUtilsHelper::GetAttrMap(obj.get(), name);
   const proto::AttrDef *proto_attr_val = nullptr;
-  if (!AttrUtilsHelper::GetAttrMapItem(obj.get(), name, proto_attr_val) || proto_attr_val == nullptr) {
+  if (!AttrUtilsHelper::GetAttrMapItem(attr_map, name, proto_attr_val) || proto_attr_val == nullptr) {
     return false;
   }
-  return GeAttrValueImp::GetValue(*proto_attr_val, obj->GetAttrMap().GetProtoOwner(), value);
+  return GeAttrValueImp::GetValue(*proto_attr_val, attr_map.GetProtoOwner(), value);
 }
 
 bool AttrUtils::SetListInt(AttrHolderAdapter &&obj, const string &name, std::initializer_list<int64_t> &&value) {
+  if (AttrUtilsHelper::SetFlatValue(obj.get(), name, vector<int64_t>(value))) {
+    return true;
+  }
   proto::AttrDef *proto_attr_val = nullptr;
   if (!AttrUtilsHelper::MutableAttrMapItem(obj.get(), name, proto_attr_val) || proto_attr_val == nullptr) {
     return false;
@@ -1172,16 +1236,17 @@ GE_FUNC_DEV_VISIBILITY GE_FUNC_HOST_VISIBILITY bool AttrUtils::SetZeroCopyBytes(
   if (!AttrUtilsHelper::MutableAttrMapItem(obj.get(), name, proto_attr_val) || proto_attr_val == nullptr) {
     return false;
   }
-  return GeAttrValueImp::SetZeroCopyBytes(*proto_attr_val, obj->GetAttrMap().GetProtoOwner(), std::move(buffer));
+  return GeAttrValueImp::SetZeroCopyBytes(*proto_attr_val, obj->GetProtoAttrMap().GetProtoOwner(), std::move(buffer));
 }
 
 GE_FUNC_DEV_VISIBILITY GE_FUNC_HOST_VISIBILITY bool AttrUtils::GetZeroCopyBytes(ConstAttrHolderAdapter &&obj,
                                                                                 const string &name, Buffer &buffer) {
+  auto attr_map = AttrUtilsHelper::GetAttrMap(obj.get(), name);
   const proto::AttrDef *proto_attr_val = nullptr;
-  if (!AttrUtilsHelper::GetAttrMapItem(obj.get(), name, proto_attr_val) || proto_attr_val == nullptr) {
+  if (!AttrUtilsHelper::GetAttrMapItem(attr_map, name, proto_attr_val) || proto_attr_val == nullptr) {
     return false;
   }
-  return GeAttrValueImp::GetZeroCopyBytes(*proto_attr_val, obj->GetAttrMap().GetProtoOwner(), buffer);
+  return GeAttrValueImp::GetZeroCopyBytes(*proto_attr_val, attr_map.GetProtoOwner(), buffer);
 }
 
 bool AttrUtils::SetZeroCopyListBytes(AttrHolderAdapter &&obj, const string &name, vector<Buffer> &list_buffer) {
@@ -1190,16 +1255,17 @@ bool AttrUtils::SetZeroCopyListBytes(AttrHolderAdapter &&obj, const string &name
   if (!AttrUtilsHelper::MutableAttrMapItem(obj.get(), name, proto_attr_val) || proto_attr_val == nullptr) {
     return false;
   }
-  return GeAttrValueImp::SetZeroCopyListBytes(*proto_attr_val, obj->GetAttrMap().GetProtoOwner(), list_buffer);
+  return GeAttrValueImp::SetZeroCopyListBytes(*proto_attr_val, obj->GetProtoAttrMap().GetProtoOwner(), list_buffer);
 }
 
 bool AttrUtils::GetZeroCopyListBytes(ConstAttrHolderAdapter &&obj, const string &name, vector<Buffer> &list_buffer) {
   list_buffer.clear();
+  auto attr_map = AttrUtilsHelper::GetAttrMap(obj.get(), name);
   const proto::AttrDef *proto_attr_val = nullptr;
-  if (!AttrUtilsHelper::GetAttrMapItem(obj.get(), name, proto_attr_val) || proto_attr_val == nullptr) {
+  if (!AttrUtilsHelper::GetAttrMapItem(attr_map, name, proto_attr_val) || proto_attr_val == nullptr) {
     return false;
   }
-  return GeAttrValueImp::GetZeroCopyListBytes(*proto_attr_val, obj->GetAttrMap().GetProtoOwner(), list_buffer);
+  return GeAttrValueImp::GetZeroCopyListBytes(*proto_attr_val, attr_map.GetProtoOwner(), list_buffer);
 }
 
 GE_FUNC_DEV_VISIBILITY GE_FUNC_HOST_VISIBILITY OpDescPtr AttrUtils::CloneOpDesc(const ConstOpDescPtr &org_op_desc) {
@@ -1286,4 +1352,12 @@ std::string AttrUtils::GetAllAttrsStr(AttrUtils::ConstAttrHolderAdapter &&obj) {
   }
   return ss.str();
 }
+
+std::map<std::string, GeAttrValue> AttrUtils::GetAllAttrs(AttrUtils::ConstAttrHolderAdapter &&obj) {
+  auto holder = obj.get();
+  if (holder == nullptr) {
+    return {};
+  }
+  return holder->GetAllAttrs();
+}
 }  // namespace ge
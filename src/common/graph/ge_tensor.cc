@@ -15,6 +15,7 @@
  */
 
 #include "graph/ge_tensor.h"
+#include <algorithm>
 #include <cstdlib>
 #include <cstring>
 #include <iostream>
@@ -67,19 +68,80 @@ static const std::map<DataType, int> kDataTypeSelfDefinedMap = {
   {DT_QINT8, 18}, {DT_QINT16, 19},        {DT_QINT32, 20},         {DT_QUINT8, 21},    {DT_QUINT16, 22},
 };
 
-GeShape::GeShape() { shape_def_.InitDefault(); }
+constexpr size_t GeShape::kInlineDimNum;
+
+GeShape::GeShape() {}
 
 // Default
 GeShape::GeShape(std::vector<int64_t> s) : GeShape() {
-  auto proto_msg = shape_def_.GetProtoMsg();
-  if (proto_msg != nullptr) {
-    for (auto i : s) {
-      proto_msg->add_dim(i);
+  ResizeDims(s.size());
+  if (!s.empty()) {
+    (void)std::copy(s.begin(), s.end(), MutableDimsData());
+  }
+  UpdateCache();
+}
+
+void GeShape::ResizeDims(size_t dim_num) {
+  if (dim_num > kInlineDimNum) {
+    if (dim_num_ <= kInlineDimNum) {
+      heap_dims_.assign(inline_dims_, inline_dims_ + dim_num_);
+    }
+    heap_dims_.resize(dim_num);
+  } else if (dim_num_ > kInlineDimNum) {
+    (void)std::copy(heap_dims_.begin(), heap_dims_.begin() + dim_num, inline_dims_);
+    heap_dims_.clear();
+  }
+  dim_num_ = dim_num;
+}
+
+void GeShape::UpdateCache() {
+  // the same rules as the proto based implementation
+  is_unknown_shape_ = false;
+  is_unknown_dim_num_ = false;
+  shape_size_ = dim_num_ == 0 ? 0 : 1;
+  const int64_t *dims = DimsData();
+  for (size_t i = 0; i < dim_num_; ++i) {
+    if (dims[i] == UNKNOWN_DIM_NUM) {
+      is_unknown_dim_num_ = true;
+    }
+    if (dims[i] < 0) {
+      is_unknown_shape_ = true;
+    }
+    if (shape_size_ != UNKNOWN_DIM) {
+      shape_size_ = (dims[i] == UNKNOWN_DIM || dims[i] == UNKNOWN_DIM_NUM) ? UNKNOWN_DIM : shape_size_ * dims[i];
     }
   }
 }
 
+void GeShape::CopyDimsFrom(const GeShape &other) {
+  if (!other.is_ref_) {
+    ResizeDims(other.dim_num_);
+    if (dim_num_ > 0) {
+      (void)std::copy(other.DimsData(), other.DimsData() + dim_num_, MutableDimsData());
+    }
+    shape_size_ = other.shape_size_;
+    is_unknown_shape_ = other.is_unknown_shape_;
+    is_unknown_dim_num_ = other.is_unknown_dim_num_;
+    return;
+  }
+
+  auto proto_msg = other.shape_def_.GetProtoMsg();
+  if (proto_msg == nullptr) {
+    return;
+  }
+  ResizeDims(static_cast<size_t>(proto_msg->dim_size()));
+  int64_t *dims = MutableDimsData();
+  for (size_t i = 0; i < dim_num_; ++i) {
+    dims[i] = proto_msg->dim(static_cast<int>(i));
+  }
+  UpdateCache();
+}
+
 size_t GeShape::GetDimNum() const {
+  if (!is_ref_) {
+    // check whether contain -2, if true, return 0
+    return is_unknown_dim_num_ ? 0 : dim_num_;
+  }
   auto proto_msg = shape_def_.GetProtoMsg();
   if (proto_msg != nullptr) {
     if (proto_msg->dim_size() >= 0) {
@@ -98,6 +160,9 @@ size_t GeShape::GetDimNum() const {
 }
 
 int64_t GeShape::GetDim(size_t idx) const {
+  if (!is_ref_) {
+    return idx < dim_num_ ? DimsData()[idx] : 0;
+  }
   auto proto_msg = shape_def_.GetProtoMsg();
   if (proto_msg != nullptr) {
     if (proto_msg->dim_size() > static_cast<int>(idx)) {
@@ -108,6 +173,19 @@ int64_t GeShape::GetDim(size_t idx) const {
 }
 
 graphStatus GeShape::SetDim(size_t idx, int64_t value) {
+  if (!is_ref_) {
+    if (dim_num_ == 0) {
+      GELOGE(GRAPH_FAILED, "shape is empty");
+      return GRAPH_FAILED;
+    }
+    if (idx >= dim_num_) {
+      GELOGE(GRAPH_FAILED, "idx is out of range");
+      return GRAPH_FAILED;
+    }
+    MutableDimsData()[idx] = value;
+    UpdateCache();
+    return GRAPH_SUCCESS;
+  }
   auto proto_msg = shape_def_.GetProtoMsg();
   if (proto_msg != nullptr) {
     auto dims = proto_msg->mutable_dim();
@@ -126,36 +204,36 @@ graphStatus GeShape::SetDim(size_t idx, int64_t value) {
 }
 
 std::vector<int64_t> GeShape::GetDims() const {
+  if (!is_ref_) {
+    return std::vector<int64_t>(DimsData(), DimsData() + dim_num_);
+  }
   vector<int64_t> dims;
   auto proto_msg = shape_def_.GetProtoMsg();
   if (proto_msg != nullptr) {
-    for (auto i : proto_msg->dim()) {
-      dims.push_back(i);
-    }
+    dims.assign(proto_msg->dim().begin(), proto_msg->dim().end());
   }
   return dims;
 }
 
 std::string GeShape::ToString() const {
-  auto proto_msg = shape_def_.GetProtoMsg();
-  if (proto_msg == nullptr) {
+  if (is_ref_ && shape_def_.GetProtoMsg() == nullptr) {
     return "";
   }
 
   std::stringstream ss;
-  bool first = true;
-  for (auto i : proto_msg->dim()) {
-    if (first) {
-      first = false;
-    } else {
+  for (size_t i = 0; i < (is_ref_ ? static_cast<size_t>(shape_def_.GetProtoMsg()->dim_size()) : dim_num_); ++i) {
+    if (i != 0) {
       ss << ",";
     }
-    ss << i;
+    ss << GetDim(i);
   }
   return ss.str();
 }
 
 int64_t GeShape::GetShapeSize() const {
+  if (!is_ref_) {
+    return shape_size_;
+  }
   int64_t res = 1;
   auto proto_msg = shape_def_.GetProtoMsg();
   if (proto_msg != nullptr) {
@@ -178,6 +256,9 @@ int64_t GeShape::GetShapeSize() const {
 /// @return bool
 /// ///
 bool GeShape::IsUnknownShape() const {
+  if (!is_ref_) {
+    return is_unknown_shape_;
+  }
   auto proto_msg = shape_def_.GetProtoMsg();
   if (proto_msg != nullptr) {
     for (auto i : proto_msg->dim()) {
@@ -194,6 +275,9 @@ bool GeShape::IsUnknownShape() const {
 /// @return bool
 ///
 bool GeShape::IsScalar() const {
+  if (!is_ref_) {
+    return dim_num_ == 0;
+  }
   auto proto_msg = shape_def_.GetProtoMsg();
   if (proto_msg != nullptr) {
     return proto_msg->dim().empty();
@@ -222,23 +306,73 @@ const string TENSOR_UTILS_ORIGIN_DATA_TYPE = "origin_data_type";
 const string TENSOR_UTILS_SHAPE_RANGE = "shape_range";
 const string TENSOR_UTILS_REF_PORT_INDEX = "ref_port_index";
 
-GeShape::GeShape(const ProtoMsgOwner &proto_owner, proto::ShapeDef *proto_msg) : shape_def_(proto_owner, proto_msg) {}
+GeShape::GeShape(const ProtoMsgOwner &proto_owner, proto::ShapeDef *proto_msg)
+    : shape_def_(proto_owner, proto_msg), is_ref_(true) {}
 
-GeShape::GeShape(const GeShape &other) : GeShape() { shape_def_.CopyValueFrom(other.shape_def_); }
+GeShape::GeShape(const GeShape &other) : GeShape() { CopyDimsFrom(other); }
 
-GeShape::GeShape(GeShape &&other) : GeShape() { shape_def_.MoveValueFrom(std::move(other.shape_def_)); }
+GeShape::GeShape(GeShape &&other) : GeShape() {
+  // the moved shape is left empty
+  if (other.is_ref_) {
+    CopyDimsFrom(other);
+    if (other.shape_def_.GetProtoMsg() != nullptr) {
+      other.shape_def_.GetProtoMsg()->clear_dim();
+    }
+    return;
+  }
+  if (other.dim_num_ > kInlineDimNum) {
+    heap_dims_ = std::move(other.heap_dims_);
+    dim_num_ = other.dim_num_;
+    shape_size_ = other.shape_size_;
+    is_unknown_shape_ = other.is_unknown_shape_;
+    is_unknown_dim_num_ = other.is_unknown_dim_num_;
+  } else {
+    CopyDimsFrom(other);
+  }
+  other.heap_dims_.clear();
+  other.dim_num_ = 0;
+  other.UpdateCache();
+}
 
 GeShape &GeShape::operator=(const GeShape &other) {
-  if (&other != this) {
-    shape_def_.CopyValueFrom(other.shape_def_);
+  if (&other == this) {
+    return *this;
+  }
+  if (!is_ref_) {
+    CopyDimsFrom(other);
+    return *this;
+  }
+
+  // write through to the referred tensor descriptor
+  auto proto_msg = shape_def_.GetProtoMsg();
+  if (proto_msg == nullptr || (other.is_ref_ && other.shape_def_.GetProtoMsg() == nullptr)) {
+    return *this;
+  }
+  if (other.is_ref_) {
+    *proto_msg = *other.shape_def_.GetProtoMsg();
+    return *this;
+  }
+  proto_msg->clear_dim();
+  proto_msg->mutable_dim()->Reserve(static_cast<int>(other.dim_num_));
+  for (size_t i = 0; i < other.dim_num_; ++i) {
+    proto_msg->add_dim(other.DimsData()[i]);
   }
   return *this;
 }
 
 GeShape &GeShape::operator=(GeShape &&other) {
-  if (&other != this) {
-    shape_def_.CopyValueFrom(std::move(other.shape_def_));
-  }
+  // dims on heap are taken over, inline dims and those of a tensor descriptor are copied as they are cheap
+  if (&other == this || is_ref_ || other.is_ref_ || other.dim_num_ <= kInlineDimNum) {
+    return operator=(static_cast<const GeShape &>(other));
+  }
+  heap_dims_ = std::move(other.heap_dims_);
+  dim_num_ = other.dim_num_;
+  shape_size_ = other.shape_size_;
+  is_unknown_shape_ = other.is_unknown_shape_;
+  is_unknown_dim_num_ = other.is_unknown_dim_num_;
+  other.heap_dims_.clear();
+  other.dim_num_ = 0;
+  other.UpdateCache();
   return *this;
 }
 
@@ -27,7 +27,9 @@ COMMON_LOCAL_SRC_FILES := \
     ./operator_factory_impl.cc \
     ./ge_attr_define.cc \
     ./ge_tensor.cc \
+    ./detail/attr_store.cc \
     ./detail/attributes_holder.cc \
+    ./detail/node_list.cc \
     ./utils/anchor_utils.cc \
     ./utils/graph_utils.cc \
     ./utils/ge_ir_utils.cc \
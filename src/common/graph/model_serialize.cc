@@ -92,6 +92,7 @@ bool ModelSerializeImp::SerializeOpDesc(const ConstOpDescPtr &op_desc, proto::Op
   GE_CHK_BOOL_EXEC(op_def_proto != nullptr, return false, "op_def_proto is null.");
   if (op_desc->op_def_.GetProtoMsg() != nullptr) {
     *op_def_proto = *op_desc->op_def_.GetProtoMsg();
+    op_desc->attr_store_.CopyTo(*op_def_proto->mutable_attr());
     // Delete unnecessary attr
     if (is_dump) {
       auto attr = op_def_proto->mutable_attr();
@@ -916,13 +916,35 @@ ProtoAttrMapHelper OpDesc::MutableAttrMap() {
     GELOGE(GRAPH_FAILED, "op def get proto msg failed");
     return GeIrProtoHelper<ProtoAttrMap>();
   }
+  // the caller may write the proto attr map directly, so it takes over the flat attributes
+  attr_store_.MoveTo(*op_def_.GetProtoMsg()->mutable_attr());
   return ProtoAttrMapHelper(op_def_.GetProtoOwner(), op_def_.GetProtoMsg()->mutable_attr());
 }
 
 ConstProtoAttrMapHelper OpDesc::GetAttrMap() const {
+  if (attr_store_.Empty() || op_def_.GetProtoMsg() == nullptr) {
+    return GetProtoAttrMap();
+  }
+  // const readers never write op_def_, which other threads may be reading, so the flat attributes go to a copy
+  auto attr_owner = ComGraphMakeShared<proto::OpDef>();
+  if (attr_owner == nullptr) {
+    GELOGE(GRAPH_FAILED, "proto::OpDef make shared failed");
+    return ConstProtoAttrMapHelper();
+  }
+  *attr_owner->mutable_attr() = op_def_.GetProtoMsg()->attr();
+  attr_store_.CopyTo(*attr_owner->mutable_attr());
+  return ConstProtoAttrMapHelper(attr_owner, &attr_owner->attr());
+}
+
+ConstProtoAttrMapHelper OpDesc::GetProtoAttrMap() const {
   return ConstProtoAttrMapHelper(op_def_.GetProtoOwner(), &op_def_.GetProtoMsg()->attr());
 }
 
+AttrStore *OpDesc::MutableAttrStore() {
+  attr_store_.BindProto(op_def_.GetProtoMsg() == nullptr ? nullptr : op_def_.GetProtoMsg()->mutable_attr());
+  return &attr_store_;
+}
+
 GE_FUNC_DEV_VISIBILITY GE_FUNC_HOST_VISIBILITY void OpDesc::SetId(int64_t id) {
   auto proto_msg = op_def_.GetProtoMsg();
   if (proto_msg != nullptr) {
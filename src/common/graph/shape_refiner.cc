@@ -17,6 +17,7 @@
 #include "graph/shape_refiner.h"
 
 #include <memory>
+#include <mutex>
 #include <string>
 #include <unordered_map>
 #include <utility>
@@ -482,8 +483,43 @@ graphStatus ShapeRefiner::InferShapeAndType(const ConstNodePtr &node, Operator &
   return GRAPH_SUCCESS;
 }
 
-InferenceContextPtr CreateInferenceContext(const std::unordered_map<NodePtr, InferenceContextPtr> &context_map,
-                                           const NodePtr &node) {
+namespace {
+// inference contexts of nodes in one graph
+struct GraphContextMap {
+  std::mutex mu;
+  std::weak_ptr<ComputeGraph> graph;
+  std::unordered_map<NodePtr, InferenceContextPtr> contexts;
+};
+
+// contexts are kept per owner graph, so that nodes can be inferred concurrently, and
+// inferring one graph never observes contexts left by another one
+std::mutex context_maps_mu;
+std::unordered_map<const ComputeGraph *, std::shared_ptr<GraphContextMap>> context_maps;
+
+// nodes inferred concurrently may share a successor, whose input descs are updated by each of them
+std::mutex peer_update_mu;
+
+std::shared_ptr<GraphContextMap> GetContextMap(const ComputeGraphPtr &graph) {
+  std::lock_guard<std::mutex> lk(context_maps_mu);
+  auto &context_map = context_maps[graph.get()];
+  if (context_map != nullptr && !context_map->graph.expired()) {
+    return context_map;
+  }
+  // the address of a freed graph may be taken by a new one, which must not see contexts of the freed one
+  context_map = std::make_shared<GraphContextMap>();
+  context_map->graph = graph;
+  for (auto iter = context_maps.begin(); iter != context_maps.end();) {
+    if (iter->second == nullptr || iter->second->graph.expired()) {
+      iter = context_maps.erase(iter);
+    } else {
+      ++iter;
+    }
+  }
+  return context_map;
+}
+}  // namespace
+
+InferenceContextPtr CreateInferenceContext(GraphContextMap &context_map, const NodePtr &node) {
   if (node == nullptr) {
     GELOGE(GRAPH_FAILED, "node is null");
     return nullptr;
@@ -499,6 +535,7 @@ InferenceContextPtr CreateInferenceContext(const std::unordered_map<NodePtr, Inf
   std::vector<std::string> marks;
 
   bool has_input_shapes_and_types = false;
+  std::lock_guard<std::mutex> lk(context_map.mu);
   for (const auto &in_anchor : all_in_data_anchors) {
     const auto &out_anchor = in_anchor->GetPeerOutAnchor();
     if (out_anchor == nullptr) {
@@ -510,8 +547,8 @@ InferenceContextPtr CreateInferenceContext(const std::unordered_map<NodePtr, Inf
       continue;
     }
 
-    auto iter = context_map.find(input_node);
-    if (iter != context_map.end()) {
+    auto iter = context_map.contexts.find(input_node);
+    if (iter != context_map.contexts.end()) {
       const auto &src_context = iter->second;
       GE_IF_BOOL_EXEC(src_context == nullptr, GELOGE(GRAPH_FAILED, "src_context is null."); return nullptr);
       GELOGD("node:%s get %ld marks from node:%s", node->GetName().c_str(), src_context->GetMarks().size(),
@@ -543,10 +580,37 @@ InferenceContextPtr CreateInferenceContext(const std::unordered_map<NodePtr, Inf
 }
 
 namespace {
-std::unordered_map<NodePtr, InferenceContextPtr> context_map;
+// the nodes and contexts are released at once, even if the map is still held by a running inference
+void ReleaseContextMap(const ComputeGraph *graph) {
+  auto iter = context_maps.find(graph);
+  if (iter == context_maps.end()) {
+    return;
+  }
+  if (iter->second != nullptr) {
+    std::lock_guard<std::mutex> lk(iter->second->mu);
+    iter->second->contexts.clear();
+  }
+  (void)context_maps.erase(iter);
+}
+}  // namespace
+
+GE_FUNC_DEV_VISIBILITY GE_FUNC_HOST_VISIBILITY void ShapeRefiner::ClearContextMap() {
+  std::lock_guard<std::mutex> lk(context_maps_mu);
+  while (!context_maps.empty()) {
+    ReleaseContextMap(context_maps.begin()->first);
+  }
 }
 
-GE_FUNC_DEV_VISIBILITY GE_FUNC_HOST_VISIBILITY void ShapeRefiner::ClearContextMap() { context_map.clear(); }
+GE_FUNC_DEV_VISIBILITY GE_FUNC_HOST_VISIBILITY void ShapeRefiner::ClearContextMap(const ComputeGraphPtr &graph) {
+  if (graph == nullptr) {
+    return;
+  }
+  std::lock_guard<std::mutex> lk(context_maps_mu);
+  ReleaseContextMap(graph.get());
+  for (const auto &subgraph : graph->GetAllSubgraphs()) {
+    ReleaseContextMap(subgraph.get());
+  }
+}
 
 GE_FUNC_DEV_VISIBILITY GE_FUNC_HOST_VISIBILITY graphStatus ShapeRefiner::InferShapeAndType(const NodePtr &node) {
   return InferShapeAndType(node, true);
@@ -561,9 +625,13 @@ GE_FUNC_DEV_VISIBILITY GE_FUNC_HOST_VISIBILITY graphStatus ShapeRefiner::InferSh
   PrintInOutTensorShape(node, "before_infershape");
   Operator op = OpDescUtils::CreateOperatorFromNode(node);
 
-  bool is_unknown_graph = node->GetOwnerComputeGraph()->GetGraphUnknownFlag();
+  auto owner_graph = node->GetOwnerComputeGraph();
+  GE_IF_BOOL_EXEC(owner_graph == nullptr, GELOGE(GRAPH_FAILED, "owner graph is null."); return GRAPH_FAILED);
+  bool is_unknown_graph = owner_graph->GetGraphUnknownFlag();
+  std::shared_ptr<GraphContextMap> context_map;
   if (!is_unknown_graph) {
-    auto inference_context = CreateInferenceContext(context_map, node);
+    context_map = GetContextMap(owner_graph);
+    auto inference_context = CreateInferenceContext(*context_map, node);
     if (inference_context == nullptr) {
       GELOGE(GRAPH_FAILED, "inference context is null");
       return GRAPH_FAILED;
@@ -574,6 +642,7 @@ GE_FUNC_DEV_VISIBILITY GE_FUNC_HOST_VISIBILITY graphStatus ShapeRefiner::InferSh
 
   graphStatus status = InferShapeAndType(node, op, before_subgraph);
   if (status == GRAPH_PARAM_INVALID || status == GRAPH_SUCCESS) {
+    std::lock_guard<std::mutex> lk(peer_update_mu);
     (void)ge::NodeUtils::UpdatePeerNodeInputDesc(node);
   } else {
     GELOGE(GRAPH_FAILED, "%s call infer function failed.", node->GetName().c_str());
@@ -586,7 +655,8 @@ GE_FUNC_DEV_VISIBILITY GE_FUNC_HOST_VISIBILITY graphStatus ShapeRefiner::InferSh
       if (!ctx_after_infer->GetOutputHandleShapesAndTypes().empty() || !ctx_after_infer->GetMarks().empty()) {
         GELOGD("[%s] set inference context after. mark:%zu", node->GetName().c_str(),
                ctx_after_infer->GetMarks().size());
-        (void)context_map.emplace(node, ctx_after_infer);
+        std::lock_guard<std::mutex> lk(context_map->mu);
+        (void)context_map->contexts.emplace(node, ctx_after_infer);
       }
     }
   }
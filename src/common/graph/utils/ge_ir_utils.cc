@@ -512,8 +512,11 @@ void OnnxUtils::AddAttrProtoFromNodeMembers(const NodePtr &node, onnx::NodeProto
       AddAttrProto(node_proto, onnx::AttributeProto_AttributeType_INTS, "workspace_bytes", workspace_bytes);
       const auto &is_input_const = op_def->is_input_const();
       AddAttrProto(node_proto, onnx::AttributeProto_AttributeType_INTS, "is_input_const", is_input_const);
-      const auto &op_def_attr_map = op_def->attr();
-      AddAttrProtoForAttrsFromAttrMap(op_def_attr_map, node_proto);
+      // with the flat attributes of op_desc, which are not in op_def
+      auto op_desc_attr_map = op_desc->GetAttrMap();
+      if (op_desc_attr_map.GetProtoMsg() != nullptr) {
+        AddAttrProtoForAttrsFromAttrMap(*op_desc_attr_map.GetProtoMsg(), node_proto);
+      }
     } else {
       GELOGE(FAILED, "Opdef is nullptr");
       return;
@@ -1020,6 +1023,8 @@ void OnnxUtils::DecodeNodeAttributeForOpDesc(const onnx::AttributeProto &attr_pr
       DecodeAttribute(attr_proto, ints);
       op_desc->SetDstIndex(ints);
     } else if (attr_name == "fusion_scope") {
+      // op_def_ is written directly, so it takes over the flat attributes first
+      (void)op_desc->MutableAttrMap();
       DecodeNodeAttributeForOpDef(attr_proto, *op_desc->op_def_.GetProtoMsg());
     } else if (attr_name == "input_i") {
       std::vector<std::int64_t> ints;
@@ -212,9 +212,8 @@ GraphUtils::RemoveSubgraphRecursively(const ComputeGraphPtr &compute_graph, cons
     return GRAPH_FAILED;
   }
 
-  // Check if this node is belong to this compute graph, maybe a little slow
-  const auto &all_nodes_in_graph = compute_graph->GetDirectNode();
-  if (std::find(all_nodes_in_graph.begin(), all_nodes_in_graph.end(), remove_node) == all_nodes_in_graph.end()) {
+  // Check if this node is belong to this compute graph
+  if (!compute_graph->nodes_.Contains(remove_node)) {
     GELOGE(GRAPH_FAILED, "Can not find node %s in graph %s.", remove_node->GetName().c_str(),
            compute_graph->GetName().c_str());
     return GRAPH_FAILED;
@@ -277,9 +276,7 @@ GraphUtils::RemoveNodeWithoutRelink(const ComputeGraphPtr &compute_graph, const
     return GRAPH_FAILED;
   }
 
-  auto iter = find(compute_graph->nodes_.begin(), compute_graph->nodes_.end(), node);
-  if (iter != compute_graph->nodes_.end()) {
-    compute_graph->nodes_.erase(iter);
+  if (compute_graph->nodes_.Erase(node)) {
     return GRAPH_SUCCESS;
   }
   return GRAPH_FAILED;
@@ -472,9 +469,7 @@ GE_FUNC_DEV_VISIBILITY GE_FUNC_HOST_VISIBILITY graphStatus GraphUtils::RemoveJus
     GELOGE(GRAPH_FAILED, "The node ptr should be not null.");
     return GRAPH_FAILED;
   }
-  auto iter = find(compute_graph.nodes_.begin(), compute_graph.nodes_.end(), node);
-  if (iter != compute_graph.nodes_.end()) {
-    compute_graph.nodes_.erase(iter);
+  if (compute_graph.nodes_.Erase(node)) {
     return GRAPH_SUCCESS;
   }
   return GRAPH_FAILED;
@@ -1347,6 +1342,7 @@ GE_FUNC_DEV_VISIBILITY GE_FUNC_HOST_VISIBILITY graphStatus GraphUtils::AppendInp
   }
   graph->SetInputSize(graph->GetInputSize() + 1);
   graph->inputs_order_.emplace_back(node->GetName());
+  graph->is_topo_sorted_ = false;
   return GRAPH_SUCCESS;
 }
 
@@ -2667,7 +2663,7 @@ void PartialGraphBuilder::BuildExistNodes(graphStatus &error_code, std::string &
 GE_FUNC_DEV_VISIBILITY GE_FUNC_HOST_VISIBILITY graphStatus
 GraphUtils::TopologicalSortingByName(const ge::ComputeGraphPtr &compute_graph, vector<NodePtr> &node_vec) {
   std::vector<NodePtr> stack_input;
-  std::map<NodePtr, uint32_t> map_in_edge_num;
+  std::unordered_map<NodePtr, uint32_t> map_in_edge_num;
   graphStatus ret = compute_graph->SortNodes(stack_input, map_in_edge_num);
   if (ret != GRAPH_SUCCESS) {
     GELOGE(GRAPH_FAILED, "Sort nodes failed.");
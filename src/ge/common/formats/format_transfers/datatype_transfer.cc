@@ -17,9 +17,12 @@
 #include "common/formats/format_transfers/datatype_transfer.h"
 
 #include <cstdint>
+#include <cstring>
 #include <map>
 #include <utility>
+#include <vector>
 
+#include "common/formats/utils/formats_definitions.h"
 #include "common/formats/utils/formats_trans_utils.h"
 #include "common/fp16_t.h"
 #include "common/ge/ge_util.h"
@@ -61,59 +64,161 @@ std::map<std::pair<DataType, DataType>, DataTypeTransMode> trans_mode_map{
   {std::pair<DataType, DataType>(DT_INT8, DT_INT32), kTransferWithDatatypeInt8ToInt32},
   {std::pair<DataType, DataType>(DT_INT64, DT_INT32), kTransferWithDatatypeInt64ToInt32}};
 
+// number of all the fp16 values
+const size_t kFp16ValueNum = 65536;
+// bits of the fp32 mantissa truncated while converting to fp16
+const uint32_t kFp32ToFp16TruncLen = kFp32ManLen - kFp16ManLen;
+// fp32 exponents used by fp16_t: values above kFp16NormalExpMax saturate, values above kFp16NormalExpMin are normal
+// fp16 values, values above kFp16DenormExpMin are denormal ones, and values of kFp16DenormExpMin are rounded up
+const uint32_t kFp16NormalExpMax = kFp32ExpBias + kFp16ExpBias + 1;
+const uint32_t kFp16NormalExpMin = kFp32ExpBias - kFp16ExpBias;
+const uint32_t kFp16DenormExpMin = kFp32ExpBias - kFp16ExpBias - kFp16ManLen;
+
 template <typename SrcT, typename DstT>
-Status TransDataSrc2Dst(const CastArgs &args, uint8_t *dst, const size_t data_size) {
-  SrcT src_data;
+Status TransDataSrc2Dst(const uint8_t *src, uint8_t *dst, const size_t data_size) {
+  auto src_data = reinterpret_cast<const SrcT *>(src);
+  auto dst_data = reinterpret_cast<DstT *>(dst);
   for (size_t idx = 0; idx != data_size; idx++) {
-    src_data = reinterpret_cast<const SrcT *>(args.data)[idx];
-    reinterpret_cast<DstT *>(dst)[idx] = static_cast<DstT>(src_data);
+    dst_data[idx] = static_cast<DstT>(src_data[idx]);
   }
   return SUCCESS;
 }
 
-template <typename SrcT>
-Status TransDataSrc2Fp16(const CastArgs &args, uint8_t *dst, const size_t data_size) {
-  fp16_t src_data;
+// values of all the fp16 bits converted by fp16_t, so that looking up the table gives the same values as fp16_t
+template <typename DstT>
+const std::vector<DstT> &GetFp16ValueTable() {
+  static const std::vector<DstT> table = []() {
+    std::vector<DstT> values(kFp16ValueNum);
+    fp16_t fp16;
+    for (size_t i = 0; i < kFp16ValueNum; i++) {
+      fp16.val = static_cast<uint16_t>(i);
+      values[i] = static_cast<DstT>(fp16);
+    }
+    return values;
+  }();
+  return table;
+}
+
+template <typename DstT>
+Status TransDataFp162Dst(const uint8_t *src, uint8_t *dst, const size_t data_size) {
+  const DstT *table = GetFp16ValueTable<DstT>().data();
+  auto src_data = reinterpret_cast<const uint16_t *>(src);
+  auto dst_data = reinterpret_cast<DstT *>(dst);
   for (size_t idx = 0; idx != data_size; idx++) {
-    src_data = reinterpret_cast<const SrcT *>(args.data)[idx];
-    reinterpret_cast<uint16_t *>(dst)[idx] = src_data.val;
+    dst_data[idx] = table[src_data[idx]];
   }
   return SUCCESS;
 }
 
-Status CastKernel(const CastArgs &args, uint8_t *dst, const size_t data_size, const DataTypeTransMode trans_mode) {
+// shift the mantissa right by trunc_len bits, rounded as IsRoundOne of fp16_t in the round mode kRoundToNearest:
+// half to even. Adding half - 1 and the last bit kept carries exactly when rounding up, without branches.
+inline uint64_t ShiftRoundToNearest(uint64_t man, uint32_t trunc_len) {
+  return (man + (static_cast<uint64_t>(1) << (trunc_len - 1)) - 1 + ((man >> trunc_len) & 1)) >> trunc_len;
+}
+
+// same as fp16_t::operator=(const float &), in which the values too large saturate to the max fp16, including inf
+// and nan, and the values rounded up to 2^16 get the bits of nan
+inline uint16_t FloatToFp16(float value) {
+  uint32_t bits;
+  (void)memcpy(&bits, &value, sizeof(bits));
+  auto sign = static_cast<uint16_t>((bits & kFp32SignMask) >> (kFp32SignIndex - kFp16SignIndex));
+  uint32_t exp = (bits & kFp32ExpMask) >> kFp32ManLen;
+  uint32_t man = bits & kFp32ManMask;
+  if (exp > kFp16NormalExpMax) {
+    return sign | kFp16Max;
+  }
+  if (exp > kFp16NormalExpMin) {
+    // the carry of rounding goes to the exponent
+    uint32_t ret = ((exp - kFp16NormalExpMin) << kFp16ManLen) +
+                   static_cast<uint32_t>(ShiftRoundToNearest(man, kFp32ToFp16TruncLen));
+    return sign | static_cast<uint16_t>(ret >= kFp16ExpMask ? kFp16AbsMax : ret);
+  }
+  if (exp > kFp16DenormExpMin) {
+    uint64_t denorm_man = static_cast<uint64_t>(man | kFp32ManHideBit) << (exp - kFp16DenormExpMin - 1);
+    return sign | static_cast<uint16_t>(ShiftRoundToNearest(denorm_man, kFp32ManLen));
+  }
+  return sign | static_cast<uint16_t>((exp == kFp16DenormExpMin && man > 0) ? 1 : 0);
+}
+
+// same as fp16_t::operator=(const int32_t &), the min int32 is converted to -0.5 by it
+inline uint16_t Int32ToFp16(int32_t value) {
+  if (value == 0) {
+    return 0;
+  }
+  auto bits = static_cast<uint32_t>(value);
+  auto sign = static_cast<uint16_t>(bits >> kFp32SignIndex);
+  uint32_t man = (sign != 0 ? 0u - bits : bits) & kFp32AbsMax;
+  uint32_t len = (man == 0) ? 0 : kBitShift32 - static_cast<uint32_t>(__builtin_clz(man));
+  // fp16 has 11 bits of mantissa with the hidden bit
+  uint32_t exp;
+  if (len > kDim11) {
+    uint32_t trunc_len = len - kDim11;
+    exp = kFp16ExpBias + kFp16ManLen + trunc_len;
+    auto ret_man = static_cast<uint32_t>(ShiftRoundToNearest(man, trunc_len));
+    if (ret_man > kFp16ManHideBit + kFp16ManMask) {
+      ret_man >>= 1;
+      exp++;
+    }
+    if (exp >= kFp16MaxExp) {
+      exp = kFp16MaxValidExp;
+      ret_man = kFp16MaxMan;
+    }
+    man = ret_man;
+  } else {
+    exp = kFp16ExpBias + len - 1;
+    man <<= kDim11 - len;
+  }
+  return static_cast<uint16_t>(FP16_CONSTRUCTOR(sign, exp, man));
+}
+
+Status TransDataFloat2Fp16(const uint8_t *src, uint8_t *dst, const size_t data_size) {
+  auto src_data = reinterpret_cast<const float *>(src);
+  auto dst_data = reinterpret_cast<uint16_t *>(dst);
+  for (size_t idx = 0; idx != data_size; idx++) {
+    dst_data[idx] = FloatToFp16(src_data[idx]);
+  }
+  return SUCCESS;
+}
+
+Status TransDataInt322Fp16(const uint8_t *src, uint8_t *dst, const size_t data_size) {
+  auto src_data = reinterpret_cast<const int32_t *>(src);
+  auto dst_data = reinterpret_cast<uint16_t *>(dst);
+  for (size_t idx = 0; idx != data_size; idx++) {
+    dst_data[idx] = Int32ToFp16(src_data[idx]);
+  }
+  return SUCCESS;
+}
+
+CastFunc GetCastFunc(const DataTypeTransMode trans_mode) {
   switch (trans_mode) {
     case kTransferWithDatatypeFloatToFloat16:
-      return TransDataSrc2Fp16<float>(args, dst, data_size);
+      return TransDataFloat2Fp16;
     case kTransferWithDatatypeFloatToInt32:
-      return TransDataSrc2Dst<float, int32_t>(args, dst, data_size);
+      return TransDataSrc2Dst<float, int32_t>;
     case kTransferWithDatatypeFloat16ToFloat:
-      return TransDataSrc2Dst<fp16_t, float>(args, dst, data_size);
+      return TransDataFp162Dst<float>;
     case kTransferWithDatatypeFloat16ToInt32:
-      return TransDataSrc2Dst<fp16_t, int32_t>(args, dst, data_size);
+      return TransDataFp162Dst<int32_t>;
     case kTransferWithDatatypeInt32ToFloat:
-      return TransDataSrc2Dst<int32_t, float>(args, dst, data_size);
+      return TransDataSrc2Dst<int32_t, float>;
     case kTransferWithDatatypeInt32ToFloat16:
-      return TransDataSrc2Fp16<int32_t>(args, dst, data_size);
+      return TransDataInt322Fp16;
     case kTransferWithDatatypeInt32ToUint8:
-      return TransDataSrc2Dst<int32_t, uint8_t>(args, dst, data_size);
+      return TransDataSrc2Dst<int32_t, uint8_t>;
     case kTransferWithDatatypeInt32ToInt8:
-      return TransDataSrc2Dst<int32_t, int8_t>(args, dst, data_size);
+      return TransDataSrc2Dst<int32_t, int8_t>;
     case kTransferWithDatatypeUint8ToFloat:
-      return TransDataSrc2Dst<uint8_t, float>(args, dst, data_size);
+      return TransDataSrc2Dst<uint8_t, float>;
     case kTransferWithDatatypeUint8ToInt32:
-      return TransDataSrc2Dst<uint8_t, int32_t>(args, dst, data_size);
+      return TransDataSrc2Dst<uint8_t, int32_t>;
     case kTransferWithDatatypeInt8ToFloat:
-      return TransDataSrc2Dst<int8_t, float>(args, dst, data_size);
+      return TransDataSrc2Dst<int8_t, float>;
     case kTransferWithDatatypeInt8ToInt32:
-      return TransDataSrc2Dst<int8_t, int32_t>(args, dst, data_size);
+      return TransDataSrc2Dst<int8_t, int32_t>;
     case kTransferWithDatatypeInt64ToInt32:
-      return TransDataSrc2Dst<int64_t, int32_t>(args, dst, data_size);
+      return TransDataSrc2Dst<int64_t, int32_t>;
     default:
-      GELOGE(PARAM_INVALID, "Trans data type from %s to %s is not supported.",
-             TypeUtils::DataTypeToSerialString(args.src_data_type).c_str(),
-             TypeUtils::DataTypeToSerialString(args.dst_data_type).c_str());
-      return UNSUPPORTED;
+      return nullptr;
   }
 }
 }  // namespace
@@ -121,15 +226,12 @@ Status CastKernel(const CastArgs &args, uint8_t *dst, const size_t data_size, co
 Status DataTypeTransfer::TransDataType(const CastArgs &args, TransResult &result) {
   GELOGD("Begin trans data from %s to %s, data size %zu", TypeUtils::DataTypeToSerialString(args.src_data_type).c_str(),
          TypeUtils::DataTypeToSerialString(args.dst_data_type).c_str(), args.src_data_size);
-  std::pair<DataType, DataType> trans_info(args.src_data_type, args.dst_data_type);
-  auto iter = trans_mode_map.find(trans_info);
-  if (iter == trans_mode_map.end()) {
+  if (!DataTypeTransferExists(args)) {
     GELOGE(PARAM_INVALID, "Trans data type from %s to %s is not supported.",
            TypeUtils::DataTypeToSerialString(args.src_data_type).c_str(),
            TypeUtils::DataTypeToSerialString(args.dst_data_type).c_str());
     return UNSUPPORTED;
   }
-  auto trans_mode = iter->second;
 
   int size = GetSizeByDataType(args.dst_data_type);
   if (size <= 0) {
@@ -154,13 +256,66 @@ Status DataTypeTransfer::TransDataType(const CastArgs &args, TransResult &result
     return OUT_OF_MEMORY;
   }
 
-  if (CastKernel(args, dst.get(), args.src_data_size, trans_mode) != SUCCESS) {
+  auto ret = TransDataType(args, dst.get(), total_size);
+  if (ret != SUCCESS) {
+    return ret;
+  }
+  result.data = dst;
+  return SUCCESS;
+}
+
+Status DataTypeTransfer::TransDataType(const CastArgs &args, uint8_t *dst, size_t dst_size) {
+  ElementCast elem_cast;
+  auto ret = GetElementCast(args.src_data_type, args.dst_data_type, elem_cast);
+  if (ret != SUCCESS || elem_cast.cast == nullptr) {
+    GELOGE(PARAM_INVALID, "Trans data type from %s to %s is not supported.",
+           TypeUtils::DataTypeToSerialString(args.src_data_type).c_str(),
+           TypeUtils::DataTypeToSerialString(args.dst_data_type).c_str());
+    return UNSUPPORTED;
+  }
+  if (args.src_data_size > dst_size / static_cast<size_t>(elem_cast.dst_size) ||
+      (dst == nullptr && args.src_data_size != 0)) {
+    GELOGE(PARAM_INVALID, "The dst buf %zu is not enough for %zu elements of %s", dst_size, args.src_data_size,
+           TypeUtils::DataTypeToSerialString(args.dst_data_type).c_str());
+    return PARAM_INVALID;
+  }
+
+  // the elements are converted by parts on several threads
+  auto cast_part = [&](int64_t begin, int64_t end) -> Status {
+    return elem_cast.cast(args.data + begin * elem_cast.src_size, dst + begin * elem_cast.dst_size,
+                          static_cast<size_t>(end - begin));
+  };
+  if (ParallelFor(static_cast<int64_t>(args.src_data_size), Ceil(kMinParallelTransSize, elem_cast.dst_size),
+                  cast_part) != SUCCESS) {
     GELOGE(INTERNAL_ERROR, "Failed to cast data from %s to %s, data size %zu",
            TypeUtils::DataTypeToSerialString(args.src_data_type).c_str(),
            TypeUtils::DataTypeToSerialString(args.dst_data_type).c_str(), args.src_data_size);
     return INTERNAL_ERROR;
   }
-  result.data = dst;
+  return SUCCESS;
+}
+
+Status GetElementCast(DataType src_data_type, DataType dst_data_type, ElementCast &elem_cast) {
+  elem_cast.src_size = GetSizeByDataType(src_data_type);
+  elem_cast.dst_size = GetSizeByDataType(dst_data_type);
+  elem_cast.cast = nullptr;
+  if (elem_cast.src_size <= 0 || elem_cast.dst_size <= 0) {
+    GELOGE(PARAM_INVALID, "Failed to calc size from data type %s or %s",
+           TypeUtils::DataTypeToSerialString(src_data_type).c_str(),
+           TypeUtils::DataTypeToSerialString(dst_data_type).c_str());
+    return PARAM_INVALID;
+  }
+  if (src_data_type == dst_data_type) {
+    return SUCCESS;
+  }
+  auto iter = trans_mode_map.find(std::pair<DataType, DataType>(src_data_type, dst_data_type));
+  if (iter == trans_mode_map.end()) {
+    GELOGE(UNSUPPORTED, "Trans data type from %s to %s is not supported.",
+           TypeUtils::DataTypeToSerialString(src_data_type).c_str(),
+           TypeUtils::DataTypeToSerialString(dst_data_type).c_str());
+    return UNSUPPORTED;
+  }
+  elem_cast.cast = GetCastFunc(iter->second);
   return SUCCESS;
 }
 
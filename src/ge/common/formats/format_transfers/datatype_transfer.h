@@ -21,6 +21,7 @@
 #include <memory>
 #include <vector>
 
+#include "common/formats/utils/formats_trans_utils.h"
 #include "register/register_format_transfer.h"
 #include "external/graph/types.h"
 #include "framework/common/ge_inner_error_codes.h"
@@ -37,11 +38,22 @@ struct CastArgs {
 class DataTypeTransfer {
  public:
   Status TransDataType(const CastArgs &args, TransResult &result);
+
+  /**
+   * Convert the data type into the dst buffer of dst_size bytes instead of allocating
+   */
+  Status TransDataType(const CastArgs &args, uint8_t *dst, size_t dst_size);
 };
 
 std::shared_ptr<DataTypeTransfer> BuildDataTypeTransfer(const CastArgs &args);
 
 bool DataTypeTransferExists(const CastArgs &args);
+
+/**
+ * Get how to transfer the elements from src_data_type to dst_data_type, the cast is null if they are the same
+ * @return UNSUPPORTED if the data types can not be converted
+ */
+Status GetElementCast(DataType src_data_type, DataType dst_data_type, ElementCast &elem_cast);
 }  // namespace formats
 }  // namespace ge
 
@@ -17,8 +17,10 @@
 #include "common/formats/format_transfers/format_transfer_fractal_nz.h"
 
 #include <securec.h>
+#include <cstring>
 #include <memory>
 
+#include "common/debug/log.h"
 #include "common/formats/utils/formats_definitions.h"
 #include "common/formats/utils/formats_trans_utils.h"
 #include "framework/common/debug/ge_log.h"
@@ -121,7 +123,7 @@ Status TransFormatFromNdToFracNz(const TransArgs &args, TransResult &result, con
     return SUCCESS;
   }
 
-  std::shared_ptr<uint8_t> dst(new (std::nothrow) uint8_t[dst_size](), std::default_delete<uint8_t[]>());
+  std::shared_ptr<uint8_t> dst(new (std::nothrow) uint8_t[dst_size], std::default_delete<uint8_t[]>());
   if (dst == nullptr) {
     GELOGE(OUT_OF_MEMORY, "Failed to trans format from %s to %s, can not alloc the memory for dst buf %ld",
            TypeUtils::FormatToSerialString(args.src_format).c_str(),
@@ -133,7 +135,6 @@ Status TransFormatFromNdToFracNz(const TransArgs &args, TransResult &result, con
   auto times = hw_shape.at(0);
   auto h = hw_shape.at(1);
   auto w = hw_shape.at(2);
-  auto hw = h * w;
 
   auto shape_size = args.dst_shape.size();
   auto w1 = args.dst_shape[shape_size - 4];
@@ -145,41 +146,44 @@ Status TransFormatFromNdToFracNz(const TransArgs &args, TransResult &result, con
   auto w1h1h0w0 = w1 * h1h0w0;
   auto num_w1 = w / w0;
 
-  for (int64_t times_idx = 0; times_idx < times; times_idx++) {
-    auto times_head = times_idx * w1h1h0w0;
-    auto src_times_head = times_idx * hw;
-    for (int64_t h1h0_idx = 0; h1h0_idx < h; h1h0_idx++) {
-      auto h1h0_head = times_head + h1h0_idx * w0;
-      auto src_h_head = src_times_head + h1h0_idx * w;
-      for (int64_t w1_idx = 0; w1_idx < num_w1; w1_idx++) {
-        auto dst_offset = (h1h0_head + w1_idx * h1h0w0) * size;
-        auto src_offset = (src_h_head + w1_idx * w0) * size;
-        auto protected_size = dst_size - dst_offset < static_cast<int64_t>(SECUREC_MEM_MAX_LEN)
-                                ? dst_size - dst_offset
-                                : static_cast<int64_t>(SECUREC_MEM_MAX_LEN);
-        auto ret = memcpy_s(dst.get() + dst_offset, static_cast<size_t>(protected_size), args.data + src_offset,
-                            static_cast<size_t>(size * w0));
-        if (ret != EOK) {
-          GELOGE(INTERNAL_ERROR, "Failed to operate the dst memory at offset %ld, error-code %d", dst_offset, ret);
-          return INTERNAL_ERROR;
+  // each row of h1h0 is transferred on one thread, its w elements are copied to runs of w0, which are h1h0w0 apart,
+  // and the rest of the runs are set to 0, so that the padding is written only once
+  auto w_tail = w - num_w1 * w0;
+  auto trans_rows = [&](int64_t begin, int64_t end) -> Status {
+    for (int64_t row_idx = begin; row_idx < end; row_idx++) {
+      auto times_idx = row_idx / h1h0;
+      auto h1h0_idx = row_idx % h1h0;
+      uint8_t *dst_row = dst.get() + (times_idx * w1h1h0w0 + h1h0_idx * w0) * size;
+      int64_t copied_num = 0;
+      if (h1h0_idx < h) {
+        const uint8_t *src_row = args.data + (times_idx * h + h1h0_idx) * w * size;
+        GE_CHK_STATUS_RET_NOLOG(CopyMatrix(src_row, {w0, 1}, dst_row, {h1h0w0, 1}, num_w1, w0, size));
+        if (w_tail > 0) {
+          auto tail_size = static_cast<size_t>(w_tail * size);
+          auto ret = memcpy_s(dst_row + num_w1 * h1h0w0 * size, tail_size, src_row + num_w1 * w0 * size, tail_size);
+          if (ret != EOK) {
+            GELOGE(INTERNAL_ERROR, "Failed to copy the tail of row %ld, err-code %d", row_idx, ret);
+            return INTERNAL_ERROR;
+          }
         }
+        copied_num = w;
       }
-      auto w1_head = num_w1 * w0;
-      for (int64_t w0_idx = 0; w1_head + w0_idx < w; w0_idx++) {
-        auto src_w_idx = w1_head + w0_idx;
-        auto dst_offset = (h1h0_head + num_w1 * h1h0w0 + w0_idx) * size;
-        auto src_offset = (src_h_head + src_w_idx) * size;
-        auto protected_size = dst_size - dst_offset < static_cast<int64_t>(SECUREC_MEM_MAX_LEN)
-                                ? dst_size - dst_offset
-                                : static_cast<int64_t>(SECUREC_MEM_MAX_LEN);
-        auto ret = memcpy_s(dst.get() + dst_offset, static_cast<size_t>(protected_size), args.data + src_offset,
-                            static_cast<size_t>(size));
+      for (int64_t w1_idx = copied_num / w0; w1_idx < w1; w1_idx++) {
+        auto pad_begin = (w1_idx == copied_num / w0) ? copied_num % w0 : 0;
+        auto pad_size = static_cast<size_t>((w0 - pad_begin) * size);
+        auto ret = memset_s(dst_row + (w1_idx * h1h0w0 + pad_begin) * size, pad_size, 0, pad_size);
         if (ret != EOK) {
-          GELOGE(INTERNAL_ERROR, "Failed to operate the dst memory at offset %ld, error-code %d", dst_offset, ret);
+          GELOGE(INTERNAL_ERROR, "Failed to pad the row %ld with zero, err-code %d", row_idx, ret);
           return INTERNAL_ERROR;
         }
       }
     }
+    return SUCCESS;
+  };
+  auto ret = ParallelFor(times * h1h0, Ceil(kMinParallelTransSize, w1 * w0 * size), trans_rows);
+  if (ret != SUCCESS) {
+    GELOGE(INTERNAL_ERROR, "Failed to trans rows to FRACTAL_NZ, src shape %s", ShapeToString(args.src_shape).c_str());
+    return ret;
   }
   result.data = dst;
   result.length = static_cast<size_t>(dst_size);
@@ -205,7 +209,6 @@ Status TransFormatFromFracNzToNd(const TransArgs &args, TransResult &result, con
   auto times = dst_hw_shape.at(0);
   auto h = dst_hw_shape.at(1);
   auto w = dst_hw_shape.at(2);
-  auto hw = h * w;
 
   auto shape_size = args.src_shape.size();
   auto w1 = args.src_shape[shape_size - 4];
@@ -216,43 +219,31 @@ Status TransFormatFromFracNzToNd(const TransArgs &args, TransResult &result, con
   auto h1h0w0 = h1h0 * w0;
   auto w1h1h0w0 = w1 * h1h0w0;
   auto num_w1 = w / w0;
-  errno_t ret;
 
-  for (int64_t times_idx = 0; times_idx < times; times_idx++) {
-    auto times_head = times_idx * w1h1h0w0;
-    auto dst_times_head = times_idx * hw;
-    for (int64_t h1h0_idx = 0; h1h0_idx < h; h1h0_idx++) {
-      auto h1h0_head = times_head + h1h0_idx * w0;
-      auto dst_h_head = dst_times_head + h1h0_idx * w;
-      for (int64_t w1_idx = 0; w1_idx < num_w1; w1_idx++) {
-        auto src_offset = (h1h0_head + w1_idx * h1h0w0) * size;
-        auto dst_offset = (dst_h_head + w1_idx * w0) * size;
-        auto protected_size = dst_size - dst_offset < static_cast<int64_t>(SECUREC_MEM_MAX_LEN)
-                                ? dst_size - dst_offset
-                                : static_cast<int64_t>(SECUREC_MEM_MAX_LEN);
-        ret = memcpy_s(dst.get() + dst_offset, static_cast<size_t>(protected_size), args.data + src_offset,
-                       static_cast<size_t>(size * w0));
+  // each row is transferred on one thread, its w elements are copied from runs of w0, which are h1h0w0 apart
+  auto w_tail = w - num_w1 * w0;
+  auto trans_rows = [&](int64_t begin, int64_t end) -> Status {
+    for (int64_t row_idx = begin; row_idx < end; row_idx++) {
+      auto times_idx = row_idx / h;
+      auto h1h0_idx = row_idx % h;
+      const uint8_t *src_row = args.data + (times_idx * w1h1h0w0 + h1h0_idx * w0) * size;
+      uint8_t *dst_row = dst.get() + row_idx * w * size;
+      GE_CHK_STATUS_RET_NOLOG(CopyMatrix(src_row, {h1h0w0, 1}, dst_row, {w0, 1}, num_w1, w0, size));
+      if (w_tail > 0) {
+        auto tail_size = static_cast<size_t>(w_tail * size);
+        auto ret = memcpy_s(dst_row + num_w1 * w0 * size, tail_size, src_row + num_w1 * h1h0w0 * size, tail_size);
         if (ret != EOK) {
-          GELOGE(INTERNAL_ERROR, "Failed to operate the dst memory at offset %ld, error-code %d", dst_offset, ret);
-          return INTERNAL_ERROR;
-        }
-      }
-      auto w1_head = num_w1 * w0;
-      for (int64_t w0_idx = 0; w1_head + w0_idx < w; w0_idx++) {
-        auto dst_w_idx = w1_head + w0_idx;
-        auto src_offset = (h1h0_head + num_w1 * h1h0w0 + w0_idx) * size;
-        auto dst_offset = (dst_h_head + dst_w_idx) * size;
-        auto protected_size = dst_size - dst_offset < static_cast<int64_t>(SECUREC_MEM_MAX_LEN)
-                                ? dst_size - dst_offset
-                                : static_cast<int64_t>(SECUREC_MEM_MAX_LEN);
-        ret = memcpy_s(dst.get() + dst_offset, static_cast<size_t>(protected_size), args.data + src_offset,
-                       static_cast<size_t>(size));
-        if (ret != EOK) {
-          GELOGE(INTERNAL_ERROR, "Failed to operate the dst memory at offset %ld, error-code %d", dst_offset, ret);
+          GELOGE(INTERNAL_ERROR, "Failed to copy the tail of row %ld, err-code %d", row_idx, ret);
           return INTERNAL_ERROR;
         }
       }
     }
+    return SUCCESS;
+  };
+  auto ret = ParallelFor(times * h, Ceil(kMinParallelTransSize, w * size), trans_rows);
+  if (ret != SUCCESS) {
+    GELOGE(INTERNAL_ERROR, "Failed to trans rows from FRACTAL_NZ, dst shape %s", ShapeToString(args.dst_shape).c_str());
+    return ret;
   }
   result.data = dst;
   result.length = static_cast<size_t>(dst_size);
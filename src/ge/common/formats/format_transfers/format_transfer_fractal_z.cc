@@ -17,9 +17,12 @@
 #include "common/formats/format_transfers/format_transfer_fractal_z.h"
 
 #include <securec.h>
+#include <algorithm>
+#include <cstring>
 #include <memory>
 
 #include "common/debug/log.h"
+#include "common/formats/format_transfers/datatype_transfer.h"
 #include "common/formats/utils/formats_definitions.h"
 #include "common/formats/utils/formats_trans_utils.h"
 #include "framework/common/debug/ge_log.h"
@@ -97,7 +100,7 @@ Status TransShapeNhwcToFz(const std::vector<int64_t> &src_shape, DataType data_t
   return TransShapeToFz(n, c, h, w, data_type, dst_shape);
 }
 
-Status TransFormatFromNchwToFz(const TransArgs &args, TransResult &result) {
+Status TransFormatFromNchwToFz(const TransArgs &args, const ElementCast &elem_cast, uint8_t *dst) {
   int64_t n = args.src_shape.at(kNchwN);
   int64_t c = args.src_shape.at(kNchwC);
   int64_t h = args.src_shape.at(kNchwH);
@@ -108,83 +111,50 @@ Status TransFormatFromNchwToFz(const TransArgs &args, TransResult &result) {
 
   int64_t hw = h * w;
   int64_t chw = c * hw;
-  int64_t nchw = n * chw;
   int64_t hwc0 = hw * c0;
-
-  // horizontal fractal matrix count (N)
-  int64_t hf_cnt = Ceil(n, static_cast<int64_t>(kNiSize));
-  // vertical fractal matrix count (C1HWC0)
-  int64_t vf_cnt = c1 * hw;
-  // elements count in one fractal
-  int64_t fractal_ele_cnt = c0 * kNiSize;
-  int64_t total_ele_cnt = hf_cnt * vf_cnt * fractal_ele_cnt;
-  int size = GetSizeByDataType(args.src_data_type);
-  int64_t dst_size = total_ele_cnt * size;
-  GE_CHK_BOOL_EXEC_NOLOG(dst_size != 0, result.length = static_cast<size_t>(dst_size); return SUCCESS;);
-
-  std::shared_ptr<uint8_t> dst(new (std::nothrow) uint8_t[dst_size], std::default_delete<uint8_t[]>());
-  GE_CHK_BOOL_TRUE_EXEC_WITH_LOG(
-    dst == nullptr,
-    GELOGE(OUT_OF_MEMORY, "Failed to trans format from %s to %s, can not alloc the memory for dst buf %ld",
-           TypeUtils::FormatToSerialString(args.src_format).c_str(),
-           TypeUtils::FormatToSerialString(args.dst_format).c_str(), dst_size);
-    return OUT_OF_MEMORY;);
-
-  for (int64_t vfi = 0; vfi < vf_cnt; vfi++) {
-    // vertical fractal matrix base index
-    auto vf_base_i = vfi * hf_cnt;
-    for (int64_t hfi = 0; hfi < hf_cnt; hfi++) {
-      // global fractal matrix index
-      auto gfi = vf_base_i + hfi;
-      auto src_n_offset = hfi * chw * kNiSize;
-      auto src_f_offset = src_n_offset + vfi % hw + vfi / hw * hwc0;
-      for (int64_t row = 0; row < c0; row++) {
-        auto src_ci = vfi / hw * c0 + row;
-        auto src_row_offset = src_f_offset + row * hw;
-        for (int col = 0; col < kNiSize; col++) {
-          auto src_ni = hfi * kNiSize + col;
-          auto src_offset = src_row_offset + chw * col;
-          // pad 0
-          // 1. src_ni grater than n
-          // 2. src_ci grater than c
-          // 3. source address grater than original array size
-          auto need_pad_zero = src_ni >= n || src_offset >= nchw || src_ci >= c;
-          auto idx = gfi * fractal_ele_cnt + col * c0 + row;
-          auto offset = idx * size;
-          auto protected_size = dst_size - offset < static_cast<int64_t>(SECUREC_MEM_MAX_LEN)
-                                  ? dst_size - offset
-                                  : static_cast<int64_t>(SECUREC_MEM_MAX_LEN);
-          errno_t ret = EOK;
-          if (need_pad_zero) {
-            ret = memset_s(dst.get() + offset, static_cast<size_t>(protected_size), 0, static_cast<size_t>(size));
-          } else {
-            if (protected_size < size) {
-              GELOGE(INTERNAL_ERROR, "Failed to operate the dst memory, protected_size is %ld and size is %ld",
-                     protected_size, size);
-              return INTERNAL_ERROR;
-            }
-            char *dst_data = reinterpret_cast<char *>(dst.get() + offset);
-            const char *src_data = reinterpret_cast<const char *>(args.data + src_offset * size);
-            for (int64_t index = 0; index < size; index++) {
-              *dst_data++ = *src_data++;
-            }
-          }
+  int64_t n1n0 = Ceil(n, static_cast<int64_t>(kNiSize)) * kNiSize;
+  int64_t src_size = elem_cast.src_size;
+  int64_t dst_size = elem_cast.dst_size;
+
+  // each (c1, n) pair is transferred on one thread, the c0 channel planes of it are read in lock-step and written
+  // to hw rows of c0, which are n1n0 rows apart
+  int64_t dst_row_stride = n1n0 * c0;
+  const uint8_t *src = args.data;
+  auto trans_blocks = [&](int64_t begin, int64_t end) -> Status {
+    for (int64_t block_idx = begin; block_idx < end; block_idx++) {
+      int64_t c1i = block_idx / n1n0;
+      int64_t ni = block_idx % n1n0;
+      int64_t c_num = std::min(c0, c - c1i * c0);
+      uint8_t *dst_block = dst + (c1i * hw * n1n0 + ni) * c0 * dst_size;
+      // pad 0 to the channels out of c, or to the whole row if ni is out of n
+      int64_t pad_begin = (ni < n) ? c_num : 0;
+      if (pad_begin < c0) {
+        for (int64_t hwi = 0; hwi < hw; hwi++) {
+          auto pad_size = static_cast<size_t>((c0 - pad_begin) * dst_size);
+          auto ret = memset_s(dst_block + (hwi * dst_row_stride + pad_begin) * dst_size, pad_size, 0, pad_size);
           if (ret != EOK) {
-            GELOGE(INTERNAL_ERROR, "Failed to operate the dst memory at offset %ld, error-code %d pad mode %d", offset,
-                   ret, need_pad_zero);
+            GELOGE(INTERNAL_ERROR, "Failed to pad the block %ld of FRACTAL_Z with zero, err-code %d", block_idx, ret);
             return INTERNAL_ERROR;
           }
         }
       }
+      if (ni < n) {
+        GE_CHK_STATUS_RET_NOLOG(CastMatrix(src + (ni * chw + c1i * hwc0) * src_size, {1, hw}, dst_block,
+                                           {dst_row_stride, 1}, hw, c_num, elem_cast));
+      }
     }
+    return SUCCESS;
+  };
+  auto ret = ParallelFor(c1 * n1n0, Ceil(kMinParallelTransSize, hwc0 * dst_size), trans_blocks);
+  if (ret != SUCCESS) {
+    GELOGE(INTERNAL_ERROR, "Failed to trans blocks from NCHW to FRACTAL_Z, src shape %s",
+           ShapeToString(args.src_shape).c_str());
+    return ret;
   }
-
-  result.data = dst;
-  result.length = static_cast<size_t>(dst_size);
   return SUCCESS;
 }
 
-Status TransFormatHwcnToFz(const TransArgs &args, TransResult &result) {
+Status TransFormatHwcnToFz(const TransArgs &args, const ElementCast &elem_cast, uint8_t *dst) {
   int64_t h = args.src_shape[kHwcnH];
   int64_t w = args.src_shape[kHwcnW];
   int64_t c = args.src_shape[kHwcnC];
@@ -193,155 +163,114 @@ Status TransFormatHwcnToFz(const TransArgs &args, TransResult &result) {
   int64_t c0 = GetCubeSizeByDataType(args.src_data_type);
   int64_t c1 = Ceil(c, c0);
 
+  auto hw = h * w;
   auto cn = c * n;
-  auto wcn = w * cn;
   auto n1n0c0 = n1n0 * c0;
-  auto wn1n0c0 = w * n1n0c0;
-  auto hwn1n0c0 = h * wn1n0c0;
-
-  int64_t data_size = GetSizeByDataType(args.src_data_type);
-  int64_t dst_size = 1;
-  for (auto dim : args.dst_shape) {
-    dst_size *= dim;
-  }
-  dst_size *= data_size;
-  GE_CHK_BOOL_EXEC_NOLOG(dst_size != 0, result.length = static_cast<size_t>(dst_size); return SUCCESS;);
-
-  std::shared_ptr<uint8_t> dst(new (std::nothrow) uint8_t[dst_size], std::default_delete<uint8_t[]>());
-  GE_CHK_BOOL_TRUE_EXEC_WITH_LOG(
-    dst == nullptr,
-    GELOGE(OUT_OF_MEMORY, "Failed to trans format from %s to %s, can not alloc the memory for dst buf %ld",
-           TypeUtils::FormatToSerialString(args.src_format).c_str(),
-           TypeUtils::FormatToSerialString(args.dst_format).c_str(), dst_size);
-    return OUT_OF_MEMORY;);
-
-  for (int64_t c1i = 0; c1i < c1; c1i++) {
-    for (int64_t hi = 0; hi < h; hi++) {
-      for (int64_t wi = 0; wi < w; wi++) {
-        for (int64_t n1n0i = 0; n1n0i < n1n0; n1n0i++) {
-          for (int64_t c0i = 0; c0i < c0; c0i++) {
-            int64_t dst_idx = c1i * hwn1n0c0 + hi * wn1n0c0 + wi * n1n0c0 + n1n0i * c0 + c0i;
-            int64_t dst_offset = dst_idx * data_size;
-            auto protected_size = dst_size - dst_offset < static_cast<int64_t>(SECUREC_MEM_MAX_LEN)
-                                    ? dst_size - dst_offset
-                                    : static_cast<int64_t>(SECUREC_MEM_MAX_LEN);
-            auto pad_zero = ((c1i * c0 + c0i) >= c) || (n1n0i >= n);
-            errno_t ret = EOK;
-            if (pad_zero) {
-              ret = memset_s(dst.get() + dst_offset, static_cast<size_t>(protected_size), 0,
-                             static_cast<size_t>(data_size));
-            } else {
-              if (protected_size < data_size) {
-                GELOGE(INTERNAL_ERROR, "Failed to operate the dst memory, protected_size is %ld and size is %ld",
-                       protected_size, data_size);
-                return INTERNAL_ERROR;
-              }
-              int64_t src_idx = hi * wcn + wi * cn + (c1i * c0 + c0i) * n + n1n0i;
-              char *dst_data = reinterpret_cast<char *>(dst.get() + dst_offset);
-              const char *src_data = reinterpret_cast<const char *>(args.data + src_idx * data_size);
-              for (int64_t index = 0; index < data_size; index++) {
-                *dst_data++ = *src_data++;
-              }
-            }
-            if (ret != EOK) {
-              GELOGE(INTERNAL_ERROR, "Failed to operate the dst memory at offset %ld, error-code %d, pad mode %d",
-                     dst_offset, ret, pad_zero);
-              return INTERNAL_ERROR;
-            }
-          }
+  int64_t src_size = elem_cast.src_size;
+  int64_t dst_size = elem_cast.dst_size;
+
+  // each (c1, h, w) fractal row is transferred on one thread, its padding is set to 0 at once
+  auto block_size = n1n0c0 * dst_size;
+  const uint8_t *src = args.data;
+  auto trans_blocks = [&](int64_t begin, int64_t end) -> Status {
+    for (int64_t block_idx = begin; block_idx < end; block_idx++) {
+      int64_t c1i = block_idx / hw;
+      int64_t hwi = block_idx % hw;
+      int64_t c_num = std::min(c0, c - c1i * c0);
+      uint8_t *dst_block = dst + block_idx * block_size;
+      if (c_num < c0 || n < n1n0) {
+        // the whole block if some channels are out of c, otherwise the rows out of n
+        int64_t pad_begin = (c_num < c0) ? 0 : n * c0 * dst_size;
+        auto pad_size = static_cast<size_t>(block_size - pad_begin);
+        auto ret = memset_s(dst_block + pad_begin, pad_size, 0, pad_size);
+        if (ret != EOK) {
+          GELOGE(INTERNAL_ERROR, "Failed to pad the block %ld of FRACTAL_Z with zero, err-code %d", block_idx, ret);
+          return INTERNAL_ERROR;
         }
       }
+      GE_CHK_STATUS_RET_NOLOG(
+        CastMatrix(src + (hwi * cn + c1i * c0 * n) * src_size, {1, n}, dst_block, {c0, 1}, n, c_num, elem_cast));
     }
+    return SUCCESS;
+  };
+  auto ret = ParallelFor(c1 * hw, Ceil(kMinParallelTransSize, block_size), trans_blocks);
+  if (ret != SUCCESS) {
+    GELOGE(INTERNAL_ERROR, "Failed to trans blocks from HWCN to FRACTAL_Z, src shape %s",
+           ShapeToString(args.src_shape).c_str());
+    return ret;
   }
-
-  result.data = dst;
-  result.length = static_cast<size_t>(dst_size);
   return SUCCESS;
 }
 
-Status TransFormatNhwcToFz(const TransArgs &args, TransResult &result) {
+Status TransFormatNhwcToFz(const TransArgs &args, const ElementCast &elem_cast, uint8_t *dst) {
   int64_t n = args.src_shape[kNhwcN];
   int64_t h = args.src_shape[kNhwcH];
   int64_t w = args.src_shape[kNhwcW];
   int64_t c = args.src_shape[kNhwcC];
-  auto wc = w * c;
-  auto hwc = h * w * c;
+  auto hw = h * w;
+  auto hwc = hw * c;
 
   int64_t n1n0 = Ceil(n, static_cast<int64_t>(kNiSize)) * kNiSize;
   int64_t c0 = GetCubeSizeByDataType(args.src_data_type);
   int64_t c1 = Ceil(c, c0);
   auto n1n0c0 = n1n0 * c0;
-  auto wn1n0c0 = w * n1n0c0;
-  auto hwn1n0c0 = h * wn1n0c0;
-
-  int64_t data_size = GetSizeByDataType(args.src_data_type);
-  int64_t dst_size = 1;
-  for (auto dim : args.dst_shape) {
-    dst_size *= dim;
-  }
-  dst_size *= data_size;
-  GE_CHK_BOOL_EXEC_NOLOG(dst_size != 0, result.length = static_cast<size_t>(dst_size); return SUCCESS;);
-
-  std::shared_ptr<uint8_t> dst(new (std::nothrow) uint8_t[dst_size], std::default_delete<uint8_t[]>());
-  GE_CHK_BOOL_TRUE_EXEC_WITH_LOG(
-    dst == nullptr,
-    GELOGE(OUT_OF_MEMORY, "Failed to trans format from %s to %s, can not alloc the memory for dst buf %ld",
-           TypeUtils::FormatToSerialString(args.src_format).c_str(),
-           TypeUtils::FormatToSerialString(args.dst_format).c_str(), dst_size);
-    return OUT_OF_MEMORY;);
-
-  for (int64_t c1i = 0; c1i < c1; c1i++) {
-    for (int64_t hi = 0; hi < h; hi++) {
-      for (int64_t wi = 0; wi < w; wi++) {
-        for (int64_t n1n0i = 0; n1n0i < n1n0; n1n0i++) {
-          for (int64_t c0i = 0; c0i < c0; c0i++) {
-            int64_t dst_idx = c1i * hwn1n0c0 + hi * wn1n0c0 + wi * n1n0c0 + n1n0i * c0 + c0i;
-            int64_t dst_offset = dst_idx * data_size;
-            auto protected_size = dst_size - dst_offset < static_cast<int64_t>(SECUREC_MEM_MAX_LEN)
-                                    ? dst_size - dst_offset
-                                    : static_cast<int64_t>(SECUREC_MEM_MAX_LEN);
-            auto pad_zero = ((c1i * c0 + c0i) >= c) || (n1n0i >= n);
-            errno_t ret = EOK;
-            if (pad_zero) {
-              ret = memset_s(dst.get() + dst_offset, static_cast<size_t>(protected_size), 0,
-                             static_cast<size_t>(data_size));
-            } else {
-              if (protected_size < data_size) {
-                GELOGE(INTERNAL_ERROR, "Failed to operate the dst memory, protected_size is %ld and size is %ld",
-                       protected_size, data_size);
-                return INTERNAL_ERROR;
-              }
-              int64_t src_idx = n1n0i * hwc + hi * wc + wi * c + (c1i * c0 + c0i);
-              char *dst_data = reinterpret_cast<char *>(dst.get() + dst_offset);
-              const char *src_data = reinterpret_cast<const char *>(args.data + src_idx * data_size);
-              for (int64_t index = 0; index < data_size; index++) {
-                *dst_data++ = *src_data++;
-              }
-            }
-            if (ret != EOK) {
-              GELOGE(INTERNAL_ERROR, "Failed to operate the dst memory at offset %ld, error-code %d, pad mode %d",
-                     dst_offset, ret, pad_zero);
-              return INTERNAL_ERROR;
-            }
-          }
+  int64_t src_size = elem_cast.src_size;
+  int64_t dst_size = elem_cast.dst_size;
+
+  // each (c1, h, w) fractal row is transferred on one thread, its padding is set to 0 at once
+  auto block_size = n1n0c0 * dst_size;
+  const uint8_t *src = args.data;
+  auto trans_blocks = [&](int64_t begin, int64_t end) -> Status {
+    for (int64_t block_idx = begin; block_idx < end; block_idx++) {
+      int64_t c1i = block_idx / hw;
+      int64_t hwi = block_idx % hw;
+      int64_t c_num = std::min(c0, c - c1i * c0);
+      uint8_t *dst_block = dst + block_idx * block_size;
+      if (c_num < c0 || n < n1n0) {
+        // the whole block if some channels are out of c, otherwise the rows out of n
+        int64_t pad_begin = (c_num < c0) ? 0 : n * c0 * dst_size;
+        auto pad_size = static_cast<size_t>(block_size - pad_begin);
+        auto ret = memset_s(dst_block + pad_begin, pad_size, 0, pad_size);
+        if (ret != EOK) {
+          GELOGE(INTERNAL_ERROR, "Failed to pad the block %ld of FRACTAL_Z with zero, err-code %d", block_idx, ret);
+          return INTERNAL_ERROR;
         }
       }
+      GE_CHK_STATUS_RET_NOLOG(
+        CastMatrix(src + (hwi * c + c1i * c0) * src_size, {hwc, 1}, dst_block, {c0, 1}, n, c_num, elem_cast));
     }
+    return SUCCESS;
+  };
+  auto ret = ParallelFor(c1 * hw, Ceil(kMinParallelTransSize, block_size), trans_blocks);
+  if (ret != SUCCESS) {
+    GELOGE(INTERNAL_ERROR, "Failed to trans blocks from NHWC to FRACTAL_Z, src shape %s",
+           ShapeToString(args.src_shape).c_str());
+    return ret;
   }
-
-  result.data = dst;
-  result.length = static_cast<size_t>(dst_size);
   return SUCCESS;
 }
-}  // namespace
 
-Status FormatTransferFractalZ::TransFormat(const TransArgs &args, TransResult &result) {
-  GELOGD("Begin to trans format from %s to %s, src shape %s, data type %s, dst shape %s",
-         TypeUtils::FormatToSerialString(args.src_format).c_str(),
-         TypeUtils::FormatToSerialString(args.dst_format).c_str(), ShapeToString(args.src_shape).c_str(),
-         TypeUtils::DataTypeToSerialString(args.src_data_type).c_str(), ShapeToString(args.dst_shape).c_str());
-  std::vector<int64_t> expect_shape;
-  auto ret = TransShape(args.src_format, args.src_shape, args.src_data_type, args.dst_format, expect_shape);
+Status TransShapeToFzByFormat(Format src_format, const std::vector<int64_t> &src_shape, DataType data_type,
+                              Format dst_format, std::vector<int64_t> &dst_shape) {
+  if (CheckDataTypeSupport(data_type) != SUCCESS) {
+    return UNSUPPORTED;
+  }
+
+  if (src_format == FORMAT_NHWC && dst_format == FORMAT_FRACTAL_Z) {
+    return TransShapeNhwcToFz(src_shape, data_type, dst_shape);
+  }
+  if (src_format == FORMAT_HWCN && dst_format == FORMAT_FRACTAL_Z) {
+    return TransShapeHwcnToFz(src_shape, data_type, dst_shape);
+  }
+  if (src_format == FORMAT_NCHW && dst_format == FORMAT_FRACTAL_Z) {
+    return TransShapeNchwToFz(src_shape, data_type, dst_shape);
+  }
+
+  return UNSUPPORTED;
+}
+
+Status CheckArgsForFz(const TransArgs &args, std::vector<int64_t> &expect_shape) {
+  auto ret = TransShapeToFzByFormat(args.src_format, args.src_shape, args.src_data_type, args.dst_format, expect_shape);
   if (ret != SUCCESS) {
     return ret;
   }
@@ -352,39 +281,90 @@ Status FormatTransferFractalZ::TransFormat(const TransArgs &args, TransResult &r
            ShapeToString(expect_shape).c_str());
     return PARAM_INVALID;
   }
+  return SUCCESS;
+}
 
+Status TransDataToFz(const TransArgs &args, const ElementCast &elem_cast, uint8_t *dst) {
   if (args.src_format == FORMAT_NHWC && args.dst_format == FORMAT_FRACTAL_Z) {
-    return TransFormatNhwcToFz(args, result);
+    return TransFormatNhwcToFz(args, elem_cast, dst);
   }
 
   if (args.src_format == FORMAT_HWCN && args.dst_format == FORMAT_FRACTAL_Z) {
-    return TransFormatHwcnToFz(args, result);
+    return TransFormatHwcnToFz(args, elem_cast, dst);
   }
 
   if (args.src_format == FORMAT_NCHW && args.dst_format == FORMAT_FRACTAL_Z) {
-    return TransFormatFromNchwToFz(args, result);
+    return TransFormatFromNchwToFz(args, elem_cast, dst);
   }
 
   return UNSUPPORTED;
 }
+}  // namespace
 
-Status FormatTransferFractalZ::TransShape(Format src_format, const std::vector<int64_t> &src_shape, DataType data_type,
-                                          Format dst_format, std::vector<int64_t> &dst_shape) {
-  if (CheckDataTypeSupport(data_type) != SUCCESS) {
-    return UNSUPPORTED;
+Status FormatTransferFractalZ::TransFormat(const TransArgs &args, TransResult &result) {
+  GELOGD("Begin to trans format from %s to %s, src shape %s, data type %s, dst shape %s",
+         TypeUtils::FormatToSerialString(args.src_format).c_str(),
+         TypeUtils::FormatToSerialString(args.dst_format).c_str(), ShapeToString(args.src_shape).c_str(),
+         TypeUtils::DataTypeToSerialString(args.src_data_type).c_str(), ShapeToString(args.dst_shape).c_str());
+  std::vector<int64_t> expect_shape;
+  auto ret = CheckArgsForFz(args, expect_shape);
+  if (ret != SUCCESS) {
+    return ret;
+  }
+  int64_t size = GetSizeByDataType(args.src_data_type);
+  int64_t dst_size = GetItemNumByShape(expect_shape) * size;
+  if (dst_size == 0) {
+    result.length = static_cast<size_t>(dst_size);
+    return SUCCESS;
   }
 
-  if (src_format == FORMAT_NHWC && dst_format == FORMAT_FRACTAL_Z) {
-    return TransShapeNhwcToFz(src_shape, data_type, dst_shape);
+  std::shared_ptr<uint8_t> dst(new (std::nothrow) uint8_t[dst_size], std::default_delete<uint8_t[]>());
+  GE_CHK_BOOL_TRUE_EXEC_WITH_LOG(
+    dst == nullptr,
+    GELOGE(OUT_OF_MEMORY, "Failed to trans format from %s to %s, can not alloc the memory for dst buf %ld",
+           TypeUtils::FormatToSerialString(args.src_format).c_str(),
+           TypeUtils::FormatToSerialString(args.dst_format).c_str(), dst_size);
+    return OUT_OF_MEMORY;);
+
+  ret = TransDataToFz(args, {size, size, nullptr}, dst.get());
+  if (ret != SUCCESS) {
+    return ret;
   }
-  if (src_format == FORMAT_HWCN && dst_format == FORMAT_FRACTAL_Z) {
-    return TransShapeHwcnToFz(src_shape, data_type, dst_shape);
+  result.data = dst;
+  result.length = static_cast<size_t>(dst_size);
+  return SUCCESS;
+}
+
+Status FormatTransferFractalZ::TransFormatWithCast(const TransArgs &args, DataType dst_data_type, uint8_t *dst,
+                                                   size_t dst_size) {
+  GELOGD("Begin to trans format from %s to %s, src shape %s, data type %s to %s, dst shape %s",
+         TypeUtils::FormatToSerialString(args.src_format).c_str(),
+         TypeUtils::FormatToSerialString(args.dst_format).c_str(), ShapeToString(args.src_shape).c_str(),
+         TypeUtils::DataTypeToSerialString(args.src_data_type).c_str(),
+         TypeUtils::DataTypeToSerialString(dst_data_type).c_str(), ShapeToString(args.dst_shape).c_str());
+  std::vector<int64_t> expect_shape;
+  auto ret = CheckArgsForFz(args, expect_shape);
+  if (ret != SUCCESS) {
+    return ret;
   }
-  if (src_format == FORMAT_NCHW && dst_format == FORMAT_FRACTAL_Z) {
-    return TransShapeNchwToFz(src_shape, data_type, dst_shape);
+  ElementCast elem_cast;
+  GE_CHK_STATUS_RET_NOLOG(GetElementCast(args.src_data_type, dst_data_type, elem_cast));
+  auto expect_size = GetItemNumByShape(expect_shape) * elem_cast.dst_size;
+  if (expect_size == 0) {
+    return SUCCESS;
   }
+  if (dst == nullptr || dst_size < static_cast<size_t>(expect_size)) {
+    GELOGE(PARAM_INVALID, "Failed to trans format from %s to %s, the dst buf %zu is less than %ld",
+           TypeUtils::FormatToSerialString(args.src_format).c_str(),
+           TypeUtils::FormatToSerialString(args.dst_format).c_str(), dst_size, expect_size);
+    return PARAM_INVALID;
+  }
+  return TransDataToFz(args, elem_cast, dst);
+}
 
-  return UNSUPPORTED;
+Status FormatTransferFractalZ::TransShape(Format src_format, const std::vector<int64_t> &src_shape, DataType data_type,
+                                          Format dst_format, std::vector<int64_t> &dst_shape) {
+  return TransShapeToFzByFormat(src_format, src_shape, data_type, dst_format, dst_shape);
 }
 
 REGISTER_FORMAT_TRANSFER(FormatTransferFractalZ, FORMAT_NCHW, FORMAT_FRACTAL_Z)
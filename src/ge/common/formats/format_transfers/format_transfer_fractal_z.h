@@ -19,13 +19,15 @@
 
 #include <vector>
 
+#include "common/formats/format_transfers/format_transfer_with_cast.h"
 #include "register/register_format_transfer.h"
 
 namespace ge {
 namespace formats {
-class FormatTransferFractalZ : public FormatTransfer {
+class FormatTransferFractalZ : public FormatTransfer, public FormatTransferWithCast {
  public:
   Status TransFormat(const TransArgs &args, TransResult &result) override;
+  Status TransFormatWithCast(const TransArgs &args, DataType dst_data_type, uint8_t *dst, size_t dst_size) override;
   Status TransShape(Format src_format, const std::vector<int64_t> &src_shape, DataType data_type, Format dst_format,
                     std::vector<int64_t> &dst_shape) override;
 };
@@ -17,8 +17,10 @@
 #include "common/formats/format_transfers/format_transfer_fractal_zz.h"
 
 #include <securec.h>
+#include <cstring>
 #include <memory>
 
+#include "common/debug/log.h"
 #include "common/formats/utils/formats_definitions.h"
 #include "common/formats/utils/formats_trans_utils.h"
 #include "framework/common/debug/ge_log.h"
@@ -122,7 +124,7 @@ Status TransFormatFromNdToFracZz(const TransArgs &args, TransResult &result, con
     return SUCCESS;
   }
 
-  std::shared_ptr<uint8_t> dst(new (std::nothrow) uint8_t[dst_size](), std::default_delete<uint8_t[]>());
+  std::shared_ptr<uint8_t> dst(new (std::nothrow) uint8_t[dst_size], std::default_delete<uint8_t[]>());
   if (dst == nullptr) {
     GELOGE(OUT_OF_MEMORY, "Failed to trans format from %s to %s, can not alloc the memory for dst buf %ld",
            TypeUtils::FormatToSerialString(args.src_format).c_str(),
@@ -133,7 +135,6 @@ Status TransFormatFromNdToFracZz(const TransArgs &args, TransResult &result, con
   auto times = hw_shape.at(0);
   auto h = hw_shape.at(1);
   auto w = hw_shape.at(2);
-  auto hw = h * w;
 
   auto shape_size = args.dst_shape.size();
   auto h1 = args.dst_shape[shape_size - 4];
@@ -143,48 +144,48 @@ Status TransFormatFromNdToFracZz(const TransArgs &args, TransResult &result, con
   auto h0w0 = h0 * w0;
   auto w1h0w0 = w1 * h0w0;
   auto h1w1h0w0 = h1 * w1h0w0;
+  auto h1h0 = h1 * h0;
   auto num_w1 = w / w0;
 
-  for (int64_t times_idx = 0; times_idx < times; times_idx++) {
-    auto times_head = times_idx * h1w1h0w0;
-    auto src_times_head = times_idx * hw;
-    for (int64_t h1_idx = 0; h1_idx < h1; h1_idx++) {
-      auto h1_head = times_head + h1_idx * w1h0w0;
-      auto src_h1_head = h1_idx * h0;
-      for (int64_t h0_idx = 0; h0_idx < h0 && h0_idx + src_h1_head < h; h0_idx++) {
-        auto h0_head = h1_head + h0_idx * w0;
-        auto src_h_head = src_times_head + (src_h1_head + h0_idx) * w;
-        for (int64_t w1_idx = 0; w1_idx < num_w1; w1_idx++) {
-          auto src_offset = (src_h_head + w1_idx * w0) * size;
-          auto dst_offset = (h0_head + w1_idx * h0w0) * size;
-          auto protected_size = dst_size - dst_offset < static_cast<int64_t>(SECUREC_MEM_MAX_LEN)
-                                  ? dst_size - dst_offset
-                                  : static_cast<int64_t>(SECUREC_MEM_MAX_LEN);
-          auto ret = memcpy_s(dst.get() + dst_offset, static_cast<size_t>(protected_size), args.data + src_offset,
-                              static_cast<size_t>(size * w0));
+  // each row of h1h0 is transferred on one thread, its w elements are copied to runs of w0, which are h0w0 apart,
+  // and the rest of the runs are set to 0, so that the padding is written only once
+  auto w_tail = w - num_w1 * w0;
+  auto trans_rows = [&](int64_t begin, int64_t end) -> Status {
+    for (int64_t row_idx = begin; row_idx < end; row_idx++) {
+      auto times_idx = row_idx / h1h0;
+      auto h1h0_idx = row_idx % h1h0;
+      auto fractal_row_head = times_idx * h1w1h0w0 + h1h0_idx / h0 * w1h0w0 + h1h0_idx % h0 * w0;
+      uint8_t *dst_row = dst.get() + fractal_row_head * size;
+      int64_t copied_num = 0;
+      if (h1h0_idx < h) {
+        const uint8_t *src_row = args.data + (times_idx * h + h1h0_idx) * w * size;
+        GE_CHK_STATUS_RET_NOLOG(CopyMatrix(src_row, {w0, 1}, dst_row, {h0w0, 1}, num_w1, w0, size));
+        if (w_tail > 0) {
+          auto tail_size = static_cast<size_t>(w_tail * size);
+          auto ret = memcpy_s(dst_row + num_w1 * h0w0 * size, tail_size, src_row + num_w1 * w0 * size, tail_size);
           if (ret != EOK) {
-            GELOGE(INTERNAL_ERROR, "Failed to operate the dst memory at offset %ld, error-code %d", dst_offset, ret);
+            GELOGE(INTERNAL_ERROR, "Failed to copy the tail of row %ld, err-code %d", row_idx, ret);
             return INTERNAL_ERROR;
           }
         }
-        auto w1_head = num_w1 * w0;
-        auto w0_head = h0_head + num_w1 * h0w0;
-        for (int64_t w0_idx = 0; w0_idx + w1_head < w; w0_idx++) {
-          auto src_w_idx = w1_head + w0_idx;
-          auto src_offset = (src_h_head + src_w_idx) * size;
-          auto dst_offset = (w0_head + w0_idx) * size;
-          auto protected_size = dst_size - dst_offset < static_cast<int64_t>(SECUREC_MEM_MAX_LEN)
-                                  ? dst_size - dst_offset
-                                  : static_cast<int64_t>(SECUREC_MEM_MAX_LEN);
-          auto ret = memcpy_s(dst.get() + dst_offset, static_cast<size_t>(protected_size), args.data + src_offset,
-                              static_cast<size_t>(size));
-          if (ret != EOK) {
-            GELOGE(INTERNAL_ERROR, "Failed to operate the dst memory at offset %ld, error-code %d", dst_offset, ret);
-            return INTERNAL_ERROR;
-          }
+        copied_num = w;
+      }
+      for (int64_t w1_idx = copied_num / w0; w1_idx < w1; w1_idx++) {
+        auto pad_begin = (w1_idx == copied_num / w0) ? copied_num % w0 : 0;
+        auto pad_size = static_cast<size_t>((w0 - pad_begin) * size);
+        auto ret = memset_s(dst_row + (w1_idx * h0w0 + pad_begin) * size, pad_size, 0, pad_size);
+        if (ret != EOK) {
+          GELOGE(INTERNAL_ERROR, "Failed to pad the row %ld with zero, err-code %d", row_idx, ret);
+          return INTERNAL_ERROR;
         }
       }
     }
+    return SUCCESS;
+  };
+  auto ret = ParallelFor(times * h1h0, Ceil(kMinParallelTransSize, w1 * w0 * size), trans_rows);
+  if (ret != SUCCESS) {
+    GELOGE(INTERNAL_ERROR, "Failed to trans rows to FRACTAL_ZZ, src shape %s", ShapeToString(args.src_shape).c_str());
+    return ret;
   }
   result.data = dst;
   result.length = static_cast<size_t>(dst_size);
@@ -199,7 +200,7 @@ Status TransFormatFromFracZzToNd(const TransArgs &args, TransResult &result, con
     return SUCCESS;
   }
 
-  std::shared_ptr<uint8_t> dst(new (std::nothrow) uint8_t[dst_size](), std::default_delete<uint8_t[]>());
+  std::shared_ptr<uint8_t> dst(new (std::nothrow) uint8_t[dst_size], std::default_delete<uint8_t[]>());
   if (dst == nullptr) {
     GELOGE(OUT_OF_MEMORY, "Failed to trans format from %s to %s, can not alloc the memory for dst buf %ld",
            TypeUtils::FormatToSerialString(args.src_format).c_str(),
@@ -211,7 +212,6 @@ Status TransFormatFromFracZzToNd(const TransArgs &args, TransResult &result, con
   auto times = dst_hw_shape.at(0);
   auto h = dst_hw_shape.at(1);
   auto w = dst_hw_shape.at(2);
-  auto hw = h * w;
 
   auto shape_size = args.src_shape.size();
   auto h1 = args.src_shape[shape_size - 4];
@@ -223,46 +223,31 @@ Status TransFormatFromFracZzToNd(const TransArgs &args, TransResult &result, con
   auto h1w1h0w0 = h1 * w1h0w0;
   auto num_w1 = w / w0;
 
-  for (int64_t times_idx = 0; times_idx < times; times_idx++) {
-    auto times_head = times_idx * h1w1h0w0;
-    auto dst_times_head = times_idx * hw;
-    for (int64_t h1_idx = 0; h1_idx < h1; h1_idx++) {
-      auto h1_head = times_head + h1_idx * w1h0w0;
-      auto dst_h1_head = h1_idx * h0;
-      for (int64_t h0_idx = 0; h0_idx < h0 && h0_idx + dst_h1_head < h; h0_idx++) {
-        auto h0_head = h1_head + h0_idx * w0;
-        auto dst_h_head = dst_times_head + (dst_h1_head + h0_idx) * w;
-        for (int64_t w1_idx = 0; w1_idx < num_w1; w1_idx++) {
-          auto src_offset = (h0_head + w1_idx * h0w0) * size;
-          auto dst_offset = (dst_h_head + w1_idx * w0) * size;
-          auto protected_size = dst_size - dst_offset < static_cast<int64_t>(SECUREC_MEM_MAX_LEN)
-                                  ? dst_size - dst_offset
-                                  : static_cast<int64_t>(SECUREC_MEM_MAX_LEN);
-          auto ret = memcpy_s(dst.get() + dst_offset, static_cast<size_t>(protected_size), args.data + src_offset,
-                              static_cast<size_t>(size * w0));
-          if (ret != EOK) {
-            GELOGE(INTERNAL_ERROR, "Failed to operate the dst memory at offset %ld, error-code %d", dst_offset, ret);
-            return INTERNAL_ERROR;
-          }
-        }
-        auto w1_head = num_w1 * w0;
-        auto w0_head = h0_head + num_w1 * h0w0;
-        for (int64_t w0_idx = 0; w0_idx + w1_head < w; w0_idx++) {
-          auto src_offset = (w0_head + w0_idx) * size;
-          auto dst_w_idx = w1_head + w0_idx;
-          auto dst_offset = (dst_h_head + dst_w_idx) * size;
-          auto protected_size = dst_size - dst_offset < static_cast<int64_t>(SECUREC_MEM_MAX_LEN)
-                                  ? dst_size - dst_offset
-                                  : static_cast<int64_t>(SECUREC_MEM_MAX_LEN);
-          auto ret = memcpy_s(dst.get() + dst_offset, static_cast<size_t>(protected_size), args.data + src_offset,
-                              static_cast<size_t>(size));
-          if (ret != EOK) {
-            GELOGE(INTERNAL_ERROR, "Failed to operate the dst memory at offset %ld, error-code %d", dst_offset, ret);
-            return INTERNAL_ERROR;
-          }
+  // each row is transferred on one thread, its w elements are copied from runs of w0, which are h0w0 apart
+  auto w_tail = w - num_w1 * w0;
+  auto trans_rows = [&](int64_t begin, int64_t end) -> Status {
+    for (int64_t row_idx = begin; row_idx < end; row_idx++) {
+      auto times_idx = row_idx / h;
+      auto h_idx = row_idx % h;
+      auto fractal_row_head = times_idx * h1w1h0w0 + h_idx / h0 * w1h0w0 + h_idx % h0 * w0;
+      const uint8_t *src_row = args.data + fractal_row_head * size;
+      uint8_t *dst_row = dst.get() + row_idx * w * size;
+      GE_CHK_STATUS_RET_NOLOG(CopyMatrix(src_row, {h0w0, 1}, dst_row, {w0, 1}, num_w1, w0, size));
+      if (w_tail > 0) {
+        auto tail_size = static_cast<size_t>(w_tail * size);
+        auto ret = memcpy_s(dst_row + num_w1 * w0 * size, tail_size, src_row + num_w1 * h0w0 * size, tail_size);
+        if (ret != EOK) {
+          GELOGE(INTERNAL_ERROR, "Failed to copy the tail of row %ld, err-code %d", row_idx, ret);
+          return INTERNAL_ERROR;
         }
       }
     }
+    return SUCCESS;
+  };
+  auto ret = ParallelFor(times * h, Ceil(kMinParallelTransSize, w * size), trans_rows);
+  if (ret != SUCCESS) {
+    GELOGE(INTERNAL_ERROR, "Failed to trans rows from FRACTAL_ZZ, dst shape %s", ShapeToString(args.dst_shape).c_str());
+    return ret;
   }
   result.data = dst;
   result.length = static_cast<size_t>(dst_size);
@@ -17,8 +17,12 @@
 #include "common/formats/format_transfers/format_transfer_nhwc_nc1hwc0.h"
 
 #include <securec.h>
+#include <algorithm>
+#include <cstring>
 #include <memory>
 
+#include "common/debug/log.h"
+#include "common/formats/format_transfers/datatype_transfer.h"
 #include "common/formats/utils/formats_definitions.h"
 #include "common/formats/utils/formats_trans_utils.h"
 #include "framework/common/debug/ge_log.h"
@@ -86,70 +90,45 @@ Status CheckArgsForNhwcToNc1hwc0(const TransArgs &args) {
   return SUCCESS;
 }
 
-Status GetDstDataAfterTrans(const TransArgs &args, TransResult &result, const int size, const int64_t total_size) {
-  std::shared_ptr<uint8_t> dst(new (std::nothrow) uint8_t[total_size], std::default_delete<uint8_t[]>());
-  if (dst == nullptr) {
-    GELOGE(OUT_OF_MEMORY, "Failed to trans format from %s to %s, can not alloc the memory for dst buf %ld, shape %s",
-           TypeUtils::FormatToSerialString(args.src_format).c_str(),
-           TypeUtils::FormatToSerialString(args.dst_format).c_str(), total_size, ShapeToString(args.dst_shape).c_str());
-    return OUT_OF_MEMORY;
-  }
-
+Status TransDataByBlocks(const TransArgs &args, const ElementCast &elem_cast, uint8_t *dst) {
   auto n = args.src_shape.at(kNhwcN);
   auto h = args.src_shape.at(kNhwcH);
   auto w = args.src_shape.at(kNhwcW);
   auto c = args.src_shape.at(kNhwcC);
   auto c1 = args.dst_shape.at(kNc1hwc0C1);
   auto c0 = args.dst_shape.at(kNc1hwc0C0);
-  int64_t wc = w * c;
-  int64_t hwc = h * wc;
-  int64_t wc0 = w * c0;
-  int64_t hwc0 = h * wc0;
-  int64_t c1hwc0 = c1 * hwc0;
+  int64_t hw = h * w;
+  int64_t hwc = hw * c;
+  int64_t hwc0 = hw * c0;
+  int64_t src_size = elem_cast.src_size;
+  int64_t block_size = hwc0 * elem_cast.dst_size;
 
-  for (int64_t n_idx = 0; n_idx < n; n_idx++) {
-    int64_t n_head_addr = n_idx * c1hwc0;
-    for (int64_t c1_idx = 0; c1_idx < c1; c1_idx++) {
-      int64_t c1_head_addr = n_head_addr + c1_idx * hwc0;
-      for (int64_t h_idx = 0; h_idx < h; h_idx++) {
-        int64_t h_head_addr = c1_head_addr + h_idx * wc0;
-        for (int64_t w_idx = 0; w_idx < w; w_idx++) {
-          int64_t w_head_addr = h_head_addr + w_idx * c0;
-          for (int64_t c0_idx = 0; c0_idx < c0; c0_idx++) {
-            int64_t dst_idx = c0_idx + w_head_addr;
-            int64_t dst_offset = dst_idx * size;
-            auto protected_size = total_size - dst_offset < static_cast<int64_t>(SECUREC_MEM_MAX_LEN)
-                                    ? total_size - dst_offset
-                                    : static_cast<int64_t>(SECUREC_MEM_MAX_LEN);
-            int64_t c_idx = c0_idx + c1_idx * c0;
-            int64_t src_idx = n_idx * hwc + h_idx * wc + w_idx * c + c_idx;
-            auto src_offset = src_idx * size;
-
-            if (c_idx < c) {
-              auto ret = memcpy_s(dst.get() + dst_offset, protected_size, args.data + src_offset, size);
-              if (ret != EOK) {
-                GELOGE(INTERNAL_ERROR,
-                       "Failed to copy data from NHWC[%ld, %ld, %ld, %ld] offset %ld to "
-                       "NC1HWC0[%ld, %ld, %ld, %ld, %ld] offset %ld err-code %d",
-                       n_idx, h_idx, w_idx, c_idx, src_offset, n_idx, c1_idx, h_idx, w_idx, c0_idx, dst_offset, ret);
-                return INTERNAL_ERROR;
-              }
-            } else {
-              auto ret = memset_s(dst.get() + dst_offset, protected_size, 0, size);
-              if (ret != EOK) {
-                GELOGE(INTERNAL_ERROR,
-                       "Failed to set 0 to NC1HWC0[%ld, %ld, %ld, %ld, %ld] offset %ld base err-code %d", n_idx, c1_idx,
-                       h_idx, w_idx, c0_idx, dst_offset, ret);
-                return INTERNAL_ERROR;
-              }
-            }
-          }
+  // each (n, c1) block is transferred as a whole on one thread, the c0 channels of a pixel are copied at once
+  const uint8_t *src = args.data;
+  auto trans_blocks = [&](int64_t begin, int64_t end) -> Status {
+    for (int64_t block_idx = begin; block_idx < end; block_idx++) {
+      int64_t n_idx = block_idx / c1;
+      int64_t c_idx = (block_idx % c1) * c0;
+      int64_t c_num = std::min(c0, c - c_idx);
+      uint8_t *dst_block = dst + block_idx * block_size;
+      if (c_num < c0) {
+        auto ret = memset_s(dst_block, static_cast<size_t>(block_size), 0, static_cast<size_t>(block_size));
+        if (ret != EOK) {
+          GELOGE(INTERNAL_ERROR, "Failed to pad the block %ld of NC1HWC0 with zero, err-code %d", block_idx, ret);
+          return INTERNAL_ERROR;
         }
       }
+      GE_CHK_STATUS_RET_NOLOG(
+        CastMatrix(src + (n_idx * hwc + c_idx) * src_size, {c, 1}, dst_block, {c0, 1}, hw, c_num, elem_cast));
     }
+    return SUCCESS;
+  };
+  auto ret = ParallelFor(n * c1, Ceil(kMinParallelTransSize, block_size), trans_blocks);
+  if (ret != SUCCESS) {
+    GELOGE(INTERNAL_ERROR, "Failed to trans blocks from NHWC to NC1HWC0, dst shape %s",
+           ShapeToString(args.dst_shape).c_str());
+    return ret;
   }
-  result.data = dst;
-  result.length = static_cast<size_t>(total_size);
   return SUCCESS;
 }
 }  // namespace
@@ -174,15 +153,46 @@ Status FormatTransferNhwcNc1hwc0::TransFormat(const TransArgs &args, TransResult
   GELOGD("Begin to trans format from NHWC to NC1HWC0, src shape %s, data type %s, dst shape %s, memory size %ld",
          ShapeToString(args.src_shape).c_str(), TypeUtils::DataTypeToSerialString(args.src_data_type).c_str(),
          ShapeToString(args.dst_shape).c_str(), total_size);
-  if (GetDstDataAfterTrans(args, result, size, total_size) != SUCCESS) {
+  std::shared_ptr<uint8_t> dst(new (std::nothrow) uint8_t[total_size], std::default_delete<uint8_t[]>());
+  if (dst == nullptr) {
+    GELOGE(OUT_OF_MEMORY, "Failed to trans format from %s to %s, can not alloc the memory for dst buf %ld, shape %s",
+           TypeUtils::FormatToSerialString(args.src_format).c_str(),
+           TypeUtils::FormatToSerialString(args.dst_format).c_str(), total_size, ShapeToString(args.dst_shape).c_str());
+    return OUT_OF_MEMORY;
+  }
+  if (TransDataByBlocks(args, {size, size, nullptr}, dst.get()) != SUCCESS) {
     GELOGE(INTERNAL_ERROR, "Failed to get data after trans, src shape %s, data type %s, dst shape %s, memory size %ld",
            ShapeToString(args.src_shape).c_str(), TypeUtils::DataTypeToSerialString(args.src_data_type).c_str(),
            ShapeToString(args.dst_shape).c_str(), total_size);
     return INTERNAL_ERROR;
   }
+  result.data = dst;
+  result.length = static_cast<size_t>(total_size);
   return SUCCESS;
 }
 
+Status FormatTransferNhwcNc1hwc0::TransFormatWithCast(const TransArgs &args, DataType dst_data_type, uint8_t *dst,
+                                                      size_t dst_size) {
+  if (CheckArgsForNhwcToNc1hwc0(args) != SUCCESS) {
+    return PARAM_INVALID;
+  }
+  ElementCast elem_cast;
+  GE_CHK_STATUS_RET_NOLOG(GetElementCast(args.src_data_type, dst_data_type, elem_cast));
+  auto total_size = GetItemNumByShape(args.dst_shape) * elem_cast.dst_size;
+  if (total_size == 0) {
+    return SUCCESS;
+  }
+  if (dst == nullptr || dst_size < static_cast<size_t>(total_size)) {
+    GELOGE(PARAM_INVALID, "Failed to trans format from NHWC to NC1HWC0, the dst buf %zu is less than %ld", dst_size,
+           total_size);
+    return PARAM_INVALID;
+  }
+  GELOGD("Begin to trans format from NHWC to NC1HWC0, src shape %s, data type %s to %s, dst shape %s",
+         ShapeToString(args.src_shape).c_str(), TypeUtils::DataTypeToSerialString(args.src_data_type).c_str(),
+         TypeUtils::DataTypeToSerialString(dst_data_type).c_str(), ShapeToString(args.dst_shape).c_str());
+  return TransDataByBlocks(args, elem_cast, dst);
+}
+
 Status FormatTransferNhwcNc1hwc0::TransShape(Format src_format, const std::vector<int64_t> &src_shape,
                                              DataType data_type, Format dst_format, std::vector<int64_t> &dst_shape) {
   if (src_format == FORMAT_NHWC && CheckDataTypeSupported(data_type)) {
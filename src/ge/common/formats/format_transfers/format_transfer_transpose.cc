@@ -17,8 +17,11 @@
 #include "common/formats/format_transfers/format_transfer_transpose.h"
 
 #include <securec.h>
+#include <algorithm>
+#include <cstring>
 #include <memory>
 
+#include "common/formats/utils/formats_definitions.h"
 #include "common/formats/utils/formats_trans_utils.h"
 #include "framework/common/debug/ge_log.h"
 #include "framework/common/debug/log.h"
@@ -27,6 +30,10 @@
 namespace ge {
 namespace formats {
 namespace {
+// the edge of a tile holds a cache line at least, so that each line read or written is used up within the tile
+const int64_t kCacheLineSize = 64;
+const int64_t kMinTileSize = 16;
+
 std::map<Format, std::map<Format, std::vector<int64_t>>> perm_args{
   {FORMAT_NCHW,
    {{FORMAT_NHWC, std::vector<int64_t>({0, 2, 3, 1})},
@@ -103,34 +110,180 @@ std::vector<int64_t> GenHeads(const std::vector<int64_t> &shape) {
   return heads;
 }
 
-int64_t GenOffset(const std::vector<int64_t> &offsets, const std::vector<int64_t> &indexes) {
-  int64_t offset = 0;
-  for (size_t i = 0; i < indexes.size(); ++i) {
-    offset += offsets[i] * indexes[i];
+std::vector<int64_t> TransShapeByPerm(const std::vector<int64_t> &src_shape, const std::vector<int64_t> &perm_arg) {
+  std::vector<int64_t> dst_shape(src_shape.size());
+  for (size_t i = 0; i < perm_arg.size(); ++i) {
+    dst_shape[i] = src_shape[perm_arg[i]];
   }
-  return offset;
+  return dst_shape;
 }
 
-void AddOne(const std::vector<int64_t> &shape, std::vector<int64_t> &indexes) {
-  size_t i = indexes.size() - 1;
-  indexes[i]++;
-  while (i > 0) {
-    if (indexes[i] >= shape[i]) {
-      indexes[i] = 0;
-      indexes[i - 1]++;
-      --i;
+///
+/// @brief Drop the dims of 1 and merge the dims which are adjacent in both src and dst, e.g. the src shape
+///        [n, c, h, w] with perm [0, 2, 3, 1] is merged to [n, c, hw] with perm [0, 2, 1]
+/// @param [in] src_shape
+/// @param [in] perm_arg
+/// @param [out] merged_shape merged src shape, at least one dim
+/// @param [out] merged_perm perm of the merged dims
+///
+void MergeDims(const std::vector<int64_t> &src_shape, const std::vector<int64_t> &perm_arg,
+               std::vector<int64_t> &merged_shape, std::vector<int64_t> &merged_perm) {
+  std::vector<int64_t> kept_index(src_shape.size(), -1);
+  int64_t kept_num = 0;
+  for (size_t i = 0; i < src_shape.size(); ++i) {
+    if (src_shape[i] != 1) {
+      kept_index[i] = kept_num++;
+    }
+  }
+  // the first kept src dim and the size of every merged dim, in dst order
+  std::vector<int64_t> heads;
+  std::vector<int64_t> sizes;
+  int64_t last_index = -1;
+  for (auto perm : perm_arg) {
+    auto index = kept_index[perm];
+    if (index < 0) {
+      continue;
+    }
+    if (!heads.empty() && index == last_index + 1) {
+      sizes.back() *= src_shape[perm];
     } else {
-      break;
+      heads.push_back(index);
+      sizes.push_back(src_shape[perm]);
     }
+    last_index = index;
+  }
+  if (heads.empty()) {
+    merged_shape = {1};
+    merged_perm = {0};
+    return;
+  }
+
+  std::vector<size_t> src_order(heads.size());
+  for (size_t i = 0; i < src_order.size(); ++i) {
+    src_order[i] = i;
+  }
+  std::sort(src_order.begin(), src_order.end(), [&heads](size_t left, size_t right) {
+    return heads[left] < heads[right];
+  });
+  merged_shape.resize(heads.size());
+  merged_perm.resize(heads.size());
+  for (size_t i = 0; i < src_order.size(); ++i) {
+    merged_shape[i] = sizes[src_order[i]];
+    merged_perm[src_order[i]] = static_cast<int64_t>(i);
   }
 }
 
-std::vector<int64_t> TransShapeByPerm(const std::vector<int64_t> &src_shape, const std::vector<int64_t> &perm_arg) {
-  std::vector<int64_t> dst_shape(src_shape.size());
-  for (size_t i = 0; i < perm_arg.size(); ++i) {
-    dst_shape[i] = src_shape[perm_arg[i]];
+// offsets of src and dst counted by elements, of the index-th item in a shape
+void GetOffsets(int64_t index, const std::vector<int64_t> &shape, const std::vector<int64_t> &src_strides,
+                const std::vector<int64_t> &dst_strides, int64_t &src_offset, int64_t &dst_offset) {
+  src_offset = 0;
+  dst_offset = 0;
+  for (auto i = static_cast<int64_t>(shape.size()) - 1; i >= 0; --i) {
+    auto dim_index = index % shape[i];
+    index /= shape[i];
+    src_offset += dim_index * src_strides[i];
+    dst_offset += dim_index * dst_strides[i];
   }
-  return dst_shape;
+}
+
+int64_t GetTileSize(int64_t data_size) {
+  return std::max(kMinTileSize, kCacheLineSize / std::max(data_size, static_cast<int64_t>(1)));
+}
+
+///
+/// @brief Transpose the merged shape. The dst is walked by tiles of a plane made up of the last dims of src and dst,
+///        so that both of the src and dst are accessed by cache lines. If the last dim of src is still the last one
+///        of dst, the plane is a row, and it is copied at once.
+///
+Status TransposeMerged(const uint8_t *src, const std::vector<int64_t> &shape, const std::vector<int64_t> &perm,
+                       int64_t data_size, uint8_t *dst) {
+  auto dim_num = shape.size();
+  auto dst_shape = TransShapeByPerm(shape, perm);
+  auto src_strides = TransShapeByPerm(GenHeads(shape), perm);
+  auto dst_strides = GenHeads(dst_shape);
+  int64_t total = GetItemNumByShape(shape);
+
+  // identity
+  if (dim_num == 1) {
+    return ParallelFor(total * data_size, kMinParallelTransSize, [&](int64_t begin, int64_t end) -> Status {
+      // memcpy_s copies at most SECUREC_MEM_MAX_LEN bytes at a time
+      for (int64_t offset = begin; offset < end; offset += SECUREC_MEM_MAX_LEN) {
+        auto size = static_cast<size_t>(std::min(end - offset, static_cast<int64_t>(SECUREC_MEM_MAX_LEN)));
+        auto ret = memcpy_s(dst + offset, size, src + offset, size);
+        if (ret != EOK) {
+          GELOGE(INTERNAL_ERROR, "Failed to copy the bytes [%ld, %ld), err-code %d", begin, end, ret);
+          return INTERNAL_ERROR;
+        }
+      }
+      return SUCCESS;
+    });
+  }
+
+  // the last dim of src is still the last one of dst
+  if (perm[dim_num - 1] == static_cast<int64_t>(dim_num - 1)) {
+    auto row_size = dst_shape[dim_num - 1] * data_size;
+    std::vector<int64_t> outer_shape(dst_shape.begin(), dst_shape.end() - 1);
+    std::vector<int64_t> outer_src_strides(src_strides.begin(), src_strides.end() - 1);
+    std::vector<int64_t> outer_dst_strides(dst_strides.begin(), dst_strides.end() - 1);
+    return ParallelFor(total / dst_shape[dim_num - 1], Ceil(kMinParallelTransSize, row_size),
+                       [&](int64_t begin, int64_t end) -> Status {
+                         int64_t src_offset = 0;
+                         int64_t dst_offset = 0;
+                         for (int64_t i = begin; i < end; ++i) {
+                           GetOffsets(i, outer_shape, outer_src_strides, outer_dst_strides, src_offset, dst_offset);
+                           auto ret = memcpy_s(dst + dst_offset * data_size, static_cast<size_t>(row_size),
+                                               src + src_offset * data_size, static_cast<size_t>(row_size));
+                           if (ret != EOK) {
+                             GELOGE(INTERNAL_ERROR, "Failed to copy the row %ld, err-code %d", i, ret);
+                             return INTERNAL_ERROR;
+                           }
+                         }
+                         return SUCCESS;
+                       });
+  }
+
+  // rows of the plane are the last dim of src, which is the dim row_dim of dst, cols are the last dim of dst
+  size_t row_dim = 0;
+  while (perm[row_dim] != static_cast<int64_t>(dim_num - 1)) {
+    ++row_dim;
+  }
+  int64_t rows = dst_shape[row_dim];
+  int64_t cols = dst_shape[dim_num - 1];
+  MatrixLayout src_layout = {1, src_strides[dim_num - 1]};
+  MatrixLayout dst_layout = {dst_strides[row_dim], 1};
+  std::vector<int64_t> outer_shape;
+  std::vector<int64_t> outer_src_strides;
+  std::vector<int64_t> outer_dst_strides;
+  for (size_t i = 0; i + 1 < dim_num; ++i) {
+    if (i != row_dim) {
+      outer_shape.push_back(dst_shape[i]);
+      outer_src_strides.push_back(src_strides[i]);
+      outer_dst_strides.push_back(dst_strides[i]);
+    }
+  }
+
+  auto tile_size = GetTileSize(data_size);
+  auto row_tile_num = Ceil(rows, tile_size);
+  // each work item is a band of tile_size rows across the whole plane
+  return ParallelFor(
+    total / (rows * cols) * row_tile_num, Ceil(kMinParallelTransSize, tile_size * cols * data_size),
+    [&](int64_t begin, int64_t end) -> Status {
+      int64_t src_offset = 0;
+      int64_t dst_offset = 0;
+      for (int64_t i = begin; i < end; ++i) {
+        GetOffsets(i / row_tile_num, outer_shape, outer_src_strides, outer_dst_strides, src_offset, dst_offset);
+        int64_t row_begin = i % row_tile_num * tile_size;
+        int64_t tile_rows = std::min(tile_size, rows - row_begin);
+        for (int64_t col_begin = 0; col_begin < cols; col_begin += tile_size) {
+          int64_t tile_cols = std::min(tile_size, cols - col_begin);
+          GE_CHK_STATUS_RET_NOLOG(
+            CopyMatrix(src + (src_offset + row_begin + col_begin * src_layout.col_stride) * data_size, src_layout,
+                       dst + (dst_offset + row_begin * dst_layout.row_stride + col_begin) * data_size, dst_layout,
+                       tile_rows, tile_cols, data_size));
+        }
+      }
+      return SUCCESS;
+    });
 }
 }  // namespace
 
@@ -141,9 +294,6 @@ Status Transpose(const uint8_t *src, const std::vector<int64_t> &src_shape, Data
   }
 
   auto dst_shape = TransShapeByPerm(src_shape, perm_arg);
-  auto src_origin_ordered_heads = GenHeads(src_shape);
-  auto src_heads = TransShapeByPerm(src_origin_ordered_heads, perm_arg);
-
   int64_t dst_ele_num = GetItemNumByShape(dst_shape);
   int64_t data_size = GetSizeByDataType(src_data_type);
   int64_t dst_size = data_size * dst_ele_num;
@@ -157,26 +307,20 @@ Status Transpose(const uint8_t *src, const std::vector<int64_t> &src_shape, Data
   }
 
   std::shared_ptr<uint8_t> dst(new (std::nothrow) uint8_t[dst_size], std::default_delete<uint8_t[]>());
-  int64_t dst_index = 0;
-  std::vector<int64_t> dst_indexes(dst_shape.size());
-  while (dst_index < dst_ele_num) {
-    auto src_offset = GenOffset(src_heads, dst_indexes) * data_size;
-    auto dst_offset_bytes = dst_index * data_size;
-    auto protected_size = dst_size - dst_offset_bytes < static_cast<int64_t>(SECUREC_MEM_MAX_LEN)
-                            ? dst_size - dst_offset_bytes
-                            : static_cast<int64_t>(SECUREC_MEM_MAX_LEN);
-    auto ret = memcpy_s(dst.get() + dst_offset_bytes, static_cast<size_t>(protected_size), src + src_offset,
-                        static_cast<size_t>(data_size));
-    if (ret != EOK) {
-      GELOGE(INTERNAL_ERROR,
-             "Failed to transpose, src shape %s, perm arg %s, dst shape %s, "
-             "failed to write to dst offset %ld, current dim offset %s",
-             ShapeToString(src_shape).c_str(), ShapeToString(perm_arg).c_str(), ShapeToString(dst_shape).c_str(),
-             dst_offset_bytes, ShapeToString(dst_indexes).c_str());
-      return INTERNAL_ERROR;
-    }
-    AddOne(dst_shape, dst_indexes);
-    ++dst_index;
+  if (dst == nullptr) {
+    GELOGE(OUT_OF_MEMORY, "Failed to allocate memory for dst buf %ld when transpose, src shape %s, perm arg %s",
+           dst_size, ShapeToString(src_shape).c_str(), ShapeToString(perm_arg).c_str());
+    return OUT_OF_MEMORY;
+  }
+  std::vector<int64_t> merged_shape;
+  std::vector<int64_t> merged_perm;
+  MergeDims(src_shape, perm_arg, merged_shape, merged_perm);
+  auto ret = TransposeMerged(src, merged_shape, merged_perm, data_size, dst.get());
+  if (ret != SUCCESS) {
+    GELOGE(INTERNAL_ERROR, "Failed to transpose, src shape %s, perm arg %s, dst shape %s, merged shape %s perm %s",
+           ShapeToString(src_shape).c_str(), ShapeToString(perm_arg).c_str(), ShapeToString(dst_shape).c_str(),
+           ShapeToString(merged_shape).c_str(), ShapeToString(merged_perm).c_str());
+    return ret;
   }
 
   result.data = dst;
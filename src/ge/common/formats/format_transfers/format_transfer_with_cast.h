@@ -0,0 +1,48 @@
+/**
+ * Copyright 2019-2020 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef GE_COMMON_FORMATS_FORMAT_TRANSFERS_FORMAT_TRANSFER_WITH_CAST_H_
+#define GE_COMMON_FORMATS_FORMAT_TRANSFERS_FORMAT_TRANSFER_WITH_CAST_H_
+
+#include <cstdint>
+
+#include "register/register_format_transfer.h"
+
+namespace ge {
+namespace formats {
+/**
+ * Implemented by the format transfers which can convert the data type of the elements while moving them, so that
+ * a format and data type transfer takes a single pass over memory
+ */
+class FormatTransferWithCast {
+ public:
+  virtual ~FormatTransferWithCast() = default;
+
+  /**
+   * Same as TransFormat followed by casting the result to dst_data_type, but written into the dst buffer
+   * @param args
+   * @param dst_data_type
+   * @param dst
+   * @param dst_size bytes of dst, which should be enough for the transferred data
+   * @return
+   */
+  virtual Status TransFormatWithCast(const TransArgs &args, DataType dst_data_type, uint8_t *dst,
+                                     size_t dst_size) = 0;
+};
+}  // namespace formats
+}  // namespace ge
+
+#endif  // GE_COMMON_FORMATS_FORMAT_TRANSFERS_FORMAT_TRANSFER_WITH_CAST_H_
@@ -17,6 +17,7 @@
 #include "common/formats/formats.h"
 
 #include <securec.h>
+#include <algorithm>
 #include <cmath>
 #include <cstring>
 #include <functional>
@@ -24,6 +25,8 @@
 #include <string>
 #include <vector>
 
+#include "common/debug/log.h"
+#include "common/formats/format_transfers/format_transfer_with_cast.h"
 #include "common/formats/utils/formats_trans_utils.h"
 #include "framework/common/debug/ge_log.h"
 #include "framework/common/ge_inner_error_codes.h"
@@ -84,6 +87,112 @@ GE_FUNC_DEV_VISIBILITY GE_FUNC_HOST_VISIBILITY Status TransDataType(const CastAr
   return transfer->TransDataType(args, result);
 }
 
+namespace {
+Status BuildFormatTransferWithData(const TransArgs &args, std::shared_ptr<FormatTransfer> &transfer) {
+  transfer = BuildFormatTransfer(args);
+  if (transfer == nullptr) {
+    GELOGE(UNSUPPORTED, "Failed to trans data from format %s to %s, unsupport now",
+           TypeUtils::FormatToSerialString(args.src_format).c_str(),
+           TypeUtils::FormatToSerialString(args.dst_format).c_str());
+    return UNSUPPORTED;
+  }
+  if (args.data == nullptr && GetItemNumByShape(args.src_shape) != 0) {
+    GELOGE(PARAM_INVALID, "Invalid input null data");
+    return PARAM_INVALID;
+  }
+  return SUCCESS;
+}
+
+CastArgs GetCastArgs(const TransResult &format_result, const TransArgs &args, DataType dst_data_type) {
+  CastArgs cast_args;
+  cast_args.data = format_result.data.get();
+  cast_args.src_data_size = format_result.length / GetSizeByDataType(args.src_data_type);
+  cast_args.src_data_type = args.src_data_type;
+  cast_args.dst_data_type = dst_data_type;
+  return cast_args;
+}
+}  // namespace
+
+GE_FUNC_DEV_VISIBILITY GE_FUNC_HOST_VISIBILITY Status TransFormatAndDataType(const TransArgs &args,
+                                                                             DataType dst_data_type,
+                                                                             TransResult &result) {
+  std::shared_ptr<FormatTransfer> transfer;
+  GE_CHK_STATUS_RET_NOLOG(BuildFormatTransferWithData(args, transfer));
+  auto transfer_with_cast = std::dynamic_pointer_cast<FormatTransferWithCast>(transfer);
+  if (transfer_with_cast == nullptr) {
+    TransResult format_result;
+    GE_CHK_STATUS_RET_NOLOG(transfer->TransFormat(args, format_result));
+    if (args.src_data_type == dst_data_type) {
+      result = format_result;
+      return SUCCESS;
+    }
+    return TransDataType(GetCastArgs(format_result, args, dst_data_type), result);
+  }
+
+  ElementCast elem_cast;
+  GE_CHK_STATUS_RET_NOLOG(GetElementCast(args.src_data_type, dst_data_type, elem_cast));
+  std::vector<int64_t> dst_shape;
+  GE_CHK_STATUS_RET_NOLOG(
+    transfer->TransShape(args.src_format, args.src_shape, args.src_data_type, args.dst_format, dst_shape));
+  int64_t dst_size = GetItemNumByShape(dst_shape) * elem_cast.dst_size;
+  if (dst_size <= 0) {
+    result.length = 0;
+    return transfer_with_cast->TransFormatWithCast(args, dst_data_type, nullptr, 0);
+  }
+  std::shared_ptr<uint8_t> dst(new (std::nothrow) uint8_t[dst_size], std::default_delete<uint8_t[]>());
+  if (dst == nullptr) {
+    GELOGE(OUT_OF_MEMORY, "Failed to trans format from %s to %s, can not alloc the memory for dst buf %ld",
+           TypeUtils::FormatToSerialString(args.src_format).c_str(),
+           TypeUtils::FormatToSerialString(args.dst_format).c_str(), dst_size);
+    return OUT_OF_MEMORY;
+  }
+  GE_CHK_STATUS_RET_NOLOG(
+    transfer_with_cast->TransFormatWithCast(args, dst_data_type, dst.get(), static_cast<size_t>(dst_size)));
+  result.data = dst;
+  result.length = static_cast<size_t>(dst_size);
+  return SUCCESS;
+}
+
+GE_FUNC_DEV_VISIBILITY GE_FUNC_HOST_VISIBILITY Status TransFormatAndDataType(const TransArgs &args,
+                                                                             DataType dst_data_type, uint8_t *dst,
+                                                                             size_t dst_size) {
+  std::shared_ptr<FormatTransfer> transfer;
+  GE_CHK_STATUS_RET_NOLOG(BuildFormatTransferWithData(args, transfer));
+  auto transfer_with_cast = std::dynamic_pointer_cast<FormatTransferWithCast>(transfer);
+  if (transfer_with_cast != nullptr) {
+    return transfer_with_cast->TransFormatWithCast(args, dst_data_type, dst, dst_size);
+  }
+
+  // the data type is converted from the format result straight into dst
+  ElementCast elem_cast;
+  GE_CHK_STATUS_RET_NOLOG(GetElementCast(args.src_data_type, dst_data_type, elem_cast));
+  TransResult format_result;
+  GE_CHK_STATUS_RET_NOLOG(transfer->TransFormat(args, format_result));
+  if (elem_cast.cast != nullptr) {
+    return DataTypeTransfer().TransDataType(GetCastArgs(format_result, args, dst_data_type), dst, dst_size);
+  }
+  if (format_result.length == 0) {
+    return SUCCESS;
+  }
+  if (dst == nullptr || dst_size < format_result.length) {
+    GELOGE(PARAM_INVALID, "Failed to trans format from %s to %s, the dst buf %zu is less than %zu",
+           TypeUtils::FormatToSerialString(args.src_format).c_str(),
+           TypeUtils::FormatToSerialString(args.dst_format).c_str(), dst_size, format_result.length);
+    return PARAM_INVALID;
+  }
+  // memcpy_s copies at most SECUREC_MEM_MAX_LEN bytes at a time
+  for (size_t offset = 0; offset < format_result.length; offset += SECUREC_MEM_MAX_LEN) {
+    auto size = std::min(format_result.length - offset, static_cast<size_t>(SECUREC_MEM_MAX_LEN));
+    auto ret = memcpy_s(dst + offset, size, format_result.data.get() + offset, size);
+    if (ret != EOK) {
+      GELOGE(INTERNAL_ERROR, "Failed to copy the format result of %zu bytes to dst, err-code %d",
+             format_result.length, ret);
+      return INTERNAL_ERROR;
+    }
+  }
+  return SUCCESS;
+}
+
 GE_FUNC_DEV_VISIBILITY GE_FUNC_HOST_VISIBILITY bool IsTransFormatSupport(const TransArgs &args) {
   return FormatTransferExists(args);
 }
@@ -41,6 +41,27 @@ Status TransShape(Format src_format, const std::vector<int64_t> &src_shape, Data
 
 Status TransDataType(const CastArgs &args, TransResult &result);
 
+/**
+ * Convert the data format and the data type of args into dst_data_type at once, the result is the same as
+ * TransFormat followed by TransDataType, but the elements are converted while scattering them into the dst layout
+ * by the transfers supporting it, without the intermediate buffer
+ * @param args
+ * @param dst_data_type
+ * @param result
+ * @return
+ */
+Status TransFormatAndDataType(const TransArgs &args, DataType dst_data_type, TransResult &result);
+
+/**
+ * Same as above, but the result is written to the dst buffer provided by the caller
+ * @param args
+ * @param dst_data_type
+ * @param dst
+ * @param dst_size bytes of dst, PARAM_INVALID is returned if it is less than the result
+ * @return
+ */
+Status TransFormatAndDataType(const TransArgs &args, DataType dst_data_type, uint8_t *dst, size_t dst_size);
+
 bool IsTransFormatSupport(const TransArgs &args);
 
 bool IsTransDataTypeSupport(const CastArgs &args);
@@ -22,6 +22,8 @@ namespace formats {
 static const int kCubeSize = 16;
 static const int kNiSize = 16;
 static const int64_t kShapeItemNumMAX = 1024UL * 1024UL * 1024UL * 1024UL;
+// Bytes transferred by one thread at least, smaller data is transferred on the calling thread only
+static const int64_t kMinParallelTransSize = 1024 * 1024;
 
 enum NchwDimIndex { kNchwN, kNchwC, kNchwH, kNchwW, kNchwDimsNum };
 
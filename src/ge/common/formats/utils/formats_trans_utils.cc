@@ -16,15 +16,67 @@
 
 #include "common/formats/utils/formats_trans_utils.h"
 
+#include <securec.h>
+#include <algorithm>
 #include <cstdint>
+#include <cstring>
+#include <future>
+#include <thread>
 
+#include "common/debug/log.h"
 #include "common/formats/utils/formats_definitions.h"
+#include "common/thread_pool.h"
 #include "framework/common/debug/ge_log.h"
 #include "framework/common/ge_inner_error_codes.h"
 #include "graph/utils/type_utils.h"
 
 namespace ge {
 namespace formats {
+namespace {
+// Transfers are also run for several tensors at the same time, so that each of them takes a few threads only
+const int64_t kMaxTransThreadNum = 8;
+// elements converted by one call of the cast function in CastMatrix, and the largest size of them
+const int64_t kCastRunNum = 256;
+const int64_t kMaxElementSize = 8;
+
+// The bounds are checked by CopyMatrix once for the whole matrix, the elements are copied by fixed size copies
+// which are inlined
+template <int64_t kSize>
+void CopyMatrixBySize(const uint8_t *src, const MatrixLayout &src_layout, uint8_t *dst,
+                      const MatrixLayout &dst_layout, int64_t rows, int64_t cols) {
+  for (int64_t i = 0; i < rows; i++) {
+    const uint8_t *src_row = src + i * src_layout.row_stride * kSize;
+    uint8_t *dst_row = dst + i * dst_layout.row_stride * kSize;
+    for (int64_t j = 0; j < cols; j++) {
+      memcpy(dst_row + j * dst_layout.col_stride * kSize, src_row + j * src_layout.col_stride * kSize, kSize);
+    }
+  }
+}
+
+// Bytes from the first element of a matrix to the end of its last one, -1 if a stride is negative or it overflows
+int64_t GetMatrixSpan(const MatrixLayout &layout, int64_t rows, int64_t cols, int64_t size) {
+  if (layout.row_stride < 0 || layout.col_stride < 0) {
+    return -1;
+  }
+  int64_t max_index = INT64_MAX / size - 1;
+  if (layout.row_stride != 0 && rows - 1 > max_index / layout.row_stride) {
+    return -1;
+  }
+  int64_t last_index = (rows - 1) * layout.row_stride;
+  if (layout.col_stride != 0 && cols - 1 > (max_index - last_index) / layout.col_stride) {
+    return -1;
+  }
+  last_index += (cols - 1) * layout.col_stride;
+  return (last_index + 1) * size;
+}
+
+bool IsOverlapped(const uint8_t *addr1, int64_t size1, const uint8_t *addr2, int64_t size2) {
+  auto begin1 = reinterpret_cast<uintptr_t>(addr1);
+  auto begin2 = reinterpret_cast<uintptr_t>(addr2);
+  return (begin1 < begin2 + static_cast<uintptr_t>(size2)) && (begin2 < begin1 + static_cast<uintptr_t>(size1));
+}
+}  // namespace
+
 int64_t GetCubeSizeByDataType(DataType data_type) {
   // Current cube does not support 4 bytes and longer data
   auto size = GetSizeByDataType(data_type);
@@ -94,5 +146,137 @@ bool IsShapeEqual(const GeShape &src, const GeShape &dst) {
   }
   return true;
 }
+
+Status ParallelFor(int64_t total, int64_t min_num, const std::function<Status(int64_t, int64_t)> &func) {
+  if (total <= 0) {
+    return SUCCESS;
+  }
+  int64_t thread_num = std::min(total / std::max(min_num, static_cast<int64_t>(1)), kMaxTransThreadNum);
+  thread_num = std::min(thread_num, static_cast<int64_t>(std::thread::hardware_concurrency()));
+  if (thread_num <= 1) {
+    return func(0, total);
+  }
+
+  int64_t step = Ceil(total, thread_num);
+  Status ret = SUCCESS;
+  std::vector<std::future<Status>> futures;
+  ThreadPool pool(static_cast<uint32_t>(thread_num - 1));
+  for (int64_t begin = step; begin < total; begin += step) {
+    auto f = pool.commit(func, begin, std::min(begin + step, total));
+    if (!f.valid()) {
+      GELOGE(INTERNAL_ERROR, "Failed to commit the part [%ld, %ld) of %ld items", begin, begin + step, total);
+      ret = INTERNAL_ERROR;
+      break;
+    }
+    futures.emplace_back(std::move(f));
+  }
+  if (ret == SUCCESS) {
+    ret = func(0, step);
+  }
+  // wait for all of the committed parts, as they refer to data of caller
+  for (auto &f : futures) {
+    Status part_ret = f.get();
+    if (ret == SUCCESS) {
+      ret = part_ret;
+    }
+  }
+  return ret;
+}
+
+Status CopyMatrix(const uint8_t *src, const MatrixLayout &src_layout, uint8_t *dst, const MatrixLayout &dst_layout,
+                  int64_t rows, int64_t cols, int64_t size) {
+  if (rows <= 0 || cols <= 0) {
+    return SUCCESS;
+  }
+  int64_t src_span = (src == nullptr || size <= 0) ? -1 : GetMatrixSpan(src_layout, rows, cols, size);
+  int64_t dst_span = (dst == nullptr || size <= 0) ? -1 : GetMatrixSpan(dst_layout, rows, cols, size);
+  if (src_span < 0 || dst_span < 0 || IsOverlapped(src, src_span, dst, dst_span)) {
+    GELOGE(PARAM_INVALID, "Invalid copy of a %ld x %ld matrix of %ld bytes elements, src strides (%ld, %ld), "
+           "dst strides (%ld, %ld)", rows, cols, size, src_layout.row_stride, src_layout.col_stride,
+           dst_layout.row_stride, dst_layout.col_stride);
+    return PARAM_INVALID;
+  }
+
+  if (src_layout.col_stride == 1 && dst_layout.col_stride == 1) {
+    auto row_size = static_cast<size_t>(cols * size);
+    for (int64_t i = 0; i < rows; i++) {
+      auto ret = memcpy_s(dst + i * dst_layout.row_stride * size, row_size, src + i * src_layout.row_stride * size,
+                          row_size);
+      if (ret != EOK) {
+        GELOGE(INTERNAL_ERROR, "Failed to copy the row %ld of matrix, err-code %d", i, ret);
+        return INTERNAL_ERROR;
+      }
+    }
+    return SUCCESS;
+  }
+  switch (size) {
+    case 1:
+      CopyMatrixBySize<1>(src, src_layout, dst, dst_layout, rows, cols);
+      return SUCCESS;
+    case 2:
+      CopyMatrixBySize<2>(src, src_layout, dst, dst_layout, rows, cols);
+      return SUCCESS;
+    case 4:
+      CopyMatrixBySize<4>(src, src_layout, dst, dst_layout, rows, cols);
+      return SUCCESS;
+    case 8:
+      CopyMatrixBySize<8>(src, src_layout, dst, dst_layout, rows, cols);
+      return SUCCESS;
+    default:
+      break;
+  }
+  for (int64_t i = 0; i < rows; i++) {
+    for (int64_t j = 0; j < cols; j++) {
+      memcpy(dst + (i * dst_layout.row_stride + j * dst_layout.col_stride) * size,
+             src + (i * src_layout.row_stride + j * src_layout.col_stride) * size, static_cast<size_t>(size));
+    }
+  }
+  return SUCCESS;
+}
+
+Status CastMatrix(const uint8_t *src, const MatrixLayout &src_layout, uint8_t *dst, const MatrixLayout &dst_layout,
+                  int64_t rows, int64_t cols, const ElementCast &elem_cast) {
+  if (elem_cast.cast == nullptr) {
+    return CopyMatrix(src, src_layout, dst, dst_layout, rows, cols, elem_cast.src_size);
+  }
+  if (elem_cast.src_size > kMaxElementSize || elem_cast.dst_size > kMaxElementSize) {
+    GELOGE(PARAM_INVALID, "Failed to cast elements from %ld bytes to %ld bytes", elem_cast.src_size,
+           elem_cast.dst_size);
+    return PARAM_INVALID;
+  }
+
+  // walk along the contiguous side of src, so that the elements are read by runs
+  MatrixLayout src_walk = src_layout;
+  MatrixLayout dst_walk = dst_layout;
+  if (src_walk.col_stride != 1 && src_walk.row_stride == 1) {
+    std::swap(src_walk.row_stride, src_walk.col_stride);
+    std::swap(dst_walk.row_stride, dst_walk.col_stride);
+    std::swap(rows, cols);
+  }
+  alignas(kMaxElementSize) uint8_t src_buf[kCastRunNum * kMaxElementSize];
+  alignas(kMaxElementSize) uint8_t dst_buf[kCastRunNum * kMaxElementSize];
+  for (int64_t i = 0; i < rows; i++) {
+    for (int64_t j = 0; j < cols; j += kCastRunNum) {
+      int64_t num = std::min(kCastRunNum, cols - j);
+      const uint8_t *src_run = src + (i * src_walk.row_stride + j * src_walk.col_stride) * elem_cast.src_size;
+      uint8_t *dst_run = dst + (i * dst_walk.row_stride + j * dst_walk.col_stride) * elem_cast.dst_size;
+      if (src_walk.col_stride != 1) {
+        GE_CHK_STATUS_RET_NOLOG(
+          CopyMatrix(src_run, {0, src_walk.col_stride}, src_buf, {0, 1}, 1, num, elem_cast.src_size));
+        src_run = src_buf;
+      }
+      uint8_t *cast_dst = (dst_walk.col_stride == 1) ? dst_run : dst_buf;
+      auto ret = elem_cast.cast(src_run, cast_dst, static_cast<size_t>(num));
+      if (ret != SUCCESS) {
+        return ret;
+      }
+      if (cast_dst == dst_buf) {
+        GE_CHK_STATUS_RET_NOLOG(
+          CopyMatrix(dst_buf, {0, 1}, dst_run, {0, dst_walk.col_stride}, 1, num, elem_cast.dst_size));
+      }
+    }
+  }
+  return SUCCESS;
+}
 }  // namespace formats
 }  // namespace ge
@@ -18,10 +18,12 @@
 #define GE_COMMON_FORMATS_UTILS_FORMATS_TRANS_UTILS_H_
 
 #include <cstdint>
+#include <functional>
 #include <sstream>
 #include <string>
 #include <vector>
 #include "external/graph/types.h"
+#include "framework/common/ge_inner_error_codes.h"
 #include "graph/ge_tensor.h"
 
 namespace ge {
@@ -61,6 +63,58 @@ bool IsShapeValid(const std::vector<int64_t> &shape);
 
 bool IsShapeEqual(const GeShape &src, const GeShape &dst);
 
+/**
+ * Split the items [0, total) into parts of at least min_num items, and process the parts on several threads.
+ * The first part is processed on the calling thread, and all of the parts are done when returned.
+ * @param total items number
+ * @param min_num the least items number of one thread
+ * @param func called with the begin and the end of a part
+ * @return SUCCESS, or the first failure returned by func
+ */
+Status ParallelFor(int64_t total, int64_t min_num, const std::function<Status(int64_t, int64_t)> &func);
+
+/**
+ * Strides of a matrix in memory, counted by elements
+ */
+struct MatrixLayout {
+  int64_t row_stride;
+  int64_t col_stride;
+};
+
+/**
+ * Copy a matrix of rows * cols elements, the element (i, j) is copied from
+ * src[i * src_layout.row_stride + j * src_layout.col_stride] to
+ * dst[i * dst_layout.row_stride + j * dst_layout.col_stride]. Rows contiguous in both src and dst are copied as a
+ * whole, other elements by fixed size copies after the bounds of the whole matrix are checked once.
+ * @param size bytes of one element
+ * @return SUCCESS, PARAM_INVALID if a stride is negative or src and dst overlap, or INTERNAL_ERROR if a row copy
+ * failed
+ */
+Status CopyMatrix(const uint8_t *src, const MatrixLayout &src_layout, uint8_t *dst, const MatrixLayout &dst_layout,
+                  int64_t rows, int64_t cols, int64_t size);
+
+/**
+ * Convert data_size elements, which are contiguous in both src and dst
+ */
+using CastFunc = Status (*)(const uint8_t *src, uint8_t *dst, const size_t data_size);
+
+/**
+ * How to transfer an element: converted from src_size bytes to dst_size bytes by cast, or copied as it is if the
+ * cast is null
+ */
+struct ElementCast {
+  int64_t src_size;
+  int64_t dst_size;
+  CastFunc cast;
+};
+
+/**
+ * Same as CopyMatrix, but the elements are converted by elem_cast on the way. Elements not contiguous in src or dst
+ * are gathered or scattered through a small buffer, so that they are converted by runs.
+ */
+Status CastMatrix(const uint8_t *src, const MatrixLayout &src_layout, uint8_t *dst, const MatrixLayout &dst_layout,
+                  int64_t rows, int64_t cols, const ElementCast &elem_cast);
+
 template <typename T>
 T Ceil(T n1, T n2) {
   if (n1 == 0) {
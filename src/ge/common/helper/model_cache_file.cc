@@ -0,0 +1,237 @@
+/**
+ * Copyright 2019-2020 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "common/helper/model_cache_file.h"
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#include <cerrno>
+#include <cstdio>
+#include <cstring>
+#include <vector>
+
+#include "framework/common/debug/ge_log.h"
+#include "graph/common/graph_hasher.h"
+
+namespace ge {
+namespace {
+const size_t kSectionAlign = 8;
+const int kCacheFileAuthority = 0600;
+
+size_t AlignSize(size_t size) { return (size + kSectionAlign - 1) / kSectionAlign * kSectionAlign; }
+
+HashCode128 GetChecksum(const uint8_t *data, size_t size) { return StreamHasher().Update(data, size).Finish(); }
+
+Status WriteFile(const std::string &path, const std::vector<uint8_t> &buffer) {
+  // write to temp file and rename, so that a broken file is never taken as cache
+  const std::string temp_path = path + ".tmp";
+  int fd = open(temp_path.c_str(), O_WRONLY | O_CREAT | O_TRUNC, kCacheFileAuthority);
+  if (fd < 0) {
+    GELOGW("Fail to open the file: %s.", temp_path.c_str());
+    return INTERNAL_ERROR;
+  }
+  size_t written = 0;
+  while (written < buffer.size()) {
+    ssize_t ret = write(fd, buffer.data() + written, buffer.size() - written);
+    if (ret < 0 && errno == EINTR) {
+      continue;
+    }
+    if (ret <= 0) {
+      GELOGW("Fail to write the file: %s, errno: %d.", temp_path.c_str(), errno);
+      (void)close(fd);
+      (void)remove(temp_path.c_str());
+      return INTERNAL_ERROR;
+    }
+    written += static_cast<size_t>(ret);
+  }
+  if (close(fd) != 0) {
+    GELOGW("Fail to close the file: %s.", temp_path.c_str());
+    (void)remove(temp_path.c_str());
+    return INTERNAL_ERROR;
+  }
+  if (rename(temp_path.c_str(), path.c_str()) != 0) {
+    GELOGW("Fail to rename file %s to %s, errno: %d.", temp_path.c_str(), path.c_str(), errno);
+    (void)remove(temp_path.c_str());
+    return INTERNAL_ERROR;
+  }
+  return SUCCESS;
+}
+}  // namespace
+
+Status ModelCacheFile::Save(const std::string &path, const Json &json) {
+  if (!json.is_object()) {
+    GELOGW("Cache json should be an object.");
+    return PARAM_INVALID;
+  }
+  std::vector<std::pair<std::string, std::vector<uint8_t>>> sections;
+  try {
+    for (auto iter = json.begin(); iter != json.end(); ++iter) {
+      if (iter.key().size() >= kModelCacheSectionNameLen) {
+        GELOGW("Section name %s is too long.", iter.key().c_str());
+        return PARAM_INVALID;
+      }
+      sections.emplace_back(iter.key(), Json::to_msgpack(iter.value()));
+    }
+  } catch (const std::exception &e) {
+    GELOGW("Fail to encode cache json. Error message: %s", e.what());
+    return INTERNAL_ERROR;
+  }
+
+  size_t offset = sizeof(ModelCacheFileHeader) + sizeof(ModelCacheSectionHeader) * sections.size();
+  std::vector<ModelCacheSectionHeader> section_headers(sections.size());
+  for (size_t i = 0; i < sections.size(); ++i) {
+    auto &section_header = section_headers[i];
+    (void)memset(&section_header, 0, sizeof(section_header));
+    (void)memcpy(section_header.name, sections[i].first.data(), sections[i].first.size());
+    section_header.offset = offset;
+    section_header.size = sections[i].second.size();
+    offset += AlignSize(sections[i].second.size());
+  }
+
+  std::vector<uint8_t> buffer(offset, 0);
+  if (!section_headers.empty()) {
+    (void)memcpy(buffer.data() + sizeof(ModelCacheFileHeader), section_headers.data(),
+                 sizeof(ModelCacheSectionHeader) * section_headers.size());
+  }
+  for (size_t i = 0; i < sections.size(); ++i) {
+    if (!sections[i].second.empty()) {
+      (void)memcpy(buffer.data() + section_headers[i].offset, sections[i].second.data(), sections[i].second.size());
+    }
+  }
+
+  ModelCacheFileHeader header;
+  (void)memset(&header, 0, sizeof(header));
+  header.magic = kModelCacheFileMagic;
+  header.version = kModelCacheFileVersion;
+  header.section_num = static_cast<uint32_t>(sections.size());
+  header.file_size = buffer.size();
+  HashCode128 checksum =
+    GetChecksum(buffer.data() + sizeof(ModelCacheFileHeader), buffer.size() - sizeof(ModelCacheFileHeader));
+  header.checksum_high = checksum.high;
+  header.checksum_low = checksum.low;
+  (void)memcpy(buffer.data(), &header, sizeof(header));
+  return WriteFile(path, buffer);
+}
+
+Status ModelCacheFile::Load(const std::string &path) {
+  mapped_file_.reset();
+  sections_.clear();
+  int fd = open(path.c_str(), O_RDONLY);
+  if (fd < 0) {
+    GELOGI("File[%s] is not found.", path.c_str());
+    return FAILED;
+  }
+  struct stat file_stat;
+  if (fstat(fd, &file_stat) != 0 || file_stat.st_size < static_cast<off_t>(sizeof(ModelCacheFileHeader))) {
+    GELOGW("Invalid cache file: %s.", path.c_str());
+    (void)close(fd);
+    return FAILED;
+  }
+  size_t len = static_cast<size_t>(file_stat.st_size);
+  void *data = mmap(nullptr, len, PROT_READ, MAP_PRIVATE, fd, 0);
+  (void)close(fd);
+  if (data == MAP_FAILED) {
+    GELOGW("Map file failed, path: %s, errno: %d.", path.c_str(), errno);
+    return FAILED;
+  }
+  mapped_file_ = std::shared_ptr<void>(data, [len](void *addr) { (void)munmap(addr, len); });
+
+  auto base = static_cast<const uint8_t *>(data);
+  auto header = static_cast<const ModelCacheFileHeader *>(data);
+  if (header->magic != kModelCacheFileMagic || header->version != kModelCacheFileVersion) {
+    GELOGI("Cache file %s is of other version, magic: %x, version: %u.", path.c_str(), header->magic,
+           header->version);
+    mapped_file_.reset();
+    return FAILED;
+  }
+  size_t table_end = sizeof(ModelCacheFileHeader) + sizeof(ModelCacheSectionHeader) * header->section_num;
+  if (header->file_size != len || table_end > len) {
+    GELOGW("Cache file %s is truncated, size: %zu, expect: %lu.", path.c_str(), len, header->file_size);
+    mapped_file_.reset();
+    return FAILED;
+  }
+  HashCode128 checksum = GetChecksum(base + sizeof(ModelCacheFileHeader), len - sizeof(ModelCacheFileHeader));
+  if (checksum.high != header->checksum_high || checksum.low != header->checksum_low) {
+    GELOGW("Checksum of cache file %s mismatch.", path.c_str());
+    mapped_file_.reset();
+    return FAILED;
+  }
+
+  auto section_headers = reinterpret_cast<const ModelCacheSectionHeader *>(base + sizeof(ModelCacheFileHeader));
+  for (uint32_t i = 0; i < header->section_num; ++i) {
+    const auto &section_header = section_headers[i];
+    if (section_header.offset < table_end || section_header.offset > len ||
+        section_header.size > len - section_header.offset) {
+      GELOGW("Section %u of cache file %s is out of range.", i, path.c_str());
+      mapped_file_.reset();
+      sections_.clear();
+      return FAILED;
+    }
+    std::string name(section_header.name, strnlen(section_header.name, kModelCacheSectionNameLen));
+    sections_[name] = std::make_pair(base + section_header.offset, static_cast<size_t>(section_header.size));
+  }
+  return SUCCESS;
+}
+
+bool ModelCacheFile::HasSection(const std::string &name) const { return sections_.count(name) > 0; }
+
+Status ModelCacheFile::GetSection(const std::string &name, Json &json) const {
+  auto iter = sections_.find(name);
+  if (iter == sections_.end()) {
+    GELOGW("Section %s is not found in cache file.", name.c_str());
+    return FAILED;
+  }
+  const uint8_t *begin = iter->second.first;
+  try {
+    json = Json::from_msgpack(begin, begin + iter->second.second);
+  } catch (const std::exception &e) {
+    GELOGW("Fail to decode section %s. Error message: %s", name.c_str(), e.what());
+    return INTERNAL_ERROR;
+  }
+  return SUCCESS;
+}
+
+Status ModelCacheFile::GetSections(const std::vector<std::string> &names, Json &json) const {
+  if (!(json.is_null() || json.is_object())) {
+    GELOGW("Input param json type should be null or object.");
+    return PARAM_INVALID;
+  }
+  for (const auto &name : names) {
+    Json section_json;
+    auto ret = GetSection(name, section_json);
+    if (ret != SUCCESS) {
+      return ret;
+    }
+    json[name] = std::move(section_json);
+  }
+  return SUCCESS;
+}
+
+Status ModelCacheFile::GetAllSections(Json &json) const {
+  json = Json::object();
+  for (const auto &section : sections_) {
+    Json section_json;
+    auto ret = GetSection(section.first, section_json);
+    if (ret != SUCCESS) {
+      return ret;
+    }
+    json[section.first] = std::move(section_json);
+  }
+  return SUCCESS;
+}
+}  // namespace ge
@@ -0,0 +1,76 @@
+/**
+ * Copyright 2019-2020 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef GE_COMMON_HELPER_MODEL_CACHE_FILE_H_
+#define GE_COMMON_HELPER_MODEL_CACHE_FILE_H_
+
+#include <nlohmann/json.hpp>
+#include <map>
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "ge/ge_api_error_codes.h"
+
+namespace ge {
+using Json = nlohmann::json;
+
+// Binary cache file of incremental build. Layout, all parts are 8 bytes aligned:
+// | ModelCacheFileHeader | ModelCacheSectionHeader * section_num | section data ... |
+// Each top level item of the cache json is kept in its own section encoded as MessagePack, so that a section can be
+// decoded in place from the mapped file without touching the others.
+const uint32_t kModelCacheFileMagic = 0x48434547;  // "GECH"
+const uint32_t kModelCacheFileVersion = 1;
+const size_t kModelCacheSectionNameLen = 32;
+
+struct ModelCacheFileHeader {
+  uint32_t magic;
+  uint32_t version;  // cache of other version is invalid
+  uint32_t section_num;
+  uint32_t reserved;
+  uint64_t file_size;
+  uint64_t checksum_high;  // hash of all bytes after file header
+  uint64_t checksum_low;
+};
+
+struct ModelCacheSectionHeader {
+  char name[kModelCacheSectionNameLen];
+  uint64_t offset;  // offset from begin of file
+  uint64_t size;
+};
+
+class ModelCacheFile {
+ public:
+  // Items of json object are saved as sections, file is replaced atomically
+  static Status Save(const std::string &path, const Json &json);
+
+  // Map file and check header, version and checksum
+  Status Load(const std::string &path);
+
+  bool HasSection(const std::string &name) const;
+  Status GetSection(const std::string &name, Json &json) const;
+  // Decode only the named sections into items of json object, other sections are left untouched
+  Status GetSections(const std::vector<std::string> &names, Json &json) const;
+  Status GetAllSections(Json &json) const;
+
+ private:
+  std::shared_ptr<void> mapped_file_;
+  std::map<std::string, std::pair<const uint8_t *, size_t>> sections_;
+};
+}  // namespace ge
+
+#endif  // GE_COMMON_HELPER_MODEL_CACHE_FILE_H_
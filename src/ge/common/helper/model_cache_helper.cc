@@ -18,10 +18,11 @@
 #include <unistd.h>
 #include <climits>
 #include <cstdio>
+#include <cstdlib>
 #include <fstream>
-#include <functional>
 
 #include "common/ge/ge_util.h"
+#include "common/helper/model_cache_file.h"
 #include "common/helper/model_cache_helper.h"
 #include "common/types.h"
 #include "framework/common/debug/ge_log.h"
@@ -29,19 +30,16 @@
 #include "framework/common/helper/model_helper.h"
 #include "framework/common/util.h"
 #include "graph/detail/attributes_holder.h"
-#include "graph/detail/model_serialize_imp.h"
 #include "graph/load/new_model_manager/davinci_model_parser.h"
 #include "graph/model.h"
 #include "graph/utils/graph_utils.h"
 #include "graph/utils/tensor_utils.h"
 #include "init/gelib.h"
-#include "proto/ge_ir.pb.h"
 
 using namespace std;
 
 namespace {
 const char *const kTbeKernelInfoStoreName = "AIcoreEngine";
-const char *const kGraphName = "temp_name";
 // Keys of json
 const char *const kNodeNum = "nodeNum";
 const char *const kEdgeNum = "edgeNum";
@@ -90,10 +88,13 @@ const char *const kInputSize = "inputSize";
 const char *const kOutputOffset = "outputOffset";
 const char *const kOutputSize = "outputSize";
 // Suffix of cache files
-const char *const kBeforeVarManagerSuffix = "_before_build_var_manager.json";
-const char *const kAfterVarManagerSuffix = "_after_build_var_manager.json";
+const char *const kBeforeVarManagerSuffix = "_before_build_var_manager.cache";
+const char *const kAfterVarManagerSuffix = "_after_build_var_manager.cache";
 const char *const kManifestSuffix = ".manifest";
 const char *const kOmSuffix = ".om";
+const char *const kJsonExportSuffix = ".json";
+// Cache files are binary, set to 1 to export them as json for debugging as well
+const char *const kEnvCacheJsonExport = "GE_INCRE_BUILD_CACHE_JSON";
 }  // namespace
 
 namespace ge {
@@ -159,25 +160,26 @@ bool ModelCacheHelper::IsModelCacheHit() const {
     GELOGI("Graph id[%u] cache miss: the edge number of the graph does not match the cache info.", graph_id_);
     return false;
   }
-  size_t compute_graph_hash;
-  auto ret = GetComputeGraphHash(compute_graph_hash);
+  HashCode128 compute_graph_hash;
+  map<std::string, HashCode128> nodes_hash;
+  auto ret = GetComputeGraphHash(compute_graph_hash, nodes_hash);
   if (ret != SUCCESS || cache_info.graph_hash != compute_graph_hash) {
     GELOGI("Graph id[%u] cache miss: the hash code of the graph does not match the cache info.", graph_id_);
     return false;
   }
-  if (!IsNodeHashSameAsCache(cache_info.nodes_hash)) {
+  if (!IsNodeHashSameAsCache(cache_info.nodes_hash, nodes_hash)) {
     GELOGI("Graph id[%u] cache miss: the hash code of node does not match the cache info.", graph_id_);
     return false;
   }
 
   string var_manager_cache =
     to_string(graph_id_) + "_" + to_string(graph_id_run_times_[graph_id_]) + kBeforeVarManagerSuffix;
-  Json var_manager_json;
-  if (LoadJsonFromFile(var_manager_cache, var_manager_json) != SUCCESS) {
-    GELOGW("Fail to load json from cache file: %s", var_manager_cache.c_str());
+  ModelCacheFile var_manager_file;
+  if (LoadCacheFile(var_manager_cache, var_manager_file) != SUCCESS) {
+    GELOGW("Fail to load cache file: %s", var_manager_cache.c_str());
     return false;
   }
-  if (!IsVarManagerSameAsCache(var_manager_json)) {
+  if (!IsVarManagerSameAsCache(var_manager_file)) {
     GELOGI("Graph id[%u] cache miss: the VarManager does not match the cache info.", graph_id_);
     return false;
   }
@@ -250,7 +252,7 @@ Status ModelCacheHelper::RecoverVarManagerFromCache() const {
   string var_manager_cache =
     to_string(graph_id_) + "_" + to_string(graph_id_run_times_[graph_id_]) + kAfterVarManagerSuffix;
   Json var_manager_json;
-  if (LoadJsonFromFile(var_manager_cache, var_manager_json) != SUCCESS) {
+  if (LoadJsonFromFile(var_manager_cache, {kMemResourceMap, kVarResource}, var_manager_json) != SUCCESS) {
     GELOGW("Fail to load json from cache file: %s", var_manager_cache.c_str());
     return FAILED;
   }
@@ -291,7 +293,8 @@ Status ModelCacheHelper::RecoverVarManagerFromCache() const {
   return SUCCESS;
 }
 
-Status ModelCacheHelper::GetNodesNeedRecompile(ComputeGraphPtr &graph, vector<NodePtr> &nodes) {
+Status ModelCacheHelper::GetNodesNeedRecompile(ComputeGraphPtr &graph, const TBEKernelStore &tbe_kernel_store,
+                                               vector<NodePtr> &nodes) {
   std::shared_ptr<GELib> instance = ge::GELib::GetInstance();
   if (instance == nullptr || !instance->InitFlag()) {
     GELOGW("RecompileNodes failed.");
@@ -317,6 +320,12 @@ Status ModelCacheHelper::GetNodesNeedRecompile(ComputeGraphPtr &graph, vector<No
         continue;
       }
     }
+    // Node hash matches the cache, so only aicore ops whose kernel is missing in the cached model need compiling
+    if (kernel_lib_name != kTbeKernelInfoStoreName || tbe_kernel_store.FindTBEKernel(op_desc->GetName()) != nullptr) {
+      continue;
+    }
+    GELOGD("Node %s needs recompiling.", node->GetName().c_str());
+    nodes.emplace_back(node);
   }
   return SUCCESS;
 }
@@ -336,7 +345,7 @@ Status ModelCacheHelper::RecompileNodes(GeModelPtr &ge_model) {
 
   auto compute_graph = GraphUtils::GetComputeGraph(ge_model->GetGraph());
   vector<NodePtr> node_vec;
-  auto ret = GetNodesNeedRecompile(compute_graph, node_vec);
+  auto ret = GetNodesNeedRecompile(compute_graph, ge_model->GetTBEKernelStore(), node_vec);
   GE_CHK_BOOL_EXEC_WARN(ret == ge::SUCCESS, return ret, "Get nodes need recompiling failed");
   // Recompile aicore ops
   ret = kernel_info->CompileOp(node_vec);
@@ -364,74 +373,13 @@ Status ModelCacheHelper::RecompileNodes(GeModelPtr &ge_model) {
   return SUCCESS;
 }
 
-Status ModelCacheHelper::GetNodesHash(map<std::string, size_t> &hash_map) const {
-  vector<NodePtr> nodes;
-  GraphUtils::TopologicalSortingByName(compute_graph_, nodes);
-  ModelSerializeImp model_serialize_imp;
-  std::hash<string> node_hash;
-  for (const auto &node : nodes) {
-    if (node == nullptr) {
-      continue;
-    }
-    proto::OpDef op_def;
-    bool is_framework_op = (node->GetType() == FRAMEWORKOP);
-    int32_t framework_type = 0;
-    if (is_framework_op) {
-      AttrUtils::GetInt(node->GetOpDesc(), ge::ATTR_NAME_FRAMEWORK_FWK_TYPE, framework_type);
-      AttrUtils::SetInt(node->GetOpDesc(), ge::ATTR_NAME_FRAMEWORK_FWK_TYPE, 0);
-    }
-    bool ret = model_serialize_imp.SerializeNode(node, &op_def, is_framework_op);
-    op_def.set_id(0);  // Id of op is not stable because of parallel parsing
-    // Clear weights attr in constant.
-    auto attr = op_def.mutable_attr();
-    if (op_def.type() == CONSTANT || op_def.type() == CONSTANTOP) {
-      attr->erase(ATTR_NAME_WEIGHTS);
-    }
-    if (is_framework_op) {
-      AttrUtils::SetInt(node->GetOpDesc(), ge::ATTR_NAME_FRAMEWORK_FWK_TYPE, framework_type);
-    }
-    if (!ret) {
-      GELOGW("Fail to serialize node[%s].", node->GetName().c_str());
-      return INTERNAL_ERROR;
-    }
-    string prototxt;
-    ret = google::protobuf::TextFormat::PrintToString(op_def, &prototxt);
-    if (!ret) {
-      GELOGW("Print OpDef to string failed.");
-      hash_map.clear();
-      return INTERNAL_ERROR;
-    }
-    size_t hash_code = node_hash(prototxt);
-    hash_map[node->GetName()] = hash_code;
-  }
-  return SUCCESS;
-}
-
-Status ModelCacheHelper::GetComputeGraphHash(size_t &hash) const {
-  proto::GraphDef graph_proto;
-  ModelSerializeImp model_serialize_imp;
-  // The name of compute graph may be generated randomly, so replace it temporarily.
-  const string origin_name = compute_graph_->GetName();
-  compute_graph_->SetName(kGraphName);
-  bool serialize_ret = model_serialize_imp.SerializeGraph(compute_graph_, &graph_proto);
-  graph_proto.clear_op();
-  if (!serialize_ret) {
-    GELOGW("Serialize graph failed.");
-    hash = 0;
-    return INTERNAL_ERROR;
-  }
-  compute_graph_->SetName(origin_name);
-  // Generate proto text of GraphDef
-  string prototxt;
-  bool print_ret = google::protobuf::TextFormat::PrintToString(graph_proto, &prototxt);
-  if (!print_ret) {
-    GELOGW("Print GraphDef to string failed.");
-    hash = 0;
+Status ModelCacheHelper::GetComputeGraphHash(HashCode128 &hash, map<std::string, HashCode128> &nodes_hash) const {
+  // Hash the structure of graph directly, without serializing graph and nodes to proto text.
+  if (GraphHasher::HashGraph(compute_graph_, nodes_hash, hash) != GRAPH_SUCCESS) {
+    GELOGW("Hash graph failed.");
+    nodes_hash.clear();
     return INTERNAL_ERROR;
   }
-  // Get the hash code of proto text
-  std::hash<string> graph_hash;
-  hash = graph_hash(prototxt);
   return SUCCESS;
 }
 
@@ -447,34 +395,30 @@ Status ModelCacheHelper::SaveJsonToFile(const string &file_name, const Json &jso
     return FAILED;
   }
   const string path = cache_path_ + file_name;
-  const int FILE_AUTHORITY = 0600;
-  int fd = open(path.c_str(), O_WRONLY | O_CREAT | O_TRUNC, FILE_AUTHORITY);
-  if (fd < 0) {
-    GELOGW("Fail to open the file: %s.", path.c_str());
-    return INTERNAL_ERROR;
-  }
-  if (close(fd) != 0) {
-    GELOGW("Fail to close the file: %s.", path.c_str());
-    return INTERNAL_ERROR;
+  auto ret = ModelCacheFile::Save(path, json);
+  if (ret != SUCCESS) {
+    GELOGW("Fail to save cache file: %s.", path.c_str());
+    return ret;
   }
 
-  // Write json into cache file
+  const char *json_export = std::getenv(kEnvCacheJsonExport);
+  if (json_export == nullptr || string(json_export) != "1") {
+    return SUCCESS;
+  }
+  // Json is only for debugging, it is never loaded
+  const string json_path = path + kJsonExportSuffix;
   ofstream ofs;
-  ofs.open(path);
+  ofs.open(json_path);
   if (!ofs.is_open()) {
-    GELOGW("Fail to open the file: %s.", path.c_str());
-    return INTERNAL_ERROR;
+    GELOGW("Fail to open the file: %s.", json_path.c_str());
+    return SUCCESS;
   }
-  ofs << json << std::endl;
+  ofs << json.dump(2) << std::endl;
   ofs.close();
   return SUCCESS;
 }
 
-Status ModelCacheHelper::LoadJsonFromFile(const string &file_name, Json &json) const {
-  if (!json.is_null()) {
-    GELOGW("Input param json type should be null.");
-    return PARAM_INVALID;
-  }
+Status ModelCacheHelper::LoadCacheFile(const string &file_name, ModelCacheFile &cache_file) const {
   string real_path = RealPath(cache_path_.c_str());
   if (real_path.empty()) {
     GELOGW("File path is invalid. please check cache path: %s", cache_path_.c_str());
@@ -490,24 +434,31 @@ Status ModelCacheHelper::LoadJsonFromFile(const string &file_name, Json &json) c
     GELOGI("File[%s] is not found.", path.c_str());
     return FAILED;
   }
-  // Read json from cache file
-  ifstream ifs;
-  ifs.open(path);
-  if (!ifs.is_open()) {
-    GELOGW("Fail to open the file: %s.", path.c_str());
-    return INTERNAL_ERROR;
+  return cache_file.Load(cache_real_path);
+}
+
+Status ModelCacheHelper::LoadJsonFromFile(const string &file_name, const vector<string> &section_names,
+                                          Json &json) const {
+  if (!json.is_null()) {
+    GELOGW("Input param json type should be null.");
+    return PARAM_INVALID;
   }
-  ifs >> json;
-  if (!json.is_object()) {
-    GELOGW("Fail to load the json file: %s.", path.c_str());
-    return INTERNAL_ERROR;
+  ModelCacheFile cache_file;
+  auto ret = LoadCacheFile(file_name, cache_file);
+  if (ret != SUCCESS) {
+    return ret;
+  }
+  ret = cache_file.GetSections(section_names, json);
+  if (ret != SUCCESS) {
+    GELOGW("Fail to load the cache file: %s.", file_name.c_str());
+    return ret;
   }
   return SUCCESS;
 }
 
 Status ModelCacheHelper::SaveCacheInfoToCache() const {
-  // Generate cache json
-  // example: {"edgeNum":6,"nodeNum":7,"graphCache":134714827475991356}
+  // Generate cache json, each item is saved as a section of the binary manifest
+  // example: {"edgeNum":6,"nodeNum":7,"graphHash":"4a3b4e945f23f492cadacd403b83716c","nodeHash":[...]}
   Json cache_json;
   try {
     cache_json[kNodeNum] = compute_graph_->GetDirectNodesSize();
@@ -518,15 +469,16 @@ Status ModelCacheHelper::SaveCacheInfoToCache() const {
       }
     }
     cache_json[kEdgeNum] = edge_num;
-    size_t hash = 0;
-    auto ret = GetComputeGraphHash(hash);
+    HashCode128 hash;
+    map<std::string, HashCode128> nodes_hash;
+    auto ret = GetComputeGraphHash(hash, nodes_hash);
     if (ret != SUCCESS) {
       GELOGW("Error occur when generate graph hash code.");
       return ret;
     }
-    cache_json[kGraphHash] = hash;
+    cache_json[kGraphHash] = hash.ToString();
     Json nodes_hash_json;
-    ret = GetNodesHashMapJson(nodes_hash_json);
+    ret = GetNodesHashMapJson(nodes_hash, nodes_hash_json);
     if (ret != SUCCESS) {
       GELOGW("Error occur when generate nodes hash code.");
       return ret;
@@ -548,29 +500,44 @@ Status ModelCacheHelper::SaveCacheInfoToCache() const {
 
 Status ModelCacheHelper::GetCacheInfo(CacheInfo &cache_info) const {
   string cache_manifest = to_string(graph_id_) + "_" + to_string(graph_id_run_times_[graph_id_]) + kManifestSuffix;
-  Json cache_json;
-  if (LoadJsonFromFile(cache_manifest, cache_json) != SUCCESS) {
-    GELOGW("Fail to load json from cache file: %s", cache_manifest.c_str());
+  ModelCacheFile cache_file;
+  if (LoadCacheFile(cache_manifest, cache_file) != SUCCESS) {
+    GELOGW("Fail to load cache file: %s", cache_manifest.c_str());
     return INTERNAL_ERROR;
   }
-  if (!cache_json.is_object()) {
-    GELOGW("Manifest should be a json object");
+  // Each item of manifest is a section, decode them one by one
+  Json node_num_json;
+  Json edge_num_json;
+  Json graph_hash_json;
+  Json nodes_hash_json;
+  if (cache_file.GetSection(kNodeNum, node_num_json) != SUCCESS ||
+      cache_file.GetSection(kEdgeNum, edge_num_json) != SUCCESS ||
+      cache_file.GetSection(kGraphHash, graph_hash_json) != SUCCESS ||
+      cache_file.GetSection(kNodeHash, nodes_hash_json) != SUCCESS) {
+    GELOGW("Manifest is incomplete: %s", cache_manifest.c_str());
     return INTERNAL_ERROR;
   }
   try {
-    cache_info.node_num = cache_json[kNodeNum];
-    cache_info.edge_num = cache_json[kEdgeNum];
-    cache_info.graph_hash = cache_json[kGraphHash];
-    Json nodes_hash_json = cache_json[kNodeHash];
+    cache_info.node_num = node_num_json.get<size_t>();
+    cache_info.edge_num = edge_num_json.get<size_t>();
+    if (!HashCode128::FromString(graph_hash_json.get<std::string>(), cache_info.graph_hash)) {
+      GELOGW("Invalid graph hash in cache.");
+      return FAILED;
+    }
     if (!(nodes_hash_json.is_null() || nodes_hash_json.is_array())) {
       GELOGW("Nodes hash in cache should be null or array.");
       return FAILED;
     }
     for (const auto &iter : nodes_hash_json) {
-      cache_info.nodes_hash[iter[kName].get<std::string>()] = iter[kHash].get<size_t>();
+      HashCode128 node_hash;
+      if (!HashCode128::FromString(iter[kHash].get<std::string>(), node_hash)) {
+        GELOGW("Invalid node hash in cache.");
+        return FAILED;
+      }
+      cache_info.nodes_hash[iter[kName].get<std::string>()] = node_hash;
     }
   } catch (const std::exception &e) {
-    GELOGW("Fail to get info from json file. Error message: %s", e.what());
+    GELOGW("Fail to get info from cache file. Error message: %s", e.what());
     return INTERNAL_ERROR;
   }
   return SUCCESS;
@@ -603,9 +570,8 @@ bool ModelCacheHelper::IsAllocatedGraphIdSameAsCache(Json &json) const {
   return true;
 }
 
-bool ModelCacheHelper::IsNodeHashSameAsCache(const map<std::string, size_t> &hash_map) const {
-  map<std::string, size_t> cur_hash_map;
-  GetNodesHash(cur_hash_map);
+bool ModelCacheHelper::IsNodeHashSameAsCache(const map<std::string, HashCode128> &hash_map,
+                                             const map<std::string, HashCode128> &cur_hash_map) const {
   if (hash_map.size() != cur_hash_map.size()) {
     GELOGI("The number of hash code is different from cache info.");
     return false;
@@ -846,16 +812,24 @@ bool ModelCacheHelper::IsVarManagerParamSameAsCache(Json &json) const {
   return true;
 }
 
-bool ModelCacheHelper::IsVarManagerSameAsCache(Json &json) const {
-  if (!json.is_object()) {
-    GELOGW("Input param json type should be object.");
+bool ModelCacheHelper::IsVarManagerSameAsCache(const ModelCacheFile &cache_file) const {
+  // Params are small, check them first so that a miss never decodes the resource sections
+  Json json;
+  if (cache_file.GetSections({kSessionId, kDeviceId, kJobId, kGraphMemMaxSize, kVarMemMaxSize, kVarMemLogicBase,
+                              kUseMaxMemSize},
+                             json) != SUCCESS) {
+    GELOGW("Check VarManager cache failed.[Param sections]");
+    return false;
+  }
+  if (!IsVarManagerParamSameAsCache(json)) {
+    GELOGW("Check VarManager cache failed.[Param]");
+    return false;
+  }
+  if (cache_file.GetSections({kMemResourceMap, kVarResource}, json) != SUCCESS) {
+    GELOGW("Check VarManager cache failed.[Resource sections]");
     return false;
   }
   try {
-    if (!IsVarManagerParamSameAsCache(json)) {
-      GELOGW("Check VarManager cache failed.[Param]");
-      return false;
-    }
     Json mem_resource_json = move(json[kMemResourceMap]);
     auto ret = IsMemResourceSameAsCache(mem_resource_json);
     if (!ret) {
@@ -1097,18 +1071,16 @@ Status ModelCacheHelper::JsonToTensorDesc(const Json &json, ge::GeTensorDesc &ge
   return SUCCESS;
 }
 
-Status ModelCacheHelper::GetNodesHashMapJson(Json &json) const {
+Status ModelCacheHelper::GetNodesHashMapJson(const map<std::string, HashCode128> &hash_map, Json &json) const {
   if (!(json.is_null() || json.is_array())) {
     GELOGW("Input param json type should be null or array.");
     return PARAM_INVALID;
   }
-  map<std::string, size_t> hash_map;
-  GetNodesHash(hash_map);
   for (const auto &iter : hash_map) {
     Json node_hash_json;
     try {
       node_hash_json[kName] = iter.first;
-      node_hash_json[kHash] = iter.second;
+      node_hash_json[kHash] = iter.second.ToString();
       json.emplace_back(move(node_hash_json));
     } catch (const std::exception &e) {
       GELOGW("Fail to trans node cache to json. Error message: %s", e.what());
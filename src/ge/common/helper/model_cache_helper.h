@@ -17,24 +17,23 @@
 #ifndef GE_COMMON_HELPER_MODEL_CACHE_HELPER_H_
 #define GE_COMMON_HELPER_MODEL_CACHE_HELPER_H_
 
-#include <nlohmann/json.hpp>
 #include <set>
 #include <string>
 
+#include "common/helper/model_cache_file.h"
 #include "ge/ge_api_error_codes.h"
+#include "graph/common/graph_hasher.h"
 #include "graph/compute_graph.h"
 #include "graph/manager/graph_var_manager.h"
 #include "model/ge_model.h"
 
 namespace ge {
-using Json = nlohmann::json;
-
 struct CacheInfo {
   size_t node_num;
   size_t edge_num;
-  size_t graph_hash;
-  map<std::string, size_t> nodes_hash;
-  CacheInfo() : node_num(0), edge_num(0), graph_hash(0) {}
+  HashCode128 graph_hash;
+  map<std::string, HashCode128> nodes_hash;
+  CacheInfo() : node_num(0), edge_num(0) {}
 };
 
 class ModelCacheHelper {
@@ -52,8 +51,7 @@ class ModelCacheHelper {
   Status ClearCache(uint32_t graph_id) const;
 
  private:
-  Status GetComputeGraphHash(size_t &hash) const;
-  Status GetNodesHash(map<std::string, size_t> &hash_map) const;
+  Status GetComputeGraphHash(HashCode128 &hash, map<std::string, HashCode128> &nodes_hash) const;
   Status GetCacheInfo(CacheInfo &cache_info) const;
 
   Status RecoverMemResource(const Json &json) const;
@@ -62,10 +60,12 @@ class ModelCacheHelper {
   Status RecoverVarAddrAndTensorDesc(const Json &json) const;
   Status RecoverBroadcastInfo(const Json &json) const;
   Status RecoverTransRoads(const Json &json) const;
-  static Status GetNodesNeedRecompile(ComputeGraphPtr &graph, vector<NodePtr> &nodes);
+  static Status GetNodesNeedRecompile(ComputeGraphPtr &graph, const TBEKernelStore &tbe_kernel_store,
+                                      vector<NodePtr> &nodes);
   static Status RecompileNodes(GeModelPtr &ge_model);
 
-  bool IsNodeHashSameAsCache(const map<std::string, size_t> &hash_map) const;
+  bool IsNodeHashSameAsCache(const map<std::string, HashCode128> &hash_map,
+                             const map<std::string, HashCode128> &cur_hash_map) const;
   bool IsMemResourceSameAsCache(Json &json) const;
   bool IsChangedGraphIdSameAsCache(Json &json) const;
   bool IsAllocatedGraphIdSameAsCache(Json &json) const;
@@ -73,13 +73,14 @@ class ModelCacheHelper {
   bool IsVarAddrMgrMapSameAsCache(Json &json) const;
   bool IsBroadcastInfoSameAsCache(Json &json) const;
   bool IsTransRoadsSameAsCache(Json &json) const;
-  bool IsVarManagerSameAsCache(Json &json) const;
+  bool IsVarManagerSameAsCache(const ModelCacheFile &cache_file) const;
   bool IsVarManagerParamSameAsCache(Json &json) const;
 
   Status SaveJsonToFile(const string &file_name, const Json &json) const;
-  Status LoadJsonFromFile(const string &file_name, Json &json) const;
+  Status LoadJsonFromFile(const string &file_name, const vector<string> &section_names, Json &json) const;
+  Status LoadCacheFile(const string &file_name, ModelCacheFile &cache_file) const;
 
-  Status GetNodesHashMapJson(Json &json) const;
+  Status GetNodesHashMapJson(const map<std::string, HashCode128> &hash_map, Json &json) const;
   Status GetMemResourceMap(Json &json) const;
   Status GetVarAddrMgrMapJson(Json &json) const;
   Status GetCurVarTensorDescMapJson(Json &json) const;
@@ -239,6 +239,15 @@ ModelHelper::SaveOriginalGraphToOmModel(const ge::Graph &graph, const std::strin
   return (ret == SUCCESS ? SUCCESS : FAILED);
 }
 
+FMK_FUNC_HOST_VISIBILITY FMK_FUNC_DEV_VISIBILITY Status
+ModelHelper::LoadModel(const ge::ModelData &model_data, const std::shared_ptr<void> &model_data_owner) {
+  model_data_owner_ = model_data_owner;
+  Status ret = LoadModel(model_data);
+  // weights and kernels which refer to model_data hold the owner from now on
+  model_data_owner_ = nullptr;
+  return ret;
+}
+
 FMK_FUNC_HOST_VISIBILITY FMK_FUNC_DEV_VISIBILITY Status ModelHelper::LoadModel(const ge::ModelData &model_data) {
   if (model_data.model_data == nullptr || model_data.model_len == 0) {
     GELOGE(GE_EXEC_MODEL_DATA_SIZE_INVALID, "Model_data is nullptr, or model_data_size is 0");
@@ -342,8 +351,12 @@ Status ModelHelper::LoadWeights(OmFileLoadHelper &om_load_helper) {
     GELOGE(FAILED, "Get weight model partition failed.");
     return FAILED;
   }
-  ge::Buffer weight = ge::Buffer::CopyFrom(partition.data, partition.size);
-  model_->SetWeight(weight);
+  if (model_data_owner_ != nullptr) {
+    model_->SetWeightDataBuf(partition.data, partition.size, model_data_owner_);
+  } else {
+    ge::Buffer weight = ge::Buffer::CopyFrom(partition.data, partition.size);
+    model_->SetWeight(weight);
+  }
 
   GELOGI("GetWeight size:%u", partition.size);
   return SUCCESS;
@@ -374,7 +387,7 @@ Status ModelHelper::LoadTBEKernelStore(OmFileLoadHelper &om_load_helper) {
   TBEKernelStore kernel_store;
   if (om_load_helper.GetModelPartition(ModelPartitionType::TBE_KERNELS, partition_kernel_def) == SUCCESS) {
     GELOGI("Kernels partition size:%u", partition_kernel_def.size);
-    if (kernel_store.Load(partition_kernel_def.data, partition_kernel_def.size)) {
+    if (kernel_store.Load(partition_kernel_def.data, partition_kernel_def.size, model_data_owner_)) {
       GELOGI("Load tbe kernels success");
     } else {
       GELOGW("Load tbe kernels failed");
@@ -16,8 +16,13 @@
 
 #include "common/model_parser/base.h"
 #include "common/helper/model_helper.h"
+#include <errno.h>
+#include <fcntl.h>
 #include <securec.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
 #include <sys/sysinfo.h>
+#include <unistd.h>
 #include <fstream>
 #include <memory>
 #include <string>
@@ -73,6 +78,48 @@ FMK_FUNC_HOST_VISIBILITY FMK_FUNC_DEV_VISIBILITY Status ModelParserBase::LoadFro
   return SUCCESS;
 }
 
+FMK_FUNC_HOST_VISIBILITY FMK_FUNC_DEV_VISIBILITY Status ModelParserBase::MapFromFile(const char *model_path,
+                                                                                     const char *key, int32_t priority,
+                                                                                     ge::ModelData &model_data,
+                                                                                     std::shared_ptr<void> &mapped_file) {
+  std::string real_path = RealPath(model_path);
+  if (real_path.empty()) {
+    GELOGE(GE_EXEC_MODEL_PATH_INVALID, "Model file path '%s' is invalid", model_path);
+    return GE_EXEC_MODEL_PATH_INVALID;
+  }
+
+  int fd = open(real_path.c_str(), O_RDONLY);
+  GE_CHK_BOOL_RET_STATUS(fd >= 0, GE_EXEC_READ_MODEL_FILE_FAILED, "Open file failed! path:%s", model_path);
+  struct stat file_stat;
+  if (fstat(fd, &file_stat) != 0 || file_stat.st_size < 1 || file_stat.st_size > UINT32_MAX) {
+    GELOGE(GE_EXEC_READ_MODEL_FILE_FAILED, "File size not valid, path:%s", model_path);
+    (void)close(fd);
+    return GE_EXEC_READ_MODEL_FILE_FAILED;
+  }
+  size_t len = static_cast<size_t>(file_stat.st_size);
+
+  // private writable mapping, in case model data is modified in place, which must not reach the file
+  void *data = mmap(nullptr, len, PROT_READ | PROT_WRITE, MAP_PRIVATE, fd, 0);
+  (void)close(fd);
+  if (data == MAP_FAILED) {
+    GELOGE(GE_EXEC_READ_MODEL_FILE_FAILED, "Map file failed, path:%s, errno:%d", model_path, errno);
+    return GE_EXEC_READ_MODEL_FILE_FAILED;
+  }
+  // weights are copied to device from begin to end
+  (void)madvise(data, len, MADV_SEQUENTIAL);
+  mapped_file = std::shared_ptr<void>(data, [len](void *addr) { (void)munmap(addr, len); });
+
+  ModelHelper model_helper;
+  model_helper.GetBaseNameFromFileName(model_path, model_data.om_name);
+  // Set the model data parameter
+  model_data.model_data = data;
+  model_data.model_len = static_cast<uint32_t>(len);
+  model_data.priority = priority;
+  model_data.key = (key == nullptr) ? "" : key;
+
+  return SUCCESS;
+}
+
 FMK_FUNC_HOST_VISIBILITY FMK_FUNC_DEV_VISIBILITY Status ModelParserBase::ParseModelContent(const ge::ModelData &model,
                                                                                            uint8_t *&model_data,
                                                                                            uint32_t &model_len) {
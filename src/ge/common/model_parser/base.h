@@ -51,6 +51,19 @@ class ModelParserBase {
   static Status LoadFromFile(const char *model_file, const char *model_key, int32_t priority,
                              ge::ModelData &model_data);
 
+  /**
+   * @ingroup hiai
+   * @brief Map a model file instead of reading it, so that partitions can refer to it in place
+   * @param [in] model_file  model path
+   * @param [in] model_key   model secret key
+   * @param [in] priority    modle priority
+   * @param [out] model_data model data, valid as long as mapped_file is held
+   * @param [out] mapped_file owner of the mapping, which unmaps the file when released
+   * @return Status  result
+   */
+  static Status MapFromFile(const char *model_file, const char *model_key, int32_t priority,
+                            ge::ModelData &model_data, std::shared_ptr<void> &mapped_file);
+
   /**
    * @ingroup domi_ome
    * @brief Parse model contents from the ModelData
@@ -90,7 +90,7 @@ const uint8_t *TBEKernelStore::Data() const { return buffer_.data(); }
 
 size_t TBEKernelStore::DataSize() const { return buffer_.size(); }
 
-bool TBEKernelStore::Load(const uint8_t *data, const size_t &len) {
+bool TBEKernelStore::Load(const uint8_t *data, const size_t &len, const std::shared_ptr<void> &data_owner) {
   if (data == nullptr || len == 0) {
     return false;
   }
@@ -110,8 +110,13 @@ bool TBEKernelStore::Load(const uint8_t *data, const size_t &len) {
 
     next_buffer += kernel_head->name_len;
     GELOGI("Load kernel from om:%s,%u,%u", name.c_str(), kernel_head->name_len, kernel_head->bin_len);
-    std::vector<char> kernel_bin(next_buffer, next_buffer + kernel_head->bin_len);
-    TBEKernelPtr teb_kernel_ptr = ge::MakeShared<TBEKernel>(name, std::move(kernel_bin));
+    TBEKernelPtr teb_kernel_ptr;
+    if (data_owner != nullptr) {
+      teb_kernel_ptr = ge::MakeShared<TBEKernel>(name, next_buffer, kernel_head->bin_len, data_owner);
+    } else {
+      std::vector<char> kernel_bin(next_buffer, next_buffer + kernel_head->bin_len);
+      teb_kernel_ptr = ge::MakeShared<TBEKernel>(name, std::move(kernel_bin));
+    }
     if (teb_kernel_ptr != nullptr) {
       kernels_.emplace(name, teb_kernel_ptr);
     }
@@ -38,7 +38,8 @@ class FMK_FUNC_HOST_VISIBILITY FMK_FUNC_DEV_VISIBILITY TBEKernelStore {
   void AddTBEKernel(const TBEKernelPtr &kernel);
   bool Build();
 
-  bool Load(const uint8_t *data, const size_t &len);
+  // kernels refer to data in place if data_owner is set, otherwise they are copied
+  bool Load(const uint8_t *data, const size_t &len, const std::shared_ptr<void> &data_owner = nullptr);
   TBEKernelPtr FindTBEKernel(const std::string &name) const;
 
   void LoadTBEKernelBinToOpDesc(const std::shared_ptr<ge::OpDesc> &op_desc) const;
@@ -26,6 +26,7 @@ local_ge_executor_src_files :=  \
     ../graph/load/new_model_manager/data_inputer.cc \
     ../graph/load/new_model_manager/data_dumper.cc \
     ../graph/load/new_model_manager/zero_copy_task.cc \
+    ../graph/load/new_model_manager/zero_copy_args_arena.cc \
     ../graph/load/new_model_manager/zero_copy_offset.cc \
     ../graph/load/new_model_manager/task_info/task_info.cc                  \
     ../graph/load/new_model_manager/task_info/event_record_task_info.cc     \
@@ -26,6 +26,7 @@ COMMON_LOCAL_SRC_FILES := \
     common/formats/format_transfers/format_transfer_nchw_fz_c04.cc \
     common/formats/formats.cc \
     common/profiling/profiling_manager.cc \
+    common/helper/model_cache_file.cc \
     common/helper/model_cache_helper.cc \
     ge_local_engine/engine/host_cpu_engine.cc \
 
@@ -65,6 +66,7 @@ BUILER_SRC_FILES := \
 OMG_HOST_SRC_FILES := \
     model/ge_model.cc \
     model/ge_root_model.cc \
+    graph/common/graph_hasher.cc \
     graph/common/transop_util.cc \
     graph/passes/pass_manager.cc \
     graph/passes/resource_pair_add_control_pass.cc \
@@ -210,6 +212,7 @@ OME_HOST_SRC_FILES := \
     graph/load/new_model_manager/tbe_handle_store.cc                     \
     graph/load/new_model_manager/cpu_queue_schedule.cc                   \
     graph/load/new_model_manager/zero_copy_task.cc                       \
+    graph/load/new_model_manager/zero_copy_args_arena.cc                 \
     graph/load/new_model_manager/zero_copy_offset.cc                     \
     graph/load/new_model_manager/data_dumper.cc                          \
     graph/load/new_model_manager/task_info/task_info.cc                  \
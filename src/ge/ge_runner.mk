@@ -24,6 +24,7 @@ LIBGE_LOCAL_SRC_FILES := \
     common/fp16_t.cc \
     common/ge/plugin_manager.cc\
     common/ge/op_tiling_manager.cc\
+    common/helper/model_cache_file.cc \
     common/helper/model_cache_helper.cc \
     common/profiling/profiling_manager.cc \
     engine_manager/dnnengine_manager.cc \
@@ -39,6 +40,7 @@ LIBGE_LOCAL_SRC_FILES := \
     graph/build/stream_graph_optimizer.cc \
     graph/build/task_generator.cc \
     graph/common/bcast.cc \
+    graph/common/graph_hasher.cc \
     graph/common/omg_util.cc \
     graph/common/transop_util.cc \
     graph/execute/graph_execute.cc \
@@ -78,6 +80,7 @@ LIBGE_LOCAL_SRC_FILES := \
     graph/load/new_model_manager/task_info/task_info.cc \
     graph/load/new_model_manager/tbe_handle_store.cc \
     graph/load/new_model_manager/zero_copy_task.cc \
+    graph/load/new_model_manager/zero_copy_args_arena.cc \
     graph/load/new_model_manager/zero_copy_offset.cc    \
     graph/manager/graph_context.cc \
     graph/manager/graph_manager.cc \
@@ -254,8 +257,10 @@ LIBGE_LOCAL_SRC_FILES := \
     hybrid/executor/subgraph_context.cc                                  \
     hybrid/executor/subgraph_executor.cc                                 \
     hybrid/executor/worker/task_compile_engine.cc                        \
+    hybrid/executor/worker/task_compile_cache.cc                         \
     hybrid/executor/worker/shape_inference_engine.cc                     \
     hybrid/executor/worker/execution_engine.cc                           \
+    hybrid/executor/worker/work_stealing_pool.cc                         \
     hybrid/model/hybrid_model.cc                                         \
     hybrid/model/hybrid_model_builder.cc                                 \
     hybrid/model/node_item.cc                                            \
@@ -265,45 +265,42 @@ void AddDependLife(const ge::NodePtr &org_node, const ge::NodePtr &node, int64_t
   GE_CHECK_NOTNULL_EXEC(node_desc, return );
   auto node_id = node_desc->GetId();
   auto stream_life = total_node_depend_stream_life.find(node_id);
-  if (stream_life != total_node_depend_stream_life.end()) {
-    for (auto &it : stream_life->second) {
-      if (depend_stream_life.find(it.first) == depend_stream_life.end()) {
-        depend_stream_life[it.first] = it.second;
-      }
-    }
-    return;
-  }
-
-  for (const auto &in_anchor : node->GetAllInAnchors()) {
-    GE_CHECK_NOTNULL_EXEC(in_anchor, continue);
-    for (auto peer_out_anchor : in_anchor->GetPeerAnchors()) {
-      GE_CHECK_NOTNULL_EXEC(peer_out_anchor, continue);
-      auto peer_node = peer_out_anchor->GetOwnerNode();
-      GE_CHECK_NOTNULL_EXEC(peer_node, continue);
-      auto peer_node_desc = peer_node->GetOpDesc();
-      GE_CHECK_NOTNULL_EXEC(peer_node_desc, continue);
-      auto peer_node_stream_id = peer_node_desc->GetStreamId();
-      if (peer_node_stream_id < 0) {
-        continue;
-      }
-      size_t peer_node_life_time = peer_node_desc->GetId();
-      auto it = depend_stream_life.find(peer_node_stream_id);
-      if (it == depend_stream_life.end() || peer_node_life_time > it->second) {
-        depend_stream_life[peer_node_stream_id] = peer_node_life_time;
-        if (peer_node_stream_id != stream_id) {
-          GELOGI("Node:%s stream id:%ld depend node:%s stream id:%ld index[%d] life time[%zu].",
-                 org_node->GetName().c_str(), stream_id, peer_node_desc->GetName().c_str(), peer_node_stream_id,
-                 peer_out_anchor->GetIdx(), peer_node_life_time);
+  if (stream_life == total_node_depend_stream_life.end()) {
+    // depends of the node itself only, the ones of org_node found in other inputs must not be saved on it
+    std::map<int64_t, size_t> node_depend_stream_life;
+    for (const auto &in_anchor : node->GetAllInAnchors()) {
+      GE_CHECK_NOTNULL_EXEC(in_anchor, continue);
+      for (auto peer_out_anchor : in_anchor->GetPeerAnchors()) {
+        GE_CHECK_NOTNULL_EXEC(peer_out_anchor, continue);
+        auto peer_node = peer_out_anchor->GetOwnerNode();
+        GE_CHECK_NOTNULL_EXEC(peer_node, continue);
+        auto peer_node_desc = peer_node->GetOpDesc();
+        GE_CHECK_NOTNULL_EXEC(peer_node_desc, continue);
+        auto peer_node_stream_id = peer_node_desc->GetStreamId();
+        if (peer_node_stream_id < 0) {
+          continue;
+        }
+        size_t peer_node_life_time = peer_node_desc->GetId();
+        auto it = node_depend_stream_life.find(peer_node_stream_id);
+        if (it == node_depend_stream_life.end() || peer_node_life_time > it->second) {
+          node_depend_stream_life[peer_node_stream_id] = peer_node_life_time;
+          if (peer_node_stream_id != stream_id) {
+            GELOGI("Node:%s stream id:%ld depend node:%s stream id:%ld index[%d] life time[%zu].",
+                   org_node->GetName().c_str(), stream_id, peer_node_desc->GetName().c_str(), peer_node_stream_id,
+                   peer_out_anchor->GetIdx(), peer_node_life_time);
+          }
         }
-        AddDependLife(org_node, peer_node, stream_id, depend_stream_life, total_node_depend_stream_life);
+        AddDependLife(org_node, peer_node, stream_id, node_depend_stream_life, total_node_depend_stream_life);
       }
     }
+    // save on node to save next calculation
+    stream_life = total_node_depend_stream_life.emplace(node_id, std::move(node_depend_stream_life)).first;
   }
 
-  // save on node to save next calculation
-  for (auto &it : depend_stream_life) {
-    if (total_node_depend_stream_life[node_id].find(it.first) == total_node_depend_stream_life[node_id].end()) {
-      total_node_depend_stream_life[node_id][it.first] = it.second;
+  for (auto &it : stream_life->second) {
+    auto iter = depend_stream_life.find(it.first);
+    if (iter == depend_stream_life.end() || it.second > iter->second) {
+      depend_stream_life[it.first] = it.second;
     }
   }
 }
@@ -157,6 +157,19 @@ class MemoryBlock {
   std::vector<MemoryBlock *> child_blocks_;
 };
 
+///
+/// @ingroup GE
+/// @brief Get the last life time of each stream that node depends on
+/// @param [in] org_node node whose depends are searched
+/// @param [in] node current node in search
+/// @param [in] stream_id stream of org_node
+/// @param [in|out] depend_stream_life last life time of each stream, raised by the depends of node
+/// @param [in|out] total_node_depend_stream_life depends of each node searched, by its own inputs only
+/// @return void
+///
+void AddDependLife(const ge::NodePtr &org_node, const ge::NodePtr &node, int64_t stream_id,
+                   std::map<int64_t, size_t> &depend_stream_life, DependStreamLife &total_node_depend_stream_life);
+
 class BlockMemAssigner : public MemAssigner {
  public:
   explicit BlockMemAssigner(ge::ComputeGraphPtr compute_graph);
@@ -198,7 +211,18 @@ class BlockMemAssigner : public MemAssigner {
   /// @brief traverse all memory size, resize, and calculate offset
   /// @param [in&out] memory_blocks memory size, resize and calculate memory address after offset
   ///
-  void ResizeMemoryBlocks();
+  virtual void ResizeMemoryBlocks();
+
+  ///
+  /// @ingroup GE
+  /// @|+++++++++block1++++++++|                               |+++++++++block1++++++++|
+  /// @|+++++++++block1++++++++||++block2++|                   |+++++++++block1++++++++||++block2++|
+  /// @                         |++block2++||++block3++|  ==>  |++block3++|             |++block2++|
+  /// @                                     |++block3++|       |++block3++|
+  /// @return void
+  /// @author
+  ///
+  virtual void ReuseBlocksByLifeTime(size_t range_size);
 
   void GetOutAndWorkSpaceMem(std::vector<int64_t> &all_memory_size);
 
@@ -267,6 +291,8 @@ class BlockMemAssigner : public MemAssigner {
   std::map<std::string, bool> post_reuse_flag_;
   std::map<std::string, size_t> symbol_size_;
 
+  DependStreamLife total_node_depend_stream_life_;
+
  private:
   ///
   /// @ingroup GE
@@ -355,17 +381,6 @@ class BlockMemAssigner : public MemAssigner {
   bool IsOutNodeSetContinuousInput(const NodePtr &n, uint32_t out_index, std::string &peer_name,
                                    uint32_t &peer_input_index);
 
-  ///
-  /// @ingroup GE
-  /// @|+++++++++block1++++++++|                               |+++++++++block1++++++++|
-  /// @|+++++++++block1++++++++||++block2++|                   |+++++++++block1++++++++||++block2++|
-  /// @                         |++block2++||++block3++|  ==>  |++block3++|             |++block2++|
-  /// @                                     |++block3++|       |++block3++|
-  /// @return void
-  /// @author
-  ///
-  void ReuseBlocksByLifeTime(size_t range_size);
-
   bool IsContinuousOutput(const NodePtr &n);
 
   MemoryBlock *ApplyContinuousMemory(const NodePtr &n, const vector<int64_t> &ranges, const bool is_op_reuse_mem);
@@ -396,8 +411,6 @@ class BlockMemAssigner : public MemAssigner {
   size_t life_time_;
 
   int64_t atomic_addr_clean_id_ = 0;
-
-  DependStreamLife total_node_depend_stream_life_;
 };
 }  // namespace ge
 #endif  // GE_GRAPH_BUILD_MEMORY_BLOCK_MEM_ASSIGNER_H_
@@ -19,6 +19,7 @@
 #include <vector>
 #include "framework/common/debug/ge_log.h"
 #include "graph/build/memory/binary_block_mem_assigner.h"
+#include "graph/build/memory/interval_block_mem_assigner.h"
 #include "graph/build/memory/max_block_mem_assigner.h"
 
 namespace ge {
@@ -47,16 +48,25 @@ Status HybridMemAssigner::Assign() {
   std::unique_ptr<BlockMemAssigner> max_assigner(new (std::nothrow) MaxBlockMemAssigner(compute_graph_));
   GE_CHECK_NOTNULL(max_assigner);
 
+  std::unique_ptr<BlockMemAssigner> interval_assigner(new (std::nothrow) IntervalBlockMemAssigner(compute_graph_));
+  GE_CHECK_NOTNULL(interval_assigner);
+
   size_t bin_mem_size = 0;
   size_t max_mem_size = 0;
+  size_t interval_mem_size = 0;
 
   GE_CHK_STATUS_RET(AssignMemory(binary_assigner, bin_mem_size), "BinaryBlock Method AssignMemory Fail!");
   GE_CHK_STATUS_RET(AssignMemory(max_assigner, max_mem_size), "MaxBlock Method AssignMemory Fail!");
+  GE_CHK_STATUS_RET(AssignMemory(interval_assigner, interval_mem_size), "IntervalBlock Method AssignMemory Fail!");
 
   std::unique_ptr<BlockMemAssigner> priority_assigner;
 
-  GELOGI("Binary-block memory size:%zu, max-block memory size:%zu", bin_mem_size, max_mem_size);
-  if (bin_mem_size <= max_mem_size) {
+  GELOGI("Binary-block memory size:%zu, max-block memory size:%zu, interval-block memory size:%zu", bin_mem_size,
+         max_mem_size, interval_mem_size);
+  if ((interval_mem_size < bin_mem_size) && (interval_mem_size < max_mem_size)) {
+    GELOGI("Use interval-block memory assigner method");
+    priority_assigner = std::move(interval_assigner);
+  } else if (bin_mem_size <= max_mem_size) {
     GELOGI("Use binary-block memory assigner method");
     priority_assigner = std::move(binary_assigner);
   } else {
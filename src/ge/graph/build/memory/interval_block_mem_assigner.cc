@@ -0,0 +1,412 @@
+/**
+ * Copyright 2019-2020 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "graph/build/memory/interval_block_mem_assigner.h"
+#include <algorithm>
+#include <iterator>
+#include <limits>
+#include <map>
+#include "framework/common/debug/ge_log.h"
+
+namespace {
+// Several placing orders are tried and the best one is kept, as long as there are not more conflicts than this.
+const size_t kMaxSearchConflictNum = 1 << 20;
+// Life time checks of item pairs are bounded, blocks are laid out one after another on graphs needing more.
+const size_t kMaxConflictCheckNum = 1 << 24;
+
+// life time of a tensor, or of tensors sharing the memory by ref
+struct LifeSegment {
+  size_t begin = 0;
+  size_t end = 0;
+  int64_t stream_id = 0;
+  // memory of tensors released before the begin can be taken
+  bool pre_reuse = false;
+  // memory can be taken by tensors beginning after the end
+  bool post_reuse = false;
+  // the last node of each stream which has to be done before the begin
+  std::map<int64_t, size_t> depend_stream_life;
+};
+
+// blocks which must be continuous are placed together as one item
+struct PlanItem {
+  std::vector<ge::MemoryBlock *> blocks;
+  std::vector<LifeSegment> segments;
+  size_t head_size = 0;
+  size_t size = 0;
+  bool continuous = false;
+  bool before_atomic_addr_clean = false;
+};
+
+// same rule as MemoryBlock::AddLifeReuseBlock
+bool CanReuseByLifeTime(const LifeSegment &earlier, const LifeSegment &later) {
+  if (!earlier.post_reuse || !later.pre_reuse) {
+    return false;
+  }
+  if (later.stream_id == earlier.stream_id) {
+    return later.begin > earlier.end;
+  }
+  auto iter = later.depend_stream_life.find(earlier.stream_id);
+  return (iter != later.depend_stream_life.end()) && (iter->second > earlier.end);
+}
+
+bool IsConflict(const PlanItem &left, const PlanItem &right) {
+  if ((left.continuous && right.continuous) || (left.continuous && right.before_atomic_addr_clean) ||
+      (right.continuous && left.before_atomic_addr_clean)) {
+    return true;
+  }
+  for (const auto &left_segment : left.segments) {
+    for (const auto &right_segment : right.segments) {
+      if (!CanReuseByLifeTime(left_segment, right_segment) && !CanReuseByLifeTime(right_segment, left_segment)) {
+        return true;
+      }
+    }
+  }
+  return false;
+}
+
+///
+/// @brief Split life time of block by tensors reusing it
+/// @param [in] block memory block
+/// @param [in] post_reuse memory of block can be taken by others
+/// @param [in|out] total_node_depend_stream_life depends of nodes searched
+/// @param [out] segments life segments of the block
+/// @return void
+///
+void GetLifeSegments(const ge::MemoryBlock *block, bool post_reuse, ge::DependStreamLife &total_node_depend_stream_life,
+                     std::vector<LifeSegment> &segments) {
+  const auto &node_type_index_list = block->NodeTypeIndexList();
+  for (size_t i = 0; i < node_type_index_list.size(); ++i) {
+    const auto &node_type_index = node_type_index_list[i];
+    // tensors by ref share the life of the tensor applied the memory
+    if ((i == 0) || !node_type_index.ref_input) {
+      LifeSegment segment;
+      if ((node_type_index.node != nullptr) && (node_type_index.node->GetOpDesc() != nullptr)) {
+        segment.begin = static_cast<size_t>(node_type_index.node->GetOpDesc()->GetId());
+        ge::AddDependLife(node_type_index.node, node_type_index.node, block->stream_id_, segment.depend_stream_life,
+                          total_node_depend_stream_life);
+      }
+      segment.stream_id = block->stream_id_;
+      segment.pre_reuse = block->reuse_mem_;
+      segment.post_reuse = post_reuse;
+      segment.depend_stream_life[segment.stream_id] = segment.begin;
+      segments.emplace_back(std::move(segment));
+    }
+    // life time end is set on the last tensor when the memory is released
+    segments.back().end = node_type_index.life_time_end;
+  }
+}
+
+// life time hull of an item, to find the items which may be in conflict with it
+struct ItemHull {
+  size_t index = 0;
+  size_t begin = 0;
+  size_t end = 0;
+  int64_t stream_id = 0;
+  // all segments are on one stream and can give memory to others
+  bool regular = true;
+  // all segments can take memory of others
+  bool pre_reuse = true;
+};
+
+// later item can take memory of a regular earlier item of the stream ending before the min depend life
+size_t GetDependLife(const PlanItem &item, int64_t stream_id) {
+  size_t depend_life = std::numeric_limits<size_t>::max();
+  for (const auto &segment : item.segments) {
+    auto iter = segment.depend_stream_life.find(stream_id);
+    if (iter == segment.depend_stream_life.end()) {
+      return 0;
+    }
+    depend_life = std::min(depend_life, iter->second);
+  }
+  return depend_life;
+}
+
+///
+/// @brief Find items in conflict with each item by a sweep line over the life time of items.
+///        Pairs of items are only checked when they overlap in life time or can not be told apart by the hull.
+/// @param [in] items items to place
+/// @param [out] conflicts indexes of items in conflict with each item
+/// @return false if there are too many pairs to check
+///
+bool GetConflicts(const std::vector<PlanItem> &items, std::vector<std::vector<size_t>> &conflicts) {
+  conflicts.assign(items.size(), std::vector<size_t>());
+  size_t check_num = 0;
+  auto check = [&items, &conflicts, &check_num](size_t left, size_t right) {
+    ++check_num;
+    if (IsConflict(items[left], items[right])) {
+      conflicts[left].emplace_back(right);
+      conflicts[right].emplace_back(left);
+    }
+  };
+
+  // continuous items conflict with each other and with items before atomic addr clean, whatever the life time is
+  for (size_t i = 0; i < items.size(); ++i) {
+    if (!items[i].continuous) {
+      continue;
+    }
+    for (size_t j = 0; j < items.size(); ++j) {
+      if ((j != i) && (items[j].before_atomic_addr_clean || (items[j].continuous && (j > i)))) {
+        conflicts[i].emplace_back(j);
+        conflicts[j].emplace_back(i);
+      }
+    }
+    check_num += items.size();
+    if (check_num > kMaxConflictCheckNum) {
+      return false;
+    }
+  }
+
+  std::vector<ItemHull> hulls;
+  for (size_t i = 0; i < items.size(); ++i) {
+    const auto &segments = items[i].segments;
+    if (segments.empty()) {
+      continue;
+    }
+    ItemHull hull;
+    hull.index = i;
+    hull.begin = std::numeric_limits<size_t>::max();
+    hull.stream_id = segments.front().stream_id;
+    for (const auto &segment : segments) {
+      hull.begin = std::min(hull.begin, segment.begin);
+      hull.end = std::max(hull.end, segment.end);
+      hull.regular = hull.regular && segment.post_reuse && (segment.stream_id == hull.stream_id);
+      hull.pre_reuse = hull.pre_reuse && segment.pre_reuse;
+    }
+    hulls.emplace_back(std::move(hull));
+  }
+  std::stable_sort(hulls.begin(), hulls.end(),
+                   [](const ItemHull &left, const ItemHull &right) { return left.begin < right.begin; });
+
+  // heap of items alive at the begin of current item, the one ending first on top
+  std::vector<size_t> alive;
+  auto end_later = [&hulls](size_t left, size_t right) { return hulls[left].end > hulls[right].end; };
+  // items ended before the begin of current item, regular ones are kept by stream in order of end
+  std::map<int64_t, std::vector<std::pair<size_t, size_t>>> ended_by_stream;
+  std::vector<size_t> ended_irregular;
+  for (size_t i = 0; i < hulls.size(); ++i) {
+    const ItemHull &hull = hulls[i];
+    while (!alive.empty() && (hulls[alive.front()].end < hull.begin)) {
+      std::pop_heap(alive.begin(), alive.end(), end_later);
+      const ItemHull &ended = hulls[alive.back()];
+      alive.pop_back();
+      if (ended.regular) {
+        ended_by_stream[ended.stream_id].emplace_back(ended.end, ended.index);
+      } else {
+        ended_irregular.emplace_back(ended.index);
+      }
+    }
+
+    for (auto alive_index : alive) {
+      check(hull.index, hulls[alive_index].index);
+    }
+    for (auto ended_index : ended_irregular) {
+      check(hull.index, ended_index);
+    }
+    for (const auto &stream_ended : ended_by_stream) {
+      // items ending before the depend life can give memory to every segment of current item
+      size_t depend_life = hull.pre_reuse ? GetDependLife(items[hull.index], stream_ended.first) : 0;
+      auto iter = std::lower_bound(stream_ended.second.begin(), stream_ended.second.end(),
+                                   std::make_pair(depend_life, static_cast<size_t>(0)));
+      for (; iter != stream_ended.second.end(); ++iter) {
+        check(hull.index, iter->second);
+      }
+    }
+    if (check_num > kMaxConflictCheckNum) {
+      return false;
+    }
+
+    alive.emplace_back(i);
+    std::push_heap(alive.begin(), alive.end(), end_later);
+  }
+
+  for (auto &item_conflicts : conflicts) {
+    std::sort(item_conflicts.begin(), item_conflicts.end());
+    item_conflicts.erase(std::unique(item_conflicts.begin(), item_conflicts.end()), item_conflicts.end());
+  }
+  return true;
+}
+
+///
+/// @brief Place items one by one in order, each into the smallest gap between the placed items in conflict with it
+/// @return memory size needed
+///
+size_t PlaceItems(const std::vector<PlanItem> &items, const std::vector<std::vector<size_t>> &conflicts,
+                  const std::vector<size_t> &order, std::vector<size_t> &offsets) {
+  size_t mem_size = 0;
+  offsets.assign(items.size(), 0);
+  std::vector<bool> placed(items.size(), false);
+  std::vector<std::pair<size_t, size_t>> used;
+  for (auto index : order) {
+    const PlanItem &item = items[index];
+    used.clear();
+    for (auto conflict_index : conflicts[index]) {
+      if (placed[conflict_index]) {
+        used.emplace_back(offsets[conflict_index], offsets[conflict_index] + items[conflict_index].size);
+      }
+    }
+    std::sort(used.begin(), used.end());
+
+    size_t offset = 0;
+    size_t best_gap = std::numeric_limits<size_t>::max();
+    bool found = false;
+    size_t cursor = 0;
+    for (const auto &range : used) {
+      if (range.first > cursor) {
+        size_t gap = range.first - cursor;
+        if ((gap >= item.size) && (gap < best_gap)) {
+          best_gap = gap;
+          offset = cursor;
+          found = true;
+        }
+      }
+      cursor = std::max(cursor, range.second);
+    }
+    if (!found) {
+      offset = cursor;
+    }
+    offsets[index] = offset;
+    mem_size = std::max(mem_size, offset + item.size);
+    placed[index] = true;
+  }
+  return mem_size;
+}
+}  // namespace
+
+namespace ge {
+///
+/// @ingroup domi_omg
+/// @brief every memory size is a range, so that blocks are shared by tensors of the same size only
+/// @param [out] ranges return memory sizes
+/// @return Status result
+///
+Status IntervalBlockMemAssigner::GetMemoryRanges(std::vector<int64_t> &ranges) {
+  std::vector<int64_t> all_memory_size;
+  GetOutAndWorkSpaceMem(all_memory_size);
+  // sorted already
+  (void)std::unique_copy(all_memory_size.begin(), all_memory_size.end(), std::back_inserter(ranges));
+  GELOGI("Range number: %zu", ranges.size());
+  return SUCCESS;
+}
+
+void IntervalBlockMemAssigner::ReuseBlocksByLifeTime(size_t range_size) {
+  (void)range_size;
+  life_time_reuse_ = true;
+}
+
+void IntervalBlockMemAssigner::ResizeMemoryBlocks() {
+  if (!life_time_reuse_) {
+    BlockMemAssigner::ResizeMemoryBlocks();
+    return;
+  }
+
+  std::vector<PlanItem> items;
+  size_t block_num = 0;
+  bool in_continuous = false;
+  for (auto &memory_block : memory_blocks_) {
+    if (memory_block == nullptr || memory_block->deleted_block_ || memory_block->is_zero_copy_) {
+      continue;
+    }
+    memory_block->Resize();
+
+    // blocks from first_continuous_block_ to last_continuous_block_ are put together by AssignContinuousBlocks
+    if (!in_continuous || memory_block->first_continuous_block_) {
+      items.emplace_back();
+      if (memory_block->first_continuous_block_) {
+        items.back().head_size = MEM_ALIGN_SIZE;
+        items.back().size = MEM_ALIGN_SIZE;
+      }
+    }
+    in_continuous =
+      (in_continuous || memory_block->first_continuous_block_) && !memory_block->last_continuous_block_;
+
+    PlanItem &item = items.back();
+    item.blocks.emplace_back(memory_block);
+    item.size += memory_block->Size();
+    item.continuous = item.continuous || memory_block->continuous_block_;
+    item.before_atomic_addr_clean = item.before_atomic_addr_clean ||
+                                    (static_cast<int64_t>(memory_block->GetLifeBegin()) < GetAtomicAddrCleanId());
+    bool post_reuse = memory_block->reuse_mem_ && IsPostReuse(memory_block);
+    GetLifeSegments(memory_block, post_reuse, total_node_depend_stream_life_, item.segments);
+    ++block_num;
+  }
+
+  std::vector<std::vector<size_t>> conflicts;
+  if (!GetConflicts(items, conflicts)) {
+    GELOGW("Too many blocks to place by life time, block number:%zu.", block_num);
+    BlockMemAssigner::ResizeMemoryBlocks();
+    return;
+  }
+  size_t conflict_num = 0;
+  for (const auto &item_conflicts : conflicts) {
+    conflict_num += item_conflicts.size();
+  }
+
+  std::vector<std::vector<size_t>> orders;
+  std::vector<size_t> order(items.size());
+  for (size_t i = 0; i < order.size(); ++i) {
+    order[i] = i;
+  }
+  // by decreasing size
+  std::stable_sort(order.begin(), order.end(),
+                   [&items](size_t left, size_t right) { return items[left].size > items[right].size; });
+  orders.emplace_back(order);
+  if (conflict_num <= kMaxSearchConflictNum) {
+    std::vector<size_t> life_lengths(items.size(), 0);
+    std::vector<size_t> life_begins(items.size(), 0);
+    for (size_t i = 0; i < items.size(); ++i) {
+      for (const auto &segment : items[i].segments) {
+        life_lengths[i] += segment.end - segment.begin;
+      }
+      life_begins[i] = items[i].segments.empty() ? 0 : items[i].segments.front().begin;
+    }
+    // by decreasing size and life time length, blocks living for the whole graph first
+    std::stable_sort(order.begin(), order.end(), [&life_lengths](size_t left, size_t right) {
+      return life_lengths[left] > life_lengths[right];
+    });
+    orders.emplace_back(order);
+    // by begin of life time, as memory is applied while running
+    std::stable_sort(order.begin(), order.end(),
+                     [&life_begins](size_t left, size_t right) { return life_begins[left] < life_begins[right]; });
+    orders.emplace_back(order);
+  }
+
+  size_t best_mem_size = std::numeric_limits<size_t>::max();
+  size_t best_order = 0;
+  std::vector<size_t> best_offsets;
+  std::vector<size_t> offsets;
+  for (size_t i = 0; i < orders.size(); ++i) {
+    size_t mem_size = PlaceItems(items, conflicts, orders[i], offsets);
+    GELOGD("Place %zu blocks in order %zu, memory size:%zu", block_num, i, mem_size);
+    if (mem_size < best_mem_size) {
+      best_mem_size = mem_size;
+      best_order = i;
+      best_offsets.swap(offsets);
+    }
+  }
+
+  for (size_t i = 0; i < items.size(); ++i) {
+    size_t offset = mem_offset_ + best_offsets[i] + items[i].head_size;
+    for (auto memory_block : items[i].blocks) {
+      memory_block->SetHeadOffset(offset);
+      offset += memory_block->Size();
+      memory_block->SetTailOffset(offset - 1);
+    }
+  }
+  mem_offset_ += items.empty() ? 0 : best_mem_size;
+  GELOGI("Place %zu blocks by life time in order %zu, mem_offset_ exclude zero_copy_memory is %zu.", block_num,
+         best_order, mem_offset_);
+}
+}  // namespace ge
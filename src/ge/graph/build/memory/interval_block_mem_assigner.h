@@ -0,0 +1,62 @@
+/**
+ * Copyright 2019-2020 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef GE_GRAPH_BUILD_MEMORY_INTERVAL_BLOCK_MEM_ASSIGNER_H_
+#define GE_GRAPH_BUILD_MEMORY_INTERVAL_BLOCK_MEM_ASSIGNER_H_
+
+#include <utility>
+#include <vector>
+#include "graph/build/memory/block_mem_assigner.h"
+
+namespace ge {
+///
+/// Blocks are only shared by tensors of exactly the same size while traversing the graph. Instead of nesting
+/// blocks into each other by life time, every block is then placed at its own offset: blocks are placed one by one,
+/// each in the smallest gap left by the placed blocks whose life time overlaps its own.
+///
+class IntervalBlockMemAssigner : public BlockMemAssigner {
+ public:
+  explicit IntervalBlockMemAssigner(ge::ComputeGraphPtr compute_graph) : BlockMemAssigner(std::move(compute_graph)) {}
+
+  IntervalBlockMemAssigner(const IntervalBlockMemAssigner &) = delete;
+
+  IntervalBlockMemAssigner &operator=(const IntervalBlockMemAssigner &) = delete;
+
+  ~IntervalBlockMemAssigner() override = default;
+
+  Status GetMemoryRanges(std::vector<int64_t> &ranges) override;
+
+ protected:
+  ///
+  /// @ingroup GE
+  /// @brief Only mark that blocks can be reused by life time, they are placed in ResizeMemoryBlocks
+  /// @param [in] range_size unused
+  /// @return void
+  ///
+  void ReuseBlocksByLifeTime(size_t range_size) override;
+
+  ///
+  /// @ingroup GE
+  /// @brief Place blocks by life time, or one after another if they can not be reused by life time
+  /// @return void
+  ///
+  void ResizeMemoryBlocks() override;
+
+ private:
+  bool life_time_reuse_ = false;
+};
+}  // namespace ge
+#endif  // GE_GRAPH_BUILD_MEMORY_INTERVAL_BLOCK_MEM_ASSIGNER_H_
@@ -6,6 +6,7 @@ local_lib_src_files :=  memory_assigner.cc \
                         binary_block_mem_assigner.cc \
                         block_mem_assigner.cc \
                         hybrid_mem_assigner.cc \
+                        interval_block_mem_assigner.cc \
                         max_block_mem_assigner.cc \
                         var_mem_assign_util.cc \
 
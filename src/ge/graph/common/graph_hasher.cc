@@ -0,0 +1,498 @@
+/**
+ * Copyright 2019-2020 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "graph/common/graph_hasher.h"
+
+#include <algorithm>
+#include <vector>
+
+#include "common/types.h"
+#include "framework/common/debug/ge_log.h"
+#include "framework/common/util.h"
+#include "graph/debug/ge_attr_define.h"
+#include "graph/utils/attr_utils.h"
+#include "graph/utils/tensor_utils.h"
+
+namespace ge {
+namespace {
+const uint64_t kMurmurC1 = 0x87c37b91114253d5ULL;
+const uint64_t kMurmurC2 = 0x4cf5ad432745937fULL;
+const size_t kBlockSize = 16;
+const size_t kHexDigitsOfUint64 = 16;
+const int kNoPeerIndex = -1;
+
+inline uint64_t RotateLeft(uint64_t value, int bits) { return (value << bits) | (value >> (64 - bits)); }
+
+inline uint64_t FinalMix(uint64_t value) {
+  value ^= value >> 33;
+  value *= 0xff51afd7ed558ccdULL;
+  value ^= value >> 33;
+  value *= 0xc4ceb9fe1a85ec53ULL;
+  value ^= value >> 33;
+  return value;
+}
+
+// little endian regardless of host, so that hash code is the same on any platform
+inline uint64_t LoadUint64(const uint8_t *data, size_t size) {
+  uint64_t value = 0;
+  for (size_t i = 0; i < size; ++i) {
+    value |= static_cast<uint64_t>(data[i]) << (8 * i);
+  }
+  return value;
+}
+
+inline uint64_t MixK1(uint64_t k1) { return RotateLeft(k1 * kMurmurC1, 31) * kMurmurC2; }
+
+inline uint64_t MixK2(uint64_t k2) { return RotateLeft(k2 * kMurmurC2, 33) * kMurmurC1; }
+
+bool ParseHex(const std::string &str, uint64_t &value) {
+  value = 0;
+  for (auto c : str) {
+    value <<= 4;
+    if (c >= '0' && c <= '9') {
+      value |= static_cast<uint64_t>(c - '0');
+    } else if (c >= 'a' && c <= 'f') {
+      value |= static_cast<uint64_t>(c - 'a' + 10);
+    } else {
+      return false;
+    }
+  }
+  return true;
+}
+
+void HashBuffer(const Buffer &buffer, StreamHasher &hasher) {
+  hasher.Update(static_cast<uint64_t>(buffer.GetSize()));
+  if (buffer.GetSize() > 0) {
+    hasher.Update(buffer.GetData(), buffer.GetSize());
+  }
+}
+
+void HashTensor(const ConstGeTensorPtr &tensor, StreamHasher &hasher) {
+  hasher.Update(tensor != nullptr);
+  if (tensor != nullptr) {
+    GraphHasher::HashTensorDesc(tensor->GetTensorDesc(), hasher);
+    HashBuffer(tensor->GetData(), hasher);
+  }
+}
+
+void HashGraphAttr(const ComputeGraphPtr &graph, StreamHasher &hasher) {
+  hasher.Update(graph != nullptr);
+  if (graph != nullptr) {
+    std::map<std::string, HashCode128> node_hash_codes;
+    HashCode128 hash_code;
+    if (GraphHasher::HashGraph(graph, node_hash_codes, hash_code) != GRAPH_SUCCESS) {
+      GELOGW("Hash graph %s failed.", graph->GetName().c_str());
+    }
+    hasher.Update(graph->GetName()).Update(hash_code);
+  }
+}
+
+void HashNamedAttrs(const GeAttrValue::NAMED_ATTRS &named_attrs, StreamHasher &hasher) {
+  hasher.Update(named_attrs.GetName());
+  GraphHasher::HashAttrs(AttrUtils::GetAllAttrs(named_attrs), hasher);
+}
+
+template <typename L, typename T = typename L::value_type, typename F>
+void HashList(const GeAttrValue &attr_value, StreamHasher &hasher, F hash_item) {
+  std::vector<T> values;
+  (void)attr_value.GetValue<L>(values);
+  hasher.Update(static_cast<uint64_t>(values.size()));
+  for (const auto &value : values) {
+    hash_item(value);
+  }
+}
+
+template <typename T>
+void HashScalar(const GeAttrValue &attr_value, StreamHasher &hasher) {
+  T value{};
+  (void)attr_value.GetValue<T>(value);
+  hasher.Update(value);
+}
+
+void HashTensorDescs(const OpDesc::Vistor<GeTensorDescPtr> &tensor_descs, StreamHasher &hasher) {
+  hasher.Update(static_cast<uint64_t>(tensor_descs.size()));
+  for (const auto &tensor_desc : tensor_descs) {
+    hasher.Update(tensor_desc != nullptr);
+    if (tensor_desc != nullptr) {
+      GraphHasher::HashTensorDesc(*tensor_desc, hasher);
+    }
+  }
+}
+
+void HashNameIndexes(const std::map<std::string, uint32_t> &name_indexes, StreamHasher &hasher) {
+  hasher.Update(static_cast<uint64_t>(name_indexes.size()));
+  for (const auto &name_index : name_indexes) {
+    hasher.Update(name_index.first).Update(name_index.second);
+  }
+}
+
+void HashInEdges(const NodePtr &node, StreamHasher &hasher) {
+  // data edges in the order of input index
+  const auto &in_data_anchors = node->GetAllInDataAnchors();
+  hasher.Update(static_cast<uint64_t>(in_data_anchors.size()));
+  for (const auto &in_data_anchor : in_data_anchors) {
+    auto peer_out_anchor = (in_data_anchor == nullptr) ? nullptr : in_data_anchor->GetPeerOutAnchor();
+    if (peer_out_anchor == nullptr || peer_out_anchor->GetOwnerNode() == nullptr) {
+      hasher.Update(kNoPeerIndex);
+      continue;
+    }
+    hasher.Update(peer_out_anchor->GetIdx()).Update(peer_out_anchor->GetOwnerNode()->GetName());
+  }
+
+  // order of control edges has no meaning
+  std::vector<std::string> control_inputs;
+  for (const auto &in_node : node->GetInControlNodes()) {
+    if (in_node != nullptr) {
+      control_inputs.emplace_back(in_node->GetName());
+    }
+  }
+  std::sort(control_inputs.begin(), control_inputs.end());
+  hasher.Update(static_cast<uint64_t>(control_inputs.size()));
+  for (const auto &name : control_inputs) {
+    hasher.Update(name);
+  }
+}
+}  // namespace
+
+std::string HashCode128::ToString() const {
+  static const char kHexDigits[] = "0123456789abcdef";
+  std::string str(kHexDigitsOfUint64 * 2, '0');
+  for (size_t i = 0; i < kHexDigitsOfUint64; ++i) {
+    size_t shift = 4 * (kHexDigitsOfUint64 - 1 - i);
+    str[i] = kHexDigits[(high >> shift) & 0xf];
+    str[kHexDigitsOfUint64 + i] = kHexDigits[(low >> shift) & 0xf];
+  }
+  return str;
+}
+
+bool HashCode128::FromString(const std::string &str, HashCode128 &hash_code) {
+  if (str.size() != kHexDigitsOfUint64 * 2) {
+    return false;
+  }
+  return ParseHex(str.substr(0, kHexDigitsOfUint64), hash_code.high) &&
+         ParseHex(str.substr(kHexDigitsOfUint64), hash_code.low);
+}
+
+void StreamHasher::ProcessBlock(const uint8_t *block) {
+  h1_ ^= MixK1(LoadUint64(block, sizeof(uint64_t)));
+  h1_ = RotateLeft(h1_, 27) + h2_;
+  h1_ = h1_ * 5 + 0x52dce729;
+  h2_ ^= MixK2(LoadUint64(block + sizeof(uint64_t), sizeof(uint64_t)));
+  h2_ = RotateLeft(h2_, 31) + h1_;
+  h2_ = h2_ * 5 + 0x38495ab5;
+}
+
+StreamHasher &StreamHasher::Update(const void *data, size_t size) {
+  auto bytes = static_cast<const uint8_t *>(data);
+  total_size_ += size;
+  if (tail_size_ > 0) {
+    size_t fill_size = std::min(size, kBlockSize - tail_size_);
+    std::copy(bytes, bytes + fill_size, tail_ + tail_size_);
+    tail_size_ += fill_size;
+    bytes += fill_size;
+    size -= fill_size;
+    if (tail_size_ < kBlockSize) {
+      return *this;
+    }
+    ProcessBlock(tail_);
+    tail_size_ = 0;
+  }
+
+  for (; size >= kBlockSize; size -= kBlockSize, bytes += kBlockSize) {
+    ProcessBlock(bytes);
+  }
+  std::copy(bytes, bytes + size, tail_);
+  tail_size_ = size;
+  return *this;
+}
+
+StreamHasher &StreamHasher::Update(const std::string &str) {
+  Update(static_cast<uint64_t>(str.size()));
+  return Update(str.data(), str.size());
+}
+
+HashCode128 StreamHasher::Finish() const {
+  uint64_t h1 = h1_;
+  uint64_t h2 = h2_;
+  if (tail_size_ > sizeof(uint64_t)) {
+    h2 ^= MixK2(LoadUint64(tail_ + sizeof(uint64_t), tail_size_ - sizeof(uint64_t)));
+  }
+  if (tail_size_ > 0) {
+    h1 ^= MixK1(LoadUint64(tail_, std::min(tail_size_, sizeof(uint64_t))));
+  }
+
+  h1 ^= total_size_;
+  h2 ^= total_size_;
+  h1 += h2;
+  h2 += h1;
+  h1 = FinalMix(h1);
+  h2 = FinalMix(h2);
+  h1 += h2;
+  h2 += h1;
+
+  HashCode128 hash_code;
+  hash_code.high = h1;
+  hash_code.low = h2;
+  return hash_code;
+}
+
+void GraphHasher::HashTensorDesc(const GeTensorDesc &tensor_desc, StreamHasher &hasher) {
+  hasher.Update(tensor_desc.GetDataType()).Update(tensor_desc.GetFormat());
+  const auto &dims = tensor_desc.GetShape().GetDims();
+  hasher.Update(static_cast<uint64_t>(dims.size()));
+  for (auto dim : dims) {
+    hasher.Update(dim);
+  }
+
+  hasher.Update(tensor_desc.GetOriginDataType()).Update(tensor_desc.GetOriginFormat());
+  const auto &origin_dims = tensor_desc.GetOriginShape().GetDims();
+  hasher.Update(static_cast<uint64_t>(origin_dims.size()));
+  for (auto dim : origin_dims) {
+    hasher.Update(dim);
+  }
+
+  // fields kept by TensorUtils
+  int64_t size = 0;
+  (void)TensorUtils::GetSize(tensor_desc, size);
+  uint32_t real_dim_cnt = 0;
+  (void)TensorUtils::GetRealDimCnt(tensor_desc, real_dim_cnt);
+  int64_t data_offset = 0;
+  (void)TensorUtils::GetDataOffset(tensor_desc, data_offset);
+  bool reuse_input = false;
+  (void)TensorUtils::GetReuseInput(tensor_desc, reuse_input);
+  uint32_t reuse_input_index = 0;
+  (void)TensorUtils::GetReuseInputIndex(tensor_desc, reuse_input_index);
+  hasher.Update(size).Update(real_dim_cnt).Update(data_offset).Update(reuse_input).Update(reuse_input_index);
+
+  HashAttrs(AttrUtils::GetAllAttrs(tensor_desc), hasher);
+}
+
+void GraphHasher::HashAttrValue(const GeAttrValue &attr_value, StreamHasher &hasher) {
+  auto value_type = attr_value.GetValueType();
+  hasher.Update(value_type);
+  switch (value_type) {
+    case GeAttrValue::VT_STRING: {
+      GeAttrValue::STR value;
+      (void)attr_value.GetValue<GeAttrValue::STR>(value);
+      hasher.Update(value);
+      break;
+    }
+    case GeAttrValue::VT_FLOAT:
+      HashScalar<GeAttrValue::FLOAT>(attr_value, hasher);
+      break;
+    case GeAttrValue::VT_BOOL:
+      HashScalar<GeAttrValue::BOOL>(attr_value, hasher);
+      break;
+    case GeAttrValue::VT_INT:
+      HashScalar<GeAttrValue::INT>(attr_value, hasher);
+      break;
+    case GeAttrValue::VT_DATA_TYPE:
+      HashScalar<GeAttrValue::DATA_TYPE>(attr_value, hasher);
+      break;
+    case GeAttrValue::VT_TENSOR_DESC: {
+      GeAttrValue::TENSOR_DESC value;
+      (void)attr_value.GetValue<GeAttrValue::TENSOR_DESC>(value);
+      HashTensorDesc(value, hasher);
+      break;
+    }
+    case GeAttrValue::VT_TENSOR: {
+      ConstGeTensorPtr value;
+      (void)attr_value.GetValue<GeAttrValue::TENSOR>(value);
+      HashTensor(value, hasher);
+      break;
+    }
+    case GeAttrValue::VT_BYTES: {
+      GeAttrValue::BYTES value;
+      (void)attr_value.GetValue<GeAttrValue::BYTES>(value);
+      HashBuffer(value, hasher);
+      break;
+    }
+    case GeAttrValue::VT_GRAPH: {
+      GeAttrValue::GRAPH value;
+      (void)attr_value.GetValue<GeAttrValue::GRAPH>(value);
+      HashGraphAttr(value, hasher);
+      break;
+    }
+    case GeAttrValue::VT_NAMED_ATTRS: {
+      GeAttrValue::NAMED_ATTRS value;
+      (void)attr_value.GetValue<GeAttrValue::NAMED_ATTRS>(value);
+      HashNamedAttrs(value, hasher);
+      break;
+    }
+    case GeAttrValue::VT_LIST_LIST_INT:
+      HashList<GeAttrValue::LIST_LIST_INT>(attr_value, hasher, [&hasher](const std::vector<int64_t> &values) {
+        hasher.Update(static_cast<uint64_t>(values.size()));
+        for (auto value : values) {
+          hasher.Update(value);
+        }
+      });
+      break;
+    case GeAttrValue::VT_LIST_STRING:
+      HashList<GeAttrValue::LIST_STR>(attr_value, hasher,
+                                      [&hasher](const GeAttrValue::STR &value) { hasher.Update(value); });
+      break;
+    case GeAttrValue::VT_LIST_FLOAT:
+      HashList<GeAttrValue::LIST_FLOAT>(attr_value, hasher,
+                                        [&hasher](GeAttrValue::FLOAT value) { hasher.Update(value); });
+      break;
+    case GeAttrValue::VT_LIST_BOOL:
+      HashList<GeAttrValue::LIST_BOOL>(attr_value, hasher,
+                                       [&hasher](GeAttrValue::BOOL value) { hasher.Update(value); });
+      break;
+    case GeAttrValue::VT_LIST_INT:
+      HashList<GeAttrValue::LIST_INT>(attr_value, hasher, [&hasher](GeAttrValue::INT value) { hasher.Update(value); });
+      break;
+    case GeAttrValue::VT_LIST_DATA_TYPE:
+      HashList<GeAttrValue::LIST_DATA_TYPE>(attr_value, hasher,
+                                            [&hasher](GeAttrValue::DATA_TYPE value) { hasher.Update(value); });
+      break;
+    case GeAttrValue::VT_LIST_TENSOR_DESC:
+      HashList<GeAttrValue::LIST_TENSOR_DESC>(
+        attr_value, hasher, [&hasher](const GeAttrValue::TENSOR_DESC &value) { HashTensorDesc(value, hasher); });
+      break;
+    case GeAttrValue::VT_LIST_TENSOR:
+      HashList<GeAttrValue::LIST_TENSOR, ConstGeTensorPtr>(
+        attr_value, hasher, [&hasher](const ConstGeTensorPtr &value) { HashTensor(value, hasher); });
+      break;
+    case GeAttrValue::VT_LIST_BYTES:
+      HashList<GeAttrValue::LIST_BYTES>(attr_value, hasher,
+                                        [&hasher](const GeAttrValue::BYTES &value) { HashBuffer(value, hasher); });
+      break;
+    case GeAttrValue::VT_LIST_GRAPH:
+      HashList<GeAttrValue::LIST_GRAPH>(attr_value, hasher,
+                                        [&hasher](const GeAttrValue::GRAPH &value) { HashGraphAttr(value, hasher); });
+      break;
+    case GeAttrValue::VT_LIST_NAMED_ATTRS:
+      HashList<GeAttrValue::LIST_NAMED_ATTRS>(
+        attr_value, hasher, [&hasher](const GeAttrValue::NAMED_ATTRS &value) { HashNamedAttrs(value, hasher); });
+      break;
+    default:
+      break;
+  }
+}
+
+void GraphHasher::HashAttrs(const std::map<std::string, GeAttrValue> &attrs, StreamHasher &hasher,
+                            const std::set<std::string> &ignored_attrs) {
+  uint64_t attr_num = 0;
+  for (const auto &attr : attrs) {
+    if (ignored_attrs.count(attr.first) > 0) {
+      continue;
+    }
+    hasher.Update(attr.first);
+    HashAttrValue(attr.second, hasher);
+    ++attr_num;
+  }
+  hasher.Update(attr_num);
+}
+
+graphStatus GraphHasher::HashNode(const NodePtr &node, HashCode128 &hash_code) {
+  GE_CHECK_NOTNULL(node);
+  auto op_desc = node->GetOpDesc();
+  GE_CHECK_NOTNULL(op_desc);
+
+  StreamHasher hasher;
+  hasher.Update(op_desc->GetName()).Update(op_desc->GetType());
+  HashInEdges(node, hasher);
+  HashTensorDescs(op_desc->GetAllInputsDescPtr(), hasher);
+  HashTensorDescs(op_desc->GetAllOutputsDescPtr(), hasher);
+  HashNameIndexes(op_desc->GetAllInputName(), hasher);
+  HashNameIndexes(op_desc->GetAllOutputName(), hasher);
+
+  hasher.Update(op_desc->GetStreamId());
+  const auto workspace_bytes = op_desc->GetWorkspaceBytes();
+  hasher.Update(static_cast<uint64_t>(workspace_bytes.size()));
+  for (auto bytes : workspace_bytes) {
+    hasher.Update(bytes);
+  }
+  const auto is_input_const = op_desc->GetIsInputConst();
+  hasher.Update(static_cast<uint64_t>(is_input_const.size()));
+  for (bool is_const : is_input_const) {
+    hasher.Update(is_const);
+  }
+  const auto &subgraph_names = op_desc->GetSubgraphInstanceNames();
+  hasher.Update(static_cast<uint64_t>(subgraph_names.size()));
+  for (const auto &name : subgraph_names) {
+    hasher.Update(name);
+  }
+
+  // weights of constant and framework type of framework op do not change the structure of graph
+  std::set<std::string> ignored_attrs;
+  if (op_desc->GetType() == CONSTANT || op_desc->GetType() == CONSTANTOP) {
+    ignored_attrs.insert(ATTR_NAME_WEIGHTS);
+  }
+  if (op_desc->GetType() == FRAMEWORKOP) {
+    ignored_attrs.insert(ATTR_NAME_FRAMEWORK_FWK_TYPE);
+  }
+  HashAttrs(op_desc->GetAllAttrs(), hasher, ignored_attrs);
+
+  hash_code = hasher.Finish();
+  return GRAPH_SUCCESS;
+}
+
+graphStatus GraphHasher::HashGraph(const ComputeGraphPtr &graph, std::map<std::string, HashCode128> &node_hash_codes,
+                                   HashCode128 &hash_code) {
+  GE_CHECK_NOTNULL(graph);
+  node_hash_codes.clear();
+  for (const auto &node : graph->GetDirectNode()) {
+    HashCode128 node_hash_code;
+    if (HashNode(node, node_hash_code) != GRAPH_SUCCESS) {
+      GELOGE(GRAPH_FAILED, "Hash node of graph %s failed.", graph->GetName().c_str());
+      return GRAPH_FAILED;
+    }
+    node_hash_codes[node->GetName()] = node_hash_code;
+  }
+
+  StreamHasher hasher;
+  HashAttrs(AttrUtils::GetAllAttrs(graph), hasher);
+  const auto &input_nodes = graph->GetInputNodes();
+  hasher.Update(static_cast<uint64_t>(input_nodes.size()));
+  for (const auto &node : input_nodes) {
+    GE_CHECK_NOTNULL(node);
+    hasher.Update(node->GetName());
+  }
+  const auto &output_nodes_info = graph->GetGraphOutNodesInfo();
+  hasher.Update(static_cast<uint64_t>(output_nodes_info.size()));
+  for (const auto &output_node_info : output_nodes_info) {
+    GE_CHECK_NOTNULL(output_node_info.first);
+    hasher.Update(output_node_info.first->GetName()).Update(output_node_info.second);
+  }
+
+  // nodes are identified by name, and in edges are hashed with each node, so name order is enough to be stable
+  hasher.Update(static_cast<uint64_t>(node_hash_codes.size()));
+  for (const auto &node_hash_code : node_hash_codes) {
+    hasher.Update(node_hash_code.second);
+  }
+
+  // subgraphs are only kept by root graph
+  std::map<std::string, ComputeGraphPtr> subgraphs;
+  for (const auto &subgraph : graph->GetAllSubgraphs()) {
+    GE_CHECK_NOTNULL(subgraph);
+    subgraphs[subgraph->GetName()] = subgraph;
+  }
+  hasher.Update(static_cast<uint64_t>(subgraphs.size()));
+  for (const auto &subgraph : subgraphs) {
+    std::map<std::string, HashCode128> subgraph_node_hash_codes;
+    HashCode128 subgraph_hash_code;
+    if (HashGraph(subgraph.second, subgraph_node_hash_codes, subgraph_hash_code) != GRAPH_SUCCESS) {
+      GELOGE(GRAPH_FAILED, "Hash subgraph %s failed.", subgraph.first.c_str());
+      return GRAPH_FAILED;
+    }
+    hasher.Update(subgraph.first).Update(subgraph_hash_code);
+  }
+  hash_code = hasher.Finish();
+  return GRAPH_SUCCESS;
+}
+}  // namespace ge
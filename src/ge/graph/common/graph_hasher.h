@@ -0,0 +1,109 @@
+/**
+ * Copyright 2019-2020 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef GE_GRAPH_COMMON_GRAPH_HASHER_H_
+#define GE_GRAPH_COMMON_GRAPH_HASHER_H_
+
+#include <map>
+#include <set>
+#include <string>
+#include <type_traits>
+
+#include "graph/compute_graph.h"
+#include "graph/ge_attr_value.h"
+#include "graph/node.h"
+
+namespace ge {
+// 128 bits hash code
+struct HashCode128 {
+  uint64_t high = 0;
+  uint64_t low = 0;
+
+  bool operator==(const HashCode128 &other) const { return high == other.high && low == other.low; }
+  bool operator!=(const HashCode128 &other) const { return !(*this == other); }
+  bool operator<(const HashCode128 &other) const {
+    return high != other.high ? high < other.high : low < other.low;
+  }
+
+  // 32 hex digits
+  std::string ToString() const;
+  static bool FromString(const std::string &str, HashCode128 &hash_code);
+};
+
+struct HashCode128Hasher {
+  size_t operator()(const HashCode128 &hash_code) const { return static_cast<size_t>(hash_code.low); }
+};
+
+// Streaming MurmurHash3 x64 128, the hash code only depends on the bytes fed, so it is stable across runs
+class StreamHasher {
+ public:
+  StreamHasher &Update(const void *data, size_t size);
+
+  // size is fed before the bytes, so that ("ab", "c") and ("a", "bc") differ
+  StreamHasher &Update(const std::string &str);
+
+  template <typename T, typename std::enable_if<std::is_arithmetic<T>::value || std::is_enum<T>::value, int>::type = 0>
+  StreamHasher &Update(T value) {
+    return Update(&value, sizeof(value));
+  }
+
+  StreamHasher &Update(const HashCode128 &hash_code) { return Update(hash_code.high).Update(hash_code.low); }
+
+  HashCode128 Finish() const;
+
+ private:
+  void ProcessBlock(const uint8_t *block);
+
+  uint64_t h1_ = 0;
+  uint64_t h2_ = 0;
+  uint64_t total_size_ = 0;
+  uint8_t tail_[16] = {0};
+  size_t tail_size_ = 0;
+};
+
+// Structural hash of graph without serialization. Node ids and graph name are not hashed, as they are not stable
+// between builds of the same graph.
+class GraphHasher {
+ public:
+  /**
+   * Hash of node, with its type, name, tensor descs, attrs and input edges
+   * @param node             node to hash
+   * @param hash_code        hash code of node
+   * @return SUCCESS on success, error code otherwise
+   */
+  static graphStatus HashNode(const NodePtr &node, HashCode128 &hash_code);
+
+  /**
+   * Hash of graph, with its attrs, inputs, outputs, hash of all direct nodes in name order and subgraphs
+   * @param graph            graph to hash
+   * @param node_hash_codes  hash code of each direct node, key is node name
+   * @param hash_code        hash code of graph
+   * @return SUCCESS on success, error code otherwise
+   */
+  static graphStatus HashGraph(const ComputeGraphPtr &graph, std::map<std::string, HashCode128> &node_hash_codes,
+                               HashCode128 &hash_code);
+
+  static void HashTensorDesc(const GeTensorDesc &tensor_desc, StreamHasher &hasher);
+
+  static void HashAttrValue(const GeAttrValue &attr_value, StreamHasher &hasher);
+
+  // attrs are hashed in name order, attrs in ignored_attrs are skipped
+  static void HashAttrs(const std::map<std::string, GeAttrValue> &attrs, StreamHasher &hasher,
+                        const std::set<std::string> &ignored_attrs = {});
+};
+}  // namespace ge
+
+#endif  // GE_GRAPH_COMMON_GRAPH_HASHER_H_
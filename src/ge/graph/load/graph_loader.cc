@@ -155,13 +155,45 @@ Status GraphLoader::LoadDataFromFile(const std::string &path, const std::string
   return ret;
 }
 
+Status GraphLoader::MapDataFromFile(const std::string &path, const std::string &key_path, int32_t priority,
+                                    ModelData &model_data, std::shared_ptr<void> &mapped_file) {
+  try {
+    if (!CheckInputPathValid(path)) {
+      GELOGE(GE_EXEC_MODEL_PATH_INVALID, "model path is invalid: %s", path.c_str());
+      return GE_EXEC_MODEL_PATH_INVALID;
+    }
+
+    GELOGI("Map model begin, model path is: %s", path.c_str());
+    if (!key_path.empty() && !CheckInputPathValid(key_path)) {
+      GELOGE(GE_EXEC_MODEL_KEY_PATH_INVALID, "decrypt_key path is invalid: %s", key_path.c_str());
+      return GE_EXEC_MODEL_KEY_PATH_INVALID;
+    }
+
+    return DavinciModelParser::MapFromFile(path.c_str(), key_path.c_str(), priority, model_data, mapped_file);
+  } catch (std::bad_alloc &) {
+    GELOGE(MEMALLOC_FAILED, "Map model from file failed, bad memory allocation");
+    return MEMALLOC_FAILED;
+  } catch (...) {
+    GELOGE(FAILED, "Map model from file failed with exception");
+    return FAILED;
+  }
+}
+
 Status GraphLoader::LoadModelFromFile(const std::string &path, const std::string &key_path, int32_t priority,
                                       const std::shared_ptr<ModelListener> &listener, uint32_t &model_id) {
   Status ret;
   ModelData model_data;
+  // weights and kernels of the model refer to the mapped file, which is unmapped after all of them released
+  std::shared_ptr<void> mapped_file;
 
   try {
-    ret = LoadDataFromFile(path, key_path, priority, model_data);
+    ret = MapDataFromFile(path, key_path, priority, model_data, mapped_file);
+    if (ret != SUCCESS) {
+      GELOGW("Map model file failed, read it instead. ret = %u", ret);
+      mapped_file = nullptr;
+      model_data = ModelData();
+      ret = LoadDataFromFile(path, key_path, priority, model_data);
+    }
     if (ret != SUCCESS) {
       GELOGE(ret, "LoadModelFromFile: Load failed. ret = %u", ret);
       if (model_data.model_data != nullptr) {
@@ -171,13 +203,9 @@ Status GraphLoader::LoadModelFromFile(const std::string &path, const std::string
       return ret;
     }
 
-    ret = LoadModel(model_data, listener, model_id);
+    ret = LoadModel(model_data, listener, model_id, mapped_file);
     if (ret != SUCCESS) {
       GELOGE(ret, "LoadModel: Load failed. ret = %u", ret);
-      if (model_data.model_data != nullptr) {
-        delete[] static_cast<char *>(model_data.model_data);
-        model_data.model_data = nullptr;
-      }
     }
   } catch (std::bad_alloc &) {
     GELOGE(MEMALLOC_FAILED, "Load model from file failed, bad memory allocation");
@@ -187,16 +215,16 @@ Status GraphLoader::LoadModelFromFile(const std::string &path, const std::string
     ret = FAILED;
   }
 
-  if (model_data.model_data != nullptr) {
+  if (mapped_file == nullptr && model_data.model_data != nullptr) {
     delete[] static_cast<char *>(model_data.model_data);
-    model_data.model_data = nullptr;
   }
+  model_data.model_data = nullptr;
 
   return ret;
 }
 
 Status GraphLoader::LoadModel(const ModelData &model_data, const std::shared_ptr<ModelListener> &listener,
-                              uint32_t &model_id) {
+                              uint32_t &model_id, const std::shared_ptr<void> &model_data_owner) {
   try {
     GELOGI("Load model begin, model_id:%u.", model_id);
 
@@ -204,7 +232,8 @@ Status GraphLoader::LoadModel(const ModelData &model_data, const std::shared_ptr
     GE_CHK_RT_RET(rtSetDevice(0));
     auto model_manager = ModelManager::GetInstance();
     GE_CHECK_NOTNULL(model_manager);
-    Status ret = model_manager->LoadModelOffline(model_id, model_data, listener);
+    Status ret = model_manager->LoadModelOffline(model_id, model_data, listener, nullptr, 0, nullptr, 0,
+                                                 model_data_owner);
     if (ret != SUCCESS) {
       GE_CHK_RT(rtDeviceReset(0));
       GELOGE(ret, "LoadModel: Load failed.");
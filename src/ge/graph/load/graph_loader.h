@@ -45,7 +45,7 @@ class GraphLoader {
   static Status GetMaxUsedMemory(uint32_t model_id, uint64_t &max_size);
 
   static Status LoadModel(const ModelData &model_data, const std::shared_ptr<ModelListener> &listener,
-                          uint32_t &model_id);
+                          uint32_t &model_id, const std::shared_ptr<void> &model_data_owner = nullptr);
 
   static Status LoadModelFromFile(const std::string &path, const std::string &key_path, int32_t priority,
                                   const std::shared_ptr<ModelListener> &listener, uint32_t &model_id);
@@ -57,6 +57,10 @@ class GraphLoader {
   static Status LoadDataFromFile(const std::string &path, const std::string &key_path, int32_t priority,
                                  ModelData &model_data);
 
+  // map model file instead of reading it, model data is valid as long as mapped_file is held
+  static Status MapDataFromFile(const std::string &path, const std::string &key_path, int32_t priority,
+                                ModelData &model_data, std::shared_ptr<void> &mapped_file);
+
   static Status LoadModelFromData(uint32_t &model_id, const ModelData &model_data, void *dev_ptr, size_t mem_size,
                                   void *weight_ptr, size_t weight_size);
 
@@ -104,6 +104,14 @@ class DataInputer {
   ///
   bool IsDataFull() { return queue_.IsFull(); }
 
+  ///
+  /// @ingroup domi_ome
+  /// @brief is input data empty
+  /// @return true empty
+  /// @return false not empty
+  ///
+  bool IsDataEmpty() { return queue_.IsEmpty(); }
+
   ///
   /// @ingroup domi_ome
   /// @brief add input data
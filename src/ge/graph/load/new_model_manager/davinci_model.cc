@@ -23,6 +23,7 @@
 #include <sched.h>
 #include <sys/prctl.h>
 #include <algorithm>
+#include <functional>
 #include <map>
 #include <utility>
 
@@ -85,6 +86,10 @@ const int kDecimal = 10;
 const int kBytes = 8;
 const uint32_t kDataMemAlignSizeCompare = 64;
 const char *const kDefaultBatchLable = "Batch_default";
+const char *const kEnvPipelineSlotNum = "GE_MODEL_PIPELINE_SLOTS";
+const int64_t kMaxPipelineSlotNum = 8;
+const char *const kEnvInitThreadNum = "GE_MODEL_INIT_THREAD_NUM";
+const int64_t kMaxInitThreadNum = 64;
 
 inline bool IsDataOp(const std::string &node_type) {
   return node_type == DATA_TYPE || node_type == AIPP_DATA_TYPE || node_type == ANN_DATA_TYPE;
@@ -94,10 +99,57 @@ inline bool IsNoTaskAndDumpNeeded(const OpDescPtr &op_desc) {
   (void)ge::AttrUtils::GetBool(op_desc, ATTR_NO_TASK_AND_DUMP_NEEDED, save_dump_info);
   return save_dump_info;
 }
+
+uint32_t GetInitThreadNum() {
+  const char *thread_num_str = std::getenv(kEnvInitThreadNum);
+  if (thread_num_str == nullptr) {
+    return 0;
+  }
+  char *end = nullptr;
+  auto thread_num = std::strtol(thread_num_str, &end, kDecimal);
+  if (end == thread_num_str || *end != '\0' || thread_num < 0 || thread_num > kMaxInitThreadNum) {
+    GELOGW("Invalid %s: %s, should be in [0, %ld], init model serially.", kEnvInitThreadNum, thread_num_str,
+           kMaxInitThreadNum);
+    return 0;
+  }
+  return static_cast<uint32_t>(thread_num);
+}
+
+// Init of these tasks only touches the task itself and the thread-safe parts of model
+inline bool IsParallelInitTask(uint32_t task_type) {
+  return task_type == RT_MODEL_TASK_KERNEL || task_type == RT_MODEL_TASK_MEMCPY_ASYNC ||
+         task_type == RT_MODEL_TASK_MEMCPY_ADDR_ASYNC;
+}
+
+// Run func(begin, step) on thread_num threads, the i-th one handles items i, i + thread_num, ...
+Status ParallelRun(ThreadPool &pool, uint32_t thread_num, const std::function<Status(size_t, size_t)> &func) {
+  Status ret = SUCCESS;
+  std::vector<std::future<Status>> futures;
+  for (size_t i = 0; i < thread_num; ++i) {
+    auto f = pool.commit(func, i, static_cast<size_t>(thread_num));
+    if (!f.valid()) {
+      GELOGE(FAILED, "Future is invalid");
+      ret = FAILED;
+      break;
+    }
+    futures.emplace_back(std::move(f));
+  }
+
+  // wait for all of the committed tasks, as they refer to data of caller
+  for (auto &f : futures) {
+    Status task_ret = f.get();
+    if (task_ret != SUCCESS && ret == SUCCESS) {
+      ret = task_ret;
+    }
+  }
+  return ret;
+}
 }  // namespace
 
 std::mutex DavinciModel::tvm_bin_mutex_;
 std::set<std::string> DavinciModel::tvm_bin_kernel_;
+thread_local std::vector<DavinciModel::ZeroCopyAddrRecord> *DavinciModel::deferred_zero_copy_addrs_ = nullptr;
+thread_local int DavinciModel::init_task_index_ = -1;
 
 DavinciModel::DavinciModel(int32_t priority, const std::shared_ptr<ModelListener> &listener)
     : weights_mem_base_(nullptr),
@@ -190,6 +242,7 @@ DavinciModel::~DavinciModel() {
     GELOGI("do ReleaseTask");
     ReleaseTask();
     CleanTbeHandle();
+    zero_copy_args_arena_.Release();
 
     var_mem_base_ = nullptr;
     if (known_node_) {
@@ -265,8 +318,7 @@ Status DavinciModel::InitModelMem(void *dev_ptr, size_t mem_size, void *weight_p
   is_model_has_inited_ = true;
 
   std::size_t data_size = TotalMemSize();
-  const Buffer &weights = ge_model_->GetWeight();
-  std::size_t weights_size = weights.GetSize();
+  std::size_t weights_size = ge_model_->GetWeightSize();
   GE_CHECK_LE(weights_size, ALLOC_MEMORY_MAX_SIZE);
 
   if ((dev_ptr != nullptr) && (mem_size < TotalMemSize())) {
@@ -312,7 +364,8 @@ Status DavinciModel::InitModelMem(void *dev_ptr, size_t mem_size, void *weight_p
     }
     GELOGI("[IMAS]InitModelMem graph_%u MallocMemory type[W] memaddr[%p] mem_size[%zu]", runtime_param_.graph_id,
            weights_mem_base_, weights_size);
-    GE_CHK_RT_RET(rtMemcpy(weights_mem_base_, weights_size, weights.GetData(), weights_size, RT_MEMCPY_HOST_TO_DEVICE));
+    GE_CHK_RT_RET(rtMemcpy(weights_mem_base_, weights_size, ge_model_->GetWeightData(), weights_size,
+                           RT_MEMCPY_HOST_TO_DEVICE));
     GELOGI("copy weights data to device");
   }
 
@@ -439,8 +492,14 @@ Status DavinciModel::DoTaskSink() {
     GE_CHK_STATUS_RET(MallocKnownArgs(), "Mallloc known node args failed.");
   }
 
+  if (!known_node_) {
+    GE_CHK_STATUS_RET(InitZeroCopyArgsArena(*model_task_def.get()), "InitZeroCopyArgsArena failed.");
+  }
+
   GE_CHK_STATUS_RET(InitTaskInfo(*model_task_def.get()), "InitTaskInfo failed.");
 
+  GE_CHK_STATUS_RET(zero_copy_args_arena_.Build(), "Build zero copy args arena failed.");
+
   GE_CHK_STATUS_RET(InitEntryTask(), "InitEntryTask failed.");
 
   GE_CHK_STATUS_RET(DistributeTask(), "Distribute failed.");
@@ -554,6 +613,7 @@ Status DavinciModel::Init(void *dev_ptr, size_t mem_size, void *weight_ptr, size
 
   // Initializing runtime_param_
   InitRuntimeParams();
+  init_thread_num_ = GetInitThreadNum();
 
   // RTS set aicore or vectorcore
   GE_CHK_STATUS_RET(SetTSDevice(), "SetTSDevice failed");
@@ -747,7 +807,7 @@ Status DavinciModel::InitNodes(const ComputeGraphPtr &compute_graph) {
   GE_TIMESTAMP_CALLNUM_START(InitTbeHandle);
 
   typedef Status (DavinciModel::*OpDescCall)(const OpDescPtr &);
-  static std::map<std::string, OpDescCall> op_desc_handle = {
+  static const std::map<std::string, OpDescCall> op_desc_handle = {
     {VARIABLE, &DavinciModel::InitVariable},           {CONSTANTOP, &DavinciModel::InitConstant},
     {STREAMACTIVE, &DavinciModel::InitStreamActive},   {STREAMSWITCH, &DavinciModel::InitStreamSwitch},
     {STREAMSWITCHN, &DavinciModel::InitStreamSwitchN}, {LABELSET, &DavinciModel::InitLabelSet},
@@ -755,6 +815,26 @@ Status DavinciModel::InitNodes(const ComputeGraphPtr &compute_graph) {
 
   auto nodes = compute_graph->GetAllNodes();
   const TBEKernelStore &tbekernel_store = ge_model_->GetTBEKernelStore();
+  bool kernel_bin_loaded = false;
+  if (init_thread_num_ > 1 && nodes.size() > 1) {
+    // Binding kernel only sets ext attr of its own op desc. The rest stays serial, as it allocates memory and
+    // registers kernels in node order.
+    GE_TIMESTAMP_START(LoadTBEKernelBinParallel);
+    ThreadPool pool(init_thread_num_);
+    Status ret = ParallelRun(pool, init_thread_num_, [&nodes, &tbekernel_store](size_t begin, size_t step) -> Status {
+      for (size_t i = begin; i < nodes.size(); i += step) {
+        const auto &node = nodes.at(i);
+        if (node != nullptr) {
+          tbekernel_store.LoadTBEKernelBinToOpDesc(node->GetOpDesc());
+        }
+      }
+      return SUCCESS;
+    });
+    GE_CHK_STATUS_RET(ret, "Load tbe kernel bin to op desc failed.");
+    GE_TIMESTAMP_END(LoadTBEKernelBinParallel, "GraphLoader::LoadTBEKernelBinParallel.");
+    kernel_bin_loaded = true;
+  }
+
   for (size_t i = 0; i < nodes.size(); i++) {
     auto node = nodes.at(i);
     auto op_desc = node->GetOpDesc();
@@ -765,9 +845,11 @@ Status DavinciModel::InitNodes(const ComputeGraphPtr &compute_graph) {
 
     op_list_[op_desc->GetId()] = op_desc;
 
-    GE_TIMESTAMP_RESTART(LoadTBEKernelBinToOpDesc);
-    tbekernel_store.LoadTBEKernelBinToOpDesc(op_desc);
-    GE_TIMESTAMP_ADD(LoadTBEKernelBinToOpDesc);
+    if (!kernel_bin_loaded) {
+      GE_TIMESTAMP_RESTART(LoadTBEKernelBinToOpDesc);
+      tbekernel_store.LoadTBEKernelBinToOpDesc(op_desc);
+      GE_TIMESTAMP_ADD(LoadTBEKernelBinToOpDesc);
+    }
 
     if (IsDataOp(op_desc->GetType())) {
       if (InitDataOp(node, data_op_index) != SUCCESS) {
@@ -2375,6 +2457,18 @@ void *DavinciModel::Run(DavinciModel *model) {
   // DeviceReset before thread run finished!
   GE_MAKE_GUARD(not_used_var, [&] { GE_CHK_RT(rtDeviceReset(device_id)); });
 
+  if (model->pipeline_slot_num_ > 1 && model->CanRunPipelined()) {
+    if (model->InitPipeline() == SUCCESS) {
+      model->RunPipelined();
+      model->ReleasePipeline();
+      CsaInteract::GetInstance().WriteInternalErrorCode();
+      GELOGI("Model run end, model id:%u", model_id);
+      return nullptr;
+    }
+    model->ReleasePipeline();
+    GELOGW("Init pipeline failed, run requests one by one, model id:%u.", model_id);
+  }
+
   while (model->RunFlag()) {
     bool rslt_flg = true;
     if (model->GetDataInputer() == nullptr) {
@@ -2490,6 +2584,280 @@ void *DavinciModel::Run(DavinciModel *model) {
   return nullptr;
 }
 
+bool DavinciModel::CanRunPipelined() {
+  // global step and variables are synced by host before each execution
+  if (listener_ == nullptr || output_op_list_.empty() || !variable_op_list_.empty()) {
+    GELOGI("Model has variables, no output or no listener, run requests one by one, model id:%u.", model_id_);
+    return false;
+  }
+  if (ProfilingManager::Instance().ProfilingOn() || std::getenv("DUMP_OP") != nullptr) {
+    GELOGI("Profiling or op dump is on, run requests one by one, model id:%u.", model_id_);
+    return false;
+  }
+  return true;
+}
+
+Status DavinciModel::InitPipeline() {
+  GE_CHK_RT_RET(rtStreamCreate(&copy_in_stream_, priority_));
+  GE_CHK_RT_RET(rtStreamCreate(&copy_out_stream_, priority_));
+  pipeline_slots_.resize(pipeline_slot_num_);
+  // async copies between host and device are only done with pinned host memory
+  for (auto &slot : pipeline_slots_) {
+    for (const auto &data : new_input_data_info_) {
+      slot.input_host_buffers.emplace_back(nullptr);
+      slot.input_buffers.emplace_back(nullptr);
+      uint64_t data_size = data.second.GetDataSize();
+      if (data_size > 0) {
+        GE_CHK_RT_RET(rtMallocHost(&slot.input_host_buffers.back(), data_size));
+        GE_CHK_RT_RET(rtMalloc(&slot.input_buffers.back(), data_size, RT_MEMORY_HBM));
+      }
+    }
+    for (const auto &output : new_output_data_info_) {
+      slot.output_buffers.emplace_back(nullptr);
+      slot.output_host_buffers.emplace_back(nullptr);
+      uint64_t data_size = output.second.GetDataSize();
+      if (data_size > 0) {
+        GE_CHK_RT_RET(rtMalloc(&slot.output_buffers.back(), data_size, RT_MEMORY_HBM));
+        GE_CHK_RT_RET(rtMallocHost(&slot.output_host_buffers.back(), data_size));
+      }
+    }
+    GE_CHK_RT_RET(rtEventCreate(&slot.input_ready));
+    GE_CHK_RT_RET(rtEventCreate(&slot.compute_done));
+    GE_CHK_RT_RET(rtEventCreate(&slot.output_ready));
+  }
+  GELOGI("Init pipeline success, slot num:%u, model id:%u.", pipeline_slot_num_, model_id_);
+  return SUCCESS;
+}
+
+void DavinciModel::ReleasePipeline() {
+  for (auto &slot : pipeline_slots_) {
+    for (auto buffer : slot.input_host_buffers) {
+      GE_IF_BOOL_EXEC(buffer != nullptr, GE_CHK_RT(rtFreeHost(buffer)));
+    }
+    for (auto buffer : slot.input_buffers) {
+      GE_IF_BOOL_EXEC(buffer != nullptr, GE_CHK_RT(rtFree(buffer)));
+    }
+    for (auto buffer : slot.output_buffers) {
+      GE_IF_BOOL_EXEC(buffer != nullptr, GE_CHK_RT(rtFree(buffer)));
+    }
+    for (auto buffer : slot.output_host_buffers) {
+      GE_IF_BOOL_EXEC(buffer != nullptr, GE_CHK_RT(rtFreeHost(buffer)));
+    }
+    GE_IF_BOOL_EXEC(slot.input_ready != nullptr, GE_CHK_RT(rtEventDestroy(slot.input_ready)));
+    GE_IF_BOOL_EXEC(slot.compute_done != nullptr, GE_CHK_RT(rtEventDestroy(slot.compute_done)));
+    GE_IF_BOOL_EXEC(slot.output_ready != nullptr, GE_CHK_RT(rtEventDestroy(slot.output_ready)));
+  }
+  pipeline_slots_.clear();
+  if (copy_in_stream_ != nullptr) {
+    GE_CHK_RT(rtStreamDestroy(copy_in_stream_));
+    copy_in_stream_ = nullptr;
+  }
+  if (copy_out_stream_ != nullptr) {
+    GE_CHK_RT(rtStreamDestroy(copy_out_stream_));
+    copy_out_stream_ = nullptr;
+  }
+}
+
+void DavinciModel::RunPipelined() {
+  GELOGI("Model run pipelined, slot num:%zu, model id:%u.", pipeline_slots_.size(), model_id_);
+  size_t next_slot = 0;
+  while (RunFlag()) {
+    if (data_inputer_ == nullptr) {
+      GELOGW("Data inputer is nullptr.");
+      CsaInteract::GetInstance().StoreInternalErrorCode(FAILED, ERROR_MODULE_FMK, JOBSUBSTATE_GRAPH_EXEC);
+      break;
+    }
+    // nothing more to overlap with, return results in flight instead of holding them until next request
+    if (data_inputer_->IsDataEmpty()) {
+      CompletePipeline(next_slot);
+    }
+
+    std::shared_ptr<InputDataWrapper> data_wrapper;
+    Status ret = data_inputer_->Pop(data_wrapper);
+    if (data_wrapper == nullptr || ret != SUCCESS) {
+      GELOGI("data_wrapper is null!");
+      continue;
+    }
+    GE_IF_BOOL_EXEC(!RunFlag(), break);
+
+    PipelineSlot &slot = pipeline_slots_[next_slot];
+    next_slot = (next_slot + 1) % pipeline_slots_.size();
+    if (slot.in_flight) {
+      CompleteSlot(slot);
+    }
+
+    uint32_t data_index = data_wrapper->GetInput().index;
+    GELOGI("Model thread Run begin, model id:%u, data index:%u.", model_id_, data_index);
+    ret = SubmitToSlot(slot, data_wrapper);
+    if (ret != SUCCESS) {
+      GELOGE(ret, "Submit data to model failed, model id:%u, data index:%u.", model_id_, data_index);
+      // wait for copies submitted before failure, which may still use buffers of the slot
+      GE_CHK_RT(rtStreamSynchronize(copy_in_stream_));
+      GE_CHK_RT(rtStreamSynchronize(rt_model_stream_));
+      GE_CHK_RT(rtStreamSynchronize(copy_out_stream_));
+      slot.in_flight = false;
+      (void)ReturnResult(data_index, false, false, data_wrapper->GetOutput());
+      CsaInteract::GetInstance().StoreInternalErrorCode(ret, ERROR_MODULE_FMK, JOBSUBSTATE_GRAPH_EXEC);
+      continue;
+    }
+    iterator_count_++;
+    is_first_execute_ = false;
+    GELOGI("run iterator count is %lu", iterator_count_);
+  }
+  CompletePipeline(next_slot);
+}
+
+Status DavinciModel::SubmitToSlot(PipelineSlot &slot, const std::shared_ptr<InputDataWrapper> &data_wrapper) {
+  const std::vector<DataBuffer> &input_blobs = data_wrapper->GetInput().blobs;
+  OutputData *output_data = data_wrapper->GetOutput();
+  GE_CHECK_NOTNULL(output_data);
+  output_data->index = data_wrapper->GetInput().index;
+  output_data->model_id = model_id_;
+  slot.outputs.clear();
+  uint32_t data_index = 0;
+  for (auto &op_desc : output_op_list_) {
+    GE_CHK_STATUS_RET(GenOutputTensorInfo(op_desc, data_index, output_data, slot.outputs),
+                      "Generate output tensor info failed.");
+    data_index += op_desc->GetInputsSize();
+  }
+  const std::vector<DataBuffer> &output_blobs = output_data->blobs;
+  if (output_blobs.size() != new_output_data_info_.size()) {
+    GELOGE(FAILED, "Output data buffer num=%zu not equal model data num=%zu", output_blobs.size(),
+           new_output_data_info_.size());
+    return FAILED;
+  }
+  for (const auto &output : new_output_data_info_) {
+    uint64_t mem_size = static_cast<uint64_t>(output.second.GetDataSize());
+    if (output.first >= output_blobs.size()) {
+      GELOGE(FAILED, "Blobs not match: blobs=%zu, tensor=%zu, index=%u", output_blobs.size(),
+             new_output_data_info_.size(), output.first);
+      return FAILED;
+    }
+    uint64_t buffer_length = output_blobs[output.first].length;
+    if ((buffer_length != 0) && (mem_size != 0) && (buffer_length < mem_size)) {
+      GELOGE(FAILED, "Tensor data size=%lu, buffer size=%lu, output tensor index=%u", mem_size, buffer_length,
+             output.first);
+      return FAILED;
+    }
+  }
+
+  // upload inputs to the slot, overlapping with execution of the previous request
+  size_t index = 0;
+  for (const auto &data : new_input_data_info_) {
+    if (data.first >= input_blobs.size()) {
+      GELOGE(FAILED, "Blobs not match: blobs=%zu, tensor=%zu, index=%u", input_blobs.size(),
+             new_input_data_info_.size(), data.first);
+      return FAILED;
+    }
+    const DataBuffer &data_buf = input_blobs[data.first];
+    uint64_t data_size = data.second.GetDataSize();
+    GE_CHK_BOOL_RET_STATUS(data_size >= data_buf.length, PARAM_INVALID,
+                           "input data size(%lu) does not match model required size(%lu), ret failed.", data_buf.length,
+                           data_size);
+    void *host_buffer = slot.input_host_buffers[index];
+    void *buffer = slot.input_buffers[index++];
+    if (data_buf.length > 0) {
+      auto ret = memcpy_s(host_buffer, data_size, data_buf.data, data_buf.length);
+      if (ret != EOK) {
+        GELOGE(INTERNAL_ERROR, "Failed to stage input %u, size %lu, err-code %d", data.first, data_buf.length, ret);
+        return INTERNAL_ERROR;
+      }
+      GE_CHK_RT_RET(rtMemcpyAsync(buffer, data_size, host_buffer, data_buf.length, RT_MEMCPY_HOST_TO_DEVICE,
+                                  copy_in_stream_));
+    }
+  }
+  GE_CHK_RT_RET(rtEventRecord(slot.input_ready, copy_in_stream_));
+
+  // execute with inputs of the slot, then move outputs to the slot before next request overwrites them
+  GE_CHK_RT_RET(rtStreamWaitEvent(rt_model_stream_, slot.input_ready));
+  index = 0;
+  for (const auto &data : new_input_data_info_) {
+    const DataBuffer &data_buf = input_blobs[data.first];
+    void *buffer = slot.input_buffers[index++];
+    if (data_buf.length > 0) {
+      GE_CHK_RT_RET(rtMemcpyAsync(data.second.GetBasicAddr(), data.second.GetDataSize(), buffer, data_buf.length,
+                                  RT_MEMCPY_DEVICE_TO_DEVICE, rt_model_stream_));
+    }
+  }
+  GE_CHK_RT_RET(rtModelExecute(rt_model_handle_, rt_model_stream_, 0));
+  index = 0;
+  for (const auto &output : new_output_data_info_) {
+    uint64_t mem_size = static_cast<uint64_t>(output.second.GetDataSize());
+    void *buffer = slot.output_buffers[index++];
+    if ((output_blobs[output.first].length == 0) || (mem_size == 0)) {
+      GELOGI("Length of data is zero, No need copy. output tensor index=%u", output.first);
+      continue;
+    }
+    GE_CHK_RT_RET(rtMemcpyAsync(buffer, mem_size, output.second.GetBasicAddr(), mem_size, RT_MEMCPY_DEVICE_TO_DEVICE,
+                                rt_model_stream_));
+  }
+  GE_CHK_RT_RET(rtEventRecord(slot.compute_done, rt_model_stream_));
+
+  // download outputs, overlapping with execution of the next request
+  GE_CHK_RT_RET(rtStreamWaitEvent(copy_out_stream_, slot.compute_done));
+  index = 0;
+  for (const auto &output : new_output_data_info_) {
+    uint64_t mem_size = static_cast<uint64_t>(output.second.GetDataSize());
+    void *slot_buffer = slot.output_buffers[index];
+    void *host_buffer = slot.output_host_buffers[index++];
+    if ((output_blobs[output.first].length == 0) || (mem_size == 0)) {
+      continue;
+    }
+    GE_CHK_RT_RET(
+      rtMemcpyAsync(host_buffer, mem_size, slot_buffer, mem_size, RT_MEMCPY_DEVICE_TO_HOST, copy_out_stream_));
+  }
+  GE_CHK_RT_RET(rtEventRecord(slot.output_ready, copy_out_stream_));
+
+  slot.data_wrapper = data_wrapper;
+  slot.in_flight = true;
+  return SUCCESS;
+}
+
+void DavinciModel::CompleteSlot(PipelineSlot &slot) {
+  slot.in_flight = false;
+  std::shared_ptr<InputDataWrapper> data_wrapper = std::move(slot.data_wrapper);
+  uint32_t data_index = data_wrapper->GetInput().index;
+  rtError_t rt_ret = rtEventSynchronize(slot.output_ready);
+  if (rt_ret != RT_ERROR_NONE) {
+    bool seq_end_flag = rt_ret == RT_ERROR_END_OF_SEQUENCE;
+    GELOGW("Wait for output of data index %u failed, ret: 0x%X, seq_end_flg: %d", data_index, rt_ret, seq_end_flag);
+    Status ret = seq_end_flag ? END_OF_SEQUENCE : INTERNAL_ERROR;
+    GE_CHK_STATUS(listener_->OnComputeDone(model_id_, data_index, ret, slot.outputs), "OnComputeDone failed.");
+    CsaInteract::GetInstance().StoreInternalErrorCode(rt_ret, ERROR_MODULE_RUNTIME, JOBSUBSTATE_GRAPH_EXEC);
+    return;
+  }
+
+  // outputs are downloaded to the pinned buffers of slot, hand them over to user buffers
+  const std::vector<DataBuffer> &output_blobs = data_wrapper->GetOutput()->blobs;
+  size_t index = 0;
+  for (const auto &output : new_output_data_info_) {
+    const DataBuffer &buffer = output_blobs[output.first];
+    uint64_t mem_size = static_cast<uint64_t>(output.second.GetDataSize());
+    void *host_buffer = slot.output_host_buffers[index++];
+    if ((buffer.length == 0) || (mem_size == 0)) {
+      continue;
+    }
+    auto ret = memcpy_s(buffer.data, buffer.length, host_buffer, mem_size);
+    if (ret != EOK) {
+      GELOGE(INTERNAL_ERROR, "Failed to copy output %u of data index %u, err-code %d", output.first, data_index, ret);
+      GE_CHK_STATUS(listener_->OnComputeDone(model_id_, data_index, INTERNAL_ERROR, slot.outputs),
+                    "OnComputeDone failed.");
+      CsaInteract::GetInstance().StoreInternalErrorCode(INTERNAL_ERROR, ERROR_MODULE_FMK, JOBSUBSTATE_GRAPH_EXEC);
+      return;
+    }
+  }
+  GE_CHK_STATUS(listener_->OnComputeDone(model_id_, data_index, SUCCESS, slot.outputs), "OnComputeDone failed.");
+}
+
+void DavinciModel::CompletePipeline(size_t oldest_slot) {
+  for (size_t i = 0; i < pipeline_slots_.size(); ++i) {
+    PipelineSlot &slot = pipeline_slots_[(oldest_slot + i) % pipeline_slots_.size()];
+    if (slot.in_flight) {
+      CompleteSlot(slot);
+    }
+  }
+}
+
 ///
 /// @ingroup ge
 /// @brief call API provided by data inputer to destroy thread
@@ -2538,6 +2906,19 @@ Status DavinciModel::ModelRunStart() {
   int64_t maxDumpOpNum = std::strtol(opt.c_str(), nullptr, kDecimal);
   maxDumpOpNum_ = maxDumpOpNum;
 
+  pipeline_slot_num_ = 0;
+  const char *slot_num = std::getenv(kEnvPipelineSlotNum);
+  if (slot_num != nullptr) {
+    char *end = nullptr;
+    int64_t num = std::strtol(slot_num, &end, kDecimal);
+    if (end != slot_num && *end == '\0' && num >= 0 && num <= kMaxPipelineSlotNum) {
+      pipeline_slot_num_ = static_cast<uint32_t>(num);
+    } else {
+      GELOGW("Invalid %s: %s, should be in [0, %ld], pipelined run is disabled.", kEnvPipelineSlotNum, slot_num,
+             kMaxPipelineSlotNum);
+    }
+  }
+
   CREATE_STD_THREAD(thread_id_, DavinciModel::Run, this);
   GELOGI("model tread create success, model id:%u.", model_id_);
   return SUCCESS;
@@ -2681,12 +3062,31 @@ Status DavinciModel::InitTaskInfo(domi::ModelTaskDef &model_task_def) {
   task_list_.resize(model_task_def.task_size());
   for (int i = 0; i < model_task_def.task_size(); ++i) {
     // dynamic shape will create task_list_ before
-    const domi::TaskDef &task = model_task_def.task(i);
     if (this->task_list_[i] == nullptr) {
-      task_list_[i] = TaskInfoFactory::Instance().Create(static_cast<rtModelTaskType_t>(task.type()));
+      task_list_[i] = TaskInfoFactory::Instance().Create(static_cast<rtModelTaskType_t>(model_task_def.task(i).type()));
     }
     GE_CHECK_NOTNULL(task_list_[i]);
+  }
+
+  // known node computes args offset of each task in task order, so its tasks are always initialized serially
+  std::vector<std::vector<ZeroCopyAddrRecord>> zero_copy_addrs;
+  if (init_thread_num_ > 1 && !known_node_) {
+    GE_CHK_STATUS_RET(InitTaskInfoParallel(model_task_def, zero_copy_addrs), "Init tasks in parallel failed.");
+  }
+
+  for (int i = 0; i < model_task_def.task_size(); ++i) {
+    const domi::TaskDef &task = model_task_def.task(i);
+    if (!zero_copy_addrs.empty() && IsParallelInitTask(task.type())) {
+      // apply in task order, so that zero copy tasks are the same as serial initialization
+      for (const auto &record : zero_copy_addrs[i]) {
+        SetZeroCopyAddr(record.op_desc, record.outside_addrs, record.info.empty() ? nullptr : record.info.data(),
+                        record.args, record.size, record.offset);
+      }
+      continue;
+    }
+    init_task_index_ = i;
     Status ret = task_list_[i]->Init(task, this);
+    init_task_index_ = -1;
     if (ret != SUCCESS) {
       GELOGE(ret, "Task index %d init failed.", i);
       return ret;
@@ -2696,6 +3096,55 @@ Status DavinciModel::InitTaskInfo(domi::ModelTaskDef &model_task_def) {
   return SUCCESS;
 }
 
+///
+/// @ingroup ge
+/// @brief Init tasks which only touch thread-safe state of model, on init_thread_num_ threads.
+/// @param [in] model_task_def: tasks of model.
+/// @param [out] zero_copy_addrs: zero copy addrs set by each task, to be applied in task order.
+/// @return Status
+///
+Status DavinciModel::InitTaskInfoParallel(const domi::ModelTaskDef &model_task_def,
+                                          std::vector<std::vector<ZeroCopyAddrRecord>> &zero_copy_addrs) {
+  std::vector<int> task_indexes;
+  for (int i = 0; i < model_task_def.task_size(); ++i) {
+    if (IsParallelInitTask(model_task_def.task(i).type())) {
+      task_indexes.emplace_back(i);
+    }
+  }
+  if (task_indexes.size() <= 1) {
+    return SUCCESS;
+  }
+
+  rtContext_t ctx = nullptr;
+  GE_CHK_RT_RET(rtCtxGetCurrent(&ctx));
+  zero_copy_addrs.resize(model_task_def.task_size());
+  GE_TIMESTAMP_START(InitTaskInfoParallel);
+  ThreadPool pool(init_thread_num_);
+  Status ret = ParallelRun(pool, init_thread_num_, [&](size_t begin, size_t step) -> Status {
+    rtError_t rt_ret = rtCtxSetCurrent(ctx);
+    if (rt_ret != RT_ERROR_NONE) {
+      GELOGE(RT_FAILED, "Failed to set context, error_code is: 0x%X.", rt_ret);
+      return RT_ERROR_TO_GE_STATUS(rt_ret);
+    }
+    for (size_t i = begin; i < task_indexes.size(); i += step) {
+      int index = task_indexes[i];
+      deferred_zero_copy_addrs_ = &zero_copy_addrs[index];
+      init_task_index_ = index;
+      Status task_ret = task_list_[index]->Init(model_task_def.task(index), this);
+      init_task_index_ = -1;
+      deferred_zero_copy_addrs_ = nullptr;
+      if (task_ret != SUCCESS) {
+        GELOGE(task_ret, "Task index %d init failed.", index);
+        return task_ret;
+      }
+    }
+    return SUCCESS;
+  });
+  GE_TIMESTAMP_END(InitTaskInfoParallel, "GraphLoader::InitTaskInfoParallel.");
+  GELOGI("Init %zu tasks on %u threads, ret: %u.", task_indexes.size(), init_thread_num_, ret);
+  return ret;
+}
+
 Status DavinciModel::MallocKnownArgs() {
   GELOGI("DavinciModel::MallocKnownArgs in");
   const auto &model_task_def = ge_model_->GetModelTaskDefPtr();
@@ -2872,6 +3321,18 @@ void DavinciModel::DisableZeroCopy(const void *addr) {
 ///
 void DavinciModel::SetZeroCopyAddr(const OpDescPtr &op_desc, const std::vector<void *> &outside_addrs, const void *info,
                                    void *args, size_t size, size_t offset) {
+  if (deferred_zero_copy_addrs_ != nullptr) {
+    // task is initialized in parallel, keep a copy of info as it may be released once the task init returns
+    std::vector<uint8_t> info_copy;
+    if (info != nullptr) {
+      const uint8_t *data = static_cast<const uint8_t *>(info);
+      info_copy.assign(data, data + offset + outside_addrs.size() * kAddrLen);
+    }
+    deferred_zero_copy_addrs_->emplace_back(
+      ZeroCopyAddrRecord{op_desc, outside_addrs, std::move(info_copy), args, size, offset});
+    return;
+  }
+
   // Internal call has ensured that op_desc is not nullptr
   GELOGI("[ZCPY] SetZeroCopyAddr for %s.", op_desc->GetName().c_str());
   size_t nums = outside_addrs.size();
@@ -2899,12 +3360,86 @@ void DavinciModel::SetZeroCopyAddr(const OpDescPtr &op_desc, const std::vector<v
   }
 
   std::lock_guard<std::mutex> lock(outside_addrs_mutex_);
+  if (zero_copy_task.IsTaskArgsSet() && zero_copy_args_arena_.Contains(args)) {
+    // args in arena are refreshed as a whole, only offsets of the addrs are needed
+    if (zero_copy_args_arena_.AddTask(zero_copy_task) != SUCCESS) {
+      GELOGW("[ZCPY] Add %s to args arena failed.", op_desc->GetName().c_str());
+    }
+    return;
+  }
   if (zero_copy_task.IsTaskArgsSet()) {
     zero_copy_task.SetOriginalArgs(info, offset + nums * kAddrLen);
     zero_copy_tasks_.emplace_back(zero_copy_task);
   }
 }
 
+///
+/// @ingroup ge
+/// @brief Malloc zero copy args arena for TVM tasks which use address of Data or NetOutput.
+/// @param [in] model_task_def: tasks of model.
+/// @return Status
+///
+Status DavinciModel::InitZeroCopyArgsArena(const domi::ModelTaskDef &model_task_def) {
+  zero_copy_virtual_addrs_.clear();
+  zero_copy_args_offsets_.clear();
+  for (auto *outside_addrs : {&new_input_outside_addrs_, &new_output_outside_addrs_}) {
+    for (auto &data_outside_addrs : *outside_addrs) {
+      for (const auto &addrs_mapping : data_outside_addrs.second.GetOutsideAddrs()) {
+        for (const auto &virtual_args_addrs : addrs_mapping) {
+          zero_copy_virtual_addrs_.insert(virtual_args_addrs.first);
+        }
+      }
+    }
+  }
+
+  // same addrs as KernelTaskInfo::InitTVMTask uses as zero copy key
+  for (int i = 0; i < model_task_def.task_size(); ++i) {
+    const domi::TaskDef &task = model_task_def.task(i);
+    const domi::KernelContext &context = task.kernel().context();
+    if (task.type() != RT_MODEL_TASK_KERNEL ||
+        static_cast<cce::ccKernelType>(context.kernel_type()) != cce::ccKernelType::TE) {
+      continue;
+    }
+    OpDescPtr op_desc = GetOpByIndex(context.op_index());
+    if (op_desc == nullptr) {
+      continue;
+    }
+    vector<void *> io_addrs = ModelUtils::GetInputDataAddrs(runtime_param_, op_desc);
+    const vector<void *> output_data_addrs = ModelUtils::GetOutputDataAddrs(runtime_param_, op_desc);
+    io_addrs.insert(io_addrs.end(), output_data_addrs.begin(), output_data_addrs.end());
+    if (HasZeroCopyAddr(io_addrs)) {
+      zero_copy_args_offsets_[i] = zero_copy_args_arena_.Reserve(task.kernel().args_size());
+    }
+  }
+
+  GELOGI("[ZCPY] Zero copy args arena of %zu tasks.", zero_copy_args_offsets_.size());
+  return zero_copy_args_arena_.Init();
+}
+
+bool DavinciModel::HasZeroCopyAddr(const std::vector<void *> &io_addrs) const {
+  for (const auto addr : io_addrs) {
+    if (zero_copy_virtual_addrs_.count(addr) > 0) {
+      return true;
+    }
+  }
+  return false;
+}
+
+///
+/// @ingroup ge
+/// @brief Malloc args of the task being inited on current thread from zero copy args arena.
+/// @param [in] const std::vector<void *> &io_addrs: virtual address of task inputs and outputs
+/// @param [in] size_t size: size of task args
+/// @return args address in arena, nullptr if task uses no zero copy address or has no args reserved.
+///
+void *DavinciModel::MallocZeroCopyArgs(const std::vector<void *> &io_addrs, size_t size) {
+  auto iter = zero_copy_args_offsets_.find(init_task_index_);
+  if (iter == zero_copy_args_offsets_.end() || !HasZeroCopyAddr(io_addrs)) {
+    return nullptr;
+  }
+  return zero_copy_args_arena_.GetArgs(iter->second, size);
+}
+
 void DavinciModel::SetBatchLabelAddr(const OpDescPtr &op_desc, uintptr_t addr) {
   // Establish a mapping between batch label and zero copy address for multi-batch scenes
   auto it = zero_copy_op_id_batch_label_.find(op_desc->GetId());
@@ -2996,6 +3531,8 @@ Status DavinciModel::CopyModelData(const InputData &input_data, OutputData &outp
   for (ZeroCopyTask &task : zero_copy_tasks_) {
     GE_CHK_STATUS_RET(task.DistributeParam(is_async_mode_ ? rt_model_stream_ : nullptr), "[ZCPY] Update args failed.");
   }
+  GE_CHK_STATUS_RET(zero_copy_args_arena_.DistributeParam(is_async_mode_ ? rt_model_stream_ : nullptr),
+                    "[ZCPY] Update args arena failed.");
 
   output_data.index = input_data.index;
   output_data.model_id = model_id_;
@@ -3062,12 +3599,16 @@ Status DavinciModel::UpdateIoTaskArgs(const std::map<uint32_t, ZeroCopyOffset> &
       GELOGI("[ZCPY] Copy blobs_index %u, virtual_addr: %p, size: %ld, user_data_addr: %p", data.first, addr, size,
              buffer_addr);
       // For input data, just copy for rts task.
+      uintptr_t addr_val = reinterpret_cast<uintptr_t>(addr);
       for (ZeroCopyTask &task : zero_copy_tasks_) {
-        uintptr_t addr_val = reinterpret_cast<uintptr_t>(addr);
         if (task.UpdateTaskParam(addr_val, buffer_addr, zero_copy_batch_label_addrs_, batch_label) != SUCCESS) {
           return FAILED;
         }
       }
+      if (zero_copy_args_arena_.UpdateTaskParam(addr_val, buffer_addr, zero_copy_batch_label_addrs_, batch_label) !=
+          SUCCESS) {
+        return FAILED;
+      }
     }
   }
 
@@ -36,6 +36,7 @@
 #include "graph/load/new_model_manager/data_dumper.h"
 #include "graph/load/new_model_manager/data_inputer.h"
 #include "graph/load/new_model_manager/model_utils.h"
+#include "graph/load/new_model_manager/zero_copy_args_arena.h"
 #include "graph/load/new_model_manager/zero_copy_offset.h"
 #include "graph/load/new_model_manager/zero_copy_task.h"
 #include "graph/model.h"
@@ -426,6 +427,15 @@ class DavinciModel {
   void SetZeroCopyAddr(const OpDescPtr &op_desc, const std::vector<void *> &outside_addrs, const void *info, void *args,
                        size_t size, size_t offset);
 
+  ///
+  /// @ingroup ge
+  /// @brief Malloc args of the task being inited on current thread from zero copy args arena.
+  /// @param [in] const std::vector<void *> &io_addrs: virtual address of task inputs and outputs
+  /// @param [in] size_t size: size of task args
+  /// @return args address in arena, nullptr if task uses no zero copy address or has no args reserved.
+  ///
+  void *MallocZeroCopyArgs(const std::vector<void *> &io_addrs, size_t size);
+
   void SetDynamicSize(const std::vector<uint64_t> &batch_num, int32_t dynamic_type);
 
   bool GetL1FusionEnableOption() { return is_l1_fusion_enable_; }
@@ -579,6 +589,37 @@ class DavinciModel {
 
   Status InitTaskInfo(domi::ModelTaskDef &modelTaskInfo);
 
+  ///
+  /// @ingroup ge
+  /// @brief Malloc zero copy args arena for TVM tasks which use address of Data or NetOutput.
+  ///        Args of the tasks are reserved in task order, whatever order the tasks are inited in.
+  /// @param [in] model_task_def: tasks of model.
+  /// @return Status
+  ///
+  Status InitZeroCopyArgsArena(const domi::ModelTaskDef &model_task_def);
+
+  bool HasZeroCopyAddr(const std::vector<void *> &io_addrs) const;
+
+  // arguments of SetZeroCopyAddr called by a task initialized in parallel
+  struct ZeroCopyAddrRecord {
+    OpDescPtr op_desc;
+    std::vector<void *> outside_addrs;
+    std::vector<uint8_t> info;
+    void *args;
+    size_t size;
+    size_t offset;
+  };
+
+  ///
+  /// @ingroup ge
+  /// @brief Init tasks which only touch thread-safe state of model, on init_thread_num_ threads.
+  /// @param [in] model_task_def: tasks of model.
+  /// @param [out] zero_copy_addrs: zero copy addrs set by each task, to be applied in task order.
+  /// @return Status
+  ///
+  Status InitTaskInfoParallel(const domi::ModelTaskDef &model_task_def,
+                              std::vector<std::vector<ZeroCopyAddrRecord>> &zero_copy_addrs);
+
   void UnbindHcomStream();
 
   Status DistributeTask();
@@ -787,6 +828,50 @@ class DavinciModel {
   Status GenOutputTensorInfo(const OpDescPtr &op_desc, uint32_t data_index, OutputData *output_data,
                              std::vector<ge::OutputTensorInfo> &outputs);
 
+  // Staging buffers and events of one request in flight in pipelined run
+  struct PipelineSlot {
+    std::shared_ptr<InputDataWrapper> data_wrapper;
+    std::vector<ge::OutputTensorInfo> outputs;
+    std::vector<void *> input_host_buffers;   // pinned host buffer of each input, user data is staged in it
+    std::vector<void *> input_buffers;        // device buffer of each input, uploaded on copy in stream
+    std::vector<void *> output_buffers;       // device buffer of each output, downloaded on copy out stream
+    std::vector<void *> output_host_buffers;  // pinned host buffer of each output, copied to user buffer when done
+    rtEvent_t input_ready = nullptr;          // recorded after inputs uploaded
+    rtEvent_t compute_done = nullptr;         // recorded after outputs copied to output buffers
+    rtEvent_t output_ready = nullptr;         // recorded after outputs downloaded
+    bool in_flight = false;
+  };
+
+  ///
+  /// @ingroup ge
+  /// @brief check if requests can be pipelined, that is no per iteration host work depends on the device
+  /// @return true if pipelined run is allowed
+  ///
+  bool CanRunPipelined();
+
+  ///
+  /// @ingroup ge
+  /// @brief create copy streams, staging buffers and events of pipeline slots, ReleasePipeline after failure
+  /// @return Status result
+  ///
+  Status InitPipeline();
+
+  void ReleasePipeline();
+
+  ///
+  /// @ingroup ge
+  /// @brief run loop of pipelined mode: while request k executes, request k+1 is uploaded and k-1 downloaded
+  /// @return None
+  ///
+  void RunPipelined();
+
+  Status SubmitToSlot(PipelineSlot &slot, const std::shared_ptr<InputDataWrapper> &data_wrapper);
+
+  void CompleteSlot(PipelineSlot &slot);
+
+  // complete all requests in flight, starting from the oldest one
+  void CompletePipeline(size_t oldest_slot);
+
   void ParseAIPPInfo(std::string in_out_info, InputOutputDims &dims_info);
   void GetFixedAddrAttr(const OpDescPtr &op_desc);
 
@@ -849,6 +934,10 @@ class DavinciModel {
 
   std::mutex outside_addrs_mutex_;
   std::vector<ZeroCopyTask> zero_copy_tasks_;  // Task used Data or NetOutput addr.
+  ZeroCopyArgsArena zero_copy_args_arena_;     // Args of TVM tasks used Data or NetOutput addr.
+  std::set<const void *> zero_copy_virtual_addrs_;
+  // Offset in arena of args of each task, reserved in task order.
+  std::map<int, size_t> zero_copy_args_offsets_;
   std::set<const void *> copy_only_addrs_;     // Address need copy to original place.
 
   // {op_id, batch_label}
@@ -894,6 +983,13 @@ class DavinciModel {
   static std::mutex tvm_bin_mutex_;  // lock for tvm maps.
   static std::set<std::string> tvm_bin_kernel_;
 
+  // threads to init nodes and tasks, serial if not more than 1
+  uint32_t init_thread_num_ = 0;
+  // set while the task on current thread is initialized in parallel, see InitTaskInfoParallel
+  static thread_local std::vector<ZeroCopyAddrRecord> *deferred_zero_copy_addrs_;
+  // index of the task initialized on current thread, to find its args reserved in zero copy args arena
+  static thread_local int init_task_index_;
+
   std::map<std::string, uint32_t> used_tbe_handle_map_;
 
   // for profiling task and graph info
@@ -932,6 +1028,12 @@ class DavinciModel {
   std::map<string, int64_t> tensor_name_to_peer_output_index_;
   // if model is first execute
   bool is_first_execute_;
+
+  // for pipelined run, only used by run thread
+  uint32_t pipeline_slot_num_ = 0;
+  std::vector<PipelineSlot> pipeline_slots_;
+  rtStream_t copy_in_stream_ = nullptr;
+  rtStream_t copy_out_stream_ = nullptr;
   // for op debug
   std::mutex debug_reg_mutex_;
   bool is_op_debug_reg_ = false;
@@ -790,7 +790,8 @@ Status ModelManager::GenSessionId(uint64_t &session_id) {
 }
 
 Status ModelManager::LoadModelOffline(uint32_t &model_id, const ModelData &model, shared_ptr<ModelListener> listener,
-                                      void *dev_ptr, size_t mem_size, void *weight_ptr, size_t weight_size) {
+                                      void *dev_ptr, size_t mem_size, void *weight_ptr, size_t weight_size,
+                                      const std::shared_ptr<void> &model_data_owner) {
   GE_CHK_BOOL_RET_STATUS(model.key.empty() || access(model.key.c_str(), F_OK) == 0, GE_EXEC_MODEL_KEY_PATH_INVALID,
                          "input key file path %s is invalid, %s", model.key.c_str(), strerror(errno));
   GenModelId(&model_id);
@@ -799,7 +800,7 @@ Status ModelManager::LoadModelOffline(uint32_t &model_id, const ModelData &model
   mmTimespec timespec = mmGetTickCount();
 
   ModelHelper model_helper;
-  Status ret = model_helper.LoadModel(model);
+  Status ret = model_helper.LoadModel(model, model_data_owner);
   if (ret != SUCCESS) {
     GELOGE(ret, "load model failed.");
     return ret;
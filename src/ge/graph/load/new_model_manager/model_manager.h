@@ -54,12 +54,14 @@ class FMK_FUNC_HOST_VISIBILITY FMK_FUNC_DEV_VISIBILITY ModelManager {
   /// @param [in] model including model ptr and size
   /// @param [in] listener used to return result
   /// @param [in/out] info model task generate info
+  /// @param [in] model_data_owner owner of model data, model refers to model data in place if it is set
   /// @return Status run result
   /// @author
   ///
   ge::Status LoadModelOffline(uint32_t &model_id, const ModelData &model,
                               std::shared_ptr<ModelListener> listener = nullptr, void *dev_ptr = nullptr,
-                              size_t mem_size = 0, void *weight_ptr = nullptr, size_t weight_size = 0);
+                              size_t mem_size = 0, void *weight_ptr = nullptr, size_t weight_size = 0,
+                              const std::shared_ptr<void> &model_data_owner = nullptr);
 
   ///
   /// @ingroup domi_ome
@@ -464,6 +464,9 @@ Status KernelTaskInfo::Release() {
   rtError_t ret = rtCtxGetCurrent(&ctx);
 
   if (ret == RT_ERROR_NONE) {
+    if (is_args_in_arena_) {
+      args_ = nullptr;  // freed with arena
+    }
     FreeRtMem(&args_);
     FreeRtMem(&superkernel_device_args_addr_);
     FreeRtMem(&superkernel_dev_nav_table_);
@@ -593,11 +596,19 @@ Status KernelTaskInfo::InitTVMTask(uint16_t offset, const domi::KernelDef &kerne
   tensor_device_addrs.insert(tensor_device_addrs.end(), output_data_addrs.begin(), output_data_addrs.end());
   tensor_device_addrs.insert(tensor_device_addrs.end(), workspace_data_addrs.begin(), workspace_data_addrs.end());
 
-  // malloc args memory
-  rt_ret = rtMalloc(&args_, args_size_, RT_MEMORY_HBM);
-  if (rt_ret != RT_ERROR_NONE) {
-    GELOGE(RT_FAILED, "Call rt api failed, ret: 0x%X", rt_ret);
-    return RT_ERROR_TO_GE_STATUS(rt_ret);
+  vector<void *> virtual_io_addrs;  // use virtual address for zero copy key.
+  virtual_io_addrs.insert(virtual_io_addrs.end(), input_data_addrs.begin(), input_data_addrs.end());
+  virtual_io_addrs.insert(virtual_io_addrs.end(), output_data_addrs.begin(), output_data_addrs.end());
+
+  // malloc args memory, args using Data or NetOutput addr are placed in arena and refreshed by one copy per run
+  args_ = davinci_model_->MallocZeroCopyArgs(virtual_io_addrs, args_size_);
+  is_args_in_arena_ = (args_ != nullptr);
+  if (!is_args_in_arena_) {
+    rt_ret = rtMalloc(&args_, args_size_, RT_MEMORY_HBM);
+    if (rt_ret != RT_ERROR_NONE) {
+      GELOGE(RT_FAILED, "Call rt api failed, ret: 0x%X", rt_ret);
+      return RT_ERROR_TO_GE_STATUS(rt_ret);
+    }
   }
 
   // copy orign args
@@ -644,9 +655,6 @@ Status KernelTaskInfo::InitTVMTask(uint16_t offset, const domi::KernelDef &kerne
     return ge_ret;
   }
 
-  vector<void *> virtual_io_addrs;  // use virtual address for zero copy key.
-  virtual_io_addrs.insert(virtual_io_addrs.end(), input_data_addrs.begin(), input_data_addrs.end());
-  virtual_io_addrs.insert(virtual_io_addrs.end(), output_data_addrs.begin(), output_data_addrs.end());
   davinci_model_->SetZeroCopyAddr(op_desc, virtual_io_addrs, args_info.data(), args_, args_size_, offset);
 
   GELOGD("Do InitTVMTask end");
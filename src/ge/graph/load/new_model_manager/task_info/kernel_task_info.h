@@ -143,6 +143,7 @@ class KernelTaskInfo : public TaskInfo {
 
   void *stub_func_;
   void *args_;
+  bool is_args_in_arena_ = false;  // args_ is owned by zero copy args arena of model
   void *sm_desc_;
   void *flowtable_;
   uint32_t block_dim_;
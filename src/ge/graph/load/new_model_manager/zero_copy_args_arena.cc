@@ -0,0 +1,147 @@
+/**
+ * Copyright 2019-2020 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "graph/load/new_model_manager/zero_copy_args_arena.h"
+
+#include <algorithm>
+
+#include "framework/common/debug/log.h"
+#include "framework/common/util.h"
+
+namespace ge {
+namespace {
+const size_t kArgsAlignSize = 64;
+}  // namespace
+
+ZeroCopyArgsArena::~ZeroCopyArgsArena() { Release(); }
+
+size_t ZeroCopyArgsArena::GetAlignedSize(size_t size) {
+  return (size + kArgsAlignSize - 1) / kArgsAlignSize * kArgsAlignSize;
+}
+
+size_t ZeroCopyArgsArena::Reserve(size_t size) {
+  size_t offset = size_;
+  size_ += GetAlignedSize(size);
+  return offset;
+}
+
+Status ZeroCopyArgsArena::Init() {
+  if (dev_args_ != nullptr) {
+    GELOGE(FAILED, "[ZCPY] args arena has been inited, size: %zu", size_);
+    return FAILED;
+  }
+  if (size_ == 0) {
+    return SUCCESS;
+  }
+
+  void *dev_args = nullptr;
+  GE_CHK_RT_RET(rtMalloc(&dev_args, size_, RT_MEMORY_HBM));
+  dev_args_ = static_cast<uint8_t *>(dev_args);
+  host_args_.assign(size_, 0);
+  GELOGI("[ZCPY] args arena inited, addr: %p, size: %zu", dev_args_, size_);
+  return SUCCESS;
+}
+
+void *ZeroCopyArgsArena::GetArgs(size_t offset, size_t size) const {
+  if (dev_args_ == nullptr || size == 0 || offset > size_ || GetAlignedSize(size) > size_ - offset) {
+    return nullptr;
+  }
+  return dev_args_ + offset;
+}
+
+bool ZeroCopyArgsArena::Contains(const void *args) const {
+  auto addr = static_cast<const uint8_t *>(args);
+  return dev_args_ != nullptr && addr >= dev_args_ && addr < dev_args_ + size_;
+}
+
+Status ZeroCopyArgsArena::AddTask(const ZeroCopyTask &task) {
+  const uint8_t *args = task.GetArgsAddr();
+  if (!Contains(args)) {
+    GELOGE(FAILED, "[ZCPY] args %p of task is not in args arena.", args);
+    return FAILED;
+  }
+
+  std::lock_guard<std::mutex> lock(mutex_);
+  size_t base = static_cast<size_t>(args - dev_args_);
+  for (const auto &addr_offsets : task.GetTaskArgsOffset()) {
+    for (auto offset : addr_offsets.second) {
+      patches_.push_back({addr_offsets.first, base + offset});
+    }
+  }
+  return SUCCESS;
+}
+
+Status ZeroCopyArgsArena::Build() {
+  if (dev_args_ == nullptr) {
+    return SUCCESS;
+  }
+
+  // stable, so that patches of the same addr keep the order they are added
+  std::stable_sort(patches_.begin(), patches_.end(),
+                   [](const ArgsPatch &lhs, const ArgsPatch &rhs) { return lhs.addr < rhs.addr; });
+  // args are written to device by tasks themselves, start from what they wrote
+  GE_CHK_RT_RET(rtMemcpy(host_args_.data(), host_args_.size(), dev_args_, size_, RT_MEMCPY_DEVICE_TO_HOST));
+  GELOGI("[ZCPY] args arena built, size: %zu, patch num: %zu", size_, patches_.size());
+  return SUCCESS;
+}
+
+Status ZeroCopyArgsArena::UpdateTaskParam(uintptr_t addr, void *buffer_addr,
+                                          const map<string, set<uintptr_t>> &batch_addrs, const string &batch_label) {
+  auto it = std::lower_bound(patches_.begin(), patches_.end(), addr,
+                             [](const ArgsPatch &patch, uintptr_t value) { return patch.addr < value; });
+  for (; it != patches_.end() && it->addr == addr; ++it) {
+    uintptr_t args_addr = reinterpret_cast<uintptr_t>(dev_args_ + it->offset);
+    if (!ZeroCopyTask::CheckDynamicBatch(batch_addrs, batch_label, args_addr)) {
+      continue;
+    }
+    *reinterpret_cast<uintptr_t *>(host_args_.data() + it->offset) = reinterpret_cast<uintptr_t>(buffer_addr);
+    is_updated_ = true;
+  }
+  return SUCCESS;
+}
+
+Status ZeroCopyArgsArena::DistributeParam(rtStream_t stream) {
+  if (!is_updated_) {
+    return SUCCESS;
+  }
+
+  is_updated_ = false;
+  rtError_t rt_err = RT_ERROR_NONE;
+  if (stream != nullptr) {
+    rt_err = rtMemcpyAsync(dev_args_, size_, host_args_.data(), size_, RT_MEMCPY_HOST_TO_DEVICE_EX, stream);
+  } else {
+    rt_err = rtMemcpy(dev_args_, size_, host_args_.data(), size_, RT_MEMCPY_HOST_TO_DEVICE);
+  }
+
+  if (rt_err != RT_ERROR_NONE) {
+    GELOGE(RT_FAILED, "[ZCPY] distribute args arena failed, error=0x%x", rt_err);
+    return RT_ERROR_TO_GE_STATUS(rt_err);
+  }
+  GELOGD("[ZCPY] refresh args arena success, addr: %p, size: %zu", dev_args_, size_);
+  return SUCCESS;
+}
+
+void ZeroCopyArgsArena::Release() {
+  if (dev_args_ != nullptr) {
+    GE_CHK_RT(rtFree(dev_args_));
+    dev_args_ = nullptr;
+  }
+  size_ = 0;
+  host_args_.clear();
+  patches_.clear();
+  is_updated_ = false;
+}
+}  // namespace ge
@@ -0,0 +1,140 @@
+/**
+ * Copyright 2019-2020 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef GE_GRAPH_LOAD_NEW_MODEL_MANAGER_ZERO_COPY_ARGS_ARENA_H_
+#define GE_GRAPH_LOAD_NEW_MODEL_MANAGER_ZERO_COPY_ARGS_ARENA_H_
+
+#include <map>
+#include <mutex>
+#include <set>
+#include <string>
+#include <vector>
+
+#include "external/ge/ge_api_error_codes.h"
+#include "graph/load/new_model_manager/zero_copy_task.h"
+#include "runtime/mem.h"
+
+namespace ge {
+// Args of zero copy tasks placed in one device region. User addrs are patched to the host mirror of the region
+// through a flat table of {virtual addr, offset}, then the region is refreshed by a single copy per run.
+class ZeroCopyArgsArena {
+ public:
+  ZeroCopyArgsArena() = default;
+  ~ZeroCopyArgsArena();
+
+  ZeroCopyArgsArena(const ZeroCopyArgsArena &) = delete;
+  ZeroCopyArgsArena &operator=(const ZeroCopyArgsArena &) = delete;
+
+  /**
+   * @ingroup ge
+   * @brief Size of args in arena, aligned.
+   * @param [in] size: args size.
+   * @return: aligned size
+   */
+  static size_t GetAlignedSize(size_t size);
+
+  /**
+   * @ingroup ge
+   * @brief Reserve args of task at the end of arena, before Init.
+   *        Tasks reserve in task order, so the layout does not depend on the order tasks are inited in.
+   * @param [in] size: args size.
+   * @return: offset of args in arena
+   */
+  size_t Reserve(size_t size);
+
+  /**
+   * @ingroup ge
+   * @brief Malloc device memory of arena and its host mirror, for all args reserved.
+   * @return: 0 SUCCESS / others FAILED
+   */
+  Status Init();
+
+  /**
+   * @ingroup ge
+   * @brief Get args of task reserved in arena.
+   * @param [in] offset: offset of args returned by Reserve.
+   * @param [in] size: args size.
+   * @return: args addr / nullptr if arena is not inited or args are out of arena
+   */
+  void *GetArgs(size_t offset, size_t size) const;
+
+  /**
+   * @ingroup ge
+   * @brief Is args malloced from arena.
+   * @param [in] args: args addr.
+   * @return: true / false
+   */
+  bool Contains(const void *args) const;
+
+  /**
+   * @ingroup ge
+   * @brief Add args offsets of zero copy task to patch table, args of task must be malloced from arena.
+   * @param [in] task: zero copy task.
+   * @return: 0 SUCCESS / others FAILED
+   */
+  Status AddTask(const ZeroCopyTask &task);
+
+  /**
+   * @ingroup ge
+   * @brief Sort patch table and read original args to host mirror, called after all tasks inited.
+   * @return: 0 SUCCESS / others FAILED
+   */
+  Status Build();
+
+  /**
+   * @ingroup ge
+   * @brief Set user data addr to args in host mirror.
+   * @param [in] addr: virtual address value from Op.
+   * @param [in] buffer_addr: data buffer_addr from user.
+   * @param [in] batch_addrs: dynamic batch addr info.
+   * @param [in] batch_label: batch label.
+   * @return: 0 SUCCESS / others FAILED
+   */
+  Status UpdateTaskParam(uintptr_t addr, void *buffer_addr, const map<string, set<uintptr_t>> &batch_addrs,
+                         const string &batch_label);
+
+  /**
+   * @ingroup ge
+   * @brief Copy host mirror to device if updated.
+   * @param [in] stream: Stream for asychronous update.
+   * @return: 0 SUCCESS / others FAILED
+   */
+  Status DistributeParam(rtStream_t stream);
+
+  /**
+   * @ingroup ge
+   * @brief Free device memory of arena.
+   * @return: void
+   */
+  void Release();
+
+  size_t GetPatchNum() const { return patches_.size(); }
+
+ private:
+  struct ArgsPatch {
+    uintptr_t addr;  // virtual address value from Op
+    size_t offset;   // offset of the address in arena
+  };
+
+  std::mutex mutex_;
+  uint8_t *dev_args_ = nullptr;
+  size_t size_ = 0;
+  vector<uint8_t> host_args_;
+  vector<ArgsPatch> patches_;
+  bool is_updated_ = false;
+};
+}  // namespace ge
+#endif  // GE_GRAPH_LOAD_NEW_MODEL_MANAGER_ZERO_COPY_ARGS_ARENA_H_
@@ -82,8 +82,20 @@ class ZeroCopyTask {
    */
   ge::Status DistributeParam(rtStream_t stream);
 
- protected:
-  bool CheckDynamicBatch(const map<string, set<uintptr_t>> &batch_addrs, const string &batch_label, uintptr_t addr);
+  /**
+   * @ingroup ge
+   * @brief Check is dynamic batch node.
+   * @param [in] batch_addrs: dynamic batch addr info.
+   * @param [in] batch_label: batch label.
+   * @param [in] addr: args addr to be updated.
+   * @return: true / false
+   */
+  static bool CheckDynamicBatch(const map<string, set<uintptr_t>> &batch_addrs, const string &batch_label,
+                                uintptr_t addr);
+
+  const uint8_t *GetArgsAddr() const { return args_addr_; }
+
+  const map<uintptr_t, vector<size_t>> &GetTaskArgsOffset() const { return task_addr_offset_; }
 
  private:
   const string name_;
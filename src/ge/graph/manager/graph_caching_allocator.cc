@@ -16,12 +16,15 @@
 
 #include "graph/manager/graph_caching_allocator.h"
 
-#include <set>
+#include <algorithm>
+#include <functional>
 #include <string>
+#include <thread>
 #include <utility>
 
 #include "framework/common/debug/ge_log.h"
 #include "graph/manager/graph_mem_allocator.h"
+#include "runtime/rt.h"
 
 namespace ge {
 const size_t bin_ranges[kNumBins] = {kRoundBlockSize * kKByteSize,
@@ -33,14 +36,7 @@ const size_t bin_ranges[kNumBins] = {kRoundBlockSize * kKByteSize,
                                      16 * kGByteSize,
                                      26 * kGByteSize};
 
-static bool BlockComparator(const Block *left, const Block *right) {
-  if (left->size != right->size) {
-    return left->size < right->size;
-  }
-  return reinterpret_cast<uintptr_t>(left->ptr) < reinterpret_cast<uintptr_t>(right->ptr);
-}
-
-bool CanMerge(Block *block) {
+bool CanMerge(CachingBlock *block) {
   if (block == nullptr || block->allocated || !block->IsSplit()) {
     return false;
   }
@@ -79,10 +75,190 @@ size_t GetBlockSize(size_t size) {
   return kRoundBlockSize * ((size + kRoundBlockSize - 1) / kRoundBlockSize);
 }
 
-bool ShouldSplit(const Block *block, size_t size) {
+bool ShouldSplit(const CachingBlock *block, size_t size) {
   return static_cast<double>(size) <= (static_cast<double>(block->size) * kSplitThreshold);
 }
 
+namespace {
+const size_t kMaxReuseScanCount = 32;
+
+uint32_t HighestBit(size_t value) { return 63 - static_cast<uint32_t>(__builtin_clzll(value)); }
+
+///
+/// @ingroup ge_graph
+/// @brief smallest size class whose blocks are all not smaller than size
+/// @param [in] block size
+/// @return size class
+///
+uint32_t GetFitSizeClass(size_t size) {
+  uint32_t size_class = CachingBlockBin::GetSizeClass(size);
+  size_t units = size / kRoundBlockSize;
+  if (units >= kExactSizeClasses) {
+    size_t granularity_mask = (static_cast<size_t>(1) << (HighestBit(units) - kSubClassBits)) - 1;
+    if ((units & granularity_mask) != 0) {
+      ++size_class;
+    }
+  }
+  return size_class;
+}
+
+size_t GetMagazineIndex() {
+  static thread_local size_t index = std::hash<std::thread::id>()(std::this_thread::get_id()) % kNumMagazines;
+  return index;
+}
+
+size_t GetAllocatedShardIndex(const uint8_t *ptr) {
+  return (reinterpret_cast<uintptr_t>(ptr) / kRoundBlockSize) % kNumAllocatedShards;
+}
+
+void UpdatePeak(std::atomic<size_t> &peak, size_t value) {
+  size_t current = peak.load();
+  while (value > current && !peak.compare_exchange_weak(current, value)) {
+  }
+}
+}  // namespace
+
+CachingBlockBin::CachingBlockBin() : block_count_(0), free_bytes_(0) {
+  for (auto &head : heads_) {
+    head = nullptr;
+  }
+  for (auto &word : non_empty_map_) {
+    word = 0;
+  }
+}
+
+uint32_t CachingBlockBin::GetSizeClass(size_t size) {
+  size_t units = size / kRoundBlockSize;
+  if (units < kExactSizeClasses) {
+    return static_cast<uint32_t>(units);
+  }
+  uint32_t msb = HighestBit(units);
+  uint32_t sub_class = static_cast<uint32_t>(units >> (msb - kSubClassBits)) & (kSubClassCount - 1);
+  return kExactSizeClasses + (msb - kSubClassBits - 1) * kSubClassCount + sub_class;
+}
+
+void CachingBlockBin::Insert(CachingBlock *block) {
+  uint32_t size_class = GetSizeClass(block->size);
+  block->free_prev = nullptr;
+  block->free_next = heads_[size_class];
+  if (heads_[size_class] != nullptr) {
+    heads_[size_class]->free_prev = block;
+  }
+  heads_[size_class] = block;
+  non_empty_map_[size_class / 64] |= (static_cast<uint64_t>(1) << (size_class % 64));
+  ++block_count_;
+  free_bytes_ += block->size;
+}
+
+void CachingBlockBin::Erase(CachingBlock *block) {
+  uint32_t size_class = GetSizeClass(block->size);
+  if (block->free_prev != nullptr) {
+    block->free_prev->free_next = block->free_next;
+  } else {
+    heads_[size_class] = block->free_next;
+  }
+  if (block->free_next != nullptr) {
+    block->free_next->free_prev = block->free_prev;
+  }
+  block->free_prev = nullptr;
+  block->free_next = nullptr;
+  if (heads_[size_class] == nullptr) {
+    non_empty_map_[size_class / 64] &= ~(static_cast<uint64_t>(1) << (size_class % 64));
+  }
+  --block_count_;
+  free_bytes_ -= block->size;
+}
+
+size_t CachingBlockBin::LargestBlockSize() const {
+  for (uint32_t word = kSizeClassMapWords; word > 0; --word) {
+    uint64_t bits = non_empty_map_[word - 1];
+    if (bits == 0) {
+      continue;
+    }
+    uint32_t size_class = (word - 1) * 64 + HighestBit(bits);
+    size_t largest = 0;
+    for (CachingBlock *block = heads_[size_class]; block != nullptr; block = block->free_next) {
+      largest = std::max(largest, block->size);
+    }
+    return largest;
+  }
+  return 0;
+}
+
+uint32_t CachingBlockBin::FindNonEmptyClass(uint32_t size_class) const {
+  uint32_t word = size_class / 64;
+  if (word >= kSizeClassMapWords) {
+    return kNumSizeClasses;
+  }
+  uint64_t bits = non_empty_map_[word] & (~static_cast<uint64_t>(0) << (size_class % 64));
+  while (bits == 0) {
+    if (++word >= kSizeClassMapWords) {
+      return kNumSizeClasses;
+    }
+    bits = non_empty_map_[word];
+  }
+  return word * 64 + static_cast<uint32_t>(__builtin_ctzll(bits));
+}
+
+CachingBlock *CachingBlockBin::TakeFit(size_t size, uint8_t *org_ptr) {
+  uint32_t floor_class = GetSizeClass(size);
+  if (org_ptr != nullptr && floor_class < kNumSizeClasses) {
+    size_t scan_count = 0;
+    for (CachingBlock *block = heads_[floor_class]; block != nullptr && scan_count < kMaxReuseScanCount;
+         block = block->free_next, ++scan_count) {
+      if (block->ptr == org_ptr && block->size >= size) {
+        Erase(block);
+        return block;
+      }
+    }
+  }
+
+  uint32_t size_class = FindNonEmptyClass(GetFitSizeClass(size));
+  if (size_class < kNumSizeClasses) {
+    CachingBlock *block = heads_[size_class];
+    Erase(block);
+    return block;
+  }
+
+  // blocks of the floor class may still be large enough, only scan them when nothing else fits
+  if (floor_class < kNumSizeClasses) {
+    for (CachingBlock *block = heads_[floor_class]; block != nullptr; block = block->free_next) {
+      if (block->size >= size) {
+        Erase(block);
+        return block;
+      }
+    }
+  }
+  return nullptr;
+}
+
+CachingBlock *BlockPool::Acquire(uint32_t device_id, size_t size, CachingBlockBin *bin, uint8_t *ptr) {
+  if (free_list_ == nullptr) {
+    std::unique_ptr<CachingBlock[]> chunk(new (std::nothrow) CachingBlock[kBlocksPerChunk]);
+    if (chunk == nullptr) {
+      return nullptr;
+    }
+    for (size_t i = 0; i < kBlocksPerChunk; ++i) {
+      chunk[i].free_next = free_list_;
+      free_list_ = &chunk[i];
+    }
+    chunks_.emplace_back(std::move(chunk));
+  }
+  CachingBlock *block = free_list_;
+  free_list_ = block->free_next;
+  *block = CachingBlock(device_id, size, bin, ptr);
+  return block;
+}
+
+void BlockPool::Release(CachingBlock *block) {
+  if (block == nullptr) {
+    return;
+  }
+  block->free_prev = nullptr;
+  block->free_next = free_list_;
+  free_list_ = block;
+}
+
 CachingAllocator::CachingAllocator(rtMemType_t memory_type) : memory_type_(memory_type), memory_allocator_(nullptr) {
   for (uint32_t i = 0; i < kNumBins; ++i) {
     free_block_bins_[i] = nullptr;
@@ -98,9 +274,9 @@ Status CachingAllocator::Initialize(uint32_t device_id) {
     if (free_block_bins_[i] != nullptr) {
       continue;
     }
-    auto bin_ptr = new (std::nothrow) BlockBin(BlockComparator);
+    auto bin_ptr = new (std::nothrow) CachingBlockBin();
     if (bin_ptr == nullptr) {
-      GELOGE(ge::FAILED, "Alloc BlockBin failed.");
+      GELOGE(ge::FAILED, "Alloc CachingBlockBin failed.");
       return ge::FAILED;
     }
     free_block_bins_[i] = bin_ptr;
@@ -116,15 +292,33 @@ void CachingAllocator::Finalize(uint32_t device_id) {
   GELOGI("Device id %u", device_id);
   FreeBlocks();
   FreeBlockBins();
+  DestroyEvents();
 }
 
 uint8_t *CachingAllocator::Malloc(size_t size, uint8_t *org_ptr, uint32_t device_id) {
   uint8_t *ptr = nullptr;
   size = GetBlockSize(size);
-  Block *block = FindFreeBlock(size, org_ptr, device_id);
+  uint64_t malloc_count = ++malloc_count_;
+  uint64_t dump_interval = stats_dump_interval_;
+  if (dump_interval != 0 && malloc_count % dump_interval == 0) {
+    PrintStats();
+  }
+  CachingBlock *block = nullptr;
+  if (org_ptr == nullptr) {
+    block = PopFromMagazine(size);
+    if (block != nullptr) {
+      ++hit_count_;
+      ++magazine_hit_count_;
+      AddAllocatedBlock(block);
+      return block->ptr;
+    }
+  }
+  block = FindFreeBlock(size, org_ptr, device_id);
   if (block != nullptr) {
+    ++hit_count_;
     ptr = block->ptr;
   } else {
+    ++miss_count_;
     if (ge::SUCCESS == TryExtendCache(size, device_id)) {
       block = FindFreeBlock(size, org_ptr, device_id);
       if (block != nullptr) {
@@ -133,6 +327,7 @@ uint8_t *CachingAllocator::Malloc(size_t size, uint8_t *org_ptr, uint32_t device
     }
   }
   if (ptr == nullptr) {
+    ++malloc_fail_count_;
     GELOGE(FAILED, "Malloc failed device id = %u, size= %zu", device_id, size);
   }
   return ptr;
@@ -145,19 +340,216 @@ Status CachingAllocator::Free(uint8_t *ptr, uint32_t device_id) {
     return ge::PARAM_INVALID;
   }
 
-  std::lock_guard<std::recursive_mutex> lock(mutex_);
-  auto it = allocated_blocks_.find(ptr);
-  if (it == allocated_blocks_.end()) {
+  CachingBlock *block = RemoveAllocatedBlock(ptr);
+  if (block == nullptr) {
     GELOGE(PARAM_INVALID, "Invalid memory pointer");
     return ge::PARAM_INVALID;
   }
-  Block *block = it->second;
-  allocated_blocks_.erase(it);
+  ++free_count_;
+  if (PushToMagazine(block)) {
+    return ge::SUCCESS;
+  }
+  std::lock_guard<std::recursive_mutex> lock(mutex_);
   FreeBlock(block);
   return ge::SUCCESS;
 }
 
-void CachingAllocator::FreeBlock(Block *block) {
+uint8_t *CachingAllocator::MallocOnStream(size_t size, rtStream_t stream, uint8_t *org_ptr, uint32_t device_id) {
+  if (stream != nullptr && org_ptr == nullptr && pending_bytes_ > 0) {
+    std::lock_guard<std::recursive_mutex> lock(mutex_);
+    ProcessPendingBlocks(false);
+    CachingBlock *block = TakePendingBlock(GetBlockSize(size), stream);
+    if (block != nullptr) {
+      ++malloc_count_;
+      ++hit_count_;
+      AddAllocatedBlock(block);
+      GELOGI("Reuse block freed on stream, device id = %u, size= %zu", device_id, block->size);
+      return block->ptr;
+    }
+  }
+  return Malloc(size, org_ptr, device_id);
+}
+
+Status CachingAllocator::FreeOnStream(uint8_t *ptr, rtStream_t stream, uint32_t device_id) {
+  if (stream == nullptr) {
+    return Free(ptr, device_id);
+  }
+  GELOGI("Free on stream device id = %u", device_id);
+  if (ptr == nullptr) {
+    GELOGE(PARAM_INVALID, "Invalid memory pointer");
+    return ge::PARAM_INVALID;
+  }
+
+  CachingBlock *block = RemoveAllocatedBlock(ptr);
+  if (block == nullptr) {
+    GELOGE(PARAM_INVALID, "Invalid memory pointer");
+    return ge::PARAM_INVALID;
+  }
+  ++free_count_;
+
+  std::lock_guard<std::recursive_mutex> lock(mutex_);
+  rtEvent_t event = nullptr;
+  if (!free_events_.empty()) {
+    event = free_events_.back();
+    free_events_.pop_back();
+  } else if (rtEventCreate(&event) != RT_ERROR_NONE) {
+    event = nullptr;
+  }
+  if (event == nullptr || rtEventRecord(event, stream) != RT_ERROR_NONE) {
+    // without an event the block can only be reused after all work on stream is done
+    GELOGW("Failed to record event for block size = %zu, synchronize stream before free", block->size);
+    if (event != nullptr) {
+      RecycleEvent(event);
+    }
+    (void)rtStreamSynchronize(stream);
+    FreeBlock(block);
+    return ge::SUCCESS;
+  }
+  pending_blocks_[stream].push_back({block, event});
+  pending_bytes_ += block->size;
+  return ge::SUCCESS;
+}
+
+void CachingAllocator::ReleaseStream(rtStream_t stream) {
+  std::lock_guard<std::recursive_mutex> lock(mutex_);
+  // handle of a destroyed stream may be given to a new stream, which must not see blocks of the old one
+  auto it = pending_blocks_.find(stream);
+  if (it == pending_blocks_.end()) {
+    return;
+  }
+  for (auto &pending : it->second) {
+    if (rtEventSynchronize(pending.event) != RT_ERROR_NONE) {
+      GELOGW("Failed to synchronize event of block size = %zu", pending.block->size);
+    }
+    pending_bytes_ -= pending.block->size;
+    RecycleEvent(pending.event);
+    FreeBlock(pending.block);
+  }
+  pending_blocks_.erase(it);
+}
+
+void CachingAllocator::ProcessPendingBlocks(bool wait) {
+  for (auto it = pending_blocks_.begin(); it != pending_blocks_.end();) {
+    auto &blocks = it->second;
+    // events of one stream complete in record order
+    while (!blocks.empty()) {
+      PendingBlock &pending = blocks.front();
+      rtError_t ret = wait ? rtEventSynchronize(pending.event) : rtEventQuery(pending.event);
+      if (ret != RT_ERROR_NONE) {
+        if (!wait) {
+          break;
+        }
+        GELOGW("Failed to synchronize event of block size = %zu, ret = %d", pending.block->size, ret);
+      }
+      pending_bytes_ -= pending.block->size;
+      RecycleEvent(pending.event);
+      FreeBlock(pending.block);
+      blocks.pop_front();
+    }
+    if (blocks.empty()) {
+      it = pending_blocks_.erase(it);
+    } else {
+      ++it;
+    }
+  }
+}
+
+CachingBlock *CachingAllocator::TakePendingBlock(size_t size, rtStream_t stream) {
+  auto it = pending_blocks_.find(stream);
+  if (it == pending_blocks_.end()) {
+    return nullptr;
+  }
+  CachingBlockBin *bin = GetBlockBin(size);
+  auto &blocks = it->second;
+  for (auto block_it = blocks.begin(); block_it != blocks.end(); ++block_it) {
+    CachingBlock *block = block_it->block;
+    // the block is handed out as a whole, so skip blocks that the normal path would split
+    if (block->bin != bin || block->size < size || ShouldSplit(block, size)) {
+      continue;
+    }
+    pending_bytes_ -= block->size;
+    RecycleEvent(block_it->event);
+    blocks.erase(block_it);
+    if (blocks.empty()) {
+      pending_blocks_.erase(it);
+    }
+    return block;
+  }
+  return nullptr;
+}
+
+void CachingAllocator::RecycleEvent(rtEvent_t event) { free_events_.push_back(event); }
+
+void CachingAllocator::DestroyEvents() {
+  std::lock_guard<std::recursive_mutex> lock(mutex_);
+  for (auto event : free_events_) {
+    if (rtEventDestroy(event) != RT_ERROR_NONE) {
+      GELOGW("Failed to destroy event");
+    }
+  }
+  free_events_.clear();
+}
+
+void CachingAllocator::AddAllocatedBlock(CachingBlock *block) {
+  auto &shard = allocated_shards_[GetAllocatedShardIndex(block->ptr)];
+  std::lock_guard<std::mutex> lock(shard.mutex);
+  shard.blocks[block->ptr] = block;
+  UpdatePeak(peak_allocated_bytes_, allocated_bytes_ += block->size);
+}
+
+CachingBlock *CachingAllocator::RemoveAllocatedBlock(uint8_t *ptr) {
+  auto &shard = allocated_shards_[GetAllocatedShardIndex(ptr)];
+  std::lock_guard<std::mutex> lock(shard.mutex);
+  auto it = shard.blocks.find(ptr);
+  if (it == shard.blocks.end()) {
+    return nullptr;
+  }
+  CachingBlock *block = it->second;
+  shard.blocks.erase(it);
+  allocated_bytes_ -= block->size;
+  return block;
+}
+
+CachingBlock *CachingAllocator::PopFromMagazine(size_t size) {
+  if (size > kMagazineMaxBlockSize) {
+    return nullptr;
+  }
+  size_t size_class = size / kRoundBlockSize - 1;
+  auto &magazine = magazines_[GetMagazineIndex()];
+  std::lock_guard<std::mutex> lock(magazine.mutex);
+  if (magazine.counts[size_class] == 0) {
+    return nullptr;
+  }
+  return magazine.blocks[size_class][--magazine.counts[size_class]];
+}
+
+bool CachingAllocator::PushToMagazine(CachingBlock *block) {
+  // block stays marked as allocated while cached, so neighbours never merge with it
+  if (block->size > kMagazineMaxBlockSize) {
+    return false;
+  }
+  size_t size_class = block->size / kRoundBlockSize - 1;
+  auto &magazine = magazines_[GetMagazineIndex()];
+  std::lock_guard<std::mutex> lock(magazine.mutex);
+  if (magazine.counts[size_class] >= kMagazineCapacity) {
+    return false;
+  }
+  magazine.blocks[size_class][magazine.counts[size_class]++] = block;
+  return true;
+}
+
+void CachingAllocator::DrainMagazines() {
+  for (auto &magazine : magazines_) {
+    std::lock_guard<std::mutex> lock(magazine.mutex);
+    for (uint32_t i = 0; i < kMagazineSizeClasses; ++i) {
+      while (magazine.counts[i] > 0) {
+        FreeBlock(magazine.blocks[i][--magazine.counts[i]]);
+      }
+    }
+  }
+}
+
+void CachingAllocator::FreeBlock(CachingBlock *block) {
   if (block == nullptr || !block->allocated) {
     return;
   }
@@ -166,14 +558,14 @@ void CachingAllocator::FreeBlock(Block *block) {
   std::lock_guard<std::recursive_mutex> lock(mutex_);
   block->allocated = false;
   auto &bin = *block->bin;
-  Block *merge_blocks[] = {block->prev, block->next};
-  for (Block *merge_block : merge_blocks) {
+  CachingBlock *merge_blocks[] = {block->prev, block->next};
+  for (CachingBlock *merge_block : merge_blocks) {
     MergeBlocks(block, merge_block, bin);
   }
-  bin.insert(block);
+  bin.Insert(block);
 }
 
-void CachingAllocator::MergeBlocks(Block *dst, Block *src, BlockBin &bin) {
+void CachingAllocator::MergeBlocks(CachingBlock *dst, CachingBlock *src, CachingBlockBin &bin) {
   if (!CanMerge(dst) || !CanMerge(src)) {
     return;
   }
@@ -192,50 +584,43 @@ void CachingAllocator::MergeBlocks(Block *dst, Block *src, BlockBin &bin) {
   }
 
   dst->size += src->size;
-  bin.erase(src);
-  delete src;
+  bin.Erase(src);
+  block_pool_.Release(src);
 }
 
-BlockBin *CachingAllocator::GetBlockBin(size_t size) {
+CachingBlockBin *CachingAllocator::GetBlockBin(size_t size) {
   size_t index = GetBinIndex(size);
   return free_block_bins_[index];
 }
 
-Block *CachingAllocator::FindFreeBlock(size_t size, uint8_t *org_ptr, uint32_t device_id) {
-  // org_ptr - 1, try to find ptr same as org_ptr
-  Block key(device_id, size, (org_ptr == nullptr ? nullptr : org_ptr - 1));
-  BlockBin *bin = GetBlockBin(size);
+CachingBlock *CachingAllocator::FindFreeBlock(size_t size, uint8_t *org_ptr, uint32_t device_id) {
+  CachingBlockBin *bin = GetBlockBin(size);
   if (bin == nullptr) {
     GELOGE(ge::FAILED, "Get block bin failed size = %zu", size);
     return nullptr;
   }
   std::lock_guard<std::recursive_mutex> lock(mutex_);
-  auto it = bin->lower_bound(&key);
-  if (it != bin->end()) {
-    Block *block = *it;
-    bin->erase(it);
-    if (block != nullptr) {
-      GELOGI("Find block size = %zu", block->size);
-      if (ShouldSplit(block, size)) {
-        block = SplitBlock(block, size, *bin, device_id);
-      }
-
-      if (block->ptr != nullptr) {
-        block->allocated = true;
-        allocated_blocks_[block->ptr] = block;
-        GELOGI("Malloc device id = %u, size= %zu", device_id, size);
-      }
+  CachingBlock *block = bin->TakeFit(size, org_ptr);
+  if (block != nullptr) {
+    GELOGI("Find block size = %zu", block->size);
+    if (ShouldSplit(block, size)) {
+      block = SplitBlock(block, size, *bin, device_id);
     }
 
+    if (block->ptr != nullptr) {
+      block->allocated = true;
+      AddAllocatedBlock(block);
+      GELOGI("Malloc device id = %u, size= %zu", device_id, size);
+    }
     return block;
   }
   return nullptr;
 }
 
-Block *CachingAllocator::SplitBlock(Block *block, size_t size, BlockBin &bin, uint32_t device_id) {
+CachingBlock *CachingAllocator::SplitBlock(CachingBlock *block, size_t size, CachingBlockBin &bin, uint32_t device_id) {
   // block has been checked, should not be nullptr
-  Block *remaining = block;
-  Block *new_block = new (std::nothrow) Block(device_id, size, &bin, block->ptr);
+  CachingBlock *remaining = block;
+  CachingBlock *new_block = block_pool_.Acquire(device_id, size, &bin, block->ptr);
   if (new_block == nullptr) {
     GELOGE(ge::FAILED, "Alloc block failed size = %zu", size);
     return block;
@@ -248,7 +633,7 @@ Block *CachingAllocator::SplitBlock(Block *block, size_t size, BlockBin &bin, ui
   remaining->prev = new_block;
   remaining->ptr = remaining->ptr + size;
   remaining->size -= size;
-  bin.insert(remaining);
+  bin.Insert(remaining);
   return new_block;
 }
 
@@ -258,6 +643,7 @@ Status CachingAllocator::TryExtendCache(size_t size, uint32_t device_id) {
   auto memory_addr = memory_allocator_->MallocMemory(purpose, memory_size, device_id);
   // try to free caches and malloc again when malloc memory failed
   if (memory_addr == nullptr) {
+    ++free_cached_count_;
     FreeCachedBlocks();
     memory_addr = memory_allocator_->MallocMemory(purpose, memory_size, device_id);
     if (memory_addr == nullptr) {
@@ -270,48 +656,52 @@ Status CachingAllocator::TryExtendCache(size_t size, uint32_t device_id) {
     (void)memory_allocator_->FreeMemory(memory_addr);
     return ge::FAILED;
   }
+  ++extend_count_;
+  UpdatePeak(peak_cached_bytes_, cached_bytes_ += memory_size);
   return ge::SUCCESS;
 }
 
 Status CachingAllocator::AddToBlockBin(uint8_t *ptr, size_t size, uint32_t device_id) {
-  BlockBin *bin = GetBlockBin(size);
+  CachingBlockBin *bin = GetBlockBin(size);
   if (bin == nullptr) {
     GELOGE(ge::FAILED, "Get block bin failed size = %zu", size);
     return ge::FAILED;
   }
-  Block *block = new (std::nothrow) Block(device_id, size, bin, nullptr);
+  std::lock_guard<std::recursive_mutex> lock(mutex_);
+  CachingBlock *block = block_pool_.Acquire(device_id, size, bin, ptr);
   if (block == nullptr) {
     GELOGE(ge::FAILED, "Alloc block failed size = %zu", size);
     return ge::FAILED;
   }
 
-  GELOGI("Block size = %zu", size);
-  block->ptr = ptr;
-  block->size = size;
-
-  std::lock_guard<std::recursive_mutex> lock(mutex_);
-  bin->insert(block);
+  GELOGI("CachingBlock size = %zu", size);
+  bin->Insert(block);
   return ge::SUCCESS;
 }
 
 void CachingAllocator::FreeCachedBlocks() {
   GELOGI("Free cached blocks");
   std::lock_guard<std::recursive_mutex> lock(mutex_);
+  ProcessPendingBlocks(true);
+  DrainMagazines();
   for (uint32_t i = 0; i < kNumBins; ++i) {
     auto pool = free_block_bins_[i];
-    if (pool == nullptr) {
+    if (pool == nullptr || pool->Empty()) {
       continue;
     }
-    for (auto it = pool->begin(); it != pool->end();) {
-      Block *block = *it;
-      // free block memory that has not been split
-      if ((block != nullptr) && (block->ptr != nullptr) && (block->prev == nullptr) && (block->next == nullptr) &&
-          (memory_allocator_->FreeMemory(block->ptr) == ge::SUCCESS)) {
-        pool->erase(it++);
-        delete block;
-        continue;
+    for (uint32_t size_class = 0; size_class < kNumSizeClasses; ++size_class) {
+      CachingBlock *block = pool->Head(size_class);
+      while (block != nullptr) {
+        CachingBlock *next = block->free_next;
+        // free block memory that has not been split
+        if ((block->ptr != nullptr) && (block->prev == nullptr) && (block->next == nullptr) &&
+            (memory_allocator_->FreeMemory(block->ptr) == ge::SUCCESS)) {
+          cached_bytes_ -= block->size;
+          pool->Erase(block);
+          block_pool_.Release(block);
+        }
+        block = next;
       }
-      ++it;
     }
   }
 }
@@ -319,11 +709,16 @@ void CachingAllocator::FreeCachedBlocks() {
 void CachingAllocator::FreeBlocks() {
   GELOGI("Free blocks");
   std::lock_guard<std::recursive_mutex> lock(mutex_);
+  DrainMagazines();
   // free allocated blocks and put to cache
-  for (auto &it : allocated_blocks_) {
-    FreeBlock(it.second);
+  for (auto &shard : allocated_shards_) {
+    std::lock_guard<std::mutex> shard_lock(shard.mutex);
+    for (auto &it : shard.blocks) {
+      allocated_bytes_ -= it.second->size;
+      FreeBlock(it.second);
+    }
+    shard.blocks.clear();
   }
-  allocated_blocks_.clear();
 
   FreeCachedBlocks();
 }
@@ -338,4 +733,60 @@ void CachingAllocator::FreeBlockBins() {
     }
   }
 }
+
+void CachingAllocator::GetStats(CachingAllocatorStats &stats) const {
+  std::lock_guard<std::recursive_mutex> lock(mutex_);
+  stats.cached_bytes = cached_bytes_;
+  stats.peak_cached_bytes = peak_cached_bytes_;
+  stats.allocated_bytes = allocated_bytes_;
+  stats.peak_allocated_bytes = peak_allocated_bytes_;
+  stats.malloc_count = malloc_count_;
+  stats.free_count = free_count_;
+  stats.hit_count = hit_count_;
+  stats.magazine_hit_count = magazine_hit_count_;
+  stats.miss_count = miss_count_;
+  stats.extend_count = extend_count_;
+  stats.free_cached_count = free_cached_count_;
+  stats.malloc_fail_count = malloc_fail_count_;
+  stats.pending_bytes = pending_bytes_;
+  stats.magazine_bytes = 0;
+  for (auto &magazine : magazines_) {
+    std::lock_guard<std::mutex> magazine_lock(magazine.mutex);
+    for (uint32_t i = 0; i < kMagazineSizeClasses; ++i) {
+      stats.magazine_bytes += magazine.counts[i] * (i + 1) * kRoundBlockSize;
+    }
+  }
+  for (uint32_t i = 0; i < kNumBins; ++i) {
+    BinStats &bin_stats = stats.bins[i];
+    const CachingBlockBin *bin = free_block_bins_[i];
+    bin_stats.free_bytes = (bin == nullptr) ? 0 : bin->FreeBytes();
+    bin_stats.free_block_count = (bin == nullptr) ? 0 : bin->BlockCount();
+    bin_stats.largest_free_block = (bin == nullptr) ? 0 : bin->LargestBlockSize();
+  }
+}
+
+void CachingAllocator::PrintStats() const {
+  CachingAllocatorStats stats;
+  GetStats(stats);
+  GELOGI("Caching allocator memory type[%u]: cached %zu (peak %zu), allocated %zu (peak %zu), in magazines %zu, "
+         "pending on streams %zu.",
+         memory_type_, stats.cached_bytes, stats.peak_cached_bytes, stats.allocated_bytes, stats.peak_allocated_bytes,
+         stats.magazine_bytes, stats.pending_bytes);
+  GELOGI("Caching allocator memory type[%u]: malloc %lu, free %lu, hit %lu (magazine %lu), miss %lu, extend %lu, "
+         "free cached on oom %lu, malloc failed %lu.",
+         memory_type_, stats.malloc_count, stats.free_count, stats.hit_count, stats.magazine_hit_count,
+         stats.miss_count, stats.extend_count, stats.free_cached_count, stats.malloc_fail_count);
+  for (uint32_t i = 0; i < kNumBins; ++i) {
+    const BinStats &bin_stats = stats.bins[i];
+    if (bin_stats.free_block_count == 0) {
+      continue;
+    }
+    // fragmentation: share of free bytes that can not be served by the largest free block
+    double fragmentation =
+      1.0 - static_cast<double>(bin_stats.largest_free_block) / static_cast<double>(bin_stats.free_bytes);
+    GELOGI("Caching allocator bin[%u] range %zu: free %zu in %zu blocks, largest %zu, fragmentation %.2f.", i,
+           bin_ranges[i], bin_stats.free_bytes, bin_stats.free_block_count, bin_stats.largest_free_block,
+           fragmentation);
+  }
+}
 }  // namespace ge
@@ -17,6 +17,8 @@
 #ifndef GE_GRAPH_MANAGER_GRAPH_CACHING_ALLOCATOR_H_
 #define GE_GRAPH_MANAGER_GRAPH_CACHING_ALLOCATOR_H_
 
+#include <atomic>
+#include <deque>
 #include <iostream>
 #include <map>
 #include <memory>
@@ -38,28 +40,159 @@ constexpr size_t kKByteSize = 1024;
 constexpr size_t kMByteSize = 1024 * 1024;
 constexpr size_t kGByteSize = 1024 * 1024 * 1024;
 
-struct Block;
-typedef bool (*Comparison)(const Block *, const Block *);
-using BlockBin = std::set<Block *, Comparison>;
 static const uint32_t kNumBins = 8;
 
-struct Block {
-  uint32_t device_id;  // npu device id
-  size_t size;         // block size in bytes
-  BlockBin *bin;       // owning block bin
-  uint8_t *ptr;        // memory address
-  bool allocated;      // in-use flag
-  Block *prev;         // prev block if split from a larger allocation
-  Block *next;         // next block if split from a larger allocation
+// size classes of a bin: sizes below kExactSizeClasses units keep one class per unit,
+// larger sizes are split into kSubClassCount classes per power of two
+constexpr uint32_t kSubClassBits = 4;
+constexpr uint32_t kSubClassCount = 1U << kSubClassBits;
+constexpr uint32_t kExactSizeClasses = 2 * kSubClassCount;
+constexpr uint32_t kNumSizeClasses = kSubClassCount + (64 - kSubClassBits) * kSubClassCount;
+constexpr uint32_t kSizeClassMapWords = (kNumSizeClasses + 63) / 64;
+
+// thread magazines cache freed blocks up to kMagazineMaxBlockSize so that hot sizes bypass the global lock
+constexpr uint32_t kNumMagazines = 8;
+constexpr uint32_t kMagazineCapacity = 8;
+constexpr size_t kMagazineMaxBlockSize = 64 * kKByteSize;
+constexpr uint32_t kMagazineSizeClasses = kMagazineMaxBlockSize / kRoundBlockSize;
+constexpr uint32_t kNumAllocatedShards = 16;
+
+class CachingBlockBin;
+
+struct CachingBlock {
+  uint32_t device_id;       // npu device id
+  size_t size;              // block size in bytes
+  CachingBlockBin *bin;     // owning block bin
+  uint8_t *ptr;             // memory address
+  bool allocated;           // in-use flag
+  CachingBlock *prev;       // prev block if split from a larger allocation
+  CachingBlock *next;       // next block if split from a larger allocation
+  CachingBlock *free_prev;  // prev block in the same size class free list
+  CachingBlock *free_next;  // next block in the same size class free list, or in the block pool
+
+  CachingBlock() : CachingBlock(0, 0, nullptr, nullptr) {}
+
+  CachingBlock(uint32_t device, size_t size, CachingBlockBin *bin, uint8_t *ptr)
+      : device_id(device),
+        size(size),
+        bin(bin),
+        ptr(ptr),
+        allocated(false),
+        prev(nullptr),
+        next(nullptr),
+        free_prev(nullptr),
+        free_next(nullptr) {}
 
-  Block(uint32_t device, size_t size, BlockBin *bin, uint8_t *ptr)
-      : device_id(device), size(size), bin(bin), ptr(ptr), allocated(0), prev(nullptr), next(nullptr) {}
+  bool IsSplit() const { return (prev != nullptr) || (next != nullptr); }
+};
 
-  // constructor for search key
-  Block(uint32_t device, size_t size, uint8_t *ptr)
-      : device_id(device), size(size), bin(nullptr), ptr(ptr), allocated(0), prev(nullptr), next(nullptr) {}
+///
+/// @ingroup ge_graph
+/// @brief free blocks of one bin, segregated by size class into intrusive lists.
+///        A bitmap of non-empty classes makes the fit lookup O(1).
+///
+class CachingBlockBin {
+ public:
+  CachingBlockBin();
 
-  bool IsSplit() const { return (prev != nullptr) || (next != nullptr); }
+  void Insert(CachingBlock *block);
+
+  void Erase(CachingBlock *block);
+
+  ///
+  /// @ingroup ge_graph
+  /// @brief find a free block not smaller than size and take it out of the bin
+  /// @param [in] size block size
+  /// @param [in] org_ptr address to reuse if it is free and fits
+  /// @return block ptr, nullptr if no block fits
+  ///
+  CachingBlock *TakeFit(size_t size, uint8_t *org_ptr);
+
+  bool Empty() const { return block_count_ == 0; }
+
+  size_t BlockCount() const { return block_count_; }
+
+  size_t FreeBytes() const { return free_bytes_; }
+
+  size_t LargestBlockSize() const;
+
+  CachingBlock *Head(uint32_t size_class) const { return heads_[size_class]; }
+
+  static uint32_t GetSizeClass(size_t size);
+
+ private:
+  uint32_t FindNonEmptyClass(uint32_t size_class) const;
+
+  CachingBlock *heads_[kNumSizeClasses];
+  uint64_t non_empty_map_[kSizeClassMapWords];
+  size_t block_count_;
+  size_t free_bytes_;
+};
+
+///
+/// @ingroup ge_graph
+/// @brief arena of block metadata, blocks are recycled through an intrusive free list instead of new/delete
+///
+class BlockPool {
+ public:
+  BlockPool() = default;
+
+  BlockPool(const BlockPool &) = delete;
+
+  BlockPool &operator=(const BlockPool &) = delete;
+
+  ~BlockPool() = default;
+
+  CachingBlock *Acquire(uint32_t device_id, size_t size, CachingBlockBin *bin, uint8_t *ptr);
+
+  void Release(CachingBlock *block);
+
+ private:
+  static const size_t kBlocksPerChunk = 256;
+  std::vector<std::unique_ptr<CachingBlock[]>> chunks_;
+  CachingBlock *free_list_ = nullptr;
+};
+
+struct BinStats {
+  size_t free_bytes = 0;          // bytes of free blocks in the bin
+  size_t free_block_count = 0;    // number of free blocks in the bin
+  size_t largest_free_block = 0;  // size of the largest free block
+};
+
+struct CachingAllocatorStats {
+  size_t cached_bytes = 0;          // device memory held by the allocator
+  size_t peak_cached_bytes = 0;     // high-water mark of cached_bytes
+  size_t allocated_bytes = 0;       // bytes of blocks in use
+  size_t peak_allocated_bytes = 0;  // high-water mark of allocated_bytes
+  size_t magazine_bytes = 0;        // bytes of freed blocks kept by thread magazines
+  size_t pending_bytes = 0;         // bytes of stream ordered frees whose event has not completed
+  uint64_t malloc_count = 0;
+  uint64_t free_count = 0;
+  uint64_t hit_count = 0;           // malloc served from cache, including magazine hits
+  uint64_t magazine_hit_count = 0;  // malloc served by thread magazines
+  uint64_t miss_count = 0;          // malloc that had to extend the cache
+  uint64_t extend_count = 0;        // successful TryExtendCache
+  uint64_t free_cached_count = 0;   // FreeCachedBlocks triggered by out of memory
+  uint64_t malloc_fail_count = 0;
+  BinStats bins[kNumBins];
+};
+
+// freed small blocks cached for reuse, shared by the threads hashed onto it
+struct BlockMagazine {
+  std::mutex mutex;
+  uint32_t counts[kMagazineSizeClasses] = {};
+  CachingBlock *blocks[kMagazineSizeClasses][kMagazineCapacity] = {};
+};
+
+// block freed on a stream, reusable by other streams once event completes
+struct PendingBlock {
+  CachingBlock *block;
+  rtEvent_t event;
+};
+
+struct AllocatedShard {
+  std::mutex mutex;
+  std::unordered_map<uint8_t *, CachingBlock *> blocks;
 };
 
 class MemoryAllocator;
@@ -108,6 +241,58 @@ class CachingAllocator {
   ///
   Status Free(uint8_t *memory_addr, uint32_t device_id = 0);
 
+  ///
+  /// @ingroup ge_graph
+  /// @brief malloc memory used by stream, blocks freed on the same stream are reused without waiting
+  /// @param [in] size memory size
+  /// @param [in] stream stream the memory is used on
+  /// @param [in] try to reuse the same memory
+  /// @param [in] device id
+  /// @return  memory address
+  ///
+  uint8_t *MallocOnStream(size_t size, rtStream_t stream, uint8_t *org_ptr = nullptr, uint32_t device_id = 0);
+
+  ///
+  /// @ingroup ge_graph
+  /// @brief free memory after the work queued on stream, no synchronization is needed by caller
+  /// @param [in] memory_addr memory address
+  /// @param [in] stream last stream the memory is used on
+  /// @param [in] device_id device id
+  /// @return Status result of function
+  ///
+  Status FreeOnStream(uint8_t *memory_addr, rtStream_t stream, uint32_t device_id = 0);
+
+  ///
+  /// @ingroup ge_graph
+  /// @brief wait for blocks freed on stream and return them to bins, called before the stream is destroyed
+  /// @param [in] stream stream to be destroyed
+  /// @return void
+  ///
+  void ReleaseStream(rtStream_t stream);
+
+  ///
+  /// @ingroup ge_graph
+  /// @brief get snapshot of memory usage and counters
+  /// @param [out] stats allocator statistics
+  /// @return void
+  ///
+  void GetStats(CachingAllocatorStats &stats) const;
+
+  ///
+  /// @ingroup ge_graph
+  /// @brief print statistics to log
+  /// @return void
+  ///
+  void PrintStats() const;
+
+  ///
+  /// @ingroup ge_graph
+  /// @brief print statistics every interval malloc calls, 0 disables periodic dump
+  /// @param [in] interval malloc count between two dumps
+  /// @return void
+  ///
+  void SetStatsDumpInterval(uint64_t interval) { stats_dump_interval_ = interval; }
+
  private:
   ///
   /// @ingroup ge_graph
@@ -125,7 +310,7 @@ class CachingAllocator {
   /// @param [in] device_id device id
   /// @return block ptr
   ///
-  Block *FindFreeBlock(size_t size, uint8_t *org_ptr, uint32_t device_id);
+  CachingBlock *FindFreeBlock(size_t size, uint8_t *org_ptr, uint32_t device_id);
 
   ///
   /// @ingroup ge_graph
@@ -133,7 +318,7 @@ class CachingAllocator {
   /// @param [in] original malloc size
   /// @return block bin
   ///
-  BlockBin *GetBlockBin(size_t size);
+  CachingBlockBin *GetBlockBin(size_t size);
 
   ///
   /// @ingroup ge_graph
@@ -151,7 +336,7 @@ class CachingAllocator {
   /// @param [in] block ptr
   /// @return void
   ///
-  void FreeBlock(Block *block);
+  void FreeBlock(CachingBlock *block);
 
   ///
   /// @ingroup ge_graph
@@ -182,7 +367,7 @@ class CachingAllocator {
   /// @param [out] block bin
   /// @return void
   ///
-  void MergeBlocks(Block *dst, Block *src, BlockBin &bin);
+  void MergeBlocks(CachingBlock *dst, CachingBlock *src, CachingBlockBin &bin);
 
   ///
   /// @ingroup ge_graph
@@ -193,7 +378,55 @@ class CachingAllocator {
   /// @param [in] device id
   /// @return splited block ptr
   ///
-  Block *SplitBlock(Block *block, size_t size, BlockBin &bin, uint32_t device_id);
+  CachingBlock *SplitBlock(CachingBlock *block, size_t size, CachingBlockBin &bin, uint32_t device_id);
+
+  ///
+  /// @ingroup ge_graph
+  /// @brief take a cached block of the exact size from the magazine of current thread
+  /// @param [in] block size
+  /// @return block ptr, nullptr if magazine has no such block
+  ///
+  CachingBlock *PopFromMagazine(size_t size);
+
+  ///
+  /// @ingroup ge_graph
+  /// @brief cache a freed block in the magazine of current thread
+  /// @param [in] block ptr
+  /// @return true if block is cached, false if it should be returned to the bin
+  ///
+  bool PushToMagazine(CachingBlock *block);
+
+  ///
+  /// @ingroup ge_graph
+  /// @brief return all blocks cached by magazines to bins, must be called with mutex_ held
+  /// @return void
+  ///
+  void DrainMagazines();
+
+  ///
+  /// @ingroup ge_graph
+  /// @brief return blocks of completed stream ordered frees to bins, must be called with mutex_ held
+  /// @param [in] wait wait for all pending events instead of polling
+  /// @return void
+  ///
+  void ProcessPendingBlocks(bool wait);
+
+  ///
+  /// @ingroup ge_graph
+  /// @brief take a block freed on the same stream, must be called with mutex_ held
+  /// @param [in] block size
+  /// @param [in] stream
+  /// @return block ptr, nullptr if no pending block fits
+  ///
+  CachingBlock *TakePendingBlock(size_t size, rtStream_t stream);
+
+  void RecycleEvent(rtEvent_t event);
+
+  void DestroyEvents();
+
+  void AddAllocatedBlock(CachingBlock *block);
+
+  CachingBlock *RemoveAllocatedBlock(uint8_t *ptr);
 
  private:
   rtMemType_t memory_type_;
@@ -204,11 +437,39 @@ class CachingAllocator {
   // lock around all operations
   mutable std::recursive_mutex mutex_;
 
-  // allocated blocks by memory pointer
-  std::unordered_map<uint8_t *, Block *> allocated_blocks_;
+  // allocated blocks by memory pointer, sharded by address
+  AllocatedShard allocated_shards_[kNumAllocatedShards];
 
   // block bins by different block size
-  BlockBin *free_block_bins_[kNumBins];
+  CachingBlockBin *free_block_bins_[kNumBins];
+
+  // metadata of all blocks, guarded by mutex_
+  BlockPool block_pool_;
+
+  // freed small blocks, indexed by thread
+  mutable BlockMagazine magazines_[kNumMagazines];
+
+  // stream ordered frees in record order of each stream, guarded by mutex_
+  std::map<rtStream_t, std::deque<PendingBlock>> pending_blocks_;
+
+  // events ready to be recorded again, guarded by mutex_
+  std::vector<rtEvent_t> free_events_;
+
+  // statistics, updated without mutex_ on the magazine path
+  std::atomic<size_t> cached_bytes_{0};
+  std::atomic<size_t> peak_cached_bytes_{0};
+  std::atomic<size_t> allocated_bytes_{0};
+  std::atomic<size_t> peak_allocated_bytes_{0};
+  std::atomic<size_t> pending_bytes_{0};
+  std::atomic<uint64_t> malloc_count_{0};
+  std::atomic<uint64_t> free_count_{0};
+  std::atomic<uint64_t> hit_count_{0};
+  std::atomic<uint64_t> magazine_hit_count_{0};
+  std::atomic<uint64_t> miss_count_{0};
+  std::atomic<uint64_t> extend_count_{0};
+  std::atomic<uint64_t> free_cached_count_{0};
+  std::atomic<uint64_t> malloc_fail_count_{0};
+  std::atomic<uint64_t> stats_dump_interval_{0};
 };
 }  // namespace ge
 #endif  // GE_GRAPH_MANAGER_GRAPH_CACHING_ALLOCATOR_H_
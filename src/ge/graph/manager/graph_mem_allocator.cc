@@ -17,6 +17,7 @@
 #include "graph/manager/graph_mem_allocator.h"
 #include "graph/manager/graph_caching_allocator.h"
 
+#include <cstdlib>
 #include <set>
 #include <string>
 #include <utility>
@@ -24,6 +25,25 @@
 #include "framework/common/debug/ge_log.h"
 
 namespace ge {
+namespace {
+// malloc count between two dumps of caching allocator statistics, dump is disabled when not set
+const char *const kEnvMemoryStatsDumpInterval = "GE_MEMORY_STATS_DUMP_INTERVAL";
+
+uint64_t GetStatsDumpInterval() {
+  const char *interval_env = std::getenv(kEnvMemoryStatsDumpInterval);
+  if (interval_env == nullptr) {
+    return 0;
+  }
+  char *end = nullptr;
+  uint64_t interval = std::strtoull(interval_env, &end, 10);
+  if (end == interval_env || *end != '\0') {
+    GELOGW("Invalid %s: %s, statistics dump is disabled.", kEnvMemoryStatsDumpInterval, interval_env);
+    return 0;
+  }
+  return interval;
+}
+}  // namespace
+
 void MemoryAllocator::Initialize(uint32_t device_id) {
   GELOGI("MemoryAllocator::Initialize");
 
@@ -194,6 +214,7 @@ void MemManager::Finalize() noexcept {
   // caching allocator use memory allocator, so finalize it first
   for (auto &caching_allocator : caching_allocator_map_) {
     if (caching_allocator.second != nullptr) {
+      caching_allocator.second->PrintStats();
       caching_allocator.second->Finalize();
       delete caching_allocator.second;
       caching_allocator.second = nullptr;
@@ -231,6 +252,7 @@ MemoryAllocator *MemManager::GetMemoryAllocator(rtMemType_t memory_type) {
 
 Status MemManager::InitCachingAllocator(const std::vector<rtMemType_t> &memory_type) {
   CachingAllocator *caching_allocator = nullptr;
+  uint64_t stats_dump_interval = GetStatsDumpInterval();
   for (unsigned int index : memory_type) {
     auto it = caching_allocator_map_.find(index);
     if (it == caching_allocator_map_.end()) {
@@ -252,6 +274,7 @@ Status MemManager::InitCachingAllocator(const std::vector<rtMemType_t> &memory_t
       if (caching_allocator->Initialize() != ge::SUCCESS) {
         return ge::INTERNAL_ERROR;
       }
+      caching_allocator->SetStatsDumpInterval(stats_dump_interval);
     }
   }
   return ge::SUCCESS;
@@ -278,4 +301,15 @@ CachingAllocator &MemManager::GetCachingAllocator(rtMemType_t memory_type) {
 CachingAllocator &MemManager::CachingInstance(rtMemType_t memory_type) {
   return Instance().GetCachingAllocator(memory_type);
 }
+
+Status MemManager::GetCachingStats(rtMemType_t memory_type, CachingAllocatorStats &stats) {
+  std::lock_guard<std::recursive_mutex> lock(allocator_mutex_);
+  auto it = caching_allocator_map_.find(memory_type);
+  if (it == caching_allocator_map_.end() || it->second == nullptr) {
+    GELOGW("Caching allocator of memory type[%u] is not initialized.", memory_type);
+    return ge::PARAM_INVALID;
+  }
+  it->second->GetStats(stats);
+  return ge::SUCCESS;
+}
 }  // namespace ge
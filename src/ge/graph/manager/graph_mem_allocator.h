@@ -136,6 +136,7 @@ class MemoryAllocator {
 
 using MemoryAllocatorPtr = std::shared_ptr<MemoryAllocator>;
 class CachingAllocator;
+struct CachingAllocatorStats;
 
 class MemManager {
  public:
@@ -161,6 +162,15 @@ class MemManager {
   ///
   void Finalize() noexcept;
 
+  ///
+  /// @ingroup ge_graph
+  /// @brief get statistics of caching allocator
+  /// @param [in] memory_type memory type
+  /// @param [out] stats allocator statistics
+  /// @return Status result of function
+  ///
+  Status GetCachingStats(rtMemType_t memory_type, CachingAllocatorStats &stats);
+
  private:
   ///
   /// @ingroup ge_graph
@@ -15,6 +15,9 @@
  */
 
 #include "graph/manager/rdma_pool_allocator.h"
+
+#include <algorithm>
+
 #include "framework/common/debug/ge_log.h"
 #include "graph/manager/graph_mem_allocator.h"
 
@@ -98,6 +101,7 @@ uint8_t *RdmaPoolAllocator::Malloc(size_t size, uint32_t device_id) {
   auto aligned_size = GetAlignedBlockSize(size);
   Block key(device_id, aligned_size, nullptr);
   std::lock_guard<std::recursive_mutex> lock(mutex_);
+  ++malloc_count_;
   auto it = block_bin_.lower_bound(&key);
   if (it != block_bin_.end()) {
     Block *block = *it;
@@ -115,6 +119,8 @@ uint8_t *RdmaPoolAllocator::Malloc(size_t size, uint32_t device_id) {
         new (std::nothrow) Block(device_id, block->size - aligned_size, nullptr, block->ptr + aligned_size);
       if (new_block == nullptr) {
         GELOGW("Block split failed");
+        allocated_bytes_ += block->size;
+        peak_allocated_bytes_ = std::max(peak_allocated_bytes_, allocated_bytes_);
         return block->ptr;
       }
       new_block->next = block->next;
@@ -126,8 +132,11 @@ uint8_t *RdmaPoolAllocator::Malloc(size_t size, uint32_t device_id) {
       block->size = aligned_size;
       block_bin_.insert(new_block);
     }
+    allocated_bytes_ += block->size;
+    peak_allocated_bytes_ = std::max(peak_allocated_bytes_, allocated_bytes_);
     return block->ptr;
   }
+  ++malloc_fail_count_;
   return nullptr;
 }
 
@@ -146,6 +155,7 @@ Status RdmaPoolAllocator::Free(uint8_t *memory_addr, uint32_t device_id) {
   }
   Block *block = it->second;
   block->allocated = false;
+  allocated_bytes_ -= block->size;
   allocated_blocks_.erase(it);
   block_bin_.insert(block);
   // Each time merge with its pre and next.
@@ -176,4 +186,16 @@ Status RdmaPoolAllocator::GetBaseAddr(uint64_t &base_addr, uint64_t &mem_size) {
   mem_size = rdma_mem_size_;
   return SUCCESS;
 }
+
+void RdmaPoolAllocator::GetStats(RdmaPoolStats &stats) const {
+  std::lock_guard<std::recursive_mutex> lock(mutex_);
+  stats.pool_bytes = rdma_mem_size_;
+  stats.allocated_bytes = allocated_bytes_;
+  stats.peak_allocated_bytes = peak_allocated_bytes_;
+  stats.free_block_count = block_bin_.size();
+  // block bin is ordered by size
+  stats.largest_free_block = block_bin_.empty() ? 0 : (*block_bin_.rbegin())->size;
+  stats.malloc_count = malloc_count_;
+  stats.malloc_fail_count = malloc_fail_count_;
+}
 }  // namespace ge
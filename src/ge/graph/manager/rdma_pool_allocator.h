@@ -33,6 +33,16 @@
 namespace ge {
 class MemoryAllocator;
 
+struct RdmaPoolStats {
+  size_t pool_bytes = 0;            // total rdma pool size
+  size_t allocated_bytes = 0;       // bytes of blocks in use
+  size_t peak_allocated_bytes = 0;  // high-water mark of allocated_bytes
+  size_t free_block_count = 0;      // number of free blocks
+  size_t largest_free_block = 0;    // size of the largest free block
+  uint64_t malloc_count = 0;
+  uint64_t malloc_fail_count = 0;
+};
+
 class RdmaPoolAllocator {
  public:
   explicit RdmaPoolAllocator(rtMemType_t memory_type);
@@ -54,6 +64,8 @@ class RdmaPoolAllocator {
 
   Status GetBaseAddr(uint64_t &base_addr, uint64_t &mem_size);
 
+  void GetStats(RdmaPoolStats &stats) const;
+
  private:
   void MergeBlockNearby(Block *pre_block, Block *block);
 
@@ -63,6 +75,10 @@ class RdmaPoolAllocator {
   MemoryAllocator *memory_allocator_ = nullptr;
   BlockBin block_bin_;  // Save all rdma blocks.
   std::unordered_map<uint8_t *, Block *> allocated_blocks_;
+  size_t allocated_bytes_ = 0;
+  size_t peak_allocated_bytes_ = 0;
+  uint64_t malloc_count_ = 0;
+  uint64_t malloc_fail_count_ = 0;
   // lock around all operations
   mutable std::recursive_mutex mutex_;
 };
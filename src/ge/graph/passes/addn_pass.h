@@ -29,6 +29,7 @@ namespace ge {
 class AddNPass : public BaseNodePass {
  public:
   Status Run(ge::NodePtr &node) override;
+  bool NeedRun(const NodePtr &node) const override { return node != nullptr && node->GetType() == ADDN; }
 };
 }  // namespace ge
 
@@ -16,6 +16,7 @@
 
 #include "graph/passes/base_pass.h"
 
+#include <chrono>
 #include <queue>
 #include <unordered_set>
 
@@ -66,21 +67,33 @@ void AddNextIterNodes(const Node::Vistor<NodePtr> &nodes, std::queue<NodePtr> &n
 }
 
 Status RunPasses(NodePtr &node, const NamesToPass &names_to_passes, std::unordered_set<NodePtr> &nodes_re_pass,
-                 std::unordered_set<NodePtr> &nodes_deleted, std::unordered_set<Node *> &nodes_seen) {
+                 std::unordered_set<NodePtr> &nodes_deleted, std::unordered_set<Node *> &nodes_seen,
+                 std::vector<NodePassStatistic> &statistics) {
   if (node == nullptr) {
     GELOGE(FAILED, "parameter is null.");
     return FAILED;
   }
   GELOGD("Begin to run pass for node %s", node->GetName().c_str());
-  for (const auto &name_to_pass : names_to_passes) {
+  // passes run twice on nodes with sub graph, do not skip them
+  bool can_skip = node->GetOpDesc() != nullptr && node->GetOpDesc()->GetSubgraphInstanceNames().empty();
+  for (size_t i = 0; i < names_to_passes.size(); ++i) {
+    const auto &name_to_pass = names_to_passes[i];
     if (name_to_pass.second == nullptr) {
       GELOGE(INTERNAL_ERROR, "There is null pointer in passes(%s), skip it", name_to_pass.first.c_str());
       continue;
     }
+    if (can_skip && !name_to_pass.second->NeedRun(node)) {
+      statistics[i].skip_times++;
+      continue;
+    }
 
     GELOGD("Begin to run pass %s for node %s", name_to_pass.first.c_str(), node->GetName().c_str());
     name_to_pass.second->init();
+    auto start_time = std::chrono::steady_clock::now();
     auto result = name_to_pass.second->Run(node);
+    statistics[i].cost_time_us += static_cast<uint64_t>(
+      std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - start_time).count());
+    statistics[i].run_times++;
     if (result != SUCCESS) {
       GELOGE(INTERNAL_ERROR,
              "Failed to process pass %s on node %s, result "
@@ -89,7 +102,11 @@ Status RunPasses(NodePtr &node, const NamesToPass &names_to_passes, std::unorder
       return result;
     }
 
-    auto nodes_to_re_pass = name_to_pass.second->GetNodesNeedRePass();
+    const auto &nodes_to_re_pass = name_to_pass.second->GetNodesNeedRePass();
+    const auto &nodes_deleted_by_pass = name_to_pass.second->GetNodesDeleted();
+    if (!nodes_to_re_pass.empty() || !nodes_deleted_by_pass.empty()) {
+      statistics[i].change_times++;
+    }
     for (const auto &node_to_re_pass : nodes_to_re_pass) {
       if (node_to_re_pass == nullptr) {
         GELOGW("Found null re-pass node when executing %s on node %s type %s", name_to_pass.first.c_str(),
@@ -104,7 +121,6 @@ Status RunPasses(NodePtr &node, const NamesToPass &names_to_passes, std::unorder
       }
     }
 
-    auto nodes_deleted_by_pass = name_to_pass.second->GetNodesDeleted();
     nodes_deleted.insert(nodes_deleted_by_pass.begin(), nodes_deleted_by_pass.end());
     if (nodes_deleted_by_pass.count(node) > 0) {
       GELOGD("The node %s was deleted by pass %s, stop the remain passes", node->GetName().c_str(),
@@ -175,7 +191,17 @@ Status GEPass::Run(const NamesToPass &names_to_passes) {
     return PARAM_INVALID;
   }
 
-  return RunPassesOneGraph(names_to_passes);
+  statistics_.assign(names_to_passes.size(), NodePassStatistic());
+  auto ret = RunPassesOneGraph(names_to_passes);
+  if (depth_ == 1) {
+    for (size_t i = 0; i < names_to_passes.size(); ++i) {
+      const auto &statistic = statistics_[i];
+      GELOGI("Pass %s on graph %s: run %lu times, skipped %lu times, changed %lu times, cost %lu us.",
+             names_to_passes[i].first.c_str(), graph_->GetName().c_str(), statistic.run_times, statistic.skip_times,
+             statistic.change_times, statistic.cost_time_us);
+    }
+  }
+  return ret;
 }
 
 Status GEPass::RunPassesOneGraph(const NamesToPass &names_to_passes) {
@@ -209,7 +235,7 @@ Status GEPass::RunPassesOneGraph(const NamesToPass &names_to_passes) {
 
       AddNextIterNodes(node->GetOutNodes(), nodes, nodes_seen, nodes_last);
 
-      auto ret = RunPasses(node, names_to_passes, nodes_re_pass, nodes_deleted, nodes_seen);
+      auto ret = RunPasses(node, names_to_passes, nodes_re_pass, nodes_deleted, nodes_seen, statistics_);
       if (ret != SUCCESS) {
         GELOGE(ret, "Failed to process passes on node %s type %s, error code: %u", node->GetName().c_str(),
                node->GetType().c_str(), ret);
@@ -226,7 +252,7 @@ Status GEPass::RunPassesOneGraph(const NamesToPass &names_to_passes) {
       if (has_sub_graph) {
         GELOGD("There are subgraphs on node %s, run passes for for the second time", node->GetName().c_str());
         SetFlagOption(kOptimizeAfterSubGraph, names_to_passes);
-        ret = RunPasses(node, names_to_passes, nodes_re_pass, nodes_deleted, nodes_seen);
+        ret = RunPasses(node, names_to_passes, nodes_re_pass, nodes_deleted, nodes_seen, statistics_);
         if (ret != SUCCESS) {
           GELOGE(ret, "Failed to process passes on node %s type %s, error code: %u", node->GetName().c_str(),
                  node->GetType().c_str(), ret);
@@ -270,6 +296,12 @@ Status GEPass::RunPassesOnSubGraph(const NodePtr &node, const NamesToPass &names
     GELOGI("Begin to run passes on the sub graph %s of node %s", name.c_str(), node->GetName().c_str());
     GEPass pass(graph, root_graph_, depth_ + 1);
     auto ret = pass.Run(names_to_passes);
+    for (size_t i = 0; i < pass.statistics_.size() && i < statistics_.size(); ++i) {
+      statistics_[i].run_times += pass.statistics_[i].run_times;
+      statistics_[i].skip_times += pass.statistics_[i].skip_times;
+      statistics_[i].change_times += pass.statistics_[i].change_times;
+      statistics_[i].cost_time_us += pass.statistics_[i].cost_time_us;
+    }
     if (ret != SUCCESS) {
       GELOGE(ret, "Failed to run passes for sub graph %s from node %s", name.c_str(), node->GetName().c_str());
       return ret;
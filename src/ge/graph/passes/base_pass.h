@@ -49,19 +49,33 @@ class BaseNodePass {
   ///
   virtual Status Run(NodePtr &node) = 0;
 
+  ///
+  /// Check whether Run may change anything on the node, called by GEPass right
+  /// before Run, so it must not change the graph. The default is true, which
+  /// means Run is always called.
+  /// @param node
+  /// @return false if Run is sure to do nothing on the node
+  ///
+  virtual bool NeedRun(const NodePtr &node) const { return true; }
+
   virtual ~BaseNodePass() = default;
 
-  std::unordered_set<NodePtr> GetNodesNeedRePass() { return nodes_need_re_pass_; }
+  const std::unordered_set<NodePtr> &GetNodesNeedRePass() const { return nodes_need_re_pass_; }
 
-  std::unordered_set<NodePtr> GetNodesDeleted() { return nodes_deleted_; }
+  const std::unordered_set<NodePtr> &GetNodesDeleted() const { return nodes_deleted_; }
 
   void SetOption(NodePassOption option, const std::string &value) { options_[option] = value; }
 
   void ClearOptions() { options_.clear(); }
 
   void init() {
-    nodes_need_re_pass_.clear();
-    nodes_deleted_.clear();
+    // clear of unordered_set costs as many as its buckets even if it is empty
+    if (!nodes_need_re_pass_.empty()) {
+      nodes_need_re_pass_.clear();
+    }
+    if (!nodes_deleted_.empty()) {
+      nodes_deleted_.clear();
+    }
   }
 
  protected:
@@ -115,12 +129,26 @@ class BaseNodePass {
 
 using NamesToPass = std::vector<std::pair<std::string, BaseNodePass *>>;
 
+struct NodePassStatistic {
+  uint64_t run_times = 0;
+  // times skipped as NeedRun returns false
+  uint64_t skip_times = 0;
+  // times the pass re-passes or deletes nodes
+  uint64_t change_times = 0;
+  uint64_t cost_time_us = 0;
+};
+
 class GEPass {
  public:
   explicit GEPass(ComputeGraphPtr &graph) : graph_(graph), root_graph_(graph), depth_(1) {}
   virtual ~GEPass() = default;
   Status Run(const NamesToPass &names_to_passes);
 
+  ///
+  /// Statistic of the last Run, in the order of names_to_passes, sub graphs included
+  ///
+  const std::vector<NodePassStatistic> &GetStatistics() const { return statistics_; }
+
  private:
   GEPass(ComputeGraphPtr &graph, ComputeGraphPtr &root_graph, int depth)
       : graph_(graph), root_graph_(root_graph), depth_(depth) {}
@@ -129,6 +157,7 @@ class GEPass {
   ComputeGraphPtr graph_;
   ComputeGraphPtr root_graph_;
   int depth_;
+  std::vector<NodePassStatistic> statistics_;
 };
 }  // namespace ge
 
@@ -16,42 +16,18 @@
 
 #include "common_subexpression_elimination_pass.h"
 
-#include <sstream>
-#include <string>
 #include <set>
+#include <string>
+#include <unordered_map>
+#include <vector>
 
+#include "graph/common/graph_hasher.h"
 #include "graph/utils/node_utils.h"
 #include "ge_local_engine/engine/host_cpu_engine.h"
 #include "graph/passes/folding_pass.h"
 
 namespace ge {
 namespace {
-std::string GetCseKey(const NodePtr &node) {
-  std::stringstream ss;
-  ss << node->GetType() << "-data-inputs-";
-  for (auto &in_anchor : node->GetAllInDataAnchors()) {
-    auto src_anchor = in_anchor->GetPeerOutAnchor();
-    if (src_anchor == nullptr) {
-      ss << in_anchor->GetIdx() << "-null-";
-    } else {
-      ss << in_anchor->GetIdx() << "-" << src_anchor->GetOwnerNode()->GetName() << "-" << src_anchor->GetIdx() << "-";
-    }
-  }
-
-  ss << "control-inputs-";
-  std::set<std::string> control_in_node_names;
-  for (auto &src_node : node->GetInControlNodes()) {
-    control_in_node_names.insert(src_node->GetName());
-  }
-  for (auto &name : control_in_node_names) {
-    ss << name << "-";
-  }
-
-  ss << "attrs-" << AttrUtils::GetAllAttrsStr(node->GetOpDesc());
-
-  return ss.str();
-}
-
 /// As the operator category has not been defined, we do not know what types of node can be processed by CSE.
 /// To avoid delete wrong nodes(e.g. stateful nodes),
 /// only nodes have folding kernel will be considered for the CSE process
@@ -62,10 +38,64 @@ bool IsNodeSupportCse(const NodePtr &node) {
   return folding_pass::GetKernelByType(node) != nullptr;
 }
 }  // namespace
+
+/// The key is only used to find candidates in one run of the pass, so the out anchors of input nodes are identified
+/// by address. Nodes with the same key are compared by IsSameCseKey before elimination.
+HashCode128 CommonSubexpressionEliminationPass::GetCseKey(const NodePtr &node) const {
+  StreamHasher hasher;
+  hasher.Update(node->GetType());
+  hasher.Update(static_cast<uint64_t>(node->GetAllInDataAnchorsSize()));
+  for (const auto &in_anchor : node->GetAllInDataAnchors()) {
+    auto src_anchor = in_anchor->GetPeerOutAnchor();
+    hasher.Update(in_anchor->GetIdx());
+    hasher.Update(reinterpret_cast<uintptr_t>(src_anchor.get()));
+  }
+
+  std::set<uintptr_t> control_in_nodes;
+  for (const auto &src_node : node->GetInControlNodes()) {
+    control_in_nodes.insert(reinterpret_cast<uintptr_t>(src_node.get()));
+  }
+  hasher.Update(static_cast<uint64_t>(control_in_nodes.size()));
+  for (auto control_in_node : control_in_nodes) {
+    hasher.Update(control_in_node);
+  }
+
+  GraphHasher::HashAttrs(AttrUtils::GetAllAttrs(node->GetOpDesc()), hasher);
+  return hasher.Finish();
+}
+
+bool CommonSubexpressionEliminationPass::IsSameCseKey(const NodePtr &node, const NodePtr &other) {
+  if (node->GetType() != other->GetType() || node->GetAllInDataAnchorsSize() != other->GetAllInDataAnchorsSize()) {
+    return false;
+  }
+  for (const auto &in_anchor : node->GetAllInDataAnchors()) {
+    auto other_in_anchor = other->GetInDataAnchor(in_anchor->GetIdx());
+    if (other_in_anchor == nullptr || in_anchor->GetPeerOutAnchor() != other_in_anchor->GetPeerOutAnchor()) {
+      return false;
+    }
+  }
+
+  auto control_in_nodes = node->GetInControlNodes();
+  auto other_control_in_nodes = other->GetInControlNodes();
+  std::set<Node *> control_in_node_set;
+  std::set<Node *> other_control_in_node_set;
+  for (const auto &src_node : control_in_nodes) {
+    control_in_node_set.insert(src_node.get());
+  }
+  for (const auto &src_node : other_control_in_nodes) {
+    other_control_in_node_set.insert(src_node.get());
+  }
+  if (control_in_node_set != other_control_in_node_set) {
+    return false;
+  }
+
+  return AttrUtils::GetAllAttrsStr(node->GetOpDesc()) == AttrUtils::GetAllAttrsStr(other->GetOpDesc());
+}
+
 Status CommonSubexpressionEliminationPass::Run(ComputeGraphPtr graph) {
   GELOGD("Begin to run the CSE process on the graph");
   GE_CHECK_NOTNULL(graph);
-  std::map<std::string, NodePtr> keys_to_node;
+  std::unordered_map<HashCode128, std::vector<NodePtr>, HashCode128Hasher> keys_to_nodes;
   for (const auto &node : graph->GetDirectNode()) {
     if (!IsNodeSupportCse(node)) {
       continue;
@@ -83,16 +113,27 @@ Status CommonSubexpressionEliminationPass::Run(ComputeGraphPtr graph) {
       continue;
     }
     auto key = GetCseKey(node);
-    GELOGD("The node %s cse key %s", node->GetName().c_str(), key.c_str());
-    auto iter = keys_to_node.find(key);
-    if (iter == keys_to_node.end()) {
-      keys_to_node[key] = node;
+    GELOGD("The node %s cse key %s", node->GetName().c_str(), key.ToString().c_str());
+    auto &same_key_nodes = keys_to_nodes[key];
+    NodePtr same_node = nullptr;
+    for (const auto &same_key_node : same_key_nodes) {
+      if (IsSameCseKey(node, same_key_node)) {
+        same_node = same_key_node;
+        break;
+      }
+    }
+    if (same_node == nullptr) {
+      if (!same_key_nodes.empty()) {
+        GELOGI("The node %s and %s have the same CSE hash code, but they are different", node->GetName().c_str(),
+               same_key_nodes.front()->GetName().c_str());
+      }
+      same_key_nodes.emplace_back(node);
       continue;
     }
 
-    if (node->GetAllOutDataAnchorsSize() != iter->second->GetAllOutDataAnchorsSize()) {
+    if (node->GetAllOutDataAnchorsSize() != same_node->GetAllOutDataAnchorsSize()) {
       GELOGW("The node %s and %s have the same CSE key, but different output anchor count, skip to fusion them",
-             iter->second->GetName().c_str(), node->GetName().c_str());
+             same_node->GetName().c_str(), node->GetName().c_str());
       continue;
     }
 
@@ -101,10 +142,10 @@ Status CommonSubexpressionEliminationPass::Run(ComputeGraphPtr graph) {
       output_map[i] = i;
     }
 
-    ret = GraphUtils::ReplaceNodeAnchors(iter->second, node, {}, output_map);
+    ret = GraphUtils::ReplaceNodeAnchors(same_node, node, {}, output_map);
     if (ret != GRAPH_SUCCESS) {
       GELOGE(INTERNAL_ERROR, "Failed to replace node %s by node %s error node %u", node->GetName().c_str(),
-             iter->second->GetName().c_str(), ret);
+             same_node->GetName().c_str(), ret);
       return INTERNAL_ERROR;
     }
 
@@ -117,7 +158,7 @@ Status CommonSubexpressionEliminationPass::Run(ComputeGraphPtr graph) {
     }
 
     GELOGI("Remove node %s by the CSE process, replace it with node %s", node->GetName().c_str(),
-           iter->second->GetName().c_str());
+           same_node->GetName().c_str());
   }
   return SUCCESS;
 }
@@ -17,6 +17,7 @@
 #ifndef GE_COMMON_SUBEXPRESSION_ELIMINATION_H_
 #define GE_COMMON_SUBEXPRESSION_ELIMINATION_H_
 
+#include "graph/common/graph_hasher.h"
 #include "graph/types.h"
 #include "inc/graph_pass.h"
 
@@ -24,6 +25,14 @@ namespace ge {
 class CommonSubexpressionEliminationPass : public GraphPass {
  public:
   Status Run(ge::ComputeGraphPtr graph) override;
+
+ protected:
+  // Hash code of node type, input anchors, control inputs and attrs, nodes with the same key may be different
+  virtual HashCode128 GetCseKey(const NodePtr &node) const;
+
+ private:
+  // Whether the node can be replaced by the other, checked when their keys are the same
+  static bool IsSameCseKey(const NodePtr &node, const NodePtr &other);
 };
 }  // namespace ge
 #endif  // GE_COMMON_SUBEXPRESSION_ELIMINATION_H_
@@ -41,6 +41,14 @@ const std::unordered_map<std::string, std::pair<std::uint64_t, uint64_t>>
   return statistic_of_op_constant_folding_;
 }
 
+bool ConstantFoldingPass::NeedRun(const NodePtr &node) const {
+  if (node == nullptr || folding_pass::IsNoNeedConstantFolding(node)) {
+    return false;
+  }
+  auto input_nodes = OpDescUtils::GetConstInputNode(*node);
+  return !input_nodes.empty() && input_nodes.size() == node->GetOpDesc()->GetInputsSize();
+}
+
 Status ConstantFoldingPass::Run(ge::NodePtr &node) {
   GE_CHECK_NOTNULL(node);
   GELOGD("Begin to run constant folding on node %s", node->GetName().c_str());
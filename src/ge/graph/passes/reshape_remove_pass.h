@@ -23,6 +23,9 @@ namespace ge {
 class ReshapeRemovePass : public BaseNodePass {
  public:
   Status Run(NodePtr &node) override;
+  bool NeedRun(const NodePtr &node) const override {
+    return node != nullptr && (node->GetType() == RESHAPE || node->GetType() == REFORMAT);
+  }
 };
 }  // namespace ge
 
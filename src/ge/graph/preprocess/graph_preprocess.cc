@@ -15,9 +15,13 @@
  */
 
 #include "graph/preprocess/graph_preprocess.h"
+#include <algorithm>
+#include <cstdlib>
+#include <future>
 #include <map>
 #include <set>
 #include <string>
+#include <unordered_map>
 #include <utility>
 #include "common/formats/format_transfers/format_transfer_fractal_nz.h"
 #include "common/formats/format_transfers/format_transfer_fractal_z.h"
@@ -28,6 +32,7 @@
 #include "common/helper/model_helper.h"
 #include "common/math/math_util.h"
 #include "common/op/ge_op_utils.h"
+#include "common/thread_pool.h"
 #include "common/util/error_manager/error_manager.h"
 #include "common/formats/utils/formats_trans_utils.h"
 #include "framework/common/debug/ge_log.h"
@@ -35,6 +40,7 @@
 #include "graph/common/transop_util.h"
 #include "graph/debug/ge_attr_define.h"
 #include "graph/ge_context.h"
+#include "graph/ge_local_context.h"
 #include "graph/shape_refiner.h"
 #include "graph/manager/graph_var_manager.h"
 #include "graph/manager/util/rt_context_util.h"
@@ -126,6 +132,9 @@ static std::map<std::string, ge::DataType> output_type_str_to_datatype = {
   {"UINT32", ge::DT_UINT32}, {"UINT64", ge::DT_UINT64}, {"DOUBLE", ge::DT_DOUBLE}};
 
 const char *const kMbatchSwitchnName = "mbatch-switch-name";
+const char *const kEnvParallelInferShape = "GE_PARALLEL_INFER_SHAPE";
+const int64_t kMaxInferShapeThreadNum = 64;
+const int kMaxInferShapeDepth = 20;
 
 OpDescPtr CreateTensorShape(const GeTensorDesc &data_tensor) {
   GeTensorPtr tensor = MakeShared<GeTensor>();
@@ -949,6 +958,193 @@ Status ProcessNetoutputNodeDynShape(NodePtr &node, std::string &output_type) {
   }
   return SUCCESS;
 }
+
+// Thread num of the level by level InferShapePass, shapes are inferred serially when it is not greater than 1
+uint32_t GetInferShapeThreadNum() {
+  const char *thread_num_str = std::getenv(kEnvParallelInferShape);
+  if (thread_num_str == nullptr) {
+    return 0;
+  }
+  char *end = nullptr;
+  auto thread_num = std::strtol(thread_num_str, &end, 10);
+  if (end == thread_num_str || *end != '\0' || thread_num < 0 || thread_num > kMaxInferShapeThreadNum) {
+    GELOGW("Invalid %s: %s, infer shapes serially.", kEnvParallelInferShape, thread_num_str);
+    return 0;
+  }
+  return static_cast<uint32_t>(thread_num);
+}
+
+bool IsNextIteration(const NodePtr &node) {
+  return node->GetType() == NEXTITERATION || node->GetType() == REFNEXTITERATION;
+}
+
+// Group nodes by topological level, nodes of the same level do not depend on each other.
+// Edges from NextIteration are ignored, the same as GEPass does.
+Status GetNodesByLevel(const ComputeGraphPtr &graph, std::vector<std::vector<NodePtr>> &levels) {
+  std::unordered_map<Node *, size_t> pending_counts;
+  std::vector<NodePtr> current_level;
+  size_t node_num = 0;
+  for (const auto &node : graph->GetDirectNode()) {
+    GE_CHECK_NOTNULL(node);
+    ++node_num;
+    size_t pending_count = 0;
+    for (const auto &in_node : node->GetInNodes()) {
+      if (!IsNextIteration(in_node)) {
+        ++pending_count;
+      }
+    }
+    if (pending_count == 0) {
+      current_level.emplace_back(node);
+    } else {
+      pending_counts[node.get()] = pending_count;
+    }
+  }
+
+  size_t leveled_num = 0;
+  while (!current_level.empty()) {
+    std::vector<NodePtr> next_level;
+    for (const auto &node : current_level) {
+      if (IsNextIteration(node)) {
+        continue;
+      }
+      for (const auto &out_node : node->GetOutNodes()) {
+        auto it = pending_counts.find(out_node.get());
+        if (it != pending_counts.end() && --it->second == 0) {
+          next_level.emplace_back(out_node);
+        }
+      }
+    }
+    leveled_num += current_level.size();
+    levels.emplace_back(std::move(current_level));
+    current_level = std::move(next_level);
+  }
+
+  if (leveled_num != node_num) {
+    GELOGW("Only %zu of %zu nodes in graph %s can be leveled.", leveled_num, node_num, graph->GetName().c_str());
+    return FAILED;
+  }
+  return SUCCESS;
+}
+
+Status ReportInferShapeFailure(const NodePtr &node) {
+  ErrorManager::GetInstance().ATCReportErrMessage("E35003", {"opname", "err_msg"},
+                                                  {node->GetName(), "check your model!"});
+  GELOGE(GE_GRAPH_INFERSHAPE_FAILED, "infershape failed. node: %s", node->GetName().c_str());
+  return GE_GRAPH_INFERSHAPE_FAILED;
+}
+
+// Infer shapes of nodes[begin], nodes[begin + step], ... on one worker
+Status InferShapeOfNodes(const std::vector<NodePtr> *nodes, size_t begin, size_t step,
+                         const GEThreadLocalContext &context, NodePtr *failed_node) {
+  GetThreadLocalContext() = context;
+  for (size_t i = begin; i < nodes->size(); i += step) {
+    if (ShapeRefiner::InferShapeAndType((*nodes)[i], true) != GRAPH_SUCCESS) {
+      *failed_node = (*nodes)[i];
+      return GE_GRAPH_INFERSHAPE_FAILED;
+    }
+  }
+  return SUCCESS;
+}
+
+Status InferShapeOfLevel(const std::vector<NodePtr> &nodes, ThreadPool &pool, uint32_t thread_num) {
+  size_t task_num = std::min(nodes.size(), static_cast<size_t>(thread_num));
+  if (task_num <= 1) {
+    NodePtr failed_node;
+    if (InferShapeOfNodes(&nodes, 0, 1, GetThreadLocalContext(), &failed_node) != SUCCESS) {
+      return ReportInferShapeFailure(failed_node);
+    }
+    return SUCCESS;
+  }
+
+  std::vector<NodePtr> failed_nodes(task_num);
+  std::vector<std::future<Status>> futures;
+  for (size_t i = 0; i < task_num; ++i) {
+    auto f = pool.commit(InferShapeOfNodes, &nodes, i, task_num, GetThreadLocalContext(), &failed_nodes[i]);
+    if (!f.valid()) {
+      GELOGE(FAILED, "Future is invalid");
+      return FAILED;
+    }
+    futures.emplace_back(std::move(f));
+  }
+
+  // wait for all of the tasks, as they refer to nodes and failed_nodes
+  Status ret = SUCCESS;
+  for (size_t i = 0; i < futures.size(); ++i) {
+    if (futures[i].get() != SUCCESS && ret == SUCCESS) {
+      ret = ReportInferShapeFailure(failed_nodes[i]);
+    }
+  }
+  return ret;
+}
+
+Status InferShapeByLevel(const ComputeGraphPtr &graph, const ComputeGraphPtr &root_graph, ThreadPool &pool,
+                         uint32_t thread_num, int depth);
+
+// Same as GEPass: infer the node, then its subgraphs, then the node again with outputs of the subgraphs
+Status InferShapeWithSubgraphs(const NodePtr &node, const ComputeGraphPtr &root_graph, ThreadPool &pool,
+                               uint32_t thread_num, int depth) {
+  if (ShapeRefiner::InferShapeAndType(node, true) != GRAPH_SUCCESS) {
+    return ReportInferShapeFailure(node);
+  }
+  bool has_sub_graph = false;
+  for (const auto &name : node->GetOpDesc()->GetSubgraphInstanceNames()) {
+    auto subgraph = root_graph->GetSubgraph(name);
+    if (subgraph == nullptr) {
+      GELOGW("Can not find the sub graph %s from node %s, the pass-process will skip it", name.c_str(),
+             node->GetName().c_str());
+      continue;
+    }
+    has_sub_graph = true;
+    GE_CHK_STATUS_RET(InferShapeByLevel(subgraph, root_graph, pool, thread_num, depth + 1),
+                      "Failed to infer shapes for sub graph %s from node %s", name.c_str(), node->GetName().c_str());
+  }
+  if (has_sub_graph && ShapeRefiner::InferShapeAndType(node, false) != GRAPH_SUCCESS) {
+    return ReportInferShapeFailure(node);
+  }
+  return SUCCESS;
+}
+
+// Level by level InferShapePass, nodes of the same level are inferred concurrently.
+// Falls back to GEPass if the graph can not be leveled.
+Status InferShapeByLevel(const ComputeGraphPtr &graph, const ComputeGraphPtr &root_graph, ThreadPool &pool,
+                         uint32_t thread_num, int depth) {
+  if (depth > kMaxInferShapeDepth) {
+    GELOGE(PARAM_INVALID, "Too many nesting levels(%d) of subgraphs, last subgraph is %s", depth,
+           graph->GetName().c_str());
+    return PARAM_INVALID;
+  }
+
+  std::vector<std::vector<NodePtr>> levels;
+  if (GetNodesByLevel(graph, levels) != SUCCESS) {
+    GELOGI("Infer shapes of graph %s serially.", graph->GetName().c_str());
+    ComputeGraphPtr pass_graph = graph;
+    InferShapePass infer_shape_pass;
+    NamesToPass names_to_passes;
+    names_to_passes.emplace_back("InferShapePass", &infer_shape_pass);
+    GEPass ge_passes(pass_graph);
+    return ge_passes.Run(names_to_passes);
+  }
+
+  GELOGD("Infer shapes of graph %s by %zu levels.", graph->GetName().c_str(), levels.size());
+  for (const auto &level : levels) {
+    std::vector<NodePtr> plain_nodes;
+    std::vector<NodePtr> nodes_with_subgraph;
+    for (const auto &node : level) {
+      GE_CHECK_NOTNULL(node->GetOpDesc());
+      if (node->GetOpDesc()->GetSubgraphInstanceNames().empty()) {
+        plain_nodes.emplace_back(node);
+      } else {
+        nodes_with_subgraph.emplace_back(node);
+      }
+    }
+    GE_CHK_STATUS_RET_NOLOG(InferShapeOfLevel(plain_nodes, pool, thread_num));
+    // subgraphs are inferred level by level as well, so nodes with subgraph are handled on current thread
+    for (const auto &node : nodes_with_subgraph) {
+      GE_CHK_STATUS_RET_NOLOG(InferShapeWithSubgraphs(node, root_graph, pool, thread_num, depth));
+    }
+  }
+  return SUCCESS;
+}
 }  // namespace
 
 GraphPrepare::GraphPrepare() : compute_graph_(nullptr) {}
@@ -1669,17 +1865,24 @@ Status GraphPrepare::GenerateInfershapeGraph(ConstGraphPtr graph) {
     GELOGE(ret, "Prepare Graph inferformat failed");
     return ret;
   }
-  InferShapePass infer_shape_pass;
-  NamesToPass names_to_passes;
-  names_to_passes.emplace_back("InferShapePass", &infer_shape_pass);
-  GEPass ge_passes(compute_graph_);
-  ret = ge_passes.Run(names_to_passes);
+  uint32_t infer_thread_num = GetInferShapeThreadNum();
+  if (infer_thread_num > 1) {
+    GELOGI("Infer shapes level by level with %u threads.", infer_thread_num);
+    ThreadPool pool(infer_thread_num);
+    ret = InferShapeByLevel(compute_graph_, compute_graph_, pool, infer_thread_num, 1);
+  } else {
+    InferShapePass infer_shape_pass;
+    NamesToPass names_to_passes;
+    names_to_passes.emplace_back("InferShapePass", &infer_shape_pass);
+    GEPass ge_passes(compute_graph_);
+    ret = ge_passes.Run(names_to_passes);
+  }
   GE_DUMP(compute_graph_, "after_infershape");
+  ShapeRefiner::ClearContextMap(compute_graph_);
   if (ret != SUCCESS) {
     GELOGE(ret, "Run ge_passes infershape for preprocess failed, ret:%u.", ret);
     return ret;
   }
-  ShapeRefiner::ClearContextMap();
   return SUCCESS;
 }
 
@@ -1901,7 +2104,7 @@ Status GraphPrepare::InferShapeForPreprocess() {
       }
     }
   }
-  ShapeRefiner::ClearContextMap();
+  ShapeRefiner::ClearContextMap(compute_graph_);
   if (ret != SUCCESS) {
     GELOGE(ret, "Run ge_passes infershape for preprocess failed, ret:%u.", ret);
     return ret;
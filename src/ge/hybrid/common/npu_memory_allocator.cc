@@ -43,7 +43,7 @@ NpuMemoryAllocator *NpuMemoryAllocator::GetAllocator() {
 
 NpuMemoryAllocator::NpuMemoryAllocator(uint32_t device_id) : device_id_(device_id) {}
 
-void *NpuMemoryAllocator::Allocate(std::size_t size, AllocationAttr *attr) {
+void *NpuMemoryAllocator::Allocate(std::size_t size, AllocationAttr *attr, rtStream_t stream) {
   void *try_reuse_addr = nullptr;
   size_t allocate_size = size;
   if (attr != nullptr) {
@@ -56,7 +56,7 @@ void *NpuMemoryAllocator::Allocate(std::size_t size, AllocationAttr *attr) {
   }
 
   void *buffer = MemManager::CachingInstance(RT_MEMORY_HBM)
-                   .Malloc(allocate_size, reinterpret_cast<uint8_t *>(try_reuse_addr), device_id_);
+                   .MallocOnStream(allocate_size, stream, reinterpret_cast<uint8_t *>(try_reuse_addr), device_id_);
   if (buffer == nullptr) {
     GELOGE(MEMALLOC_FAILED, "Failed to malloc memory, device_id = %u, size = %zu", device_id_, allocate_size);
     return nullptr;
@@ -66,14 +66,18 @@ void *NpuMemoryAllocator::Allocate(std::size_t size, AllocationAttr *attr) {
   return buffer;
 }
 
-void NpuMemoryAllocator::Deallocate(void *data) {
+void NpuMemoryAllocator::Deallocate(void *data, rtStream_t stream) {
   GELOGI("To deallocating buffer, addr = %p", data);
   if (data != nullptr) {
     GELOGI("Deallocating buffer successfully. addr = %p", data);
-    MemManager::CachingInstance(RT_MEMORY_HBM).Free(reinterpret_cast<uint8_t *>(data), device_id_);
+    MemManager::CachingInstance(RT_MEMORY_HBM).FreeOnStream(reinterpret_cast<uint8_t *>(data), stream, device_id_);
   }
 }
 
+void NpuMemoryAllocator::ReleaseStream(rtStream_t stream) {
+  MemManager::CachingInstance(RT_MEMORY_HBM).ReleaseStream(stream);
+}
+
 NpuMemoryAllocator *NpuMemoryAllocator::GetAllocator(uint32_t device_id) {
   std::lock_guard<std::mutex> lk(mu_);
   auto it = allocators_.find(device_id);
@@ -23,6 +23,7 @@
 #include <memory>
 #include <mutex>
 #include "external/ge/ge_api_error_codes.h"
+#include "runtime/base.h"
 
 namespace ge {
 namespace hybrid {
@@ -50,8 +51,11 @@ class NpuMemoryAllocator {
     return &attr;
   }
 
-  void *Allocate(std::size_t size, AllocationAttr *attr = nullptr);
-  void Deallocate(void *data);
+  // memory allocated or deallocated with a stream is ordered by the work queued on it
+  void *Allocate(std::size_t size, AllocationAttr *attr = nullptr, rtStream_t stream = nullptr);
+  void Deallocate(void *data, rtStream_t stream = nullptr);
+  // wait for memory deallocated with the stream, must be called before the stream is destroyed
+  void ReleaseStream(rtStream_t stream);
 
   static constexpr int kDefaultPadding = 32;
 
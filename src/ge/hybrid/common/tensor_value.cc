@@ -21,10 +21,11 @@
 
 namespace ge {
 namespace hybrid {
-TensorBuffer::TensorBuffer(NpuMemoryAllocator *allocator, void *buffer, size_t size)
-    : allocator_(allocator), buffer_(buffer), size_(size) {}
+TensorBuffer::TensorBuffer(NpuMemoryAllocator *allocator, void *buffer, size_t size, rtStream_t stream)
+    : allocator_(allocator), buffer_(buffer), size_(size), stream_(stream) {}
 
-std::unique_ptr<TensorBuffer> TensorBuffer::Create(NpuMemoryAllocator *allocator, size_t size, AllocationAttr *attr) {
+std::unique_ptr<TensorBuffer> TensorBuffer::Create(NpuMemoryAllocator *allocator, size_t size, AllocationAttr *attr,
+                                                   rtStream_t stream) {
   void *buffer = nullptr;
   if (size == 0) {
     GELOGD("size is 0");
@@ -36,14 +37,14 @@ std::unique_ptr<TensorBuffer> TensorBuffer::Create(NpuMemoryAllocator *allocator
     return nullptr;
   }
 
-  buffer = allocator->Allocate(size, attr);
+  buffer = allocator->Allocate(size, attr, stream);
   if (buffer == nullptr) {
     GELOGE(MEMALLOC_FAILED, "Failed to allocate memory. size = %zu", size);
     return nullptr;
   }
 
   GELOGD("Tensor created. addr = %p, size = %zu", buffer, size);
-  return std::unique_ptr<TensorBuffer>(new (std::nothrow) TensorBuffer(allocator, buffer, size));
+  return std::unique_ptr<TensorBuffer>(new (std::nothrow) TensorBuffer(allocator, buffer, size, stream));
 }
 
 std::unique_ptr<TensorBuffer> TensorBuffer::Create(void *buffer, size_t size) {
@@ -53,7 +54,7 @@ std::unique_ptr<TensorBuffer> TensorBuffer::Create(void *buffer, size_t size) {
 
 TensorBuffer::~TensorBuffer() {
   if (allocator_ != nullptr && buffer_ != nullptr) {
-    allocator_->Deallocate(buffer_);
+    allocator_->Deallocate(buffer_, stream_);
   }
 }
 
@@ -20,6 +20,7 @@
 #include <atomic>
 #include <cstddef>
 #include <memory>
+#include "runtime/base.h"
 
 namespace ge {
 namespace hybrid {
@@ -29,7 +30,7 @@ class AllocationAttr;
 class TensorBuffer {
  public:
   static std::unique_ptr<TensorBuffer> Create(NpuMemoryAllocator *allocator, size_t size,
-                                              AllocationAttr *attr = nullptr);
+                                              AllocationAttr *attr = nullptr, rtStream_t stream = nullptr);
 
   static std::unique_ptr<TensorBuffer> Create(void *buffer, size_t size);
 
@@ -39,12 +40,16 @@ class TensorBuffer {
 
   size_t GetSize() const { return size_; }
 
+  bool IsStreamOrdered() const { return stream_ != nullptr; }
+
  private:
-  TensorBuffer(NpuMemoryAllocator *allocator, void *buffer, size_t size);
+  TensorBuffer(NpuMemoryAllocator *allocator, void *buffer, size_t size, rtStream_t stream = nullptr);
 
   NpuMemoryAllocator *allocator_ = nullptr;
   void *buffer_ = nullptr;
   size_t size_ = 0;
+  // buffer is released in the order of work on this stream
+  rtStream_t stream_ = nullptr;
 };
 
 class TensorValue {
@@ -61,6 +66,8 @@ class TensorValue {
 
   bool IsEmpty() { return ref_buffer_ == nullptr && buffer_ == nullptr; }
 
+  bool IsStreamOrdered() const { return buffer_ != nullptr && buffer_->IsStreamOrdered(); }
+
   const void *GetData() const;
 
   std::string DebugString() const;
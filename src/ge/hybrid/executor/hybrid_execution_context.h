@@ -44,6 +44,8 @@ struct GraphExecutionContext {
   long profiling_level = 0;
   bool dump_enabled = false;
   long iteration = 0;
+  // launch nodes once their inputs are ready instead of in topological order
+  bool dataflow_schedule = false;
 };
 
 #define RECORD_PROFILING_EVENT(context, evt_type, fmt, category, node_name, ...)                          \
@@ -18,6 +18,7 @@
 #include "graph/load/new_model_manager/model_utils.h"
 #include "graph/utils/tensor_utils.h"
 #include "graph/utils/type_utils.h"
+#include "hybrid/common/npu_memory_allocator.h"
 #include "omm/csa_interact.h"
 
 namespace ge {
@@ -27,10 +28,19 @@ int kDataOutputIndex = 0;
 }
 HybridModelAsyncExecutor::HybridModelAsyncExecutor(HybridModel *model) : model_(model), run_flag_(false) {}
 
-HybridModelAsyncExecutor::~HybridModelAsyncExecutor() {
-  if (stream_ != nullptr) {
-    GE_CHK_RT(rtStreamDestroy(stream_));
+HybridModelAsyncExecutor::~HybridModelAsyncExecutor() { DestroyStream(); }
+
+void HybridModelAsyncExecutor::DestroyStream() {
+  if (stream_ == nullptr) {
+    return;
+  }
+  // memory freed on the stream must not be taken over by a new stream which gets the same handle
+  auto allocator = NpuMemoryAllocator::GetAllocator(device_id_);
+  if (allocator != nullptr) {
+    allocator->ReleaseStream(stream_);
   }
+  GE_CHK_RT(rtStreamDestroy(stream_));
+  stream_ = nullptr;
 }
 
 void HybridModelAsyncExecutor::SetDeviceId(uint32_t device_id) { device_id_ = device_id; }
@@ -63,12 +73,7 @@ Status HybridModelAsyncExecutor::Stop() {
   run_flag_ = false;
   data_inputer_->Stop();
   auto ret = future_.get();
-
-  if (stream_ != nullptr) {
-    GE_CHK_RT(rtStreamDestroy(stream_));
-    stream_ = nullptr;
-  }
-
+  DestroyStream();
   return ret;
 }
 
@@ -66,6 +66,8 @@ class HybridModelAsyncExecutor {
 
   Status CopyInputData(const InputData &current_data);
 
+  void DestroyStream();
+
   std::mutex mu_;
   HybridModel *model_;
   uint32_t device_id_ = 0U;
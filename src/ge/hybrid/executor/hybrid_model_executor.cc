@@ -15,29 +15,61 @@
  */
 
 #include "hybrid_model_executor.h"
+#include <cstdlib>
+#include "framework/common/string_util.h"
 #include "graph/ge_context.h"
 #include "graph/runtime_inference_context.h"
+#include "hybrid/executor/worker/task_compile_cache.h"
 
 namespace ge {
 namespace hybrid {
+namespace {
+const char *const kEnvDataflowSchedule = "GE_HYBRID_DATAFLOW_SCHEDULE";
+const char *const kEnvCompileCacheWarmUp = "GE_HYBRID_COMPILE_CACHE_WARMUP";
+}  // namespace
+
 HybridModelExecutor::HybridModelExecutor(HybridModel *model, uint32_t device_id, rtStream_t stream)
     : model_(model), device_id_(device_id), stream_(stream) {}
 
+HybridModelExecutor::~HybridModelExecutor() {
+  TaskCompileCacheStats stats;
+  TaskCompileCache::GetInstance().GetStats(stats);
+  GELOGI("Task compile cache: size = %zu, capacity = %zu, task hits = %lu, task misses = %lu, "
+         "running param hits = %lu, running param misses = %lu, evictions = %lu",
+         stats.size, stats.capacity, stats.task_hits, stats.task_misses, stats.running_param_hits,
+         stats.running_param_misses, stats.evictions);
+  if (model_ != nullptr) {
+    TaskCompileCache::GetInstance().ClearModel(model_->GetModelId());
+  }
+}
+
 Status HybridModelExecutor::Init() {
   GELOGD("Start to init HybridGraphEngine.");
   GE_CHK_STATUS_RET_NOLOG(InitExecutionContext());
+  auto root_graph_item = model_->GetRootGraphItem();
+  GE_CHECK_NOTNULL(root_graph_item);
+  root_graph_executor_.reset(new (std::nothrow) SubgraphExecutor(root_graph_item, &context_));
+  GE_CHECK_NOTNULL(root_graph_executor_);
+
+  // warming up is best effort, failure of it does not fail loading
+  const char *warm_up_shapes = std::getenv(kEnvCompileCacheWarmUp);
+  if (warm_up_shapes != nullptr) {
+    std::vector<std::vector<GeShape>> shape_list;
+    if (ParseShapeList(warm_up_shapes, shape_list) != SUCCESS || WarmUp(shape_list) != SUCCESS) {
+      GELOGW("Failed to warm up task compile cache with shapes: %s", warm_up_shapes);
+    }
+  }
   GELOGD("HybridGraphEngine initialized successfully.");
   return SUCCESS;
 }
 
 Status HybridModelExecutor::Execute(HybridModelExecutor::ExecuteArgs &args) {
   GELOGD("Start to execute model.");
-  auto root_graph_item = model_->GetRootGraphItem();
-  GE_CHECK_NOTNULL(root_graph_item);
-
-  SubgraphExecutor executor(model_->GetRootGraphItem(), &context_);
-  auto ret = ExecuteGraphInternal(executor, args);
+  GE_CHECK_NOTNULL(root_graph_executor_);
+  auto ret = ExecuteGraphInternal(*root_graph_executor_, args);
   Cleanup();
+  // tensors are released after all callbacks are done, the execution plan is kept for next execution
+  root_graph_executor_->ReleaseContext();
   RECORD_MODEL_EXECUTION_EVENT(&context_, "[Cleanup] End");
   GE_CHK_STATUS_RET(ret, "Failed to execute model");
   GELOGD("Model executed successfully.");
@@ -50,6 +82,51 @@ Status HybridModelExecutor::Execute(HybridModelExecutor::ExecuteArgs &args) {
   return SUCCESS;
 }
 
+Status HybridModelExecutor::WarmUp(const std::vector<std::vector<GeShape>> &shape_list) {
+  GE_CHECK_NOTNULL(root_graph_executor_);
+  Status ret = SUCCESS;
+  for (size_t i = 0; i < shape_list.size(); ++i) {
+    GELOGD("Start to warm up with shape set [%zu].", i);
+    ret = root_graph_executor_->WarmUp(shape_list[i]);
+    if (ret != SUCCESS) {
+      GELOGE(ret, "Failed to warm up with shape set [%zu].", i);
+      break;
+    }
+  }
+
+  // compilation switches the context of current thread
+  GE_CHK_RT_RET(rtCtxSetCurrent(context_.rt_context));
+  TaskCompileCacheStats stats;
+  TaskCompileCache::GetInstance().GetStats(stats);
+  GELOGI("Done warming up with %zu shape sets, %zu entries in task compile cache.", shape_list.size(), stats.size);
+  return ret;
+}
+
+Status HybridModelExecutor::ParseShapeList(const std::string &shape_list_str,
+                                           std::vector<std::vector<GeShape>> &shape_list) {
+  for (const auto &shape_set_str : StringUtils::Split(shape_list_str, '|')) {
+    std::vector<GeShape> shape_set;
+    for (const auto &shape_str : StringUtils::Split(shape_set_str, ';')) {
+      std::vector<int64_t> dims;
+      for (const auto &dim_str : StringUtils::Split(shape_str, ',')) {
+        if (dim_str.empty()) {
+          continue;
+        }
+        char *end = nullptr;
+        auto dim = std::strtoll(dim_str.c_str(), &end, 10);
+        if (*end != '\0' || dim < 0) {
+          GELOGE(PARAM_INVALID, "Invalid dim [%s] in shape list: %s", dim_str.c_str(), shape_list_str.c_str());
+          return PARAM_INVALID;
+        }
+        dims.emplace_back(dim);
+      }
+      shape_set.emplace_back(dims);
+    }
+    shape_list.emplace_back(std::move(shape_set));
+  }
+  return SUCCESS;
+}
+
 Status HybridModelExecutor::ExecuteGraphInternal(SubgraphExecutor &executor, HybridModelExecutor::ExecuteArgs &args) {
   RECORD_MODEL_EXECUTION_EVENT(&context_, "[InitContext] Start");
   GE_CHK_STATUS_RET_NOLOG(ResetExecutionContext(context_));
@@ -90,6 +167,12 @@ Status HybridModelExecutor::InitExecutionContext() {
   if (IsLogEnable(GE_MODULE_NAME, DLOG_DEBUG)) {
     context_.trace_enabled = true;
   }
+
+  const char *dataflow_schedule = std::getenv(kEnvDataflowSchedule);
+  if (dataflow_schedule != nullptr && std::string(dataflow_schedule) == "1") {
+    GELOGI("Dataflow schedule is enabled.");
+    context_.dataflow_schedule = true;
+  }
   return SUCCESS;
 }
 
@@ -35,7 +35,7 @@ class HybridModelExecutor {
 
   HybridModelExecutor(HybridModel *model, uint32_t device_id, rtStream_t stream);
 
-  ~HybridModelExecutor() = default;
+  ~HybridModelExecutor();
 
   Status Init();
 
@@ -43,6 +43,22 @@ class HybridModelExecutor {
 
   Status Execute(ExecuteArgs &args);
 
+  /**
+   * Compile tasks of dynamic shaped nodes in advance
+   * @param shape_list      input shapes of model, one set of shapes per warm-up
+   * @return SUCCESS on success, error code otherwise
+   */
+  Status WarmUp(const std::vector<std::vector<GeShape>> &shape_list);
+
+  /**
+   * Parse shape list in format of "1,3,224,224;1,3|2,3,224,224;2,3",
+   * sets of input shapes are separated by '|', and shapes of inputs in one set by ';'
+   * @param shape_list_str  string to parse
+   * @param shape_list      parsed shape list
+   * @return SUCCESS on success, error code otherwise
+   */
+  static Status ParseShapeList(const std::string &shape_list_str, std::vector<std::vector<GeShape>> &shape_list);
+
  private:
   Status ExecuteGraphInternal(SubgraphExecutor &executor, ExecuteArgs &args);
   Status Cleanup();
@@ -53,6 +69,7 @@ class HybridModelExecutor {
   uint32_t device_id_;
   rtStream_t stream_;
   GraphExecutionContext context_;
+  std::unique_ptr<SubgraphExecutor> root_graph_executor_;
 };
 }  // namespace hybrid
 }  // namespace ge
@@ -46,6 +46,12 @@ void NodeDoneManager::Cond::Cancel() {
   cv_.notify_all();
 }
 
+void NodeDoneManager::Cond::Reset() {
+  std::unique_lock<std::mutex> lk(cond_mu_);
+  is_released_ = false;
+  is_cancelled_ = false;
+}
+
 bool NodeDoneManager::Cond::IsRelease() {
   std::unique_lock<std::mutex> lk(cond_mu_);
   return is_released_;
@@ -82,6 +88,16 @@ void NodeDoneManager::Destroy() {
   GELOGD("Done resetting NodeDoneManager successfully.");
 }
 
+void NodeDoneManager::Reset() {
+  std::lock_guard<std::mutex> lk(mu_);
+  // conditions are kept for reuse, so that no allocation is needed for the next execution
+  for (auto &sub : subjects_) {
+    sub.second.Reset();
+  }
+
+  destroyed_ = false;
+}
+
 void NodeDoneManager::NodeDone(const NodePtr &node) {
   auto sub = GetSubject(node);
   if (sub != nullptr) {
@@ -33,6 +33,8 @@ class NodeDoneManager {
 
   void Destroy();
 
+  void Reset();
+
  private:
   class Cond {
    public:
@@ -40,6 +42,7 @@ class NodeDoneManager {
     void Release();
     void Cancel();
     bool Await();
+    void Reset();
 
    private:
     std::mutex cond_mu_;
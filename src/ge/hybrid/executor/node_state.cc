@@ -32,6 +32,12 @@ ShapeInferenceState::ShapeInferenceState(const NodeItem &node_item) : node_item(
          this->num_pending_shapes_);
 }
 
+void ShapeInferenceState::Reset() {
+  std::lock_guard<std::mutex> lk(mu_);
+  num_pending_shapes_ = node_item.num_inputs - node_item.num_static_input_shapes;
+  shape_futures.clear();
+}
+
 void ShapeInferenceState::UpdateInputShape(uint32_t idx, const GeShape &ori_shape, const GeShape &shape) {
   if (!node_item.is_dynamic || node_item.is_input_shape_static[idx]) {
     GELOGD("[%s] Trying to update static shape, idx = %u. old shape = [%s], new shape = [%s]",
@@ -106,6 +112,11 @@ NodeState::NodeState(const NodeItem &node_item, SubgraphContext *subgraph_contex
   this->op_desc_ = node_item.node->GetOpDesc();
 }
 
+void NodeState::Reset() {
+  shape_inference_state_.Reset();
+  prepare_future_ = std::future<Status>();
+}
+
 Status NodeState::AwaitInputTensors(GraphExecutionContext &context) const {
   for (auto &src_node : node_item_->dependents_for_execution) {
     GELOGI("[%s] Start to wait for data dependent node: [%s]", node_item_->NodeName().c_str(),
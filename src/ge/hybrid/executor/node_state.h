@@ -17,6 +17,7 @@
 #ifndef GE_HYBRID_EXECUTOR_NODE_STATE_H_
 #define GE_HYBRID_EXECUTOR_NODE_STATE_H_
 
+#include <atomic>
 #include <condition_variable>
 #include <future>
 #include <mutex>
@@ -29,6 +30,7 @@ namespace hybrid {
 class NodeTask;
 class GraphExecutionContext;
 class SubgraphContext;
+class TaskContext;
 
 class ShapeFuture {
  public:
@@ -51,6 +53,8 @@ struct ShapeInferenceState {
 
   Status AwaitShapesReady(const GraphExecutionContext &context);
 
+  void Reset();
+
   const NodeItem &node_item;
 
  private:
@@ -60,6 +64,30 @@ struct ShapeInferenceState {
   std::mutex mu_;
 };
 
+// output shapes inferred for recently seen inputs of a node, kept across executions
+struct ShapeInferenceMemo {
+  struct OutputShape {
+    GeShape shape;
+    GeShape ori_shape;
+    DataType data_type = DT_UNDEFINED;
+    DataType ori_data_type = DT_UNDEFINED;
+  };
+
+  struct Entry {
+    // shapes, data types and formats of inputs, followed by values of dependent inputs
+    std::vector<int64_t> signature;
+    std::vector<OutputShape> outputs;
+  };
+
+  // most recently used first
+  std::vector<Entry> entries;
+  // signature of current inputs
+  std::vector<int64_t> signature;
+  // <src node id, output index> of inputs whose values are needed by shape inference
+  std::vector<std::pair<int64_t, int>> dependent_inputs;
+  bool dependent_inputs_parsed = false;
+};
+
 // saving sth. dynamic during execution
 struct NodeState {
  public:
@@ -76,6 +104,8 @@ struct NodeState {
 
   ShapeInferenceState &GetShapeInferenceState() { return shape_inference_state_; }
 
+  ShapeInferenceMemo &GetShapeInferenceMemo() { return shape_inference_memo_; }
+
   const shared_ptr<NodeTask> &GetKernelTask() const { return kernel_task_; }
 
   void SetKernelTask(const shared_ptr<NodeTask> &kernel_task) { kernel_task_ = kernel_task; }
@@ -86,14 +116,38 @@ struct NodeState {
 
   Status AwaitInputTensors(GraphExecutionContext &context) const;
 
+  const shared_ptr<TaskContext> &GetTaskContext() const { return task_context_; }
+
+  void SetTaskContext(const shared_ptr<TaskContext> &task_context) { task_context_ = task_context; }
+
+  // clear the state of previous execution, task and task context are kept for reuse
+  void Reset();
+
+  // for dataflow scheduling, the node is prepared once all its predecessors are prepared,
+  // and launched once itself is prepared and all its predecessors are launched
+  void ResetPendingCounts(int num_predecessors) {
+    num_pending_prepare_ = num_predecessors;
+    num_pending_launch_ = num_predecessors + 1;
+  }
+
+  // returns true if the node becomes ready to prepare
+  bool DecreasePendingPrepare() { return --num_pending_prepare_ == 0; }
+
+  // returns true if the node becomes ready to launch
+  bool DecreasePendingLaunch() { return --num_pending_launch_ == 0; }
+
  private:
   const NodeItem *node_item_ = nullptr;
   std::shared_ptr<NodeTask> kernel_task_ = nullptr;
+  std::shared_ptr<TaskContext> task_context_ = nullptr;
   std::future<Status> prepare_future_;
   OpDescPtr op_desc_;
   ShapeInferenceState shape_inference_state_;
+  ShapeInferenceMemo shape_inference_memo_;
   SubgraphContext *subgraph_context_;
   std::mutex mu_;
+  std::atomic<int> num_pending_prepare_{0};
+  std::atomic<int> num_pending_launch_{0};
 };
 
 using NodeStatePtr = std::shared_ptr<NodeState>;
@@ -29,17 +29,43 @@ Status SubgraphContext::Init() {
   all_inputs_.resize(graph_item_->TotalInputs());
   all_outputs_.resize(graph_item_->TotalOutputs());
 
+  const auto &all_nodes = graph_item_->GetAllNodes();
+  node_states_.resize(all_nodes.size());
+  for (size_t i = 0; i < all_nodes.size(); ++i) {
+    GE_CHECK_NOTNULL(all_nodes[i]);
+    node_states_[i].reset(new (std::nothrow) NodeState(*all_nodes[i], this));
+    GE_CHECK_NOTNULL(node_states_[i]);
+  }
+
   return SUCCESS;
 }
 
-NodeStatePtr SubgraphContext::GetOrCreateNodeState(const NodeItem *node_item) {
-  std::lock_guard<std::mutex> lk(mu_);
-  auto &node_state = node_states_[node_item];
-  if (node_state == nullptr) {
-    node_state.reset(new (std::nothrow) NodeState(*node_item, this));
+void SubgraphContext::Reset() {
+  GELOGD("[%s] Start to reset subgraph context.", graph_item_->GetName().c_str());
+  for (auto &tensor : all_inputs_) {
+    tensor.Destroy();
+  }
+
+  for (auto &tensor : all_outputs_) {
+    tensor.Destroy();
+  }
+
+  for (auto &node_state : node_states_) {
+    node_state->Reset();
+  }
+
+  node_done_manager_.Reset();
+}
+
+NodeStatePtr SubgraphContext::GetNodeState(const NodeItem *node_item) {
+  auto node_index = graph_item_->GetNodeIndex(node_item);
+  if (node_index < 0 || static_cast<size_t>(node_index) >= node_states_.size()) {
+    GELOGE(INTERNAL_ERROR, "[%s] Node [%s] does not belong to graph.", graph_item_->GetName().c_str(),
+           node_item == nullptr ? "null" : node_item->NodeName().c_str());
+    return nullptr;
   }
 
-  return node_state;
+  return node_states_[node_index];
 }
 
 Status SubgraphContext::SetInput(int index, const TensorValue &tensor) {
@@ -33,7 +33,10 @@ class SubgraphContext {
   ~SubgraphContext() = default;
 
   Status Init();
-  NodeStatePtr GetOrCreateNodeState(const NodeItem *node_item);
+  NodeStatePtr GetNodeState(const NodeItem *node_item);
+
+  // release tensors and states of the previous execution, node states are kept for reuse
+  void Reset();
 
   void OnError(Status error);
 
@@ -49,11 +52,11 @@ class SubgraphContext {
  private:
   friend class TaskContext;
   const GraphItem *graph_item_;
-  std::mutex mu_;
   std::vector<TensorValue> all_inputs_;
   std::vector<TensorValue> all_outputs_;
   NodeDoneManager node_done_manager_;
-  std::unordered_map<const NodeItem *, NodeStatePtr> node_states_;
+  // indexed by position of node in graph item
+  std::vector<NodeStatePtr> node_states_;
 };
 }  // namespace hybrid
 }  // namespace ge
@@ -15,6 +15,7 @@
  */
 
 #include "hybrid/executor/subgraph_executor.h"
+#include "hybrid/executor/worker/task_compile_cache.h"
 #include "hybrid/executor/worker/task_compile_engine.h"
 #include "hybrid/executor/worker/execution_engine.h"
 #include "hybrid/node_executor/node_executor.h"
@@ -29,19 +30,46 @@ constexpr int kDataInputIndex = 0;
 SubgraphExecutor::SubgraphExecutor(const GraphItem *graph_item, GraphExecutionContext *context, bool force_infer_shape)
     : graph_item_(graph_item),
       context_(context),
-      force_infer_shape_(force_infer_shape),
-      pre_run_pool_(kDefaultThreadNum) {}
+      force_infer_shape_(force_infer_shape) {}
 
 SubgraphExecutor::~SubgraphExecutor() { GELOGD("[%s] SubgraphExecutor destroyed.", graph_item_->GetName().c_str()); }
 
-Status SubgraphExecutor::Init(const std::vector<TensorValue> &inputs,
-                              const std::vector<ConstGeTensorDescPtr> &input_desc) {
+Status SubgraphExecutor::InitExecutionPlan() {
+  // for while op
+  if (force_infer_shape_) {
+    for (auto node_item : graph_item_->GetAllNodes()) {
+      if (!node_item->is_dynamic) {
+        GELOGD("[%s] Force infer shape is set, updating node to dynamic.", node_item->NodeName().c_str());
+        node_item->SetToDynamic();
+      }
+    }
+  }
+
   subgraph_context_.reset(new (std::nothrow) SubgraphContext(graph_item_));
   GE_CHECK_NOTNULL(subgraph_context_);
   GE_CHK_STATUS_RET(subgraph_context_->Init(), "[%s] Failed to init subgraph context.", graph_item_->GetName().c_str());
 
   shape_inference_engine_.reset(new (std::nothrow) ShapeInferenceEngine(context_, subgraph_context_.get()));
   GE_CHECK_NOTNULL(shape_inference_engine_);
+  return SUCCESS;
+}
+
+void SubgraphExecutor::ReleaseContext() {
+  if (subgraph_context_ != nullptr) {
+    subgraph_context_->Reset();
+  }
+}
+
+Status SubgraphExecutor::Init(const std::vector<TensorValue> &inputs,
+                              const std::vector<ConstGeTensorDescPtr> &input_desc) {
+  if (subgraph_context_ == nullptr) {
+    GE_CHK_STATUS_RET(InitExecutionPlan(), "[%s] Failed to init execution plan.", graph_item_->GetName().c_str());
+  } else {
+    subgraph_context_->Reset();
+  }
+
+  ready_queue_.Clear();
+  ready_queue_.Restart();
 
   if (graph_item_->IsDynamic()) {
     GE_CHK_STATUS_RET(InitInputsForUnknownShape(inputs, input_desc), "[%s] Failed to set inputs.",
@@ -55,6 +83,67 @@ Status SubgraphExecutor::Init(const std::vector<TensorValue> &inputs,
   return SUCCESS;
 }
 
+Status SubgraphExecutor::WarmUp(const std::vector<GeShape> &input_shapes) {
+  if (!graph_item_->IsDynamic()) {
+    return SUCCESS;
+  }
+
+  if (subgraph_context_ == nullptr) {
+    GE_CHK_STATUS_RET(InitExecutionPlan(), "[%s] Failed to init execution plan.", graph_item_->GetName().c_str());
+  } else {
+    subgraph_context_->Reset();
+  }
+
+  // shapes in op descs are going to be changed
+  graph_item_->ClearInferredInputSignature();
+  auto &input_nodes = graph_item_->GetInputNodes();
+  if (input_shapes.size() < input_nodes.size()) {
+    GELOGE(PARAM_INVALID, "[%s] Number of input shapes [%zu] is not sufficient for subgraph which needs [%zu] inputs.",
+           graph_item_->GetName().c_str(), input_shapes.size(), input_nodes.size());
+    return PARAM_INVALID;
+  }
+  for (size_t i = 0; i < input_nodes.size(); ++i) {
+    if (input_nodes[i] == nullptr) {
+      continue;
+    }
+    auto node_state = subgraph_context_->GetNodeState(input_nodes[i]);
+    GE_CHECK_NOTNULL(node_state);
+    node_state->GetShapeInferenceState().UpdateInputShape(0, input_shapes[i], input_shapes[i]);
+  }
+
+  Status ret = SUCCESS;
+  for (auto node_item : graph_item_->GetAllNodes()) {
+    if (node_item->node_type == NETOUTPUT || !node_item->is_dynamic) {
+      continue;
+    }
+    // shapes depending on tensor values or on subgraphs are unknown until executed, stop here
+    if (!node_item->dependents_for_shape_inference.empty() || node_item->IsControlOp() ||
+        node_item->node_type == PARTITIONEDCALL) {
+      GELOGI("[%s] Stop warming up at node [%s].", graph_item_->GetName().c_str(), node_item->NodeName().c_str());
+      break;
+    }
+
+    auto node_state = subgraph_context_->GetNodeState(node_item);
+    GE_CHECK_NOTNULL(node_state);
+    ret = InferShape(shape_inference_engine_.get(), *node_state);
+    if (ret == SUCCESS) {
+      ret = PrepareForExecution(context_, *node_state);
+    }
+    if (ret != SUCCESS) {
+      GELOGE(ret, "[%s] Failed to warm up node [%s].", graph_item_->GetName().c_str(), node_item->NodeName().c_str());
+      break;
+    }
+    // output shapes are futures
+    if (node_item->shape_inference_type == DEPEND_SHAPE_RANGE || node_item->shape_inference_type == DEPEND_COMPUTE) {
+      GELOGI("[%s] Stop warming up after node [%s].", graph_item_->GetName().c_str(), node_item->NodeName().c_str());
+      break;
+    }
+  }
+
+  subgraph_context_->Reset();
+  return ret;
+}
+
 Status SubgraphExecutor::InitInputsForUnknownShape(const std::vector<TensorValue> &inputs,
                                                    const std::vector<ConstGeTensorDescPtr> &input_desc) {
   // Number of inputs of parent node should be greater or equal than that of subgraph
@@ -65,6 +154,7 @@ Status SubgraphExecutor::InitInputsForUnknownShape(const std::vector<TensorValue
     return INTERNAL_ERROR;
   }
 
+  input_signature_.clear();
   for (size_t i = 0; i < input_nodes.size(); ++i) {
     auto &input_node = input_nodes[i];
     if (input_node == nullptr) {
@@ -83,9 +173,10 @@ Status SubgraphExecutor::InitInputsForUnknownShape(const std::vector<TensorValue
       GELOGD("[%s] Start to update input[%zu] for subgraph data node.", graph_item_->GetName().c_str(), i);
       GE_CHECK_LE(i + 1, input_desc.size());
       const auto &tensor_desc = input_desc[i];
-      auto node_state = subgraph_context_->GetOrCreateNodeState(input_node);
+      auto node_state = subgraph_context_->GetNodeState(input_node);
       GE_CHECK_NOTNULL(node_state);
       node_state->GetShapeInferenceState().UpdateInputShape(0, tensor_desc->GetOriginShape(), tensor_desc->GetShape());
+      AppendInputSignature(i, *tensor_desc);
     }
   }
 
@@ -93,6 +184,17 @@ Status SubgraphExecutor::InitInputsForUnknownShape(const std::vector<TensorValue
   return SUCCESS;
 }
 
+void SubgraphExecutor::AppendInputSignature(size_t index, const GeTensorDesc &tensor_desc) {
+  input_signature_.emplace_back(static_cast<int64_t>(index));
+  input_signature_.emplace_back(static_cast<int64_t>(tensor_desc.GetDataType()));
+  input_signature_.emplace_back(static_cast<int64_t>(tensor_desc.GetFormat()));
+  for (const auto &shape : {tensor_desc.GetShape(), tensor_desc.GetOriginShape()}) {
+    const auto &dims = shape.GetDims();
+    input_signature_.emplace_back(static_cast<int64_t>(dims.size()));
+    input_signature_.insert(input_signature_.end(), dims.begin(), dims.end());
+  }
+}
+
 Status SubgraphExecutor::InitInputsForKnownShape(const std::vector<TensorValue> &inputs) {
   auto &input_index_mapping = graph_item_->GetInputIndexMapping();
   for (size_t i = 0; i < input_index_mapping.size(); ++i) {
@@ -123,7 +225,18 @@ Status SubgraphExecutor::ExecuteAsync(const std::vector<TensorValue> &inputs,
     return ExecuteAsyncForKnownShape(inputs);
   }
 
+  // skip shape inference of the whole graph if the inputs are of the same shapes as the last execution
+  bool memo_enabled = !force_infer_shape_ && graph_item_->IsShapeDeterminedByInputs();
+  skip_shape_inference_ = memo_enabled && graph_item_->MatchInferredInputSignature(input_signature_);
+  if (!skip_shape_inference_) {
+    graph_item_->ClearInferredInputSignature();
+  }
+  GELOGD("[%s] Skip shape inference = %s", graph_item_->GetName().c_str(), skip_shape_inference_ ? "true" : "false");
+
   GE_CHK_STATUS_RET(ScheduleTasks(), "[%s] Failed to execute tasks.", graph_item_->GetName().c_str());
+  if (memo_enabled && !skip_shape_inference_) {
+    graph_item_->SetInferredInputSignature(input_signature_);
+  }
   GELOGD("[%s] Done executing subgraph successfully.", graph_item_->GetName().c_str());
   return SUCCESS;
 }
@@ -138,12 +251,17 @@ Status SubgraphExecutor::ExecuteAsyncForKnownShape(const std::vector<TensorValue
 
   auto node_item = graph_item_->GetAllNodes()[0];
   GE_CHECK_NOTNULL(node_item);
-  auto node_state = subgraph_context_->GetOrCreateNodeState(node_item);
+  auto node_state = subgraph_context_->GetNodeState(node_item);
   GE_CHECK_NOTNULL(node_state);
   node_state->SetKernelTask(node_item->kernel_task);
 
-  known_shape_task_context_ = TaskContext::Create(*node_item, context_, subgraph_context_.get());
-  GE_CHECK_NOTNULL(known_shape_task_context_);
+  if (known_shape_task_context_ == nullptr) {
+    known_shape_task_context_ = TaskContext::Create(*node_item, context_, subgraph_context_.get());
+    GE_CHECK_NOTNULL(known_shape_task_context_);
+    known_shape_task_context_->SetRetainOutputs(true);
+  } else {
+    known_shape_task_context_->Reset();
+  }
 
   GE_CHK_STATUS_RET(ExecutionEngine::ExecuteAsync(*node_state, known_shape_task_context_, *context_),
                     "[%s] Failed to execute node [%s] for known subgraph.", graph_item_->GetName().c_str(),
@@ -177,29 +295,25 @@ Status SubgraphExecutor::PrepareNodes() {
   auto &all_nodes = graph_item_->GetAllNodes();
   for (size_t i = 0; i < all_nodes.size(); ++i) {
     auto &node_item = *all_nodes[i];
-    // for while op
-    if (force_infer_shape_ && !node_item.is_dynamic) {
-      GELOGD("[%s] Force infer shape is set, updating node to dynamic.", node_item.NodeName().c_str());
-      auto &mutable_node_item = const_cast<NodeItem &>(node_item);
-      mutable_node_item.SetToDynamic();
-    }
-
     GELOGD("[%s] Start to prepare node [%s].", graph_item_->GetName().c_str(), node_item.NodeName().c_str());
-    auto node_state = subgraph_context_->GetOrCreateNodeState(&node_item);
+    auto node_state = subgraph_context_->GetNodeState(&node_item);
     GE_CHECK_NOTNULL(node_state);
     auto p_node_state = node_state.get();
 
     if (node_item.node_type == NETOUTPUT) {
       // Wait for all inputs become valid
       // after PrepareNodes returned. all output tensors and shapes are valid
-      GE_CHK_STATUS_RET_NOLOG(p_node_state->GetShapeInferenceState().AwaitShapesReady(*context_));
+      if (!skip_shape_inference_) {
+        GE_CHK_STATUS_RET_NOLOG(p_node_state->GetShapeInferenceState().AwaitShapesReady(*context_));
+      }
       GE_CHK_STATUS_RET_NOLOG(p_node_state->AwaitInputTensors(*context_));
       continue;
     }
 
     // only do shape inference and compilation for nodes with dynamic shapes.
-    if (node_item.is_dynamic) {
-      auto prepare_future = pre_run_pool_.commit([this, p_node_state]() -> Status {
+    // if shapes kept in op descs are still valid, dynamic nodes only need their tasks as static ones
+    if (node_item.is_dynamic && !skip_shape_inference_) {
+      auto prepare_future = pre_run_pool_->commit([this, p_node_state]() -> Status {
         GE_CHK_STATUS_RET_NOLOG(InferShape(shape_inference_engine_.get(), *p_node_state));
         return PrepareForExecution(context_, *p_node_state);
       });
@@ -208,7 +322,9 @@ Status SubgraphExecutor::PrepareNodes() {
     } else {
       GELOGD("[%s] Skipping shape inference and compilation for node with static shape.", node_item.NodeName().c_str());
       if (node_item.kernel_task == nullptr) {
-        GELOGW("[%s] Node of static shape got no task.", node_item.NodeName().c_str());
+        if (!node_item.is_dynamic) {
+          GELOGW("[%s] Node of static shape got no task.", node_item.NodeName().c_str());
+        }
         GE_CHK_STATUS_RET(TaskCompileEngine::Compile(*p_node_state, context_), "[%s] Failed to create task.",
                           p_node_state->GetName().c_str());
       } else {
@@ -246,11 +362,32 @@ Status SubgraphExecutor::PrepareForExecution(GraphExecutionContext *ctx, NodeSta
     node_state.SetKernelTask(node_item.kernel_task);
   }
 
+  // running params only depend on input shapes unless the output shapes depend on input values,
+  // reuse them if the shapes have been seen
+  GE_CHECK_NOTNULL(ctx->model);
+  auto &cache = TaskCompileCache::GetInstance();
+  bool cacheable = TaskCompileCache::IsRunningParamCacheable(node_item);
+  std::string cache_key;
+  if (cacheable) {
+    GE_CHK_STATUS_RET(TaskCompileCache::GenerateKey(ctx->model->GetModelId(), *node_item.op_desc, cache_key),
+                      "[%s] Failed to generate cache key.", node_item.NodeName().c_str());
+    OpRunningParam running_param;
+    if (cache.GetRunningParam(cache_key, running_param)) {
+      GELOGD("[%s] Hit running param cache, key = %s", node_item.NodeName().c_str(), cache_key.c_str());
+      return TaskCompileCache::ApplyRunningParam(running_param, *node_item.op_desc);
+    }
+  }
+
   GELOGD("[%s] Start to invoke CalcOpRunningParam.", node_item.NodeName().c_str());
   RECORD_COMPILE_EVENT(ctx, node_item.NodeName().c_str(), "[CalcOpRunningParam] Start");
   GE_CHK_STATUS_RET(NodeExecutorManager::GetInstance().CalcOpRunningParam(*node_item.node),
                     "[%s] Failed to invoke CalcOpRunningParam.", node_item.NodeName().c_str());
   RECORD_COMPILE_EVENT(ctx, node_item.NodeName().c_str(), "[CalcOpRunningParam] End");
+  if (cacheable) {
+    OpRunningParam running_param;
+    GE_CHK_STATUS_RET_NOLOG(TaskCompileCache::SaveRunningParam(*node_item.op_desc, running_param));
+    cache.PutRunningParam(cache_key, running_param);
+  }
   GELOGD("[%s] Done invoking CalcOpRunningParam successfully.", node_item.NodeName().c_str());
   return SUCCESS;
 }
@@ -270,20 +407,38 @@ Status SubgraphExecutor::LaunchTasks() {
 
     GE_CHK_STATUS_RET_NOLOG(node_state->WaitForPrepareDone());
 
-    GELOGD("[%s] Start to execute.", node_state->GetName().c_str());
-    auto task_context = TaskContext::Create(*node_state->GetNodeItem(), context_, subgraph_context_.get());
+    GE_CHK_STATUS_RET_NOLOG(LaunchNode(*node_state));
+  }
+}
+
+Status SubgraphExecutor::LaunchNode(NodeState &node_state) {
+  GELOGD("[%s] Start to execute.", node_state.GetName().c_str());
+  if (node_state.GetTaskContext() == nullptr) {
+    auto task_context = TaskContext::Create(*node_state.GetNodeItem(), context_, subgraph_context_.get());
     GE_CHECK_NOTNULL(task_context);
     task_context->SetForceInferShape(force_infer_shape_);
-    auto shared_task_context = std::shared_ptr<TaskContext>(task_context.release());
-    GE_CHK_STATUS_RET(ExecutionEngine::ExecuteAsync(*node_state, shared_task_context, *context_),
-                      "[%s] Execute node failed.", node_state->GetName().c_str());
-
-    GELOGD("[%s] Done executing node successfully.", node_state->GetName().c_str());
+    node_state.SetTaskContext(std::shared_ptr<TaskContext>(task_context.release()));
+  } else {
+    node_state.GetTaskContext()->Reset();
   }
+
+  GE_CHK_STATUS_RET(ExecutionEngine::ExecuteAsync(node_state, node_state.GetTaskContext(), *context_),
+                    "[%s] Execute node failed.", node_state.GetName().c_str());
+
+  GELOGD("[%s] Done executing node successfully.", node_state.GetName().c_str());
+  return SUCCESS;
 }
 
 Status SubgraphExecutor::ScheduleTasks() {
+  if (context_->dataflow_schedule) {
+    return ScheduleTasksByDataflow();
+  }
+
   GELOGD("[%s] Start to schedule prepare workers.", graph_item_->GetName().c_str());
+  if (pre_run_pool_ == nullptr) {
+    pre_run_pool_.reset(new (std::nothrow) ThreadPool(kDefaultThreadNum));
+    GE_CHECK_NOTNULL(pre_run_pool_);
+  }
   auto prepare_future = std::async([&]() -> Status {
     auto ret = PrepareNodes();
     ready_queue_.Push(nullptr);
@@ -306,6 +461,191 @@ Status SubgraphExecutor::ScheduleTasks() {
   return SUCCESS;
 }
 
+Status SubgraphExecutor::PrepareNode(NodeState &node_state) {
+  const auto &node_item = *node_state.GetNodeItem();
+  GELOGD("[%s] Start to prepare node [%s].", graph_item_->GetName().c_str(), node_item.NodeName().c_str());
+  if (node_item.node_type == NETOUTPUT) {
+    // all output tensors and shapes are valid once NetOutput is prepared
+    if (!skip_shape_inference_) {
+      GE_CHK_STATUS_RET_NOLOG(node_state.GetShapeInferenceState().AwaitShapesReady(*context_));
+    }
+    return node_state.AwaitInputTensors(*context_);
+  }
+
+  if (node_item.is_dynamic && !skip_shape_inference_) {
+    GE_CHK_STATUS_RET_NOLOG(InferShape(shape_inference_engine_.get(), node_state));
+    return PrepareForExecution(context_, node_state);
+  }
+
+  if (node_item.kernel_task == nullptr) {
+    if (!node_item.is_dynamic) {
+      GELOGW("[%s] Node of static shape got no task.", node_item.NodeName().c_str());
+    }
+    GE_CHK_STATUS_RET(TaskCompileEngine::Compile(node_state, context_), "[%s] Failed to create task.",
+                      node_state.GetName().c_str());
+  } else {
+    node_state.SetKernelTask(node_item.kernel_task);
+  }
+  return SUCCESS;
+}
+
+void SubgraphExecutor::SchedulePreparation(NodeState *node_state, std::vector<NodeState *> &in_place_nodes) {
+  // static nodes with task are cheap to prepare, do it on current thread
+  const auto &node_item = *node_state->GetNodeItem();
+  if ((!node_item.is_dynamic || skip_shape_inference_) && node_item.kernel_task != nullptr &&
+      node_item.node_type != NETOUTPUT) {
+    in_place_nodes.emplace_back(node_state);
+    return;
+  }
+
+  {
+    std::lock_guard<std::mutex> lk(schedule_mu_);
+    ++num_running_tasks_;
+  }
+  auto ret = prepare_pool_->Submit([this, node_state]() {
+    std::vector<NodeState *> nodes{node_state};
+    PrepareNodesByDataflow(nodes);
+    std::lock_guard<std::mutex> lk(schedule_mu_);
+    if (--num_running_tasks_ == 0) {
+      schedule_cv_.notify_all();
+    }
+  });
+  if (ret != SUCCESS) {
+    {
+      std::lock_guard<std::mutex> lk(schedule_mu_);
+      --num_running_tasks_;
+    }
+    OnScheduleError(ret);
+  }
+}
+
+void SubgraphExecutor::OnPrepareDone(NodeState *node_state, std::vector<NodeState *> &in_place_nodes) {
+  if (node_state->DecreasePendingLaunch()) {
+    ready_queue_.Push(node_state);
+  }
+
+  const auto &all_nodes = graph_item_->GetAllNodes();
+  auto node_index = graph_item_->GetNodeIndex(node_state->GetNodeItem());
+  for (auto dst_index : graph_item_->GetSuccessors(node_index)) {
+    auto dst_node_state = subgraph_context_->GetNodeState(all_nodes[dst_index]);
+    if (dst_node_state != nullptr && dst_node_state->DecreasePendingPrepare()) {
+      SchedulePreparation(dst_node_state.get(), in_place_nodes);
+    }
+  }
+}
+
+void SubgraphExecutor::PrepareNodesByDataflow(std::vector<NodeState *> &nodes) {
+  while (!nodes.empty() && !schedule_aborted_) {
+    auto node_state = nodes.back();
+    nodes.pop_back();
+    auto ret = PrepareNode(*node_state);
+    if (ret != SUCCESS) {
+      GELOGE(ret, "[%s] Failed to prepare node [%s].", graph_item_->GetName().c_str(), node_state->GetName().c_str());
+      OnScheduleError(ret);
+      return;
+    }
+    OnPrepareDone(node_state, nodes);
+  }
+}
+
+void SubgraphExecutor::OnScheduleError(Status error) {
+  {
+    std::lock_guard<std::mutex> lk(schedule_mu_);
+    if (schedule_status_ == SUCCESS) {
+      schedule_status_ = error;
+    }
+  }
+  schedule_aborted_ = true;
+  // wake up the launching thread
+  ready_queue_.Push(nullptr);
+}
+
+void SubgraphExecutor::WaitForPrepareTasks() {
+  std::unique_lock<std::mutex> lk(schedule_mu_);
+  schedule_cv_.wait(lk, [this] { return num_running_tasks_ == 0; });
+}
+
+Status SubgraphExecutor::ScheduleTasksByDataflow() {
+  GELOGD("[%s] Start to schedule tasks by dataflow.", graph_item_->GetName().c_str());
+  if (prepare_pool_ == nullptr) {
+    prepare_pool_.reset(new (std::nothrow) WorkStealingPool(kDefaultThreadNum));
+    GE_CHECK_NOTNULL(prepare_pool_);
+  }
+
+  const auto &all_nodes = graph_item_->GetAllNodes();
+  std::vector<NodeState *> root_nodes;
+  for (size_t i = 0; i < all_nodes.size(); ++i) {
+    auto node_state = subgraph_context_->GetNodeState(all_nodes[i]);
+    GE_CHECK_NOTNULL(node_state);
+    auto num_predecessors = graph_item_->GetNumPredecessors(static_cast<int>(i));
+    node_state->ResetPendingCounts(num_predecessors);
+    if (num_predecessors == 0) {
+      root_nodes.emplace_back(node_state.get());
+    }
+  }
+  schedule_status_ = SUCCESS;
+  schedule_aborted_ = false;
+  launch_list_.clear();
+
+  // counters of all nodes must be reset before any node is scheduled
+  std::vector<NodeState *> in_place_nodes;
+  for (auto node_state : root_nodes) {
+    SchedulePreparation(node_state, in_place_nodes);
+  }
+  PrepareNodesByDataflow(in_place_nodes);
+
+  GELOGD("[%s] Start to execute subgraph.", graph_item_->GetName().c_str());
+  Status ret = SUCCESS;
+  size_t num_launched = 0;
+  while (num_launched < all_nodes.size()) {
+    NodeState *node_state = nullptr;
+    if (!launch_list_.empty()) {
+      node_state = launch_list_.back();
+      launch_list_.pop_back();
+    } else if (!ready_queue_.Pop(node_state) || node_state == nullptr) {
+      std::lock_guard<std::mutex> lk(schedule_mu_);
+      ret = schedule_status_ != SUCCESS ? schedule_status_ : INTERNAL_ERROR;
+      break;
+    }
+
+    if (node_state->GetNodeItem()->node_type != NETOUTPUT) {
+      ret = LaunchNode(*node_state);
+      if (ret != SUCCESS) {
+        break;
+      }
+    }
+    ++num_launched;
+
+    // successors are launched on current thread, never pushed to the bounded queue
+    auto node_index = graph_item_->GetNodeIndex(node_state->GetNodeItem());
+    for (auto dst_index : graph_item_->GetSuccessors(node_index)) {
+      auto dst_node_state = subgraph_context_->GetNodeState(all_nodes[dst_index]);
+      if (dst_node_state == nullptr) {
+        ret = INTERNAL_ERROR;
+        break;
+      }
+      if (dst_node_state->DecreasePendingLaunch()) {
+        launch_list_.emplace_back(dst_node_state.get());
+      }
+    }
+    if (ret != SUCCESS) {
+      break;
+    }
+  }
+
+  if (ret != SUCCESS) {
+    GELOGE(ret, "[%s] Failed to execute subgraph.", graph_item_->GetName().c_str());
+    schedule_aborted_ = true;
+    subgraph_context_->OnError(ret);
+    ready_queue_.Stop();
+  }
+  WaitForPrepareTasks();
+  GE_CHK_STATUS_RET(ret, "[%s] Error occurred in task scheduling.", graph_item_->GetName().c_str());
+
+  GELOGD("[%s] Done launching all tasks successfully.", graph_item_->GetName().c_str());
+  return SUCCESS;
+}
+
 Status SubgraphExecutor::GetOutputs(vector<TensorValue> &outputs) { return subgraph_context_->GetOutputs(outputs); }
 
 Status SubgraphExecutor::GetOutputs(vector<TensorValue> &outputs, std::vector<ConstGeTensorDescPtr> &output_desc) {
@@ -17,6 +17,9 @@
 #ifndef GE_HYBRID_EXECUTOR_EXECUTOR_SUBGRAPH_EXECUTOR_H_
 #define GE_HYBRID_EXECUTOR_EXECUTOR_SUBGRAPH_EXECUTOR_H_
 
+#include <atomic>
+#include <condition_variable>
+#include <mutex>
 #include <vector>
 
 #include "common/blocking_queue.h"
@@ -25,6 +28,7 @@
 #include "hybrid/executor/node_state.h"
 #include "hybrid/executor/hybrid_execution_context.h"
 #include "hybrid/executor/worker/shape_inference_engine.h"
+#include "hybrid/executor/worker/work_stealing_pool.h"
 #include "hybrid/model/graph_item.h"
 #include "hybrid/node_executor/task_context.h"
 
@@ -74,27 +78,65 @@ class SubgraphExecutor {
    */
   Status GetOutputs(std::vector<TensorValue> &outputs, std::vector<ConstGeTensorDescPtr> &output_desc);
 
+  /**
+   * Release tensors held by the last execution. The execution plan is kept and reused by the next execution
+   */
+  void ReleaseContext();
+
+  const GraphExecutionContext *GetExecutionContext() const { return context_; }
+
+  /**
+   * Infer shapes and compile tasks of dynamic shaped nodes without executing them,
+   * so that later executions with the same input shapes hit the task compile cache
+   * @param input_shapes    input shapes of subgraph
+   * @return SUCCESS on success, error code otherwise
+   */
+  Status WarmUp(const std::vector<GeShape> &input_shapes);
+
  private:
   static Status PrepareForExecution(GraphExecutionContext *ctx, NodeState &node_state);
   static Status InferShape(ShapeInferenceEngine *shape_inference_engine, NodeState &node_state);
+  Status InitExecutionPlan();
   Status Init(const std::vector<TensorValue> &inputs, const std::vector<ConstGeTensorDescPtr> &input_desc);
   Status InitInputsForUnknownShape(const std::vector<TensorValue> &inputs,
                                    const std::vector<ConstGeTensorDescPtr> &input_desc);
   Status InitInputsForKnownShape(const std::vector<TensorValue> &inputs);
+  void AppendInputSignature(size_t index, const GeTensorDesc &tensor_desc);
   Status ExecuteAsyncForKnownShape(const std::vector<TensorValue> &inputs);
   Status ScheduleTasks();
   Status PrepareNodes();
   Status LaunchTasks();
+  Status LaunchNode(NodeState &node_state);
   Status SetOutputsToParentNode(TaskContext &task_context);
 
+  // dataflow scheduling
+  Status ScheduleTasksByDataflow();
+  Status PrepareNode(NodeState &node_state);
+  void PrepareNodesByDataflow(std::vector<NodeState *> &nodes);
+  void SchedulePreparation(NodeState *node_state, std::vector<NodeState *> &in_place_nodes);
+  void OnPrepareDone(NodeState *node_state, std::vector<NodeState *> &in_place_nodes);
+  void OnScheduleError(Status error);
+  void WaitForPrepareTasks();
+
   const GraphItem *graph_item_;
   GraphExecutionContext *context_;
   std::unique_ptr<SubgraphContext> subgraph_context_;
   bool force_infer_shape_;
-  ThreadPool pre_run_pool_;
+  std::unique_ptr<ThreadPool> pre_run_pool_;
+  std::unique_ptr<WorkStealingPool> prepare_pool_;
   BlockingQueue<NodeState *> ready_queue_;
+  std::vector<NodeState *> launch_list_;
+  std::atomic<bool> schedule_aborted_{false};
+  std::mutex schedule_mu_;
+  std::condition_variable schedule_cv_;
+  int num_running_tasks_ = 0;
+  Status schedule_status_ = SUCCESS;
   std::unique_ptr<ShapeInferenceEngine> shape_inference_engine_;
   std::shared_ptr<TaskContext> known_shape_task_context_;
+  // shapes, data types and formats of dynamic shaped inputs
+  std::vector<int64_t> input_signature_;
+  // shapes kept in op descs by the last execution are valid for current inputs
+  bool skip_shape_inference_ = false;
 };
 }  // namespace hybrid
 }  // namespace ge
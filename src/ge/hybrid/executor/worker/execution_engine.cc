@@ -54,7 +54,7 @@ Status LogOutputs(const NodeItem &node_item, const TaskContext &task_context) {
 class NodeDoneCallback {
  public:
   NodeDoneCallback(GraphExecutionContext *graph_context, std::shared_ptr<TaskContext> task_context);
-  ~NodeDoneCallback() = default;
+  ~NodeDoneCallback();
   Status OnNodeDone();
 
  private:
@@ -66,6 +66,11 @@ class NodeDoneCallback {
 NodeDoneCallback::NodeDoneCallback(GraphExecutionContext *graph_context, std::shared_ptr<TaskContext> task_context)
     : graph_context_(graph_context), context_(std::move(task_context)) {}
 
+NodeDoneCallback::~NodeDoneCallback() {
+  // task context is kept by node state for reuse, release resources of this execution once the node is done
+  context_->ReleaseResources();
+}
+
 Status NodeDoneCallback::PrepareConstInputs(const NodeItem &node_item) {
   for (auto output_idx : node_item.to_const_output_id_list) {
     RECORD_CALLBACK_EVENT(graph_context_, node_item.NodeName().c_str(), "[PrepareConstInputs] [index = %d] Start",
@@ -159,8 +164,21 @@ Status ExecutionEngine::ExecuteAsync(NodeState &node_state, const std::shared_pt
     }
   };
 
+  const auto &task = node_state.GetKernelTask();
+  bool stream_ordered = (task != nullptr) && task->IsStreamOrdered();
+  task_context->SetStreamOrdered(stream_ordered);
   GE_CHK_STATUS_RET_NOLOG(DoExecuteAsync(node_state, *task_context, execution_context, callback));
   GE_CHK_STATUS_RET_NOLOG(PropagateOutputs(*node_state.GetNodeItem(), *task_context, execution_context));
+
+  // inputs freed in stream order need not be held until the node is done
+  if (stream_ordered) {
+    for (int i = 0; i < task_context->NumInputs(); ++i) {
+      const TensorValue *input = task_context->GetInput(i);
+      if (input != nullptr && input->IsStreamOrdered()) {
+        task_context->ReleaseInput(i);
+      }
+    }
+  }
   return SUCCESS;
 }
 
@@ -15,12 +15,25 @@
  */
 
 #include "hybrid/executor/worker/shape_inference_engine.h"
+#include <algorithm>
+#include <cstring>
+#include "graph/runtime_inference_context.h"
 #include "graph/shape_refiner.h"
 #include "graph/utils/node_utils.h"
 #include "hybrid/node_executor/node_executor.h"
 
 namespace ge {
 namespace hybrid {
+namespace {
+const size_t kMaxShapeMemoSize = 8;
+
+void AppendShape(const GeShape &shape, std::vector<int64_t> &signature) {
+  const auto &dims = shape.GetDims();
+  signature.emplace_back(static_cast<int64_t>(dims.size()));
+  signature.insert(signature.end(), dims.begin(), dims.end());
+}
+}  // namespace
+
 ShapeInferenceEngine::ShapeInferenceEngine(GraphExecutionContext *execution_context, SubgraphContext *subgraph_context)
     : execution_context_(execution_context), subgraph_context_(subgraph_context) {}
 
@@ -49,14 +62,19 @@ Status ShapeInferenceEngine::InferShape(NodeState &node_state) {
   // Wait for "const input nodes" if node's shape inference function requires any.
   GE_CHK_STATUS_RET_NOLOG(AwaitDependentNodes(node_state));
 
-  // Do shape inference
-  GELOGD("[%s] Start to invoke InferShapeAndType", node_item.NodeName().c_str());
-  {
-    std::lock_guard<std::mutex> lk(mu_);
-    RECORD_SHAPE_INFERENCE_EVENT(execution_context_, node_item.NodeName().c_str(), "[InferShapeAndType] Start");
-    GE_CHK_STATUS_RET(ShapeRefiner::InferShapeAndType(node_item.node), "Invoke InferShapeAndType failed.");
-    RECORD_SHAPE_INFERENCE_EVENT(execution_context_, node_item.NodeName().c_str(), "[InferShapeAndType] End");
+  // output shapes of DEPEND_SHAPE_RANGE are ranges, which are not memoised
+  auto &memo = node_state.GetShapeInferenceMemo();
+  bool use_memo = node_item.shape_inference_type != DEPEND_SHAPE_RANGE && BuildSignature(node_item, memo);
+  if (use_memo && ReplayOutputShapes(node_item, memo)) {
+    GELOGD("[%s] Output shapes are replayed from memo.", node_item.NodeName().c_str());
+    return SUCCESS;
   }
+
+  // Do shape inference, inference contexts are kept per graph, so there is no need to serialise it
+  GELOGD("[%s] Start to invoke InferShapeAndType", node_item.NodeName().c_str());
+  RECORD_SHAPE_INFERENCE_EVENT(execution_context_, node_item.NodeName().c_str(), "[InferShapeAndType] Start");
+  GE_CHK_STATUS_RET(ShapeRefiner::InferShapeAndType(node_item.node), "Invoke InferShapeAndType failed.");
+  RECORD_SHAPE_INFERENCE_EVENT(execution_context_, node_item.NodeName().c_str(), "[InferShapeAndType] End");
   // Check again to make sure shape is valid after shape inference
   if (node_item.shape_inference_type != DEPEND_SHAPE_RANGE) {
     bool is_unknown_shape = false;
@@ -70,10 +88,126 @@ Status ShapeInferenceEngine::InferShape(NodeState &node_state) {
   GELOGD("[%s] [HybridTrace] After shape inference. Node = %s", node_item.NodeName().c_str(),
          node_item.DebugString().c_str());
 
+  if (use_memo) {
+    SaveOutputShapes(node_item, memo);
+  }
   GELOGD("[%s] InferShapeAndType finished successfully.", node_item.NodeName().c_str());
   return SUCCESS;
 }
 
+Status ShapeInferenceEngine::ParseDependentInputs(const NodeItem &node_item, ShapeInferenceMemo &memo) {
+  for (const auto &input_name : node_item.op_desc->GetOpInferDepends()) {
+    int input_index = node_item.op_desc->GetInputIndexByName(input_name);
+    GE_CHECK_GE(input_index, 0);
+    const auto &in_anchor = node_item.node->GetInDataAnchor(input_index);
+    GE_CHECK_NOTNULL(in_anchor);
+    const auto &peer_out_anchor = in_anchor->GetPeerOutAnchor();
+    GE_CHECK_NOTNULL(peer_out_anchor);
+    const auto &src_node = peer_out_anchor->GetOwnerNode();
+    GE_CHECK_NOTNULL(src_node);
+    GE_CHECK_NOTNULL(src_node->GetOpDesc());
+    memo.dependent_inputs.emplace_back(src_node->GetOpDesc()->GetId(), peer_out_anchor->GetIdx());
+  }
+  return SUCCESS;
+}
+
+bool ShapeInferenceEngine::BuildSignature(const NodeItem &node_item, ShapeInferenceMemo &memo) {
+  if (!memo.dependent_inputs_parsed) {
+    if (ParseDependentInputs(node_item, memo) != SUCCESS) {
+      GELOGW("[%s] Failed to parse dependent inputs, shape inference will not be memoised.",
+             node_item.NodeName().c_str());
+      return false;
+    }
+    memo.dependent_inputs_parsed = true;
+  }
+
+  auto &signature = memo.signature;
+  signature.clear();
+  for (int i = 0; i < node_item.num_inputs; ++i) {
+    auto input_desc = node_item.op_desc->MutableInputDesc(static_cast<uint32_t>(i));
+    if (input_desc == nullptr) {
+      signature.emplace_back(-1);
+      continue;
+    }
+    signature.emplace_back(static_cast<int64_t>(input_desc->GetDataType()));
+    signature.emplace_back(static_cast<int64_t>(input_desc->GetFormat()));
+    AppendShape(input_desc->GetShape(), signature);
+    AppendShape(input_desc->GetOriginShape(), signature);
+  }
+
+  if (memo.dependent_inputs.empty()) {
+    return true;
+  }
+
+  // values of dependent inputs are part of the signature
+  RuntimeInferenceContext *runtime_infer_ctx = nullptr;
+  if (RuntimeInferenceContext::GetContext(std::to_string(execution_context_->session_id), &runtime_infer_ctx) !=
+      GRAPH_SUCCESS) {
+    return false;
+  }
+  for (const auto &dependent_input : memo.dependent_inputs) {
+    Tensor tensor;
+    if (runtime_infer_ctx->GetTensor(dependent_input.first, dependent_input.second, tensor) != GRAPH_SUCCESS) {
+      return false;
+    }
+    auto size = tensor.GetSize();
+    signature.emplace_back(static_cast<int64_t>(size));
+    auto offset = signature.size();
+    signature.resize(offset + (size + sizeof(int64_t) - 1) / sizeof(int64_t), 0);
+    if (size > 0) {
+      memcpy(&signature[offset], tensor.GetData(), size);
+    }
+  }
+  return true;
+}
+
+bool ShapeInferenceEngine::ReplayOutputShapes(const NodeItem &node_item, ShapeInferenceMemo &memo) {
+  for (size_t i = 0; i < memo.entries.size(); ++i) {
+    if (memo.entries[i].signature != memo.signature) {
+      continue;
+    }
+
+    const auto &outputs = memo.entries[i].outputs;
+    for (size_t j = 0; j < outputs.size(); ++j) {
+      auto output_desc = node_item.op_desc->MutableOutputDesc(static_cast<uint32_t>(j));
+      if (output_desc == nullptr) {
+        continue;
+      }
+      output_desc->SetShape(outputs[j].shape);
+      output_desc->SetOriginShape(outputs[j].ori_shape);
+      output_desc->SetDataType(outputs[j].data_type);
+      output_desc->SetOriginDataType(outputs[j].ori_data_type);
+    }
+    if (i != 0) {
+      std::rotate(memo.entries.begin(), memo.entries.begin() + i, memo.entries.begin() + i + 1);
+    }
+    return true;
+  }
+  return false;
+}
+
+void ShapeInferenceEngine::SaveOutputShapes(const NodeItem &node_item, ShapeInferenceMemo &memo) {
+  if (memo.entries.size() >= kMaxShapeMemoSize) {
+    memo.entries.pop_back();
+  }
+
+  ShapeInferenceMemo::Entry entry;
+  entry.signature = memo.signature;
+  entry.outputs.resize(node_item.num_outputs);
+  for (int i = 0; i < node_item.num_outputs; ++i) {
+    auto output_desc = node_item.op_desc->MutableOutputDesc(static_cast<uint32_t>(i));
+    if (output_desc == nullptr) {
+      continue;
+    }
+    auto &output = entry.outputs[i];
+    output.shape = output_desc->GetShape();
+    output.ori_shape = output_desc->GetOriginShape();
+    output.data_type = output_desc->GetDataType();
+    output.ori_data_type = output_desc->GetOriginDataType();
+  }
+  memo.entries.insert(memo.entries.begin(), std::move(entry));
+}
+
 Status ShapeInferenceEngine::AwaitDependentNodes(NodeState &node_state) {
   auto &node_item = *node_state.GetNodeItem();
   for (auto &src_node : node_item.dependents_for_shape_inference) {
@@ -114,7 +248,7 @@ Status ShapeInferenceEngine::PropagateOutputShapes(const NodeItem &node_item) {
     // propagate output to all sub-inputs
     for (auto &dst_input_index_and_node : output_nodes) {
       auto &dst_node_item = dst_input_index_and_node.second;
-      auto dst_node_state = subgraph_context_->GetOrCreateNodeState(dst_node_item);
+      auto dst_node_state = subgraph_context_->GetNodeState(dst_node_item);
       GE_CHECK_NOTNULL(dst_node_state);
 
       GELOGI("[%s] Update dst node [%s], input index = %d", node_item.NodeName().c_str(),
@@ -19,7 +19,6 @@
 
 #include "hybrid/executor/hybrid_execution_context.h"
 #include "hybrid/executor/subgraph_context.h"
-#include <mutex>
 
 namespace ge {
 namespace hybrid {
@@ -34,10 +33,13 @@ class ShapeInferenceEngine {
 
  private:
   Status AwaitDependentNodes(NodeState &node_state);
+  Status ParseDependentInputs(const NodeItem &node_item, ShapeInferenceMemo &memo);
+  bool BuildSignature(const NodeItem &node_item, ShapeInferenceMemo &memo);
+  static bool ReplayOutputShapes(const NodeItem &node_item, ShapeInferenceMemo &memo);
+  static void SaveOutputShapes(const NodeItem &node_item, ShapeInferenceMemo &memo);
 
   GraphExecutionContext *execution_context_;
   SubgraphContext *subgraph_context_;
-  std::mutex mu_;
 };
 }  // namespace hybrid
 }  // namespace ge
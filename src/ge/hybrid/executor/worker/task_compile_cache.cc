@@ -0,0 +1,202 @@
+/**
+ * Copyright 2019-2020 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "hybrid/executor/worker/task_compile_cache.h"
+#include <cstdlib>
+#include "framework/common/debug/log.h"
+#include "graph/utils/tensor_utils.h"
+
+namespace ge {
+namespace hybrid {
+namespace {
+const char *const kEnvCompileCacheSize = "GE_HYBRID_COMPILE_CACHE_SIZE";
+const size_t kDefaultCompileCacheSize = 1024;
+}  // namespace
+
+TaskCompileCache::TaskCompileCache() : capacity_(kDefaultCompileCacheSize) {
+  const char *cache_size = std::getenv(kEnvCompileCacheSize);
+  if (cache_size != nullptr) {
+    char *end = nullptr;
+    auto capacity = std::strtoll(cache_size, &end, 10);
+    if (end != cache_size && *end == '\0' && capacity >= 0) {
+      capacity_ = static_cast<size_t>(capacity);
+    } else {
+      GELOGW("Invalid %s: %s, use default capacity %zu.", kEnvCompileCacheSize, cache_size, capacity_);
+    }
+  }
+  stats_.capacity = capacity_;
+  GELOGI("Capacity of task compile cache = %zu.", capacity_);
+}
+
+Status TaskCompileCache::GenerateKey(uint32_t model_id, const OpDesc &op_desc, std::string &key) {
+  // (model_id + op_id) identifies the node, then data type, format and shape of each input
+  key = std::to_string(model_id);
+  key.push_back('/');
+  key.append(std::to_string(op_desc.GetId()));
+  for (size_t i = 0; i < op_desc.GetInputsSize(); ++i) {
+    auto input_desc = op_desc.GetInputDescPtr(static_cast<uint32_t>(i));
+    GE_CHECK_NOTNULL(input_desc);
+    key.push_back('-');
+    key.append(std::to_string(static_cast<int>(input_desc->GetDataType())));
+    key.push_back(':');
+    key.append(std::to_string(static_cast<int>(input_desc->GetFormat())));
+    key.push_back(':');
+    const auto &dims = input_desc->GetShape().GetDims();
+    for (size_t j = 0; j < dims.size(); ++j) {
+      if (j != 0) {
+        key.push_back('_');
+      }
+      key.append(std::to_string(dims[j]));
+    }
+  }
+  return SUCCESS;
+}
+
+bool TaskCompileCache::IsRunningParamCacheable(const NodeItem &node_item) {
+  return node_item.shape_inference_type == DEPEND_IN_SHAPE && node_item.dependents_for_shape_inference.empty();
+}
+
+TaskCompileCache::CacheEntry *TaskCompileCache::Touch(const std::string &key) {
+  auto it = index_.find(key);
+  if (it == index_.end()) {
+    return nullptr;
+  }
+  entries_.splice(entries_.begin(), entries_, it->second);
+  return &entries_.front();
+}
+
+TaskCompileCache::CacheEntry &TaskCompileCache::FindOrCreate(const std::string &key) {
+  auto entry = Touch(key);
+  if (entry != nullptr) {
+    return *entry;
+  }
+  entries_.emplace_front();
+  entries_.front().key = key;
+  index_.emplace(key, entries_.begin());
+  EvictIfNeeded();
+  return entries_.front();
+}
+
+void TaskCompileCache::EvictIfNeeded() {
+  while (entries_.size() > capacity_ && !entries_.empty()) {
+    GELOGD("Evict [%s] from task compile cache.", entries_.back().key.c_str());
+    index_.erase(entries_.back().key);
+    entries_.pop_back();
+    ++stats_.evictions;
+  }
+}
+
+std::shared_ptr<NodeTask> TaskCompileCache::GetTask(const std::string &key) {
+  std::lock_guard<std::mutex> lk(mu_);
+  auto entry = Touch(key);
+  if (entry == nullptr || entry->task == nullptr) {
+    ++stats_.task_misses;
+    return nullptr;
+  }
+  ++stats_.task_hits;
+  return entry->task;
+}
+
+void TaskCompileCache::PutTask(const std::string &key, const std::shared_ptr<NodeTask> &task) {
+  std::lock_guard<std::mutex> lk(mu_);
+  if (capacity_ == 0) {
+    return;
+  }
+  FindOrCreate(key).task = task;
+}
+
+bool TaskCompileCache::GetRunningParam(const std::string &key, OpRunningParam &running_param) {
+  std::lock_guard<std::mutex> lk(mu_);
+  auto entry = Touch(key);
+  if (entry == nullptr || !entry->has_running_param) {
+    ++stats_.running_param_misses;
+    return false;
+  }
+  ++stats_.running_param_hits;
+  running_param = entry->running_param;
+  return true;
+}
+
+void TaskCompileCache::PutRunningParam(const std::string &key, const OpRunningParam &running_param) {
+  std::lock_guard<std::mutex> lk(mu_);
+  if (capacity_ == 0) {
+    return;
+  }
+  auto &entry = FindOrCreate(key);
+  entry.running_param = running_param;
+  entry.has_running_param = true;
+}
+
+Status TaskCompileCache::SaveRunningParam(const OpDesc &op_desc, OpRunningParam &running_param) {
+  running_param.output_sizes.resize(op_desc.GetOutputsSize());
+  for (size_t i = 0; i < op_desc.GetOutputsSize(); ++i) {
+    auto output_desc = op_desc.GetOutputDescPtr(static_cast<uint32_t>(i));
+    GE_CHECK_NOTNULL(output_desc);
+    int64_t size = 0;
+    (void)TensorUtils::GetSize(*output_desc, size);
+    running_param.output_sizes[i] = size;
+  }
+  running_param.workspace_bytes = op_desc.GetWorkspaceBytes();
+  return SUCCESS;
+}
+
+Status TaskCompileCache::ApplyRunningParam(const OpRunningParam &running_param, OpDesc &op_desc) {
+  GE_CHECK_LE(running_param.output_sizes.size(), op_desc.GetOutputsSize());
+  for (size_t i = 0; i < running_param.output_sizes.size(); ++i) {
+    auto output_desc = op_desc.MutableOutputDesc(static_cast<uint32_t>(i));
+    GE_CHECK_NOTNULL(output_desc);
+    TensorUtils::SetSize(*output_desc, running_param.output_sizes[i]);
+  }
+  op_desc.SetWorkspaceBytes(running_param.workspace_bytes);
+  return SUCCESS;
+}
+
+void TaskCompileCache::SetCapacity(size_t capacity) {
+  std::lock_guard<std::mutex> lk(mu_);
+  capacity_ = capacity;
+  stats_.capacity = capacity;
+  EvictIfNeeded();
+}
+
+void TaskCompileCache::GetStats(TaskCompileCacheStats &stats) {
+  std::lock_guard<std::mutex> lk(mu_);
+  stats = stats_;
+  stats.size = entries_.size();
+}
+
+void TaskCompileCache::Clear() {
+  std::lock_guard<std::mutex> lk(mu_);
+  entries_.clear();
+  index_.clear();
+  stats_ = TaskCompileCacheStats();
+  stats_.capacity = capacity_;
+}
+
+void TaskCompileCache::ClearModel(uint32_t model_id) {
+  std::string prefix = std::to_string(model_id);
+  prefix.push_back('/');
+  std::lock_guard<std::mutex> lk(mu_);
+  for (auto it = entries_.begin(); it != entries_.end();) {
+    if (it->key.compare(0, prefix.size(), prefix) == 0) {
+      index_.erase(it->key);
+      it = entries_.erase(it);
+    } else {
+      ++it;
+    }
+  }
+}
+}  // namespace hybrid
+}  // namespace ge
@@ -0,0 +1,124 @@
+/**
+ * Copyright 2019-2020 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef GE_HYBRID_EXECUTOR_WORKER_TASK_COMPILE_CACHE_H_
+#define GE_HYBRID_EXECUTOR_WORKER_TASK_COMPILE_CACHE_H_
+
+#include <list>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "external/ge/ge_api_error_codes.h"
+#include "graph/op_desc.h"
+#include "hybrid/model/node_item.h"
+
+namespace ge {
+namespace hybrid {
+class NodeTask;
+
+// Results of CalcOpRunningParam that are needed for execution
+struct OpRunningParam {
+  std::vector<int64_t> output_sizes;
+  std::vector<int64_t> workspace_bytes;
+};
+
+struct TaskCompileCacheStats {
+  size_t size = 0;
+  size_t capacity = 0;
+  uint64_t task_hits = 0;
+  uint64_t task_misses = 0;
+  uint64_t running_param_hits = 0;
+  uint64_t running_param_misses = 0;
+  uint64_t evictions = 0;
+};
+
+// LRU cache of compiled tasks and running params of dynamic shaped nodes,
+// keyed by node identity and shapes, data types and formats of its inputs
+class TaskCompileCache {
+ public:
+  static TaskCompileCache &GetInstance() {
+    static TaskCompileCache instance;
+    return instance;
+  }
+
+  ~TaskCompileCache() = default;
+
+  /**
+   * Generate cache key of node with current input tensor descriptions
+   * @param model_id        id of model the node belongs to
+   * @param op_desc         op desc of node
+   * @param key             generated key
+   * @return SUCCESS on success, error code otherwise
+   */
+  static Status GenerateKey(uint32_t model_id, const OpDesc &op_desc, std::string &key);
+
+  /**
+   * Whether running params of node can be cached by its input descriptions,
+   * which is not the case if its output shapes depend on values of inputs.
+   * Compiled tasks are always cached by input descriptions.
+   * @param node_item       node to check
+   * @return true if it can be cached
+   */
+  static bool IsRunningParamCacheable(const NodeItem &node_item);
+
+  std::shared_ptr<NodeTask> GetTask(const std::string &key);
+
+  void PutTask(const std::string &key, const std::shared_ptr<NodeTask> &task);
+
+  bool GetRunningParam(const std::string &key, OpRunningParam &running_param);
+
+  void PutRunningParam(const std::string &key, const OpRunningParam &running_param);
+
+  static Status SaveRunningParam(const OpDesc &op_desc, OpRunningParam &running_param);
+
+  static Status ApplyRunningParam(const OpRunningParam &running_param, OpDesc &op_desc);
+
+  void SetCapacity(size_t capacity);
+
+  void GetStats(TaskCompileCacheStats &stats);
+
+  void Clear();
+
+  // remove entries of model, called when it is unloaded as model ids are reused
+  void ClearModel(uint32_t model_id);
+
+ private:
+  struct CacheEntry {
+    std::string key;
+    std::shared_ptr<NodeTask> task;
+    bool has_running_param = false;
+    OpRunningParam running_param;
+  };
+  using EntryIterator = std::list<CacheEntry>::iterator;
+
+  TaskCompileCache();
+  // find entry and move it to the front, nullptr if not found
+  CacheEntry *Touch(const std::string &key);
+  CacheEntry &FindOrCreate(const std::string &key);
+  void EvictIfNeeded();
+
+  std::mutex mu_;
+  size_t capacity_;
+  std::list<CacheEntry> entries_;
+  std::unordered_map<std::string, EntryIterator> index_;
+  TaskCompileCacheStats stats_;
+};
+}  // namespace hybrid
+}  // namespace ge
+#endif  // GE_HYBRID_EXECUTOR_WORKER_TASK_COMPILE_CACHE_H_
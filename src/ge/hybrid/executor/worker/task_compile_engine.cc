@@ -16,19 +16,32 @@
 
 #include "hybrid/executor/worker/task_compile_engine.h"
 #include "init/gelib.h"
+#include "hybrid/executor/worker/task_compile_cache.h"
 #include "hybrid/node_executor/node_executor.h"
 
 namespace ge {
 namespace hybrid {
 Status TaskCompileEngine::Compile(NodeState &node_state, GraphExecutionContext *context) {
   const auto &node_item = *node_state.GetNodeItem();
+  auto &cache = TaskCompileCache::GetInstance();
+  // compiled kernels only depend on input descriptions, values of inputs are handled when tiling at execution
+  std::string cache_key;
+  GE_CHK_STATUS_RET(TaskCompileCache::GenerateKey(context->model->GetModelId(), *node_item.op_desc, cache_key),
+                    "[%s] Failed to generate cache key.", node_item.NodeName().c_str());
+  auto kernel_task = cache.GetTask(cache_key);
+  if (kernel_task != nullptr) {
+    GELOGD("[%s] Hit task compile cache, key = %s", node_item.NodeName().c_str(), cache_key.c_str());
+    node_state.SetKernelTask(kernel_task);
+    return SUCCESS;
+  }
+
   RECORD_COMPILE_EVENT(context, node_item.NodeName().c_str(), "Start");
   GE_CHK_RT_RET(rtCtxSetCurrent(context->rt_gen_context));
 
-  shared_ptr<NodeTask> kernel_task;
   auto ret = node_item.node_executor->CompileTask(*context->model, node_item.node, kernel_task);
   RECORD_COMPILE_EVENT(context, node_state.GetName().c_str(), "End");
   GE_CHK_STATUS_RET(ret, "Failed to create task for node: %s", node_item.NodeName().c_str());
+  cache.PutTask(cache_key, kernel_task);
   node_state.SetKernelTask(kernel_task);
   GELOGI("Compiling node %s successfully", node_state.GetName().c_str());
   return SUCCESS;
@@ -0,0 +1,125 @@
+/**
+ * Copyright 2019-2020 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "hybrid/executor/worker/work_stealing_pool.h"
+#include "framework/common/debug/ge_log.h"
+
+namespace ge {
+namespace hybrid {
+namespace {
+// the pool and index of the worker running on current thread
+thread_local const WorkStealingPool *current_pool = nullptr;
+thread_local size_t current_index = 0;
+}  // namespace
+
+WorkStealingPool::WorkStealingPool(uint32_t size) {
+  size = size < 1 ? 1 : size;
+  for (uint32_t i = 0; i < size; ++i) {
+    queues_.emplace_back(new WorkerQueue());
+  }
+  for (uint32_t i = 0; i < size; ++i) {
+    workers_.emplace_back(&WorkStealingPool::WorkerFunc, this, i);
+  }
+}
+
+WorkStealingPool::~WorkStealingPool() {
+  {
+    std::lock_guard<std::mutex> lk(mu_);
+    stopped_ = true;
+  }
+  cv_.notify_all();
+
+  for (auto &worker : workers_) {
+    if (worker.joinable()) {
+      try {
+        worker.join();
+      } catch (const std::system_error &) {
+        GELOGW("system_error");
+      } catch (...) {
+        GELOGW("exception");
+      }
+    }
+  }
+}
+
+Status WorkStealingPool::Submit(std::function<void()> task) {
+  if (stopped_) {
+    GELOGE(INTERNAL_ERROR, "Work stealing pool has been stopped.");
+    return INTERNAL_ERROR;
+  }
+
+  size_t index = current_pool == this ? current_index : next_queue_++ % queues_.size();
+  {
+    auto &queue = *queues_[index];
+    std::lock_guard<std::mutex> lk(queue.mu);
+    queue.tasks.emplace_back(std::move(task));
+  }
+
+  {
+    std::lock_guard<std::mutex> lk(mu_);
+    ++num_pending_;
+  }
+  cv_.notify_one();
+  return SUCCESS;
+}
+
+bool WorkStealingPool::PopTask(size_t index, std::function<void()> &task) {
+  // newest task of its own queue, whose inputs are most likely still hot
+  {
+    auto &queue = *queues_[index];
+    std::lock_guard<std::mutex> lk(queue.mu);
+    if (!queue.tasks.empty()) {
+      task = std::move(queue.tasks.back());
+      queue.tasks.pop_back();
+      --num_pending_;
+      return true;
+    }
+  }
+
+  // oldest task of the others
+  for (size_t i = 1; i < queues_.size(); ++i) {
+    auto &queue = *queues_[(index + i) % queues_.size()];
+    std::lock_guard<std::mutex> lk(queue.mu);
+    if (!queue.tasks.empty()) {
+      task = std::move(queue.tasks.front());
+      queue.tasks.pop_front();
+      --num_pending_;
+      return true;
+    }
+  }
+  return false;
+}
+
+void WorkStealingPool::WorkerFunc(size_t index) {
+  current_pool = this;
+  current_index = index;
+  while (true) {
+    std::function<void()> task;
+    if (PopTask(index, task)) {
+      task();
+      continue;
+    }
+
+    std::unique_lock<std::mutex> lk(mu_);
+    cv_.wait(lk, [this] { return stopped_ || num_pending_ > 0; });
+    if (stopped_ && num_pending_ == 0) {
+      break;
+    }
+  }
+  current_pool = nullptr;
+}
+}  // namespace hybrid
+}  // namespace ge
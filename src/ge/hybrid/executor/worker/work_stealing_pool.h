@@ -0,0 +1,69 @@
+/**
+ * Copyright 2019-2020 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef GE_HYBRID_EXECUTOR_WORKER_WORK_STEALING_POOL_H_
+#define GE_HYBRID_EXECUTOR_WORKER_WORK_STEALING_POOL_H_
+
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "external/ge/ge_api_error_codes.h"
+
+namespace ge {
+namespace hybrid {
+// Thread pool with one task deque per worker.
+// A worker pops its own deque in LIFO order, and steals from the others in FIFO order when it runs out of tasks.
+// Tasks submitted by a worker go to its own deque, so that a chain of dependent tasks stays on the same thread.
+class WorkStealingPool {
+ public:
+  explicit WorkStealingPool(uint32_t size);
+  ~WorkStealingPool();
+
+  /**
+   * Submit a task to the pool
+   * @param task            task to run
+   * @return SUCCESS on success, error code otherwise
+   */
+  Status Submit(std::function<void()> task);
+
+  size_t GetThreadNum() const { return workers_.size(); }
+
+ private:
+  struct WorkerQueue {
+    std::mutex mu;
+    std::deque<std::function<void()>> tasks;
+  };
+
+  void WorkerFunc(size_t index);
+  bool PopTask(size_t index, std::function<void()> &task);
+
+  std::vector<std::unique_ptr<WorkerQueue>> queues_;
+  std::vector<std::thread> workers_;
+  std::atomic<size_t> next_queue_{0};
+  std::atomic<int64_t> num_pending_{0};
+  std::atomic<bool> stopped_{false};
+  std::mutex mu_;
+  std::condition_variable cv_;
+};
+}  // namespace hybrid
+}  // namespace ge
+#endif  // GE_HYBRID_EXECUTOR_WORKER_WORK_STEALING_POOL_H_
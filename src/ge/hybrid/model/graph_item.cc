@@ -16,6 +16,8 @@
 
 #include "framework/common/util.h"
 #include "graph_item.h"
+#include <algorithm>
+#include <unordered_map>
 
 namespace ge {
 namespace hybrid {
@@ -59,5 +61,80 @@ int GraphItem::GetParentOutputIndex(size_t index) const {
 }
 
 const NodeItem *GraphItem::GetOutputNode() const { return output_node_; }
+
+Status GraphItem::InitExecutionPlan() {
+  std::unordered_map<const Node *, int> node_indices;
+  for (size_t i = 0; i < node_items_.size(); ++i) {
+    GE_CHECK_NOTNULL(node_items_[i]);
+    node_items_[i]->index_in_graph = static_cast<int>(i);
+    node_indices.emplace(node_items_[i]->node.get(), static_cast<int>(i));
+  }
+
+  successors_.assign(node_items_.size(), std::vector<int>());
+  num_predecessors_.assign(node_items_.size(), 0);
+  for (size_t i = 0; i < node_items_.size(); ++i) {
+    auto &successors = successors_[i];
+    for (const auto &output_edges : node_items_[i]->outputs) {
+      for (const auto &edge : output_edges) {
+        auto it = node_indices.find(edge.second->node.get());
+        if (it != node_indices.end()) {
+          successors.emplace_back(it->second);
+        }
+      }
+    }
+
+    for (const auto &dst_node : node_items_[i]->node->GetOutControlNodes()) {
+      auto it = node_indices.find(dst_node.get());
+      if (it != node_indices.end()) {
+        successors.emplace_back(it->second);
+      }
+    }
+
+    std::sort(successors.begin(), successors.end());
+    successors.erase(std::unique(successors.begin(), successors.end()), successors.end());
+    for (auto dst_index : successors) {
+      num_predecessors_[dst_index] += 1;
+    }
+  }
+
+  is_shape_determined_by_inputs_ = true;
+  for (const auto node_item : node_items_) {
+    if (!node_item->dependents_for_shape_inference.empty() || node_item->shape_inference_type == DEPEND_SHAPE_RANGE ||
+        node_item->shape_inference_type == DEPEND_COMPUTE || node_item->IsControlOp() ||
+        node_item->node_type == PARTITIONEDCALL) {
+      GELOGD("[%s] Shapes are not determined by inputs only due to node [%s].", name_.c_str(),
+             node_item->NodeName().c_str());
+      is_shape_determined_by_inputs_ = false;
+      break;
+    }
+  }
+  return SUCCESS;
+}
+
+void GraphItem::SetInferredInputSignature(const std::vector<int64_t> &signature) const {
+  std::lock_guard<std::mutex> lk(signature_mu_);
+  inferred_input_signature_ = signature;
+  has_inferred_input_signature_ = true;
+}
+
+void GraphItem::ClearInferredInputSignature() const {
+  std::lock_guard<std::mutex> lk(signature_mu_);
+  has_inferred_input_signature_ = false;
+}
+
+bool GraphItem::MatchInferredInputSignature(const std::vector<int64_t> &signature) const {
+  std::lock_guard<std::mutex> lk(signature_mu_);
+  return has_inferred_input_signature_ && inferred_input_signature_ == signature;
+}
+
+int GraphItem::GetNodeIndex(const NodeItem *node_item) const {
+  if (node_item == nullptr || node_item->index_in_graph < 0 ||
+      static_cast<size_t>(node_item->index_in_graph) >= node_items_.size() ||
+      node_items_[node_item->index_in_graph] != node_item) {
+    return kInvalidIndex;
+  }
+
+  return node_item->index_in_graph;
+}
 }  // namespace hybrid
 }  // namespace ge
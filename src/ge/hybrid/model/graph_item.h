@@ -17,6 +17,7 @@
 #ifndef GE_HYBRID_MODEL_SUBGRAPH_ITEM_H_
 #define GE_HYBRID_MODEL_SUBGRAPH_ITEM_H_
 
+#include <mutex>
 #include "external/ge/ge_api_error_codes.h"
 #include "hybrid/model/node_item.h"
 
@@ -44,6 +45,32 @@ class GraphItem {
   int GetParentOutputIndex(size_t index) const;
   const vector<int> &GetInputIndexMapping() const;
 
+  /**
+   * Build the static part of the execution plan, which is shared by all executions of the graph
+   * @return SUCCESS on success, error code otherwise
+   */
+  Status InitExecutionPlan();
+
+  int GetNodeIndex(const NodeItem *node_item) const;
+
+  const std::vector<int> &GetSuccessors(int node_index) const { return successors_[node_index]; }
+
+  int GetNumPredecessors(int node_index) const { return num_predecessors_[node_index]; }
+
+  /**
+   * Whether output shapes of all nodes are determined by input shapes of the graph only,
+   * i.e. no node depends on tensor values, computation or subgraphs for shape inference
+   */
+  bool IsShapeDeterminedByInputs() const { return is_shape_determined_by_inputs_; }
+
+  /**
+   * Op descs of the graph keep the shapes inferred by the last execution.
+   * Record the input signature of it, or clear it before shapes are going to be changed
+   */
+  void SetInferredInputSignature(const std::vector<int64_t> &signature) const;
+  void ClearInferredInputSignature() const;
+  bool MatchInferredInputSignature(const std::vector<int64_t> &signature) const;
+
  private:
   friend class HybridModelBuilder;
   std::string name_;
@@ -58,6 +85,15 @@ class GraphItem {
   bool is_dynamic_ = true;
   std::vector<int> input_index_mapping_;
   std::vector<int> output_index_mapping_;
+
+  // indices of the nodes consuming the outputs of each node, by data or control edges
+  std::vector<std::vector<int>> successors_;
+  std::vector<int> num_predecessors_;
+  bool is_shape_determined_by_inputs_ = false;
+
+  mutable std::mutex signature_mu_;
+  mutable bool has_inferred_input_signature_ = false;
+  mutable std::vector<int64_t> inferred_input_signature_;
 };
 }  // namespace hybrid
 }  // namespace ge
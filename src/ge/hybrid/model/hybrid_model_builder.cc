@@ -1136,6 +1136,7 @@ Status HybridModelBuilder::LoadKnownShapedSubgraph(ComputeGraph &graph, NodeItem
 
   GELOGD("NodeItem create for known shape subgraph [%s], NodeItem = %s", graph.GetName().c_str(),
          node_item->DebugString().c_str());
+  GE_CHK_STATUS_RET(graph_item->InitExecutionPlan(), "[%s] Failed to init execution plan.", graph.GetName().c_str());
 
   GELOGD("Done parse known shape subgraph successfully. graph = [%s]", graph.GetName().c_str());
   graph_item->SetName(graph.GetName());
@@ -1184,6 +1185,7 @@ Status HybridModelBuilder::LoadDynamicSubgraph(ComputeGraph &graph, bool is_root
   graph_item->total_inputs_ = input_start;
   graph_item->total_outputs_ = output_start;
   GE_CHK_STATUS_RET_NOLOG(BuildInputMapping(*graph_item, data_nodes, is_root_graph));
+  GE_CHK_STATUS_RET(graph_item->InitExecutionPlan(), "[%s] Failed to init execution plan.", graph.GetName().c_str());
   if (is_root_graph) {
     graph_item->SetName("Root-Graph");
     GELOGD("Done loading dynamic subgraph: [%s]", graph_item->GetName().c_str());
@@ -51,6 +51,7 @@ struct NodeItem {
   NodePtr node;
   OpDesc *op_desc;
   int node_id;
+  int index_in_graph = -1;
   int num_inputs;
   int num_outputs;
 
@@ -93,24 +93,6 @@ Status AiCoreNodeExecutor::GenNodeKey(const NodePtr &node, std::string &node_key
   return SUCCESS;
 }
 
-bool AiCoreNodeTaskRegistry::AddTask(const std::string &node_key, const std::shared_ptr<NodeTask> task) {
-  GE_CHECK_NOTNULL(task);
-  std::lock_guard<std::mutex> lock(mutex_);
-  auto iter = reg_node_tasks_.find(node_key);
-  if (iter != reg_node_tasks_.end()) {
-    GELOGE(FAILED, "AiCoreNodeTaskRegistry(%s) AddTask failed, key already exist.", node_key.c_str());
-    return false;
-  }
-  auto ret = reg_node_tasks_.emplace(node_key, task);
-  return ret.second;
-}
-
-std::shared_ptr<NodeTask> AiCoreNodeTaskRegistry::GetTask(const std::string &node_key) {
-  std::lock_guard<std::mutex> lock(mutex_);
-  auto iter = reg_node_tasks_.find(node_key);
-  return (iter != reg_node_tasks_.end()) ? iter->second : nullptr;
-}
-
 Status AiCoreNodeExecutor::CompileTask(const HybridModel &model, const NodePtr &node,
                                        shared_ptr<NodeTask> &task) const {
   GE_CHECK_NOTNULL(node);
@@ -118,18 +100,10 @@ Status AiCoreNodeExecutor::CompileTask(const HybridModel &model, const NodePtr &
   GE_CHECK_NOTNULL(op_desc);
   GELOGI("AiCoreNodeExecutor(%s) CompileTask Start.", node->GetName().c_str());
 
-  AiCoreNodeTaskRegistry &registry = AiCoreNodeTaskRegistry::GetInstance();
+  // compiled tasks are cached by TaskCompileEngine, the shape key only makes the kernel name unique
   std::string shape_key;
   GE_CHK_STATUS_RET(GenNodeKey(node, shape_key), "GenNodeKey failed, op name = %s.", node->GetName().c_str());
 
-  auto node_key = std::to_string(model.GetModelId()) + "/" + shape_key;
-  GELOGD("NodeKey for %s = %s", node->GetName().c_str(), node_key.c_str());
-  task = registry.GetTask(node_key);
-  if (task != nullptr) {
-    GELOGI("AiCoreNodeExecutor(%s) CompileTask Skip.", node->GetName().c_str());
-    return SUCCESS;
-  }
-
   std::vector<domi::TaskDef> task_defs;
   auto ori_node_name = node->GetName();
   op_desc->SetName(ori_node_name + "_" + shape_key);
@@ -142,12 +116,6 @@ Status AiCoreNodeExecutor::CompileTask(const HybridModel &model, const NodePtr &
   GE_CHK_STATUS_RET(builder.BuildTask(node_task, false), "[%s] Failed to build op tasks.", node->GetName().c_str());
   task = std::move(node_task);
   GELOGD("successfully created node task: %s", node->GetName().c_str());
-
-  if (!registry.AddTask(node_key, task)) {
-    GELOGE(INTERNAL_ERROR, "Add NodeTask failed, op name = %s.", node->GetName().c_str());
-    return INTERNAL_ERROR;
-  }
-
   GELOGI("AiCoreNodeExecutor(%s) CompileTask End.", node->GetName().c_str());
   return SUCCESS;
 }
@@ -20,34 +20,15 @@
 #include "hybrid/node_executor/aicore/aicore_task_builder.h"
 #include "hybrid/node_executor/aicore/aicore_task_compiler.h"
 #include "hybrid/node_executor/node_executor.h"
-#include <map>
-#include <mutex>
 
 namespace ge {
 namespace hybrid {
-class AiCoreNodeTaskRegistry {
- public:
-  ~AiCoreNodeTaskRegistry() = default;
-
-  static AiCoreNodeTaskRegistry &GetInstance() {
-    static AiCoreNodeTaskRegistry instance;
-    return instance;
-  }
-
-  std::shared_ptr<NodeTask> GetTask(const std::string &node_key);
-  bool AddTask(const std::string &node_key, const std::shared_ptr<NodeTask> task);
-
- private:
-  AiCoreNodeTaskRegistry() = default;
-  std::map<std::string, std::shared_ptr<NodeTask>> reg_node_tasks_;
-  std::mutex mutex_;
-};
-
 class AiCoreNodeTask : public NodeTask {
  public:
   explicit AiCoreNodeTask(std::vector<std::unique_ptr<AiCoreOpTask>> &&tasks);
   ~AiCoreNodeTask() override = default;
   bool IsSupportDynamicShape() override;
+  bool IsStreamOrdered() override { return true; }
   Status UpdateTilingData(TaskContext &context) override;
 
   Status UpdateArgs(TaskContext &context) override;
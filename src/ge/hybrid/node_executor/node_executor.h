@@ -53,6 +53,13 @@ class NodeTask {
    */
   virtual bool IsSupportDynamicShape() { return true; }
 
+  /**
+   * Whether this task only accesses its inputs through work queued on the execution stream,
+   * so that inputs can be released right after launch
+   * @return true if inputs are stream ordered, false otherwise
+   */
+  virtual bool IsStreamOrdered() { return false; }
+
   /**
    * Update args for execution
    * @param context             instance of TaskContext
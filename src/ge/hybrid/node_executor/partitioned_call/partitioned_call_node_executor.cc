@@ -29,6 +29,10 @@ PartitionedCallNodeTask::~PartitionedCallNodeTask() {
 
 Status PartitionedCallNodeTask::Init(TaskContext &context) {
   auto execution_context = const_cast<GraphExecutionContext *>(context.GetExecutionContext());
+  if (subgraph_executor_ != nullptr && subgraph_executor_->GetExecutionContext() == execution_context) {
+    return SUCCESS;
+  }
+
   subgraph_executor_.reset(new (std::nothrow) SubgraphExecutor(graph_item_, execution_context));
   GE_CHECK_NOTNULL(subgraph_executor_);
   return SUCCESS;
@@ -53,7 +57,7 @@ Status PartitionedCallNodeTask::Callback(const std::function<void()> &done_callb
   }
 
   GELOGD("[%s] To release sub graph tensors.", graph_item_->GetName().c_str());
-  subgraph_executor_.reset();
+  subgraph_executor_->ReleaseContext();
   GELOGD("[%s] Done releasing sub graph tensors.", graph_item_->GetName().c_str());
   return SUCCESS;
 }
@@ -29,11 +29,18 @@ TaskContext::TaskContext(GraphExecutionContext *execution_context, const NodeIte
 
 TaskContext::~TaskContext() {
   GELOGD("[%s] TaskContext destroyed.", node_item_->NodeName().c_str());
+  ReleaseWorkspaces();
+  ReleaseOutputs();
+}
+
+void TaskContext::ReleaseWorkspaces() {
   for (auto ws_addr : workspaces_) {
-    execution_context_->allocator->Deallocate(ws_addr);
+    execution_context_->allocator->Deallocate(ws_addr, GetAllocationStream());
   }
+  workspaces_.clear();
+}
 
-  // release output
+void TaskContext::ReleaseOutputs() {
   for (int i = 0; i < NumOutputs(); ++i) {
     auto output_tensor = MutableOutput(i);
     if (output_tensor != nullptr) {
@@ -42,6 +49,20 @@ TaskContext::~TaskContext() {
   }
 }
 
+void TaskContext::ReleaseResources() {
+  ReleaseWorkspaces();
+  if (!retain_outputs_) {
+    ReleaseOutputs();
+  }
+}
+
+void TaskContext::Reset() {
+  ReleaseWorkspaces();
+  ReleaseOutputs();
+  status_ = SUCCESS;
+  iteration_ = execution_context_->iteration;
+}
+
 std::unique_ptr<TaskContext> TaskContext::Create(const NodeItem &node_item, GraphExecutionContext *execution_context,
                                                  SubgraphContext *subgraph_context) {
   GELOGI("[%s] To create task context, input start = %d, num_inputs = %d, output start = %d, num_outputs = %d.",
@@ -121,7 +142,7 @@ const TensorValue *TaskContext::GetInput(int index) const {
 Status TaskContext::AllocateWorkspaces() {
   auto workspace_sizes = node_item_->node->GetOpDesc()->GetWorkspaceBytes();
   for (auto size : workspace_sizes) {
-    void *workspace = execution_context_->allocator->Allocate(size);
+    void *workspace = execution_context_->allocator->Allocate(size, nullptr, GetAllocationStream());
     if (workspace == nullptr) {
       GELOGE(MEMALLOC_FAILED, "Failed to allocate workspace of size: %ld", size);
       return MEMALLOC_FAILED;
@@ -168,7 +189,7 @@ Status TaskContext::AllocateTensor(const GeTensorDesc &tensor_desc, TensorValue
     GELOGW("size from tensor_desc == 0");
   }
 
-  auto buffer = TensorBuffer::Create(execution_context_->allocator, size, attr);
+  auto buffer = TensorBuffer::Create(execution_context_->allocator, size, attr, GetAllocationStream());
   GE_CHECK_NOTNULL(buffer);
   tensor = TensorValue(shared_ptr<TensorBuffer>(buffer.release()));
   return SUCCESS;
@@ -246,7 +267,7 @@ Status TaskContext::AllocateOutputs(AllocationAttr *attr) {
 }
 
 Status TaskContext::AllocateTemp(size_t size, TensorValue &tensor) {
-  auto buffer = TensorBuffer::Create(execution_context_->allocator, size);
+  auto buffer = TensorBuffer::Create(execution_context_->allocator, size, nullptr, GetAllocationStream());
   if (buffer == nullptr) {
     GELOGE(MEMALLOC_FAILED, "Failed to allocate buffer of size: %zu", size);
     return MEMALLOC_FAILED;
@@ -271,6 +292,11 @@ Status TaskContext::SetOutput(int index, const TensorValue &tensor) {
 
 rtStream_t TaskContext::GetStream() { return execution_context_->stream; }
 
+rtStream_t TaskContext::GetAllocationStream() const {
+  // blocks freed in stream order are reused once queued work is done, host side tasks may still be using them
+  return stream_ordered_ ? execution_context_->stream : nullptr;
+}
+
 int64_t TaskContext::GetSessionId() const { return execution_context_->session_id; }
 
 Status TaskContext::GetStatus() const { return status_; }
@@ -280,10 +306,10 @@ void TaskContext::SetStatus(Status status) { status_ = status; }
 Status TaskContext::AllocateWorkspace(size_t size, void **buffer, void *ori_addr) {
   GE_CHECK_NOTNULL(buffer);
   if (ori_addr == nullptr) {
-    *buffer = execution_context_->allocator->Allocate(size, nullptr);
+    *buffer = execution_context_->allocator->Allocate(size, nullptr, GetAllocationStream());
   } else {
     AllocationAttr attr(ori_addr);
-    *buffer = execution_context_->allocator->Allocate(size, &attr);
+    *buffer = execution_context_->allocator->Allocate(size, &attr, GetAllocationStream());
   }
 
   if (*buffer == nullptr) {
@@ -87,6 +87,18 @@ class TaskContext {
 
   bool IsForceInferShape() const;
   void SetForceInferShape(bool force_infer_shape);
+
+  // memory of a task that only touches it through work on stream is allocated and freed in stream order
+  void SetStreamOrdered(bool stream_ordered) { stream_ordered_ = stream_ordered; }
+
+  // keep output tensors after the node is done, they are fetched by the owner of the subgraph
+  void SetRetainOutputs(bool retain_outputs) { retain_outputs_ = retain_outputs; }
+
+  // release workspaces and output tensors held for current execution when the node is done
+  void ReleaseResources();
+
+  // prepare for the next execution of the node, so that the task context can be reused
+  void Reset();
   void *handle_ = nullptr;
 
  private:
@@ -94,9 +106,14 @@ class TaskContext {
 
   static string TensorDesc2String(const GeTensorDesc &desc);
   Status AllocateTensor(const GeTensorDesc &tensor_desc, TensorValue &tensor, AllocationAttr *attr);
+  rtStream_t GetAllocationStream() const;
+  void ReleaseWorkspaces();
+  void ReleaseOutputs();
 
   const NodeItem *node_item_ = nullptr;
   bool force_infer_shape_ = false;
+  bool retain_outputs_ = false;
+  bool stream_ordered_ = false;
   GraphExecutionContext *execution_context_;
   SubgraphContext *subgraph_context_;
   TensorValue *inputs_start_ = nullptr;
@@ -43,7 +43,20 @@ std::shared_ptr<domi::ModelTaskDef> GeModel::GetModelTaskDefPtr() const { return
 
 const TBEKernelStore &GeModel::GetTBEKernelStore() const { return this->tbe_kernal_store_; }
 
-Buffer GeModel::GetWeight() const { return this->weights_buffer_; }
+Buffer GeModel::GetWeight() const {
+  if (this->weights_data_owner_ != nullptr) {
+    return Buffer::CopyFrom(this->weights_data_, this->weights_size_);
+  }
+  return this->weights_buffer_;
+}
+
+const uint8_t *GeModel::GetWeightData() const {
+  return this->weights_data_owner_ != nullptr ? this->weights_data_ : this->weights_buffer_.GetData();
+}
+
+size_t GeModel::GetWeightSize() const {
+  return this->weights_data_owner_ != nullptr ? this->weights_size_ : this->weights_buffer_.GetSize();
+}
 
 std::string GeModel::GetName() const { return this->name_; }
 
@@ -59,7 +72,19 @@ void GeModel::SetModelTaskDef(const std::shared_ptr<domi::ModelTaskDef> &task) {
 
 void GeModel::SetTBEKernelStore(const TBEKernelStore &tbe_kernal_store) { this->tbe_kernal_store_ = tbe_kernal_store; }
 
-void GeModel::SetWeight(const Buffer &weights_buffer) { this->weights_buffer_ = weights_buffer; }
+void GeModel::SetWeight(const Buffer &weights_buffer) {
+  this->weights_buffer_ = weights_buffer;
+  this->weights_data_ = nullptr;
+  this->weights_size_ = 0;
+  this->weights_data_owner_ = nullptr;
+}
+
+void GeModel::SetWeightDataBuf(const uint8_t *data, size_t size, const std::shared_ptr<void> &data_owner) {
+  this->weights_buffer_ = Buffer();
+  this->weights_data_ = data;
+  this->weights_size_ = size;
+  this->weights_data_owner_ = data_owner;
+}
 
 void GeModel::SetName(const std::string &name) { this->name_ = name; }
 
@@ -41,6 +41,9 @@ class GE_FUNC_DEV_VISIBILITY GE_FUNC_HOST_VISIBILITY GeModel : public AttrHolder
   std::shared_ptr<domi::ModelTaskDef> GetModelTaskDefPtr() const;
   const TBEKernelStore &GetTBEKernelStore() const;
   Buffer GetWeight() const;
+  // weights set by SetWeight or SetWeightDataBuf, without copying
+  const uint8_t *GetWeightData() const;
+  size_t GetWeightSize() const;
 
   std::string GetName() const;
   uint32_t GetVersion() const;
@@ -51,6 +54,8 @@ class GE_FUNC_DEV_VISIBILITY GE_FUNC_HOST_VISIBILITY GeModel : public AttrHolder
   void SetModelTaskDef(const std::shared_ptr<domi::ModelTaskDef> &task);
   void SetTBEKernelStore(const TBEKernelStore &tbe_kernal_store);
   void SetWeight(const Buffer &weights_buffer);
+  // refer to weights in place, data_owner keeps the memory alive, e.g. a mapped model file
+  void SetWeightDataBuf(const uint8_t *data, size_t size, const std::shared_ptr<void> &data_owner);
 
   void SetName(const std::string &name);
   void SetVersion(uint32_t version);
@@ -80,6 +85,9 @@ class GE_FUNC_DEV_VISIBILITY GE_FUNC_HOST_VISIBILITY GeModel : public AttrHolder
   std::shared_ptr<domi::ModelTaskDef> task_;
   TBEKernelStore tbe_kernal_store_;
   Buffer weights_buffer_;
+  const uint8_t *weights_data_ = nullptr;
+  size_t weights_size_ = 0;
+  std::shared_ptr<void> weights_data_owner_;
 
   std::string name_;
   uint32_t version_ = {0};
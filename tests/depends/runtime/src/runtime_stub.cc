@@ -19,6 +19,10 @@
 
 #define EVENT_LENTH 10
 
+// number of copy calls, for tests checking how many copies are issued
+uint64_t g_rt_memcpy_num = 0;
+uint64_t g_rt_memcpy_async_num = 0;
+
 rtError_t rtCtxSetCurrent(rtContext_t ctx) { return RT_ERROR_NONE; }
 
 rtError_t rtGetStreamId(rtStream_t stream, int32_t *stream_id) {
@@ -47,6 +51,8 @@ rtError_t rtEventRecord(rtEvent_t event, rtStream_t stream) { return RT_ERROR_NO
 
 rtError_t rtEventSynchronize(rtEvent_t event) { return RT_ERROR_NONE; }
 
+rtError_t rtEventQuery(rtEvent_t event) { return RT_ERROR_NONE; }
+
 rtError_t rtEventDestroy(rtEvent_t event) {
   delete[](int *) event;
   return RT_ERROR_NONE;
@@ -91,6 +97,7 @@ rtError_t rtSetDevice(int32_t device) { return RT_ERROR_NONE; }
 rtError_t rtStreamSynchronize(rtStream_t stream) { return RT_ERROR_NONE; }
 
 rtError_t rtMemcpy(void *dst, uint64_t dest_max, const void *src, uint64_t count, rtMemcpyKind_t kind) {
+  ++g_rt_memcpy_num;
 #ifdef OTQT_UT
   if (dest_max == 12 && count == 12) {  // UTEST_kernelinfo_manager.all_success special treatment
     memcpy_s(dst, dest_max, src, count);
@@ -100,6 +107,7 @@ rtError_t rtMemcpy(void *dst, uint64_t dest_max, const void *src, uint64_t count
 }
 rtError_t rtMemcpyAsync(void *dst, uint64_t dest_max, const void *src, uint64_t count, rtMemcpyKind_t kind,
                         rtStream_t stream) {
+  ++g_rt_memcpy_async_num;
   return RT_ERROR_NONE;
 }
 
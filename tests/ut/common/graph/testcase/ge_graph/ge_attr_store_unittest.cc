@@ -0,0 +1,224 @@
+/**
+ * Copyright 2019-2020 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <gtest/gtest.h>
+#include <thread>
+#include <vector>
+
+#define protected public
+#define private public
+#include "graph/op_desc.h"
+
+#include "graph/compute_graph.h"
+#include "graph/detail/attr_store.h"
+#include "graph/ge_attr_value.h"
+#include "graph/model_serialize.h"
+#include "graph/utils/attr_utils.h"
+#include "proto/ge_ir.pb.h"
+#undef protected
+#undef private
+
+using namespace std;
+using namespace ge;
+
+class UtestGeAttrStore : public testing::Test {
+ protected:
+  void SetUp() {}
+
+  void TearDown() {}
+};
+
+TEST_F(UtestGeAttrStore, intern_name) {
+  auto &registry = AttrNameRegistry::Instance();
+  AttrId id = registry.Intern("attr_store_intern");
+  EXPECT_EQ(registry.Intern("attr_store_intern"), id);
+  EXPECT_EQ(registry.GetName(id), "attr_store_intern");
+  AttrId found = 0;
+  EXPECT_TRUE(registry.Find("attr_store_intern", found));
+  EXPECT_EQ(found, id);
+  EXPECT_FALSE(registry.Find("attr_store_never_interned", found));
+}
+
+TEST_F(UtestGeAttrStore, set_get_flat_attrs) {
+  OpDescPtr op_desc = std::make_shared<OpDesc>("op", "Conv2D");
+  EXPECT_TRUE(AttrUtils::SetInt(op_desc, "int", 10));
+  EXPECT_TRUE(AttrUtils::SetFloat(op_desc, "float", 1.5f));
+  EXPECT_TRUE(AttrUtils::SetBool(op_desc, "bool", true));
+  EXPECT_TRUE(AttrUtils::SetStr(op_desc, "str", "value"));
+  EXPECT_TRUE(AttrUtils::SetListInt(op_desc, "list_int", vector<int32_t>{1, 2, 3}));
+  EXPECT_TRUE(AttrUtils::SetListFloat(op_desc, "list_float", vector<float>{0.5f}));
+  EXPECT_TRUE(AttrUtils::SetListStr(op_desc, "list_str", vector<string>{"a", "b"}));
+  EXPECT_EQ(op_desc->attr_store_.Size(), 7);
+  EXPECT_TRUE(op_desc->op_def_.GetProtoMsg()->attr().empty());
+
+  int64_t int_val = 0;
+  EXPECT_TRUE(AttrUtils::GetInt(op_desc, "int", int_val));
+  EXPECT_EQ(int_val, 10);
+  float float_val = 0;
+  EXPECT_TRUE(AttrUtils::GetFloat(op_desc, "float", float_val));
+  EXPECT_EQ(float_val, 1.5f);
+  bool bool_val = false;
+  EXPECT_TRUE(AttrUtils::GetBool(op_desc, "bool", bool_val));
+  EXPECT_TRUE(bool_val);
+  string str_val;
+  EXPECT_TRUE(AttrUtils::GetStr(op_desc, "str", str_val));
+  EXPECT_EQ(str_val, "value");
+  vector<uint32_t> list_int_val;
+  EXPECT_TRUE(AttrUtils::GetListInt(op_desc, "list_int", list_int_val));
+  EXPECT_EQ(list_int_val, vector<uint32_t>({1, 2, 3}));
+  vector<float> list_float_val;
+  EXPECT_TRUE(AttrUtils::GetListFloat(op_desc, "list_float", list_float_val));
+  EXPECT_EQ(list_float_val, vector<float>({0.5f}));
+  vector<string> list_str_val;
+  EXPECT_TRUE(AttrUtils::GetListStr(op_desc, "list_str", list_str_val));
+  EXPECT_EQ(list_str_val, vector<string>({"a", "b"}));
+  EXPECT_TRUE(AttrUtils::HasAttr(op_desc, "list_str"));
+  EXPECT_FALSE(AttrUtils::HasAttr(op_desc, "missing"));
+  EXPECT_FALSE(AttrUtils::GetInt(op_desc, "missing", int_val));
+}
+
+TEST_F(UtestGeAttrStore, other_type_of_same_name_fails) {
+  OpDescPtr op_desc = std::make_shared<OpDesc>("op", "Conv2D");
+  EXPECT_TRUE(AttrUtils::SetInt(op_desc, "flat", 1));
+  EXPECT_FALSE(AttrUtils::SetStr(op_desc, "flat", "str"));
+  string str_val;
+  EXPECT_FALSE(AttrUtils::GetStr(op_desc, "flat", str_val));
+  int64_t int_val = 0;
+  EXPECT_TRUE(AttrUtils::GetInt(op_desc, "flat", int_val));
+  EXPECT_EQ(int_val, 1);
+
+  // set through the proto attr map first
+  EXPECT_EQ(op_desc->SetAttr("proto", GeAttrValue::CreateFrom<GeAttrValue::STR>("str")), GRAPH_SUCCESS);
+  EXPECT_FALSE(AttrUtils::SetInt(op_desc, "proto", 1));
+  EXPECT_TRUE(AttrUtils::GetStr(op_desc, "proto", str_val));
+  EXPECT_EQ(str_val, "str");
+}
+
+TEST_F(UtestGeAttrStore, proto_attr_moves_to_store) {
+  OpDescPtr op_desc = std::make_shared<OpDesc>("op", "Conv2D");
+  EXPECT_EQ(op_desc->SetAttr("attr", GeAttrValue::CreateFrom<GeAttrValue::INT>(1)), GRAPH_SUCCESS);
+  EXPECT_TRUE(AttrUtils::SetInt(op_desc, "attr", 2));
+  EXPECT_EQ(op_desc->attr_store_.Size(), 1);
+  EXPECT_EQ(op_desc->op_def_.GetProtoMsg()->attr().count("attr"), 0);
+  GeAttrValue value;
+  EXPECT_EQ(op_desc->GetAttr("attr", value), GRAPH_SUCCESS);
+  int64_t int_val = 0;
+  EXPECT_EQ(value.GetValue<GeAttrValue::INT>(int_val), GRAPH_SUCCESS);
+  EXPECT_EQ(int_val, 2);
+}
+
+TEST_F(UtestGeAttrStore, proto_view_sees_flat_attrs) {
+  OpDescPtr op_desc = std::make_shared<OpDesc>("op", "Conv2D");
+  EXPECT_TRUE(AttrUtils::SetInt(op_desc, "int", 1));
+  auto all_attrs = AttrUtils::GetAllAttrs(op_desc);
+  ASSERT_EQ(all_attrs.count("int"), 1);
+
+  // a later set is seen by the next read
+  EXPECT_TRUE(AttrUtils::SetInt(op_desc, "int", 2));
+  auto attr_map = op_desc->GetAttrMap();
+  auto proto_attrs = attr_map.GetProtoMsg();
+  ASSERT_NE(proto_attrs, nullptr);
+  EXPECT_EQ(proto_attrs->at("int").i(), 2);
+
+  EXPECT_EQ(op_desc->DelAttr("int"), GRAPH_SUCCESS);
+  EXPECT_TRUE(op_desc->attr_store_.Empty());
+  int64_t int_val = 0;
+  EXPECT_FALSE(AttrUtils::GetInt(op_desc, "int", int_val));
+  EXPECT_FALSE(AttrUtils::HasAttr(op_desc, "int"));
+}
+
+TEST_F(UtestGeAttrStore, reads_leave_proto_attrs_alone) {
+  const int kThreadNum = 4;
+  const int kLoopNum = 200;
+  OpDescPtr op_desc = std::make_shared<OpDesc>("op", "Conv2D");
+  EXPECT_TRUE(AttrUtils::SetInt(op_desc, "int", 7));
+  EXPECT_TRUE(AttrUtils::SetListStr(op_desc, "list_str", vector<string>{"y"}));
+  ConstOpDescPtr const_op_desc = op_desc;
+
+  std::vector<int> failed_counts(kThreadNum, 0);
+  std::vector<std::thread> threads;
+  for (int i = 0; i < kThreadNum; ++i) {
+    threads.emplace_back([&, i]() {
+      for (int loop = 0; loop < kLoopNum; ++loop) {
+        GeAttrValue value;
+        int64_t int_val = 0;
+        auto all_attrs = AttrUtils::GetAllAttrs(const_op_desc);
+        if (all_attrs.size() != 2 || const_op_desc->GetAttr("int", value) != GRAPH_SUCCESS ||
+            value.GetValue<GeAttrValue::INT>(int_val) != GRAPH_SUCCESS || int_val != 7 ||
+            !AttrUtils::HasAttr(const_op_desc, "list_str")) {
+          ++failed_counts[i];
+        }
+      }
+    });
+  }
+  for (auto &thread : threads) {
+    thread.join();
+  }
+  for (int i = 0; i < kThreadNum; ++i) {
+    EXPECT_EQ(failed_counts[i], 0);
+  }
+  // the flat attributes are only copied out, op_def is never written by a reader
+  EXPECT_TRUE(op_desc->op_def_.GetProtoMsg()->attr().empty());
+  EXPECT_EQ(op_desc->attr_store_.Size(), 2);
+}
+
+TEST_F(UtestGeAttrStore, serialize_copies_flat_attrs) {
+  OpDescPtr op_desc = std::make_shared<OpDesc>("op", "Conv2D");
+  EXPECT_TRUE(AttrUtils::SetInt(op_desc, "int", 3));
+  EXPECT_TRUE(AttrUtils::SetListStr(op_desc, "list_str", vector<string>{"x"}));
+  auto clone = AttrUtils::CloneOpDesc(op_desc);
+  ASSERT_NE(clone, nullptr);
+  EXPECT_TRUE(clone->attr_store_.Empty());
+  int64_t int_val = 0;
+  EXPECT_TRUE(AttrUtils::GetInt(clone, "int", int_val));
+  EXPECT_EQ(int_val, 3);
+  vector<string> list_str_val;
+  EXPECT_TRUE(AttrUtils::GetListStr(clone, "list_str", list_str_val));
+  EXPECT_EQ(list_str_val, vector<string>({"x"}));
+}
+
+TEST_F(UtestGeAttrStore, serialize_graph_with_flat_attrs) {
+  auto graph = std::make_shared<ComputeGraph>("graph");
+  OpDescPtr op_desc = std::make_shared<OpDesc>("op", "Conv2D");
+  EXPECT_TRUE(AttrUtils::SetInt(op_desc, "int", 4));
+  EXPECT_TRUE(AttrUtils::SetListInt(op_desc, "list_int", {5, 6}));
+  ASSERT_NE(graph->AddNode(op_desc), nullptr);
+
+  ModelSerialize serialize;
+  auto buffer = serialize.SerializeGraph(graph);
+  ASSERT_GT(buffer.GetSize(), 0);
+  auto restored = serialize.UnserializeGraph(buffer.GetData(), buffer.GetSize());
+  ASSERT_NE(restored, nullptr);
+  auto node = restored->FindNode("op");
+  ASSERT_NE(node, nullptr);
+  int64_t int_val = 0;
+  EXPECT_TRUE(AttrUtils::GetInt(node->GetOpDesc(), "int", int_val));
+  EXPECT_EQ(int_val, 4);
+  vector<int64_t> list_int_val;
+  EXPECT_TRUE(AttrUtils::GetListInt(node->GetOpDesc(), "list_int", list_int_val));
+  EXPECT_EQ(list_int_val, vector<int64_t>({5, 6}));
+}
+
+TEST_F(UtestGeAttrStore, copy_attrs_from_holder) {
+  OpDescPtr src = std::make_shared<OpDesc>("src", "Conv2D");
+  OpDescPtr dst = std::make_shared<OpDesc>("dst", "Conv2D");
+  EXPECT_TRUE(AttrUtils::SetStr(src, "str", "src"));
+  EXPECT_TRUE(AttrUtils::SetStr(dst, "str", "dst"));
+  dst->CopyAttrsFrom(*src);
+  string str_val;
+  EXPECT_TRUE(AttrUtils::GetStr(dst, "str", str_val));
+  EXPECT_EQ(str_val, "src");
+}
@@ -0,0 +1,241 @@
+/**
+ * Copyright 2019-2020 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <gtest/gtest.h>
+#include <algorithm>
+#include <string>
+#include <vector>
+
+#define protected public
+#define private public
+#include "graph/compute_graph.h"
+
+#include "graph/detail/node_list.h"
+#include "graph/utils/graph_utils.h"
+#undef protected
+#undef private
+
+#include "graph_builder_utils.h"
+
+using namespace std;
+using namespace ge;
+
+class UtestGeComputeGraph : public testing::Test {
+ protected:
+  void SetUp() {}
+
+  void TearDown() {}
+};
+
+namespace {
+vector<string> GetNodeNames(const ComputeGraphPtr &graph) {
+  vector<string> names;
+  for (const auto &node : graph->GetDirectNode()) {
+    names.push_back(node->GetName());
+  }
+  return names;
+}
+
+NodePtr MakeNode(const ComputeGraphPtr &graph, const string &name) {
+  auto op_desc = std::make_shared<OpDesc>(name, "Identity");
+  op_desc->AddInputDesc(GeTensorDesc());
+  op_desc->AddOutputDesc(GeTensorDesc());
+  return graph->AddNode(op_desc);
+}
+}  // namespace
+
+TEST_F(UtestGeComputeGraph, node_list) {
+  auto graph = std::make_shared<ComputeGraph>("g");
+  auto n1 = std::make_shared<Node>(std::make_shared<OpDesc>("n1", "Identity"), graph);
+  auto n2 = std::make_shared<Node>(std::make_shared<OpDesc>("n2", "Identity"), graph);
+  auto n3 = std::make_shared<Node>(std::make_shared<OpDesc>("n3", "Identity"), graph);
+  auto n4 = std::make_shared<Node>(std::make_shared<OpDesc>("n4", "Identity"), graph);
+
+  NodeList nodes;
+  EXPECT_TRUE(nodes.push_back(n2));
+  EXPECT_TRUE(nodes.push_front(n1));
+  EXPECT_TRUE(nodes.InsertAfter(n2, n4));
+  EXPECT_TRUE(nodes.InsertBefore(n4, n3));
+  EXPECT_EQ(nodes.ToVector(), vector<NodePtr>({n1, n2, n3, n4}));
+
+  // null, duplicated or unknown position
+  auto version = nodes.GetVersion();
+  EXPECT_FALSE(nodes.push_back(nullptr));
+  EXPECT_FALSE(nodes.push_back(n1));
+  EXPECT_FALSE(nodes.InsertAfter(n1, n3));
+  auto n5 = std::make_shared<Node>(std::make_shared<OpDesc>("n5", "Identity"), graph);
+  EXPECT_FALSE(nodes.InsertAfter(n5, n5));
+  EXPECT_EQ(nodes.size(), 4);
+  EXPECT_EQ(nodes.GetVersion(), version);
+
+  NodeList copied(nodes);
+  EXPECT_NE(copied.GetVersion(), version);
+  EXPECT_TRUE(nodes.Erase(n2));
+  EXPECT_NE(nodes.GetVersion(), version);
+  EXPECT_FALSE(nodes.Erase(n2));
+  EXPECT_FALSE(nodes.Contains(n2));
+  EXPECT_EQ(nodes.ToVector(), vector<NodePtr>({n1, n3, n4}));
+  EXPECT_TRUE(copied.Contains(n2));
+  EXPECT_TRUE(copied.Erase(n1));
+  EXPECT_EQ(copied.ToVector(), vector<NodePtr>({n2, n3, n4}));
+
+  version = copied.GetVersion();
+  copied.swap(nodes);
+  EXPECT_EQ(nodes.GetVersion(), version);
+  EXPECT_EQ(nodes.ToVector(), vector<NodePtr>({n2, n3, n4}));
+  EXPECT_TRUE(copied.InsertAfter(n4, n2));
+  EXPECT_EQ(copied.ToVector(), vector<NodePtr>({n1, n3, n4, n2}));
+
+  nodes.Assign({n4, n4, nullptr, n1});
+  EXPECT_EQ(nodes.ToVector(), vector<NodePtr>({n4, n1}));
+  nodes.clear();
+  EXPECT_TRUE(nodes.empty());
+  EXPECT_FALSE(nodes.Contains(n4));
+}
+
+TEST_F(UtestGeComputeGraph, add_and_remove_node) {
+  auto builder = ut::GraphBuilder("g");
+  auto data = builder.AddNode("data", "Data", 0, 1);
+  auto relu = builder.AddNode("relu", "Relu", 1, 1);
+  builder.AddDataEdge(data, 0, relu, 0);
+  auto graph = builder.GetGraph();
+
+  auto front = graph->AddNodeFront(std::make_shared<OpDesc>("front", "Const"));
+  ASSERT_NE(front, nullptr);
+  auto op_desc = std::make_shared<OpDesc>("after_data", "Cast");
+  auto after_data = graph->AddNodeAfter(op_desc, data);
+  ASSERT_NE(after_data, nullptr);
+  EXPECT_EQ(GetNodeNames(graph), vector<string>({"data", "after_data", "front", "relu"}));
+
+  auto other_graph = std::make_shared<ComputeGraph>("other");
+  auto other_desc = std::make_shared<OpDesc>("other", "Cast");
+  auto other = other_graph->AddNode(other_desc);
+  EXPECT_EQ(graph->AddNodeAfter(other_desc, other), nullptr);
+
+  EXPECT_EQ(graph->RemoveNode(front), GRAPH_SUCCESS);
+  EXPECT_EQ(graph->RemoveNode(front), GRAPH_FAILED);
+  EXPECT_EQ(GraphUtils::RemoveJustNode(graph, data), GRAPH_SUCCESS);
+  EXPECT_EQ(GetNodeNames(graph), vector<string>({"after_data", "relu"}));
+  EXPECT_EQ(graph->GetDirectNodesSize(), 2);
+  EXPECT_EQ(graph->FindNode("data"), nullptr);
+  EXPECT_EQ(graph->AddInputNode(relu), relu);
+  EXPECT_EQ(graph->GetDirectNodesSize(), 2);
+
+  // a node is in the graph only once
+  EXPECT_EQ(graph->AddNode(relu), nullptr);
+  EXPECT_EQ(graph->AddNodeFront(relu), nullptr);
+  EXPECT_EQ(graph->GetDirectNodesSize(), 2);
+}
+
+// Remove and insert tens of thousands of nodes like constant folding and identity removal do, which was quadratic
+TEST_F(UtestGeComputeGraph, remove_and_insert_many_nodes) {
+  const int kNodeNum = 40000;
+  auto graph = std::make_shared<ComputeGraph>("g");
+  vector<NodePtr> chain;
+  for (int i = 0; i < kNodeNum; ++i) {
+    chain.push_back(MakeNode(graph, "node" + std::to_string(i)));
+    if (i > 0) {
+      ASSERT_EQ(GraphUtils::AddEdge(chain[i - 1]->GetOutDataAnchor(0), chain[i]->GetInDataAnchor(0)), GRAPH_SUCCESS);
+    }
+  }
+  ASSERT_EQ(graph->TopologicalSorting(), GRAPH_SUCCESS);
+
+  // remove the nodes with odd index
+  for (int i = 1; i < kNodeNum - 1; i += 2) {
+    ASSERT_EQ(GraphUtils::IsolateNode(chain[i], {0}), GRAPH_SUCCESS);
+    ASSERT_EQ(GraphUtils::RemoveNodeWithoutRelink(graph, chain[i]), GRAPH_SUCCESS);
+  }
+  // insert a node after each node with even index
+  for (int i = 0; i < kNodeNum - 2; i += 2) {
+    auto op_desc = std::make_shared<OpDesc>("inserted" + std::to_string(i), "Identity");
+    op_desc->AddInputDesc(GeTensorDesc());
+    op_desc->AddOutputDesc(GeTensorDesc());
+    auto node = graph->AddNodeAfter(op_desc, chain[i]);
+    ASSERT_NE(node, nullptr);
+    auto out_anchor = chain[i]->GetOutDataAnchor(0);
+    auto peer_in_anchor = out_anchor->GetPeerInDataAnchors().at(0);
+    ASSERT_EQ(GraphUtils::InsertNodeBetweenDataAnchors(out_anchor, peer_in_anchor, node), GRAPH_SUCCESS);
+  }
+  ASSERT_EQ(graph->TopologicalSorting(), GRAPH_SUCCESS);
+
+  ASSERT_EQ(graph->GetDirectNodesSize(), kNodeNum);
+  auto nodes = graph->GetDirectNode();
+  for (size_t i = 0; i < nodes.size(); ++i) {
+    EXPECT_EQ(nodes.at(i)->GetOpDesc()->GetId(), static_cast<int64_t>(i));
+    if (i + 1 < nodes.size()) {
+      EXPECT_EQ(nodes.at(i)->GetOutDataNodes().at(0), nodes.at(i + 1));
+    }
+  }
+  EXPECT_EQ(nodes.at(1)->GetName(), "inserted0");
+  EXPECT_EQ(nodes.at(kNodeNum - 1)->GetName(), "node" + std::to_string(kNodeNum - 1));
+}
+
+///
+///   a    b
+///    \  /
+///    data
+///
+TEST_F(UtestGeComputeGraph, skip_sorting_unchanged_graph) {
+  auto builder = ut::GraphBuilder("g");
+  auto data = builder.AddNode("data", "Data", 0, 1);
+  auto a = builder.AddNode("a", "Relu", 1, 1);
+  auto b = builder.AddNode("b", "Relu", 1, 1);
+  builder.AddDataEdge(data, 0, a, 0);
+  builder.AddDataEdge(data, 0, b, 0);
+  auto graph = builder.GetGraph();
+  ASSERT_EQ(graph->TopologicalSorting(), GRAPH_SUCCESS);
+  auto order = GetNodeNames(graph);
+  ASSERT_EQ(order.size(), 3);
+  auto nodes_version = graph->nodes_.GetVersion();
+
+  // nodes are not rebuilt, but their ids are restored
+  a->GetOpDesc()->SetId(100);
+  ASSERT_EQ(graph->TopologicalSorting(), GRAPH_SUCCESS);
+  EXPECT_EQ(graph->nodes_.GetVersion(), nodes_version);
+  EXPECT_EQ(GetNodeNames(graph), order);
+  EXPECT_EQ(a->GetOpDesc()->GetId(), std::find(order.begin(), order.end(), "a") - order.begin());
+
+  // a link of any graph makes it sorted again
+  auto other_graph = ut::GraphBuilder("other");
+  auto c = other_graph.AddNode("c", "Relu", 1, 1);
+  auto d = other_graph.AddNode("d", "Relu", 1, 1);
+  other_graph.AddControlEdge(c, d);
+  ASSERT_EQ(graph->TopologicalSorting(), GRAPH_SUCCESS);
+  EXPECT_NE(graph->nodes_.GetVersion(), nodes_version);
+  EXPECT_EQ(GetNodeNames(graph), order);
+
+  // the order follows a new link, and its removal
+  auto &first = (order[1] == "a") ? a : b;
+  auto &second = (order[1] == "a") ? b : a;
+  builder.AddControlEdge(second, first);
+  ASSERT_EQ(graph->TopologicalSorting(), GRAPH_SUCCESS);
+  EXPECT_EQ(GetNodeNames(graph), vector<string>({"data", second->GetName(), first->GetName()}));
+  ASSERT_EQ(GraphUtils::RemoveEdge(second->GetOutControlAnchor(), first->GetInControlAnchor()), GRAPH_SUCCESS);
+  ASSERT_EQ(graph->TopologicalSorting(), GRAPH_SUCCESS);
+  EXPECT_EQ(GetNodeNames(graph), order);
+
+  // and a removed node
+  ASSERT_EQ(graph->RemoveNode(second), GRAPH_SUCCESS);
+  ASSERT_EQ(graph->TopologicalSorting(), GRAPH_SUCCESS);
+  EXPECT_EQ(GetNodeNames(graph), vector<string>({"data", first->GetName()}));
+  EXPECT_EQ(first->GetOpDesc()->GetId(), 1);
+
+  // and a change of inputs order
+  nodes_version = graph->nodes_.GetVersion();
+  graph->SetInputsOrder({"data"});
+  ASSERT_EQ(graph->TopologicalSorting(), GRAPH_SUCCESS);
+  EXPECT_NE(graph->nodes_.GetVersion(), nodes_version);
+}
@@ -26,6 +26,7 @@
 #include "graph/ge_tensor.h"
 #include "graph/node.h"
 #include "graph/operator_factory.h"
+#include "graph/utils/attr_utils.h"
 #include "utils/op_desc_utils.h"
 #undef protected
 #undef private
@@ -236,3 +237,37 @@ TEST_F(UtestGeOpdesc, add_dynamic_output_desc) {
   OpDescPtr desc_ptr2 = std::make_shared<OpDesc>("name2", "type2");
   EXPECT_EQ(desc_ptr2->AddDynamicOutputDesc("x", 1), GRAPH_SUCCESS);
 }
+
+TEST_F(UtestGeOpdesc, get_attrs_by_attr_utils) {
+  OpDescPtr desc_ptr = std::make_shared<OpDesc>("name1", "type1");
+  EXPECT_TRUE(AttrUtils::SetInt(desc_ptr, "int", 1));
+  EXPECT_TRUE(AttrUtils::SetStr(desc_ptr, "str", "value"));
+  EXPECT_TRUE(AttrUtils::SetListInt(desc_ptr, "list_int", {1, 2, 3}));
+  GeTensorDesc tensor_desc(GeShape({1, 2}));
+  EXPECT_TRUE(AttrUtils::SetTensor(desc_ptr, "tensor", GeTensor(tensor_desc, vector<uint8_t>(8, 1))));
+
+  ConstOpDescPtr const_desc_ptr = desc_ptr;
+  int64_t int_value = 0;
+  EXPECT_TRUE(AttrUtils::GetInt(const_desc_ptr, "int", int_value));
+  EXPECT_EQ(int_value, 1);
+  string str_value;
+  EXPECT_TRUE(AttrUtils::GetStr(const_desc_ptr, "str", str_value));
+  EXPECT_EQ(str_value, "value");
+  EXPECT_FALSE(AttrUtils::GetStr(const_desc_ptr, "int", str_value));
+  vector<int64_t> list_value;
+  EXPECT_TRUE(AttrUtils::GetListInt(const_desc_ptr, "list_int", list_value));
+  EXPECT_EQ(list_value, vector<int64_t>({1, 2, 3}));
+  ConstGeTensorPtr tensor;
+  EXPECT_TRUE(AttrUtils::GetTensor(const_desc_ptr, "tensor", tensor));
+  ASSERT_NE(tensor, nullptr);
+  EXPECT_EQ(tensor->GetData().size(), 8);
+  GeTensorPtr mutable_tensor;
+  EXPECT_TRUE(AttrUtils::MutableTensor(desc_ptr, "tensor", mutable_tensor));
+  ASSERT_NE(mutable_tensor, nullptr);
+  EXPECT_EQ(mutable_tensor->GetTensorDesc().GetShape().GetDims(), vector<int64_t>({1, 2}));
+  EXPECT_FALSE(AttrUtils::GetInt(const_desc_ptr, "not_exist", int_value));
+
+  OpDescPtr null_desc_ptr = nullptr;
+  EXPECT_FALSE(AttrUtils::GetInt(null_desc_ptr, "int", int_value));
+  EXPECT_FALSE(AttrUtils::GetTensor(null_desc_ptr, "tensor", tensor));
+}
@@ -0,0 +1,175 @@
+/**
+ * Copyright 2019-2020 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <gtest/gtest.h>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "graph_builder_utils.h"
+#include "graph/operator.h"
+#include "graph/shape_refiner.h"
+
+namespace ge {
+class UtestShapeRefiner : public testing::Test {
+ protected:
+  void SetUp() {}
+
+  void TearDown() { ShapeRefiner::ClearContextMap(); }
+};
+
+namespace {
+///
+///     dst
+///      |
+///     src
+///
+ComputeGraphPtr BuildMarkGraph(const std::string &name, const std::string &mark, std::vector<std::string> &marks) {
+  auto builder = ut::GraphBuilder(name);
+  auto src = builder.AddNDNode("src", "Const", 0, 1);
+  auto dst = builder.AddNDNode("dst", "Foo", 1, 1);
+  builder.AddDataEdge(src, 0, dst, 0);
+  src->GetOpDesc()->AddInferFunc([mark](Operator &op) {
+    op.GetInferenceContext()->SetMarks({mark});
+    return GRAPH_SUCCESS;
+  });
+  dst->GetOpDesc()->AddInferFunc([&marks](Operator &op) {
+    marks = op.GetInferenceContext()->GetMarks();
+    return GRAPH_SUCCESS;
+  });
+  return builder.GetGraph();
+}
+}  // namespace
+
+TEST_F(UtestShapeRefiner, context_map_per_graph) {
+  std::vector<std::string> marks1;
+  std::vector<std::string> marks2;
+  auto graph1 = BuildMarkGraph("g1", "mark1", marks1);
+  auto graph2 = BuildMarkGraph("g2", "mark2", marks2);
+
+  EXPECT_EQ(ShapeRefiner::InferShapeAndType(graph1->FindNode("src")), GRAPH_SUCCESS);
+  EXPECT_EQ(ShapeRefiner::InferShapeAndType(graph2->FindNode("src")), GRAPH_SUCCESS);
+  ShapeRefiner::ClearContextMap(graph2);
+
+  EXPECT_EQ(ShapeRefiner::InferShapeAndType(graph1->FindNode("dst")), GRAPH_SUCCESS);
+  EXPECT_EQ(ShapeRefiner::InferShapeAndType(graph2->FindNode("dst")), GRAPH_SUCCESS);
+  EXPECT_EQ(marks1, std::vector<std::string>({"mark1"}));
+  EXPECT_TRUE(marks2.empty());
+}
+
+TEST_F(UtestShapeRefiner, clear_context_map_releases_nodes) {
+  std::vector<std::string> marks;
+  auto graph = BuildMarkGraph("g", "mark", marks);
+  auto src = graph->FindNode("src");
+  auto use_count = src.use_count();
+  EXPECT_EQ(ShapeRefiner::InferShapeAndType(src), GRAPH_SUCCESS);
+  // the context of src is kept for its successors
+  EXPECT_EQ(src.use_count(), use_count + 1);
+  ShapeRefiner::ClearContextMap(graph);
+  EXPECT_EQ(src.use_count(), use_count);
+
+  EXPECT_EQ(ShapeRefiner::InferShapeAndType(src), GRAPH_SUCCESS);
+  ShapeRefiner::ClearContextMap();
+  EXPECT_EQ(src.use_count(), use_count);
+}
+
+TEST_F(UtestShapeRefiner, context_map_of_freed_graph) {
+  std::vector<std::string> marks;
+  auto graph = BuildMarkGraph("g", "mark", marks);
+  auto src = graph->FindNode("src");
+  auto use_count = src.use_count();
+  EXPECT_EQ(ShapeRefiner::InferShapeAndType(src), GRAPH_SUCCESS);
+  EXPECT_EQ(src.use_count(), use_count + 1);
+
+  // contexts of a freed graph are dropped once another graph is inferred, even if they are not cleared
+  graph.reset();
+  EXPECT_EQ(src.use_count(), 2);
+  std::vector<std::string> other_marks;
+  auto other_graph = BuildMarkGraph("other", "other_mark", other_marks);
+  EXPECT_EQ(ShapeRefiner::InferShapeAndType(other_graph->FindNode("src")), GRAPH_SUCCESS);
+  EXPECT_EQ(src.use_count(), 1);
+  EXPECT_EQ(ShapeRefiner::InferShapeAndType(other_graph->FindNode("dst")), GRAPH_SUCCESS);
+  EXPECT_EQ(other_marks, std::vector<std::string>({"other_mark"}));
+}
+
+///
+///     concat
+///     /    \
+///  src1    src2
+///
+TEST_F(UtestShapeRefiner, infer_producers_of_same_node_concurrently) {
+  const int kLoopNum = 100;
+  auto builder = ut::GraphBuilder("g");
+  auto src1 = builder.AddNDNode("src1", "Foo", 0, 1);
+  auto src2 = builder.AddNDNode("src2", "Foo", 0, 1);
+  auto concat = builder.AddNDNode("concat", "Concat", 2, 1);
+  builder.AddDataEdge(src1, 0, concat, 0);
+  builder.AddDataEdge(src2, 0, concat, 1);
+  auto graph = builder.GetGraph();
+  std::vector<int64_t> dims1 = {1, 2};
+  std::vector<int64_t> dims2 = {3, 4, 5};
+  auto set_shape = [](const OpDescPtr &op_desc, const std::vector<int64_t> &dims) {
+    OpDesc *desc = op_desc.get();
+    op_desc->AddInferFunc([desc, dims](Operator &op) {
+      desc->MutableOutputDesc(0)->SetShape(GeShape(dims));
+      return GRAPH_SUCCESS;
+    });
+  };
+  set_shape(src1->GetOpDesc(), dims1);
+  set_shape(src2->GetOpDesc(), dims2);
+
+  for (int loop = 0; loop < kLoopNum; ++loop) {
+    std::thread thread1([&src1]() { EXPECT_EQ(ShapeRefiner::InferShapeAndType(src1), GRAPH_SUCCESS); });
+    std::thread thread2([&src2]() { EXPECT_EQ(ShapeRefiner::InferShapeAndType(src2), GRAPH_SUCCESS); });
+    thread1.join();
+    thread2.join();
+    EXPECT_EQ(concat->GetOpDesc()->GetInputDesc(0).GetShape().GetDims(), dims1);
+    EXPECT_EQ(concat->GetOpDesc()->GetInputDesc(1).GetShape().GetDims(), dims2);
+  }
+}
+
+TEST_F(UtestShapeRefiner, infer_concurrently) {
+  const int kThreadNum = 4;
+  const int kLoopNum = 100;
+  std::vector<std::vector<std::string>> marks(kThreadNum);
+  std::vector<ComputeGraphPtr> graphs;
+  for (int i = 0; i < kThreadNum; ++i) {
+    graphs.emplace_back(BuildMarkGraph("g" + std::to_string(i), "mark" + std::to_string(i), marks[i]));
+  }
+
+  std::vector<int> failed_counts(kThreadNum, 0);
+  std::vector<std::thread> threads;
+  for (int i = 0; i < kThreadNum; ++i) {
+    threads.emplace_back([&, i]() {
+      for (int loop = 0; loop < kLoopNum; ++loop) {
+        marks[i].clear();
+        if (ShapeRefiner::InferShapeAndType(graphs[i]->FindNode("src")) != GRAPH_SUCCESS ||
+            ShapeRefiner::InferShapeAndType(graphs[i]->FindNode("dst")) != GRAPH_SUCCESS ||
+            marks[i] != std::vector<std::string>({"mark" + std::to_string(i)})) {
+          ++failed_counts[i];
+        }
+        ShapeRefiner::ClearContextMap(graphs[i]);
+      }
+    });
+  }
+  for (auto &thread : threads) {
+    thread.join();
+  }
+  for (int i = 0; i < kThreadNum; ++i) {
+    EXPECT_EQ(failed_counts[i], 0);
+  }
+}
+}  // namespace ge
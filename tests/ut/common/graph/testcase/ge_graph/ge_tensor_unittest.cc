@@ -196,6 +196,84 @@ TEST_F(UtestGeTensor, test_shape_copy_move) {
   EXPECT_EQ(shape4.GetDimNum(), 3);
 }
 
+TEST_F(UtestGeTensor, test_shape_inline_and_heap_dims) {
+  GeShape shape({1, 2, 3, 4, 5, 6, 7, 8});
+  EXPECT_EQ(shape.GetShapeSize(), 40320);
+  EXPECT_TRUE(shape.heap_dims_.empty());
+
+  // grow to heap, then shrink back to inline storage
+  GeShape long_shape({1, 2, 3, 4, 5, 6, 7, 8, 9, 10});
+  EXPECT_FALSE(long_shape.heap_dims_.empty());
+  EXPECT_EQ(long_shape.GetDimNum(), 10);
+  EXPECT_EQ(long_shape.GetDim(9), 10);
+  EXPECT_EQ(long_shape.ToString(), "1,2,3,4,5,6,7,8,9,10");
+  shape = long_shape;
+  EXPECT_EQ(shape.GetDims(), long_shape.GetDims());
+  shape = GeShape({2, 3});
+  EXPECT_TRUE(shape.heap_dims_.empty());
+  EXPECT_EQ(shape.GetDims(), std::vector<int64_t>({2, 3}));
+
+  GeShape moved_shape(std::move(long_shape));
+  EXPECT_EQ(moved_shape.GetDimNum(), 10);
+  EXPECT_EQ(long_shape.GetDimNum(), 0);
+  EXPECT_TRUE(long_shape.IsScalar());
+
+  // cached size and unknown flags
+  EXPECT_EQ(shape.SetDim(1, -1), GRAPH_SUCCESS);
+  EXPECT_TRUE(shape.IsUnknownShape());
+  EXPECT_EQ(shape.GetShapeSize(), -1);
+  EXPECT_EQ(shape.SetDim(1, 4), GRAPH_SUCCESS);
+  EXPECT_FALSE(shape.IsUnknownShape());
+  EXPECT_EQ(shape.GetShapeSize(), 8);
+  GeShape unknown_rank({UNKNOWN_DIM_NUM});
+  EXPECT_EQ(unknown_rank.GetDimNum(), 0);
+  EXPECT_EQ(unknown_rank.GetShapeSize(), -1);
+}
+
+TEST_F(UtestGeTensor, test_shape_move_assign) {
+  // heap dims are taken over
+  GeShape long_shape({1, 2, 3, 4, 5, 6, 7, 8, 9, 10});
+  const int64_t *dims = long_shape.heap_dims_.data();
+  GeShape shape({2, 3});
+  shape = std::move(long_shape);
+  EXPECT_EQ(shape.heap_dims_.data(), dims);
+  EXPECT_EQ(shape.GetDimNum(), 10);
+  EXPECT_EQ(shape.GetShapeSize(), 3628800);
+  EXPECT_EQ(long_shape.GetDimNum(), 0);
+  EXPECT_EQ(long_shape.GetShapeSize(), 0);
+  long_shape = GeShape({4, 5});
+  EXPECT_EQ(long_shape.GetDims(), std::vector<int64_t>({4, 5}));
+
+  // written through to the shape of a tensor desc
+  GeTensorDesc tensor_desc(GeShape({1, 2}));
+  tensor_desc.MutableShape() = std::move(shape);
+  EXPECT_EQ(tensor_desc.GetShape().GetDimNum(), 10);
+  GeShape copied;
+  copied = std::move(tensor_desc.MutableShape());
+  EXPECT_EQ(copied.GetDimNum(), 10);
+  EXPECT_EQ(tensor_desc.GetShape().GetDimNum(), 10);
+}
+
+TEST_F(UtestGeTensor, test_shape_of_tensor_desc) {
+  GeTensorDesc tensor_desc(GeShape({1, 2, 3, 4, 5, 6, 7, 8, 9}));
+  EXPECT_EQ(tensor_desc.GetShape().GetDimNum(), 9);
+
+  // copies do not refer to the tensor desc
+  GeShape shape = tensor_desc.GetShape();
+  EXPECT_EQ(shape.SetDim(0, 2), GRAPH_SUCCESS);
+  EXPECT_EQ(tensor_desc.GetShape().GetDim(0), 1);
+
+  EXPECT_EQ(tensor_desc.MutableShape().SetDim(0, 3), GRAPH_SUCCESS);
+  EXPECT_EQ(tensor_desc.GetShape().GetDim(0), 3);
+  EXPECT_EQ(tensor_desc.GetShape().GetShapeSize(), 3 * 362880);
+
+  tensor_desc.SetShape(shape);
+  EXPECT_EQ(tensor_desc.GetShape().GetDims(), shape.GetDims());
+  GeTensorDesc copied_desc(tensor_desc);
+  EXPECT_EQ(copied_desc.GetShape().GetDims(), shape.GetDims());
+  EXPECT_TRUE(copied_desc == tensor_desc);
+}
+
 TEST_F(UtestGeTensor, test_tensor_desc_invalid_null) {
   GeTensorDesc tensor_desc(nullptr, nullptr);
   EXPECT_EQ(tensor_desc.GetDataType(), DT_UNDEFINED);
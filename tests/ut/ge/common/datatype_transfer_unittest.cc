@@ -15,6 +15,10 @@
  */
 
 #include <gtest/gtest.h>
+#include <cstring>
+#include <limits>
+#include <random>
+#include <vector>
 
 #include "common/formats/format_transfers/datatype_transfer.h"
 
@@ -397,5 +401,62 @@ TEST_F(UtestDataTypeTransfer, unsupprot_trans2) {
   EXPECT_EQ(transfer.TransDataType(args, result), UNSUPPORTED);
   EXPECT_EQ(TransDataType(args, result), UNSUPPORTED);
 }
+
+TEST_F(UtestDataTypeTransfer, same_as_fp16_t) {
+  std::mt19937 gen(2024);
+  // all of the fp16 values
+  std::vector<uint16_t> fp16_values(65536);
+  for (size_t i = 0; i < fp16_values.size(); ++i) {
+    fp16_values[i] = static_cast<uint16_t>(i);
+  }
+  // boundaries of the fp16 ranges, special values and random bits
+  std::vector<uint32_t> fp32_bits = {0x00000000, 0x80000000, 0x7F800000, 0xFF800000, 0x7FC00000, 0xFFFFFFFF, 0x00000001,
+                                     0x33000000, 0x33000001, 0x337FFFFF, 0x33800000, 0x387FE000, 0x387FF000, 0x38800000,
+                                     0x477FE000, 0x477FEFFF, 0x477FF000, 0x477FFFFF, 0x47800000, 0x47FFFFFF, 0x48000000,
+                                     0x3F801000, 0x3F803000, 0x3F801001, 0xC77FF000, 0x7F7FFFFF};
+  std::vector<int32_t> int32_values = {0,     1,     -1,    2047,  2048,  2049,   -2049,  4097,
+                                       65504, 65519, 65520, 65535, 65536, -65520, 1 << 30};
+  int32_values.push_back(std::numeric_limits<int32_t>::max());
+  int32_values.push_back(std::numeric_limits<int32_t>::min());
+  for (int i = 0; i < 100000; ++i) {
+    fp32_bits.push_back(static_cast<uint32_t>(gen()));
+    int32_values.push_back(static_cast<int32_t>(gen()) >> (gen() % 32));
+  }
+
+  TransResult result;
+  CastArgs args{reinterpret_cast<uint8_t *>(fp16_values.data()), fp16_values.size(), DT_FLOAT16, DT_FLOAT};
+  ASSERT_EQ(DataTypeTransfer().TransDataType(args, result), SUCCESS);
+  for (size_t i = 0; i < fp16_values.size(); ++i) {
+    fp16_t fp16;
+    fp16.val = fp16_values[i];
+    float expect = fp16;
+    EXPECT_EQ(memcmp(result.data.get() + i * sizeof(float), &expect, sizeof(float)), 0) << fp16_values[i];
+  }
+  args.dst_data_type = DT_INT32;
+  ASSERT_EQ(DataTypeTransfer().TransDataType(args, result), SUCCESS);
+  for (size_t i = 0; i < fp16_values.size(); ++i) {
+    fp16_t fp16;
+    fp16.val = fp16_values[i];
+    EXPECT_EQ(reinterpret_cast<int32_t *>(result.data.get())[i], static_cast<int32_t>(fp16)) << fp16_values[i];
+  }
+
+  args = {reinterpret_cast<uint8_t *>(fp32_bits.data()), fp32_bits.size(), DT_FLOAT, DT_FLOAT16};
+  ASSERT_EQ(DataTypeTransfer().TransDataType(args, result), SUCCESS);
+  for (size_t i = 0; i < fp32_bits.size(); ++i) {
+    float value;
+    memcpy(&value, &fp32_bits[i], sizeof(value));
+    fp16_t expect;
+    expect = value;
+    EXPECT_EQ(reinterpret_cast<uint16_t *>(result.data.get())[i], expect.val) << std::hex << fp32_bits[i];
+  }
+
+  args = {reinterpret_cast<uint8_t *>(int32_values.data()), int32_values.size(), DT_INT32, DT_FLOAT16};
+  ASSERT_EQ(DataTypeTransfer().TransDataType(args, result), SUCCESS);
+  for (size_t i = 0; i < int32_values.size(); ++i) {
+    fp16_t expect;
+    expect = int32_values[i];
+    EXPECT_EQ(reinterpret_cast<uint16_t *>(result.data.get())[i], expect.val) << int32_values[i];
+  }
+}
 }  // namespace formats
 }  // namespace ge
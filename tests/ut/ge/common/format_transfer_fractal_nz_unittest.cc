@@ -16,14 +16,19 @@
 
 #include <gtest/gtest.h>
 #include <ctime>
+#include <random>
+#include <vector>
 
 #include "common/formats/format_transfers/format_transfer_fractal_nz.h"
 
 #include "common/formats/format_transfers/format_transfer.h"
 #include "common/formats/formats.h"
+#include "common/formats/utils/formats_trans_utils.h"
 #include "common/fp16_t.h"
 #include "time.h"
 
+#include "format_transfer_unittest_utils.h"
+
 namespace ge {
 namespace formats {
 class UtestFormatTransferNdFractNz : public testing::Test {
@@ -9163,5 +9168,36 @@ TEST_F(UtestFormatTransferNdFractNz, invalid_src_dst_shape_relation) {
   FormatTransferFractalNzND transfer;
   EXPECT_EQ(transfer.TransFormat(args, result), PARAM_INVALID);
 }
+
+// Trans random shapes, most of which are padded in both h and w, the same as element by element, and back
+TEST_F(UtestFormatTransferNdFractNz, same_as_trans_by_element) {
+  std::mt19937 gen(2024);
+  auto shapes = test::GenRandomNdShapes(gen);
+  for (size_t i = 0; i < shapes.size(); i++) {
+    auto data_type = test::kRandomShapeDataTypes[i % test::kRandomShapeDataTypes.size()];
+    const auto &shape = shapes[i];
+    int64_t h = (shape.size() == 1) ? 1 : shape[shape.size() - 2];
+    int64_t w = shape.back();
+
+    FormatTransferFractalNz transfer;
+    FormatTransferFractalNzND transfer_back;
+    std::vector<int64_t> dst_shape;
+    ASSERT_EQ(transfer.TransShape(FORMAT_ND, shape, data_type, FORMAT_FRACTAL_NZ, dst_shape), SUCCESS);
+    auto dims = dst_shape.size();
+    int64_t w1 = dst_shape[dims - 4];
+    int64_t h1 = dst_shape[dims - 3];
+    int64_t h0 = dst_shape[dims - 2];
+    int64_t w0 = dst_shape[dims - 1];
+    TransArgs args{nullptr, FORMAT_ND, FORMAT_FRACTAL_NZ, shape, dst_shape, data_type};
+    test::CheckSameAsTransByElement(transfer, args, gen,
+                                    [&](int64_t src_idx) {
+                                      int64_t times_idx = src_idx / (h * w);
+                                      int64_t h_idx = src_idx / w % h;
+                                      int64_t w_idx = src_idx % w;
+                                      return ((times_idx * w1 + w_idx / w0) * h1 * h0 + h_idx) * w0 + w_idx % w0;
+                                    },
+                                    &transfer_back);
+  }
+}
 }  // namespace formats
-}  // namespace ge
\ No newline at end of file
+}  // namespace ge
@@ -15,10 +15,14 @@
  */
 
 #include <gtest/gtest.h>
+#include <cstring>
+#include <random>
+#include <vector>
 
 #include "common/formats/format_transfers/format_transfer_nchw_nc1hwc0.h"
 
 #include "common/formats/format_transfers/format_transfer.h"
+#include "common/formats/utils/formats_trans_utils.h"
 
 namespace ge {
 namespace formats {
@@ -28,6 +32,40 @@ class UtestFormatTransferNchw5d : public testing::Test {
   void TearDown() {}
 };
 
+namespace {
+// element by element, as the transfer was implemented
+std::vector<uint8_t> TransByElement(const std::vector<uint8_t> &src, const std::vector<int64_t> &shape, int64_t size,
+                                    int64_t c0) {
+  int64_t n = shape[0], c = shape[1], hw = shape[2] * shape[3];
+  int64_t c1 = Ceil(c, c0);
+  std::vector<uint8_t> dst(n * c1 * hw * c0 * size, 0);
+  for (int64_t n_idx = 0; n_idx < n; n_idx++) {
+    for (int64_t c1_idx = 0; c1_idx < c1; c1_idx++) {
+      for (int64_t hw_idx = 0; hw_idx < hw; hw_idx++) {
+        for (int64_t c0_idx = 0; c0_idx < c0; c0_idx++) {
+          int64_t c_idx = c1_idx * c0 + c0_idx;
+          int64_t dst_idx = ((n_idx * c1 + c1_idx) * hw + hw_idx) * c0 + c0_idx;
+          if (c_idx < c) {
+            memcpy(&dst[dst_idx * size], &src[((n_idx * c + c_idx) * hw + hw_idx) * size], size);
+          }
+        }
+      }
+    }
+  }
+  return dst;
+}
+
+std::vector<uint8_t> RandomData(int64_t len) {
+  std::mt19937 gen(len);
+  std::uniform_int_distribution<int> dis(0, 255);
+  std::vector<uint8_t> data(len);
+  for (auto &item : data) {
+    item = static_cast<uint8_t>(dis(gen));
+  }
+  return data;
+}
+}  // namespace
+
 TEST_F(UtestFormatTransferNchw5d, nchw_to_5d_uint8) {
   uint8_t data[1 * 3 * 4 * 4] = {1,   2,   3,   4,   5,   6,   7,   8,   9,   10,  11,  12,  13,  14,  15,  16,
                                  101, 102, 103, 104, 105, 106, 107, 108, 109, 110, 111, 112, 113, 114, 115, 116,
@@ -630,5 +668,50 @@ TEST_F(UtestFormatTransferNchw5d, unsupport_dst_format) {
   TransResult result;
   EXPECT_NE(transfer.TransFormat(args, result), SUCCESS);
 }
+
+TEST_F(UtestFormatTransferNchw5d, same_as_trans_by_element) {
+  std::vector<std::pair<DataType, std::vector<int64_t>>> cases = {
+      {DT_FLOAT16, {3, 17, 5, 7}}, {DT_FLOAT16, {2, 32, 1, 1}}, {DT_FLOAT, {2, 33, 9, 11}},
+      {DT_INT8, {2, 70, 13, 3}},   {DT_UINT8, {1, 1, 3, 3}},    {DT_INT64, {3, 20, 4, 5}},
+      {DT_DOUBLE, {1, 16, 2, 2}},  {DT_FLOAT, {4, 256, 16, 16}}};
+  for (const auto &trans_case : cases) {
+    auto data_type = trans_case.first;
+    const auto &shape = trans_case.second;
+    int64_t size = GetSizeByDataType(data_type);
+    int64_t c0 = GetCubeSizeByDataType(data_type);
+    auto src = RandomData(GetItemNumByShape(shape) * size);
+    auto expect = TransByElement(src, shape, size, c0);
+
+    FormatTransferNchwNc1hwc0 transfer;
+    TransArgs args{src.data(), FORMAT_NCHW, FORMAT_NC1HWC0, shape,
+                   {shape[0], Ceil(shape[1], c0), shape[2], shape[3], c0}, data_type};
+    TransResult result;
+    ASSERT_EQ(transfer.TransFormat(args, result), SUCCESS);
+    ASSERT_EQ(result.length, expect.size());
+    EXPECT_EQ(memcmp(result.data.get(), expect.data(), expect.size()), 0) << ShapeToString(shape);
+  }
+}
+
+// Feature maps and weights in the layouts of common sizes, scaled down
+TEST_F(UtestFormatTransferNchw5d, trans_realistic_shapes) {
+  std::vector<std::pair<DataType, std::vector<int64_t>>> cases = {
+      {DT_FLOAT16, {2, 40, 7, 7}}, {DT_FLOAT, {2, 20, 5, 5}}, {DT_INT8, {2, 3, 9, 9}}, {DT_FLOAT16, {16, 17, 3, 3}}};
+  for (const auto &trans_case : cases) {
+    auto data_type = trans_case.first;
+    const auto &shape = trans_case.second;
+    int64_t size = GetSizeByDataType(data_type);
+    int64_t c0 = GetCubeSizeByDataType(data_type);
+    auto src = RandomData(GetItemNumByShape(shape) * size);
+
+    auto expect = TransByElement(src, shape, size, c0);
+    FormatTransferNchwNc1hwc0 transfer;
+    TransArgs args{src.data(), FORMAT_NCHW, FORMAT_NC1HWC0, shape,
+                   {shape[0], Ceil(shape[1], c0), shape[2], shape[3], c0}, data_type};
+    TransResult result;
+    ASSERT_EQ(transfer.TransFormat(args, result), SUCCESS);
+    ASSERT_EQ(result.length, expect.size());
+    EXPECT_EQ(memcmp(result.data.get(), expect.data(), expect.size()), 0) << ShapeToString(shape);
+  }
+}
 }  // namespace formats
 }  // namespace ge
@@ -15,10 +15,14 @@
  */
 
 #include <gtest/gtest.h>
+#include <cstring>
+#include <random>
+#include <vector>
 
 #include "common/formats/format_transfers/format_transfer_nhwc_nc1hwc0.h"
 
 #include "common/formats/format_transfers/format_transfer.h"
+#include "common/formats/utils/formats_trans_utils.h"
 #include "common/fp16_t.h"
 
 namespace ge {
@@ -29,6 +33,40 @@ class UtestFormatTransferNhwc5d : public testing::Test {
   void TearDown() {}
 };
 
+namespace {
+// element by element, as the transfer was implemented
+std::vector<uint8_t> TransByElement(const std::vector<uint8_t> &src, const std::vector<int64_t> &shape, int64_t size,
+                                    int64_t c0) {
+  int64_t n = shape[0], hw = shape[1] * shape[2], c = shape[3];
+  int64_t c1 = Ceil(c, c0);
+  std::vector<uint8_t> dst(n * c1 * hw * c0 * size, 0);
+  for (int64_t n_idx = 0; n_idx < n; n_idx++) {
+    for (int64_t c1_idx = 0; c1_idx < c1; c1_idx++) {
+      for (int64_t hw_idx = 0; hw_idx < hw; hw_idx++) {
+        for (int64_t c0_idx = 0; c0_idx < c0; c0_idx++) {
+          int64_t c_idx = c1_idx * c0 + c0_idx;
+          int64_t dst_idx = ((n_idx * c1 + c1_idx) * hw + hw_idx) * c0 + c0_idx;
+          if (c_idx < c) {
+            memcpy(&dst[dst_idx * size], &src[((n_idx * hw + hw_idx) * c + c_idx) * size], size);
+          }
+        }
+      }
+    }
+  }
+  return dst;
+}
+
+std::vector<uint8_t> RandomData(int64_t len) {
+  std::mt19937 gen(len);
+  std::uniform_int_distribution<int> dis(0, 255);
+  std::vector<uint8_t> data(len);
+  for (auto &item : data) {
+    item = static_cast<uint8_t>(dis(gen));
+  }
+  return data;
+}
+}  // namespace
+
 TEST_F(UtestFormatTransferNhwc5d, nhwc_to_5d_uint8) {
   uint8_t data[1 * 4 * 4 * 3] = {
       2,  6,  1, 6, 11, 12, 30, 24, 4,  28, 22, 25, 20, 5,  18, 15, 23, 27, 1,  25, 26, 24, 11, 8,
@@ -746,5 +784,50 @@ TEST_F(UtestFormatTransferNhwc5d, unsupport_dst_format) {
   FormatTransferNhwcNc1hwc0 transfer;
   EXPECT_EQ(transfer.TransFormat(args, result), PARAM_INVALID);
 }
+
+TEST_F(UtestFormatTransferNhwc5d, same_as_trans_by_element) {
+  std::vector<std::pair<DataType, std::vector<int64_t>>> cases = {
+      {DT_FLOAT16, {3, 5, 7, 17}}, {DT_FLOAT16, {2, 1, 1, 32}}, {DT_FLOAT, {2, 9, 11, 33}},
+      {DT_INT8, {2, 13, 3, 70}},   {DT_UINT8, {1, 3, 3, 1}},    {DT_INT64, {3, 4, 5, 20}},
+      {DT_DOUBLE, {1, 2, 2, 16}},  {DT_FLOAT, {4, 16, 16, 256}}};
+  for (const auto &trans_case : cases) {
+    auto data_type = trans_case.first;
+    const auto &shape = trans_case.second;
+    int64_t size = GetSizeByDataType(data_type);
+    int64_t c0 = GetCubeSizeByDataType(data_type);
+    auto src = RandomData(GetItemNumByShape(shape) * size);
+    auto expect = TransByElement(src, shape, size, c0);
+
+    FormatTransferNhwcNc1hwc0 transfer;
+    TransArgs args{src.data(), FORMAT_NHWC, FORMAT_NC1HWC0, shape,
+                   {shape[0], Ceil(shape[3], c0), shape[1], shape[2], c0}, data_type};
+    TransResult result;
+    ASSERT_EQ(transfer.TransFormat(args, result), SUCCESS);
+    ASSERT_EQ(result.length, expect.size());
+    EXPECT_EQ(memcmp(result.data.get(), expect.data(), expect.size()), 0) << ShapeToString(shape);
+  }
+}
+
+// Feature maps and weights in the layouts of common sizes, scaled down
+TEST_F(UtestFormatTransferNhwc5d, trans_realistic_shapes) {
+  std::vector<std::pair<DataType, std::vector<int64_t>>> cases = {
+      {DT_FLOAT16, {2, 7, 7, 40}}, {DT_FLOAT, {2, 5, 5, 20}}, {DT_INT8, {2, 9, 9, 3}}, {DT_FLOAT16, {16, 3, 3, 17}}};
+  for (const auto &trans_case : cases) {
+    auto data_type = trans_case.first;
+    const auto &shape = trans_case.second;
+    int64_t size = GetSizeByDataType(data_type);
+    int64_t c0 = GetCubeSizeByDataType(data_type);
+    auto src = RandomData(GetItemNumByShape(shape) * size);
+
+    auto expect = TransByElement(src, shape, size, c0);
+    FormatTransferNhwcNc1hwc0 transfer;
+    TransArgs args{src.data(), FORMAT_NHWC, FORMAT_NC1HWC0, shape,
+                   {shape[0], Ceil(shape[3], c0), shape[1], shape[2], c0}, data_type};
+    TransResult result;
+    ASSERT_EQ(transfer.TransFormat(args, result), SUCCESS);
+    ASSERT_EQ(result.length, expect.size());
+    EXPECT_EQ(memcmp(result.data.get(), expect.data(), expect.size()), 0) << ShapeToString(shape);
+  }
+}
 }  // namespace formats
-}  // namespace ge
\ No newline at end of file
+}  // namespace ge
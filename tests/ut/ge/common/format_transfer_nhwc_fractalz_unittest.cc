@@ -15,10 +15,16 @@
  */
 
 #include <gtest/gtest.h>
+#include <random>
+#include <vector>
 
 #include "common/formats/format_transfers/format_transfer_fractal_z.h"
 
 #include "common/formats/format_transfers/format_transfer.h"
+#include "common/formats/utils/formats_definitions.h"
+#include "common/formats/utils/formats_trans_utils.h"
+
+#include "format_transfer_unittest_utils.h"
 
 namespace ge {
 namespace formats {
@@ -5350,5 +5356,28 @@ TEST_F(UtestFormatTransferNhwcFz, build_transfer_uint8) {
   auto transfer = BuildFormatTransfer(args);
   EXPECT_NE(transfer, nullptr);
 }
+
+// Trans random shapes, most of which are padded in both n and c, the same as element by element
+TEST_F(UtestFormatTransferNhwcFz, same_as_trans_by_element) {
+  std::mt19937 gen(2023);
+  auto shapes = test::GenRandom4DShapes(gen);
+  for (size_t i = 0; i < shapes.size(); i++) {
+    auto data_type = test::kRandomShapeDataTypes[i % test::kRandomShapeDataTypes.size()];
+    int64_t n = shapes[i][0], c = shapes[i][1], h = shapes[i][2], w = shapes[i][3];
+    int64_t hw = h * w;
+    int64_t c0 = GetCubeSizeByDataType(data_type);
+    int64_t c1 = Ceil(c, c0);
+    int64_t n1n0 = Ceil(n, static_cast<int64_t>(kNiSize)) * kNiSize;
+    FormatTransferFractalZ transfer;
+    TransArgs args{nullptr, FORMAT_NHWC, FORMAT_FRACTAL_Z, {n, h, w, c}, {c1 * hw, n1n0 / kNiSize, kNiSize, c0},
+                   data_type};
+    test::CheckSameAsTransByElement(transfer, args, gen, [&](int64_t src_idx) {
+      int64_t ni = src_idx / (hw * c);
+      int64_t hwi = src_idx / c % hw;
+      int64_t ci = src_idx % c;
+      return ((ci / c0 * hw + hwi) * n1n0 + ni) * c0 + ci % c0;
+    });
+  }
+}
 }  // namespace formats
-}  // namespace ge
\ No newline at end of file
+}  // namespace ge
@@ -15,9 +15,15 @@
  */
 
 #include <gtest/gtest.h>
+#include <algorithm>
+#include <cstring>
+#include <random>
+#include <vector>
 
 #include "common/formats/format_transfers/format_transfer_transpose.h"
 
+#include "common/formats/utils/formats_trans_utils.h"
+
 namespace ge {
 namespace formats {
 class UtestFormatTranspose : public testing::Test {
@@ -26,6 +32,37 @@ class UtestFormatTranspose : public testing::Test {
   void TearDown() {}
 };
 
+namespace {
+// transpose element by element
+std::vector<uint8_t> TransposeByElement(const std::vector<uint8_t> &src, const std::vector<int64_t> &src_shape,
+                                        const std::vector<int64_t> &perm, int64_t size) {
+  std::vector<int64_t> src_strides(src_shape.size(), 1);
+  for (int64_t i = static_cast<int64_t>(src_shape.size()) - 2; i >= 0; --i) {
+    src_strides[i] = src_strides[i + 1] * src_shape[i + 1];
+  }
+  std::vector<int64_t> dst_shape;
+  for (auto dim : perm) {
+    dst_shape.push_back(src_shape[dim]);
+  }
+  std::vector<uint8_t> dst(src.size());
+  std::vector<int64_t> dst_indexes(dst_shape.size(), 0);
+  for (size_t dst_idx = 0; dst_idx < src.size() / size; ++dst_idx) {
+    int64_t src_idx = 0;
+    for (size_t i = 0; i < perm.size(); ++i) {
+      src_idx += dst_indexes[i] * src_strides[perm[i]];
+    }
+    memcpy(&dst[dst_idx * size], &src[src_idx * size], size);
+    for (int64_t i = static_cast<int64_t>(dst_shape.size()) - 1; i >= 0; --i) {
+      if (++dst_indexes[i] < dst_shape[i]) {
+        break;
+      }
+      dst_indexes[i] = 0;
+    }
+  }
+  return dst;
+}
+}  // namespace
+
 TEST_F(UtestFormatTranspose, one) {
   uint8_t data[1] = {100};
   uint8_t ret[1] = {100};
@@ -4652,5 +4689,53 @@ TEST_F(UtestFormatTranspose, chwn_to_hwcn2) {
     EXPECT_EQ((reinterpret_cast<uint16_t *>(result.data.get()))[i], ret[i]);
   }
 }
+TEST_F(UtestFormatTranspose, random_perm_same_as_trans_by_element) {
+  std::mt19937 gen(2023);
+  std::vector<DataType> data_types = {DT_INT8, DT_FLOAT16, DT_FLOAT, DT_INT64};
+  for (int i = 0; i < 400; ++i) {
+    auto data_type = data_types[i % data_types.size()];
+    int64_t size = GetSizeByDataType(data_type);
+    size_t dim_num = gen() % 6 + 1;
+    std::vector<int64_t> src_shape;
+    std::vector<int64_t> perm;
+    for (size_t dim = 0; dim < dim_num; ++dim) {
+      // dims of 1 and large dims are mixed, to check merging dims and partial tiles
+      src_shape.push_back((gen() % 4 == 0) ? 1 : static_cast<int64_t>(gen() % (dim_num <= 2 ? 300 : 20) + 1));
+      perm.push_back(static_cast<int64_t>(dim));
+    }
+    std::shuffle(perm.begin(), perm.end(), gen);
+    std::vector<uint8_t> src(GetItemNumByShape(src_shape) * size);
+    for (auto &item : src) {
+      item = static_cast<uint8_t>(gen());
+    }
+    auto expect = TransposeByElement(src, src_shape, perm, size);
+
+    TransResult result;
+    ASSERT_EQ(Transpose(src.data(), src_shape, data_type, perm, result), SUCCESS);
+    ASSERT_EQ(result.length, expect.size());
+    EXPECT_EQ(memcmp(result.data.get(), expect.data(), expect.size()), 0)
+      << "src shape " << ShapeToString(src_shape) << ", perm " << ShapeToString(perm);
+  }
+}
+
+TEST_F(UtestFormatTranspose, trans_realistic_shapes) {
+  std::vector<std::pair<std::vector<int64_t>, std::vector<int64_t>>> cases = {
+    {{16, 64, 28, 28}, {0, 2, 3, 1}}, {{16, 28, 28, 64}, {0, 3, 1, 2}}, {{64, 64, 3, 3}, {2, 3, 1, 0}},
+    {{1024, 1024}, {1, 0}},           {{4, 32, 12, 64}, {0, 2, 1, 3}},  {{4, 3, 32, 32}, {0, 1, 2, 3}}};
+  for (const auto &item : cases) {
+    const auto &src_shape = item.first;
+    const auto &perm = item.second;
+    std::vector<uint8_t> src(GetItemNumByShape(src_shape) * sizeof(uint16_t));
+    for (size_t i = 0; i < src.size(); ++i) {
+      src[i] = static_cast<uint8_t>(i * 7);
+    }
+    auto expect = TransposeByElement(src, src_shape, perm, sizeof(uint16_t));
+    TransResult result;
+    ASSERT_EQ(Transpose(src.data(), src_shape, DT_FLOAT16, perm, result), SUCCESS);
+    ASSERT_EQ(result.length, expect.size());
+    EXPECT_EQ(memcmp(result.data.get(), expect.data(), expect.size()), 0)
+      << "src shape " << ShapeToString(src_shape) << ", perm " << ShapeToString(perm);
+  }
+}
 }  // namespace formats
-}  // namespace ge
\ No newline at end of file
+}  // namespace ge
@@ -15,14 +15,41 @@
  */
 
 #include <gtest/gtest.h>
+#include <cstring>
+#include <random>
+#include <vector>
 
 #include "common/formats/format_transfers/format_transfer_nchw_nc1hwc0.h"
 
 #include "common/formats/format_transfers/format_transfer.h"
+#include "common/formats/formats.h"
 #include "common/formats/utils/formats_trans_utils.h"
 
 namespace ge {
 namespace formats {
+namespace {
+std::vector<uint8_t> RandomData(size_t size, std::mt19937 &gen) {
+  std::uniform_int_distribution<int> dist(0, 255);
+  std::vector<uint8_t> data(size);
+  for (auto &value : data) {
+    value = static_cast<uint8_t>(dist(gen));
+  }
+  return data;
+}
+
+// convert by TransFormat and TransDataType one after another
+void TransFormatThenDataType(const TransArgs &args, DataType dst_data_type, TransResult &result) {
+  TransResult format_result;
+  ASSERT_EQ(TransFormat(args, format_result), SUCCESS);
+  if (args.src_data_type == dst_data_type) {
+    result = format_result;
+    return;
+  }
+  CastArgs cast_args{format_result.data.get(), format_result.length / GetSizeByDataType(args.src_data_type),
+                     args.src_data_type, dst_data_type};
+  ASSERT_EQ(TransDataType(cast_args, result), SUCCESS);
+}
+}  // namespace
 
 class UtestFormatTransfer : public testing::Test {
  protected:
@@ -77,5 +104,78 @@ TEST_F(UtestFormatTransfer, get_size_by_data_type) {
   EXPECT_EQ(GetSizeByDataType(DT_UNDEFINED), -1);
   EXPECT_EQ(DT_UNDEFINED, 26);
 }
+
+TEST_F(UtestFormatTransfer, trans_format_and_data_type_same_as_two_steps) {
+  struct TestCase {
+    Format src_format;
+    Format dst_format;
+    std::vector<int64_t> src_shape;
+  };
+  std::vector<TestCase> cases = {
+    {FORMAT_NCHW, FORMAT_FRACTAL_Z, {17, 35, 3, 5}},  {FORMAT_NCHW, FORMAT_FRACTAL_Z, {32, 64, 1, 1}},
+    {FORMAT_HWCN, FORMAT_FRACTAL_Z, {3, 5, 35, 17}},  {FORMAT_HWCN, FORMAT_FRACTAL_Z, {1, 1, 64, 32}},
+    {FORMAT_NHWC, FORMAT_FRACTAL_Z, {17, 3, 5, 35}},  {FORMAT_NHWC, FORMAT_FRACTAL_Z, {32, 1, 1, 64}},
+    {FORMAT_NCHW, FORMAT_NC1HWC0, {2, 35, 3, 5}},     {FORMAT_NCHW, FORMAT_NC1HWC0, {2, 64, 7, 7}},
+    {FORMAT_NHWC, FORMAT_NC1HWC0, {2, 3, 5, 35}},     {FORMAT_NHWC, FORMAT_NC1HWC0, {2, 7, 7, 64}},
+    {FORMAT_NCHW, FORMAT_NHWC, {2, 35, 3, 5}},
+  };
+  std::vector<std::pair<DataType, DataType>> data_types = {
+    {DT_FLOAT, DT_FLOAT16}, {DT_FLOAT16, DT_FLOAT}, {DT_FLOAT16, DT_INT32}, {DT_INT32, DT_FLOAT16},
+    {DT_INT32, DT_INT8},    {DT_INT8, DT_FLOAT},    {DT_FLOAT16, DT_FLOAT16},
+  };
+  std::mt19937 gen(0);
+  for (const auto &test_case : cases) {
+    for (const auto &data_type : data_types) {
+      TransArgs args{nullptr, test_case.src_format, test_case.dst_format, test_case.src_shape, {}, data_type.first};
+      ASSERT_EQ(TransShape(args.src_format, args.src_shape, args.src_data_type, args.dst_format, args.dst_shape),
+                SUCCESS);
+      auto src = RandomData(GetItemNumByShape(args.src_shape) * GetSizeByDataType(args.src_data_type), gen);
+      args.data = src.data();
+
+      TransResult expect;
+      TransFormatThenDataType(args, data_type.second, expect);
+      ASSERT_NE(expect.length, 0);
+
+      TransResult result;
+      ASSERT_EQ(TransFormatAndDataType(args, data_type.second, result), SUCCESS);
+      ASSERT_EQ(result.length, expect.length);
+      EXPECT_EQ(memcmp(result.data.get(), expect.data.get(), expect.length), 0)
+        << "format " << args.src_format << " to " << args.dst_format << ", data type " << data_type.first << " to "
+        << data_type.second << ", src shape " << ShapeToString(args.src_shape);
+
+      // into the buffer of the caller, the bytes after the result are not touched
+      std::vector<uint8_t> dst(expect.length + 1, 0xff);
+      ASSERT_EQ(TransFormatAndDataType(args, data_type.second, dst.data(), expect.length), SUCCESS);
+      EXPECT_EQ(memcmp(dst.data(), expect.data.get(), expect.length), 0);
+      EXPECT_EQ(dst.back(), 0xff);
+      EXPECT_EQ(TransFormatAndDataType(args, data_type.second, dst.data(), expect.length - 1), PARAM_INVALID);
+      EXPECT_EQ(TransFormatAndDataType(args, data_type.second, nullptr, expect.length), PARAM_INVALID);
+    }
+  }
+}
+
+TEST_F(UtestFormatTransfer, trans_format_and_data_type_invalid) {
+  std::vector<uint8_t> src(2 * 35 * 3 * 5 * 4);
+  uint8_t dst[1024];
+  TransArgs args{src.data(), FORMAT_NCHW, FORMAT_FRACTAL_Z, {2, 35, 3, 5}, {}, DT_FLOAT};
+  TransResult result;
+  // unsupported data types
+  EXPECT_EQ(TransFormatAndDataType(args, DT_INT8, result), UNSUPPORTED);
+  EXPECT_EQ(TransFormatAndDataType(args, DT_INT8, dst, sizeof(dst)), UNSUPPORTED);
+  // unsupported formats
+  args.dst_format = FORMAT_RESERVED;
+  EXPECT_EQ(TransFormatAndDataType(args, DT_FLOAT16, result), UNSUPPORTED);
+  // null data
+  args.dst_format = FORMAT_FRACTAL_Z;
+  args.data = nullptr;
+  EXPECT_EQ(TransFormatAndDataType(args, DT_FLOAT16, result), PARAM_INVALID);
+  // invalid dst shape
+  args.data = src.data();
+  args.dst_shape = {1, 2, 3, 4};
+  EXPECT_EQ(TransFormatAndDataType(args, DT_FLOAT16, dst, sizeof(dst)), PARAM_INVALID);
+  args.src_format = FORMAT_NCHW;
+  args.dst_format = FORMAT_NC1HWC0;
+  EXPECT_EQ(TransFormatAndDataType(args, DT_FLOAT16, result), PARAM_INVALID);
+}
 }  // namespace formats
-}  // namespace ge
\ No newline at end of file
+}  // namespace ge
@@ -0,0 +1,101 @@
+/**
+ * Copyright 2019-2020 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef UT_GE_COMMON_FORMAT_TRANSFER_UNITTEST_UTILS_H_
+#define UT_GE_COMMON_FORMAT_TRANSFER_UNITTEST_UTILS_H_
+
+#include <gtest/gtest.h>
+#include <cstring>
+#include <functional>
+#include <random>
+#include <vector>
+
+#include "common/formats/format_transfers/format_transfer.h"
+#include "common/formats/utils/formats_trans_utils.h"
+
+namespace ge {
+namespace formats {
+namespace test {
+// Data types the random shapes are transferred with, one after another
+const std::vector<DataType> kRandomShapeDataTypes = {DT_FLOAT16, DT_FLOAT, DT_INT8};
+
+///
+/// Some corner cases and 30 random 4D shapes of small n and c, and h and w up to 5
+///
+inline std::vector<std::vector<int64_t>> GenRandom4DShapes(std::mt19937 &gen) {
+  std::uniform_int_distribution<int64_t> dis(1, 40);
+  std::vector<std::vector<int64_t>> shapes = {{16, 16, 1, 1}, {1, 1, 1, 1}, {256, 256, 3, 3}};
+  for (int i = 0; i < 30; i++) {
+    shapes.push_back({dis(gen), dis(gen), dis(gen) % 5 + 1, dis(gen) % 5 + 1});
+  }
+  return shapes;
+}
+
+///
+/// Some corner cases and 30 random ND shapes of 1 to 4 dims, most of which are padded in both h and w
+///
+inline std::vector<std::vector<int64_t>> GenRandomNdShapes(std::mt19937 &gen) {
+  std::uniform_int_distribution<int64_t> dis(1, 70);
+  std::vector<std::vector<int64_t>> shapes = {{1}, {100}, {16, 16}, {32, 64}, {2, 1, 1}, {512, 1024}};
+  for (int i = 0; i < 30; i++) {
+    std::vector<int64_t> shape;
+    for (int64_t dims = i % 4 + 1; dims > 0; dims--) {
+      shape.push_back(dims > 2 ? dis(gen) % 3 + 1 : dis(gen));
+    }
+    shapes.push_back(shape);
+  }
+  return shapes;
+}
+
+///
+/// Trans random data of args.src_shape by transfer, and compare it with a reference moving the elements one by one:
+/// the element src_idx goes to the element dst_index(src_idx) of args.dst_shape, the other elements of dst are 0.
+/// If transfer_back is given, it has to trans the result back to the random data.
+///
+inline void CheckSameAsTransByElement(FormatTransfer &transfer, TransArgs args, std::mt19937 &gen,
+                                      const std::function<int64_t(int64_t)> &dst_index,
+                                      FormatTransfer *transfer_back = nullptr) {
+  int64_t size = GetSizeByDataType(args.src_data_type);
+  int64_t src_num = GetItemNumByShape(args.src_shape);
+  std::vector<uint8_t> src(src_num * size);
+  for (auto &item : src) {
+    item = static_cast<uint8_t>(gen());
+  }
+  std::vector<uint8_t> expect(GetItemNumByShape(args.dst_shape) * size, 0);
+  for (int64_t src_idx = 0; src_idx < src_num; src_idx++) {
+    memcpy(&expect[dst_index(src_idx) * size], &src[src_idx * size], size);
+  }
+
+  args.data = src.data();
+  TransResult result;
+  ASSERT_EQ(transfer.TransFormat(args, result), SUCCESS) << ShapeToString(args.src_shape);
+  ASSERT_EQ(result.length, expect.size());
+  EXPECT_EQ(memcmp(result.data.get(), expect.data(), expect.size()), 0) << ShapeToString(args.src_shape);
+  if (transfer_back == nullptr) {
+    return;
+  }
+
+  TransArgs args_back{result.data.get(), args.dst_format, args.src_format, args.dst_shape, args.src_shape,
+                      args.src_data_type};
+  TransResult result_back;
+  ASSERT_EQ(transfer_back->TransFormat(args_back, result_back), SUCCESS) << ShapeToString(args.src_shape);
+  ASSERT_EQ(result_back.length, src.size());
+  EXPECT_EQ(memcmp(result_back.data.get(), src.data(), src.size()), 0) << ShapeToString(args.src_shape);
+}
+}  // namespace test
+}  // namespace formats
+}  // namespace ge
+#endif  // UT_GE_COMMON_FORMAT_TRANSFER_UNITTEST_UTILS_H_
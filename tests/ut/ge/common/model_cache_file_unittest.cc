@@ -0,0 +1,157 @@
+/**
+ * Copyright 2019-2020 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <gtest/gtest.h>
+
+#include <unistd.h>
+#include <cstdio>
+#include <fstream>
+#include <iterator>
+#include <vector>
+
+#include "common/helper/model_cache_file.h"
+
+namespace ge {
+class UtestModelCacheFile : public testing::Test {
+ protected:
+  void SetUp() {
+    path_ = "./model_cache_file_ut_" + std::to_string(getpid()) + ".cache";
+    json_["nodeNum"] = 7;
+    json_["graphHash"] = "0123456789abcdeffedcba9876543210";
+    json_["varAddrMgrMap"] = Json::array();
+    for (int i = 0; i < 100; ++i) {
+      Json var;
+      var["name"] = "var_" + std::to_string(i);
+      var["address"] = 0x10000 + i * 512;
+      var["shape"] = {1, 3, i, 224};
+      json_["varAddrMgrMap"].emplace_back(var);
+    }
+  }
+
+  void TearDown() { (void)remove(path_.c_str()); }
+
+  std::vector<char> ReadFile() {
+    std::ifstream ifs(path_, std::ios::binary);
+    return std::vector<char>((std::istreambuf_iterator<char>(ifs)), std::istreambuf_iterator<char>());
+  }
+
+  void WriteFile(const std::vector<char> &data) {
+    std::ofstream ofs(path_, std::ios::binary | std::ios::trunc);
+    ofs.write(data.data(), data.size());
+  }
+
+  std::string path_;
+  Json json_;
+};
+
+TEST_F(UtestModelCacheFile, save_and_load) {
+  ASSERT_EQ(ModelCacheFile::Save(path_, json_), SUCCESS);
+
+  ModelCacheFile cache_file;
+  ASSERT_EQ(cache_file.Load(path_), SUCCESS);
+  EXPECT_TRUE(cache_file.HasSection("nodeNum"));
+  EXPECT_FALSE(cache_file.HasSection("edgeNum"));
+
+  Json section;
+  EXPECT_EQ(cache_file.GetSection("nodeNum", section), SUCCESS);
+  EXPECT_EQ(section.get<int>(), 7);
+  EXPECT_NE(cache_file.GetSection("edgeNum", section), SUCCESS);
+
+  Json json;
+  EXPECT_EQ(cache_file.GetAllSections(json), SUCCESS);
+  EXPECT_EQ(json, json_);
+
+  // binary form is smaller than json text
+  EXPECT_LT(ReadFile().size(), json_.dump().size());
+}
+
+TEST_F(UtestModelCacheFile, get_part_of_sections) {
+  ASSERT_EQ(ModelCacheFile::Save(path_, json_), SUCCESS);
+
+  ModelCacheFile cache_file;
+  ASSERT_EQ(cache_file.Load(path_), SUCCESS);
+  Json json;
+  EXPECT_EQ(cache_file.GetSections({"nodeNum", "graphHash"}, json), SUCCESS);
+  EXPECT_EQ(json.size(), 2);
+  EXPECT_EQ(json["nodeNum"], json_["nodeNum"]);
+  EXPECT_EQ(json["graphHash"], json_["graphHash"]);
+  EXPECT_EQ(json.count("varAddrMgrMap"), 0);
+
+  // decoded into the same object
+  EXPECT_EQ(cache_file.GetSections({"varAddrMgrMap"}, json), SUCCESS);
+  EXPECT_EQ(json, json_);
+
+  EXPECT_NE(cache_file.GetSections({"nodeNum", "edgeNum"}, json), SUCCESS);
+  Json array = Json::array();
+  EXPECT_NE(cache_file.GetSections({"nodeNum"}, array), SUCCESS);
+}
+
+TEST_F(UtestModelCacheFile, sections_are_aligned) {
+  ASSERT_EQ(ModelCacheFile::Save(path_, json_), SUCCESS);
+  auto data = ReadFile();
+  ASSERT_GE(data.size(), sizeof(ModelCacheFileHeader));
+  auto header = reinterpret_cast<const ModelCacheFileHeader *>(data.data());
+  EXPECT_EQ(header->magic, kModelCacheFileMagic);
+  EXPECT_EQ(header->version, kModelCacheFileVersion);
+  EXPECT_EQ(header->section_num, 3);
+  EXPECT_EQ(header->file_size, data.size());
+  auto sections = reinterpret_cast<const ModelCacheSectionHeader *>(data.data() + sizeof(ModelCacheFileHeader));
+  for (uint32_t i = 0; i < header->section_num; ++i) {
+    EXPECT_EQ(sections[i].offset % 8, 0);
+  }
+}
+
+TEST_F(UtestModelCacheFile, invalid_file) {
+  ModelCacheFile cache_file;
+  EXPECT_NE(cache_file.Load(path_), SUCCESS);
+
+  // json text of old version
+  std::string json_text = json_.dump();
+  WriteFile(std::vector<char>(json_text.begin(), json_text.end()));
+  EXPECT_NE(cache_file.Load(path_), SUCCESS);
+
+  ASSERT_EQ(ModelCacheFile::Save(path_, json_), SUCCESS);
+  auto data = ReadFile();
+
+  // broken content
+  auto broken = data;
+  broken[broken.size() - 10] ^= 0x1;
+  WriteFile(broken);
+  EXPECT_NE(cache_file.Load(path_), SUCCESS);
+  EXPECT_FALSE(cache_file.HasSection("nodeNum"));
+
+  // truncated
+  WriteFile(std::vector<char>(data.begin(), data.end() - 8));
+  EXPECT_NE(cache_file.Load(path_), SUCCESS);
+
+  // other version
+  auto other_version = data;
+  reinterpret_cast<ModelCacheFileHeader *>(other_version.data())->version = kModelCacheFileVersion + 1;
+  WriteFile(other_version);
+  EXPECT_NE(cache_file.Load(path_), SUCCESS);
+
+  WriteFile(data);
+  EXPECT_EQ(cache_file.Load(path_), SUCCESS);
+  EXPECT_TRUE(cache_file.HasSection("nodeNum"));
+}
+
+TEST_F(UtestModelCacheFile, save_invalid_json) {
+  EXPECT_NE(ModelCacheFile::Save(path_, Json::array()), SUCCESS);
+  Json json;
+  json[std::string(kModelCacheSectionNameLen, 'a')] = 1;
+  EXPECT_NE(ModelCacheFile::Save(path_, json), SUCCESS);
+}
+}  // namespace ge
@@ -0,0 +1,68 @@
+/**
+ * Copyright 2019-2020 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <gtest/gtest.h>
+
+#include "common/tbe_kernel_store.h"
+
+namespace ge {
+class UtestTBEKernelStore : public testing::Test {
+ protected:
+  void SetUp() {
+    TBEKernelStore kernel_store;
+    kernel_store.AddTBEKernel(std::make_shared<TBEKernel>("conv", std::vector<char>{1, 2, 3, 4}));
+    kernel_store.AddTBEKernel(std::make_shared<TBEKernel>("relu", std::vector<char>{5, 6}));
+    ASSERT_TRUE(kernel_store.Build());
+    data_.assign(kernel_store.Data(), kernel_store.Data() + kernel_store.DataSize());
+  }
+
+  void TearDown() {}
+
+  std::vector<uint8_t> data_;
+};
+
+TEST_F(UtestTBEKernelStore, load_by_copy) {
+  TBEKernelStore kernel_store;
+  ASSERT_TRUE(kernel_store.Load(data_.data(), data_.size()));
+  auto kernel = kernel_store.FindTBEKernel("conv");
+  ASSERT_NE(kernel, nullptr);
+  ASSERT_EQ(kernel->GetBinDataSize(), 4);
+  EXPECT_EQ(kernel->GetBinData()[3], 4);
+  EXPECT_TRUE(kernel->GetBinData() < data_.data() || kernel->GetBinData() >= data_.data() + data_.size());
+}
+
+TEST_F(UtestTBEKernelStore, load_in_place) {
+  auto data_owner = std::make_shared<std::vector<uint8_t>>(data_);
+  const uint8_t *data = data_owner->data();
+  size_t size = data_owner->size();
+  TBEKernelStore kernel_store;
+  ASSERT_TRUE(kernel_store.Load(data, size, data_owner));
+  data_owner = nullptr;
+
+  auto kernel = kernel_store.FindTBEKernel("relu");
+  ASSERT_NE(kernel, nullptr);
+  ASSERT_EQ(kernel->GetBinDataSize(), 2);
+  EXPECT_GE(kernel->GetBinData(), data);
+  EXPECT_LT(kernel->GetBinData(), data + size);
+  // still valid, as kernels keep the owner alive
+  EXPECT_EQ(kernel->GetBinData()[0], 5);
+  EXPECT_EQ(kernel->GetBinData()[1], 6);
+
+  // kernels referred in place can be built again
+  ASSERT_TRUE(kernel_store.Build());
+  EXPECT_EQ(kernel_store.DataSize(), data_.size());
+}
+}  // namespace ge
@@ -15,7 +15,9 @@
  */
 
 #include <gtest/gtest.h>
+#include <map>
 #include <memory>
+#include <random>
 
 #include "graph/anchor.h"
 #include "graph/attr_value.h"
@@ -30,6 +32,7 @@
 #define private public
 #include "graph/build/memory/binary_block_mem_assigner.h"
 #include "graph/build/memory/hybrid_mem_assigner.h"
+#include "graph/build/memory/interval_block_mem_assigner.h"
 #include "graph/build/memory/max_block_mem_assigner.h"
 #undef protected
 #undef private
@@ -141,6 +144,132 @@ class UtestMemoryAssignerTest : public testing::Test {
     graph->TopologicalSorting();
   }
 
+  ge::NodePtr AddNodeWithOutSize(ge::ComputeGraphPtr graph, const string &name, size_t in_num, int64_t out_size,
+                                 int64_t ws_size = 0) {
+    ge::OpDescPtr op_desc = make_shared<ge::OpDesc>(name, "Some");
+    for (size_t i = 0; i < in_num; ++i) {
+      op_desc->AddInputDesc(GeTensorDesc());
+    }
+    GeTensorDesc desc;
+    TensorUtils::SetSize(desc, out_size);
+    op_desc->AddOutputDesc(desc);
+    if (ws_size > 0) {
+      op_desc->SetWorkspaceBytes({ws_size});
+    }
+    return graph->AddNode(op_desc);
+  }
+
+  // a chain whose outputs grow and shrink, with a large tensor living along the whole chain
+  void make_interval_graph(ge::ComputeGraphPtr graph) {
+    const vector<int64_t> sizes = {8192, 12800, 16384, 4096, 24576, 8192, 2048};
+    auto root = AddNodeWithOutSize(graph, "root", 0, 65536);
+    auto pre = root;
+    for (size_t i = 0; i < sizes.size(); ++i) {
+      auto node = AddNodeWithOutSize(graph, "node" + std::to_string(i), 1, sizes[i]);
+      ge::GraphUtils::AddEdge(pre->GetOutDataAnchor(0), node->GetInDataAnchor(0));
+      pre = node;
+    }
+    auto last = AddNodeWithOutSize(graph, "last", 2, 1024);
+    ge::GraphUtils::AddEdge(pre->GetOutDataAnchor(0), last->GetInDataAnchor(0));
+    ge::GraphUtils::AddEdge(root->GetOutDataAnchor(0), last->GetInDataAnchor(1));
+    graph->TopologicalSorting();
+  }
+
+  // nodes are spread over stream_num streams at random, and only ordered across streams by data edges
+  void make_random_graph(ge::ComputeGraphPtr graph, uint32_t seed, uint32_t stream_num = 1) {
+    std::mt19937 gen(seed);
+    vector<ge::NodePtr> nodes;
+    for (int i = 0; i < 60; ++i) {
+      size_t in_num = (i == 0) ? 0 : (gen() % 2 + 1);
+      int64_t out_size = (gen() % 64 + 1) * 512;
+      int64_t ws_size = (gen() % 4 == 0) ? (gen() % 16 + 1) * 512 : 0;
+      auto node = AddNodeWithOutSize(graph, "node" + std::to_string(i), in_num, out_size, ws_size);
+      node->GetOpDesc()->SetStreamId((stream_num > 1) ? static_cast<int64_t>(gen() % stream_num) : 0);
+      for (size_t j = 0; j < in_num; ++j) {
+        auto src = nodes[gen() % nodes.size()];
+        ge::GraphUtils::AddEdge(src->GetOutDataAnchor(0), node->GetInDataAnchor(j));
+      }
+      nodes.emplace_back(node);
+    }
+    graph->TopologicalSorting();
+  }
+
+  // tensors overlapped in memory must not be alive at the same time: all users of one of them have to be done
+  // before the other is written, by order of nodes on the same stream, or by data edges across streams
+  void check_no_overlap(ge::ComputeGraphPtr graph) {
+    struct Tensor {
+      string name;
+      int64_t offset;
+      int64_t size;
+      size_t producer;
+      vector<size_t> users;
+      bool released;
+    };
+    vector<ge::NodePtr> nodes;
+    std::map<ge::NodePtr, size_t> node_indexes;
+    for (const auto &node : graph->GetDirectNode()) {
+      node_indexes[node] = nodes.size();
+      nodes.emplace_back(node);
+    }
+    // done_before[i][j]: node i is done before node j starts, nodes are in topological order
+    vector<vector<bool>> done_before(nodes.size(), vector<bool>(nodes.size(), false));
+    std::map<int64_t, size_t> last_of_stream;
+    for (size_t j = 0; j < nodes.size(); ++j) {
+      vector<size_t> preds;
+      for (const auto &in_node : nodes[j]->GetInDataNodes()) {
+        preds.emplace_back(node_indexes[in_node]);
+      }
+      int64_t stream_id = nodes[j]->GetOpDesc()->GetStreamId();
+      if (last_of_stream.count(stream_id) > 0) {
+        preds.emplace_back(last_of_stream[stream_id]);
+      }
+      last_of_stream[stream_id] = j;
+      for (auto pred : preds) {
+        done_before[pred][j] = true;
+        for (size_t i = 0; i < pred; ++i) {
+          done_before[i][j] = done_before[i][j] || done_before[i][pred];
+        }
+      }
+    }
+
+    vector<Tensor> tensors;
+    for (size_t i = 0; i < nodes.size(); ++i) {
+      auto op_desc = nodes[i]->GetOpDesc();
+      Tensor output{nodes[i]->GetName(), op_desc->GetOutputOffset().at(0), 0, i, {i}, true};
+      TensorUtils::GetSize(op_desc->GetOutputDesc(0), output.size);
+      auto peer_in_anchors = nodes[i]->GetOutDataAnchor(0)->GetPeerInDataAnchors();
+      for (const auto &peer_in_anchor : peer_in_anchors) {
+        output.users.emplace_back(node_indexes[peer_in_anchor->GetOwnerNode()]);
+      }
+      output.released = !peer_in_anchors.empty();
+      tensors.emplace_back(std::move(output));
+      auto ws_bytes = op_desc->GetWorkspaceBytes();
+      if (!ws_bytes.empty()) {
+        tensors.push_back({nodes[i]->GetName() + "_ws", op_desc->GetWorkspace().at(0), ws_bytes[0], i, {i}, true});
+      }
+    }
+    auto done_before_write = [&done_before](const Tensor &earlier, const Tensor &later) {
+      if (!earlier.released) {
+        return false;
+      }
+      for (auto user : earlier.users) {
+        if (!done_before[user][later.producer]) {
+          return false;
+        }
+      }
+      return true;
+    };
+    for (size_t i = 0; i < tensors.size(); ++i) {
+      for (size_t j = i + 1; j < tensors.size(); ++j) {
+        const auto &left = tensors[i];
+        const auto &right = tensors[j];
+        bool mem_overlap = (left.offset < right.offset + right.size) && (right.offset < left.offset + left.size);
+        bool life_overlap = !done_before_write(left, right) && !done_before_write(right, left);
+        EXPECT_FALSE(mem_overlap && life_overlap) << left.name << " and " << right.name;
+      }
+    }
+  }
+
  protected:
   void SetUp() {}
 
@@ -152,7 +281,7 @@ TEST_F(UtestMemoryAssignerTest, MemoryBlock_Resize_RealSizeList_is_empty) {
   ge::OpDescPtr op_def_a = createOpWithWsSize("A", 6000);
   ge::NodePtr node_a = graph->AddNode(op_def_a);
   MemoryBlock* memory_block = new MemoryBlock(0);
-  memory_block->Init(1, kOutput, node_a, 0);
+  memory_block->Init(1, kOutput, node_a, 0, 1);
   memory_block->real_size_list_.clear();
   memory_block->Resize();
 
@@ -181,3 +310,72 @@ TEST_F(UtestMemoryAssignerTest, Mock_block_mem_assigner_failed) {
 
   EXPECT_EQ(mock_assigner.Assign(), FAILED);
 }
+
+TEST_F(UtestMemoryAssignerTest, interval_block_mem_assigner_plan_by_life_time) {
+  ge::ComputeGraphPtr graph = make_shared<ge::ComputeGraph>("");
+  make_interval_graph(graph);
+
+  BinaryBlockMemAssigner binary_assigner(graph);
+  EXPECT_EQ(binary_assigner.Assign(), SUCCESS);
+  MaxBlockMemAssigner max_assigner(graph);
+  EXPECT_EQ(max_assigner.Assign(), SUCCESS);
+  IntervalBlockMemAssigner interval_assigner(graph);
+  EXPECT_EQ(interval_assigner.Assign(), SUCCESS);
+  check_no_overlap(graph);
+  EXPECT_LT(interval_assigner.GetMemOffset(), binary_assigner.GetMemOffset());
+  EXPECT_LT(interval_assigner.GetMemOffset(), max_assigner.GetMemOffset());
+
+  HybridMemAssigner hybrid_assigner(graph);
+  EXPECT_EQ(hybrid_assigner.Assign(), SUCCESS);
+  EXPECT_EQ(hybrid_assigner.GetMemOffset(), interval_assigner.GetMemOffset());
+  check_no_overlap(graph);
+}
+
+TEST_F(UtestMemoryAssignerTest, interval_block_mem_assigner_random_graph) {
+  for (uint32_t seed = 0; seed < 20; ++seed) {
+    ge::ComputeGraphPtr graph = make_shared<ge::ComputeGraph>("");
+    make_random_graph(graph, seed);
+    BinaryBlockMemAssigner binary_assigner(graph);
+    EXPECT_EQ(binary_assigner.Assign(), SUCCESS);
+    IntervalBlockMemAssigner interval_assigner(graph);
+    EXPECT_EQ(interval_assigner.Assign(), SUCCESS);
+    check_no_overlap(graph);
+    EXPECT_LE(interval_assigner.GetMemOffset(), binary_assigner.GetMemOffset());
+  }
+}
+
+TEST_F(UtestMemoryAssignerTest, interval_block_mem_assigner_random_multi_stream_graph) {
+  for (uint32_t seed = 0; seed < 20; ++seed) {
+    ge::ComputeGraphPtr graph = make_shared<ge::ComputeGraph>("");
+    make_random_graph(graph, seed, 3);
+    BinaryBlockMemAssigner binary_assigner(graph);
+    EXPECT_EQ(binary_assigner.Assign(), SUCCESS);
+    IntervalBlockMemAssigner interval_assigner(graph);
+    EXPECT_EQ(interval_assigner.Assign(), SUCCESS);
+    check_no_overlap(graph);
+    EXPECT_LE(interval_assigner.GetMemOffset(), binary_assigner.GetMemOffset());
+  }
+}
+
+TEST_F(UtestMemoryAssignerTest, interval_block_mem_assigner_continuous_input) {
+  ge::ComputeGraphPtr graph = make_shared<ge::ComputeGraph>("");
+  auto root = AddNodeWithOutSize(graph, "root", 0, 4096);
+  auto left = AddNodeWithOutSize(graph, "left", 1, 1024);
+  auto right = AddNodeWithOutSize(graph, "right", 1, 2048);
+  auto concat = AddNodeWithOutSize(graph, "concat", 2, 3072);
+  auto last = AddNodeWithOutSize(graph, "last", 1, 512);
+  (void)ge::AttrUtils::SetBool(concat->GetOpDesc(), ATTR_NAME_CONTINUOUS_INPUT, true);
+  ge::GraphUtils::AddEdge(root->GetOutDataAnchor(0), left->GetInDataAnchor(0));
+  ge::GraphUtils::AddEdge(root->GetOutDataAnchor(0), right->GetInDataAnchor(0));
+  ge::GraphUtils::AddEdge(left->GetOutDataAnchor(0), concat->GetInDataAnchor(0));
+  ge::GraphUtils::AddEdge(right->GetOutDataAnchor(0), concat->GetInDataAnchor(1));
+  ge::GraphUtils::AddEdge(concat->GetOutDataAnchor(0), last->GetInDataAnchor(0));
+  graph->TopologicalSorting();
+
+  IntervalBlockMemAssigner interval_assigner(graph);
+  EXPECT_EQ(interval_assigner.Assign(), SUCCESS);
+  check_no_overlap(graph);
+  int64_t left_offset = left->GetOpDesc()->GetOutputOffset().at(0);
+  EXPECT_EQ(right->GetOpDesc()->GetOutputOffset().at(0), left_offset + 1024);
+  EXPECT_GE(left_offset, MEM_ALIGN_SIZE);
+}
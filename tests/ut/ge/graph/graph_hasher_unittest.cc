@@ -0,0 +1,185 @@
+/**
+ * Copyright 2019-2020 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <gtest/gtest.h>
+
+#include "graph/common/graph_hasher.h"
+
+#include "common/types.h"
+#include "graph/debug/ge_attr_define.h"
+#include "graph/passes/graph_builder_utils.h"
+#include "graph/utils/attr_utils.h"
+#include "graph/utils/graph_utils.h"
+
+using namespace ge;
+
+namespace {
+///     netoutput
+///         |
+///       add
+///      /   \
+///   relu   const
+///     |
+///   data
+ComputeGraphPtr BuildGraph(const std::string &graph_name, bool reverse_order) {
+  ut::GraphBuilder builder(graph_name);
+  NodePtr data;
+  NodePtr relu;
+  NodePtr constant;
+  NodePtr add;
+  NodePtr netoutput;
+  if (reverse_order) {
+    netoutput = builder.AddNode("netoutput", NETOUTPUT, 1, 0);
+    add = builder.AddNode("add", ADD, 2, 1);
+    constant = builder.AddNode("const", CONSTANT, 0, 1);
+    relu = builder.AddNode("relu", RELU, 1, 1);
+    data = builder.AddNode("data", DATA, 1, 1);
+  } else {
+    data = builder.AddNode("data", DATA, 1, 1);
+    relu = builder.AddNode("relu", RELU, 1, 1);
+    constant = builder.AddNode("const", CONSTANT, 0, 1);
+    add = builder.AddNode("add", ADD, 2, 1);
+    netoutput = builder.AddNode("netoutput", NETOUTPUT, 1, 0);
+  }
+  builder.AddDataEdge(data, 0, relu, 0);
+  builder.AddDataEdge(relu, 0, add, 0);
+  builder.AddDataEdge(constant, 0, add, 1);
+  builder.AddDataEdge(add, 0, netoutput, 0);
+  AttrUtils::SetInt(relu->GetOpDesc(), "mode", 1);
+  AttrUtils::SetListStr(add->GetOpDesc(), "names", {"a", "b"});
+  AttrUtils::SetFloat(add->GetOpDesc(), "alpha", 0.5f);
+  return builder.GetGraph();
+}
+
+HashCode128 GetGraphHash(const ComputeGraphPtr &graph) {
+  std::map<std::string, HashCode128> node_hash_codes;
+  HashCode128 hash_code;
+  EXPECT_EQ(GraphHasher::HashGraph(graph, node_hash_codes, hash_code), GRAPH_SUCCESS);
+  return hash_code;
+}
+}  // namespace
+
+class UtestGraphHasher : public testing::Test {
+ protected:
+  void SetUp() {}
+
+  void TearDown() {}
+};
+
+TEST_F(UtestGraphHasher, stream_hasher_murmur3) {
+  // reference values of MurmurHash3_x64_128 with seed 0, high and low are the two 64 bits words of the digest
+  HashCode128 empty = StreamHasher().Finish();
+  EXPECT_EQ(empty.high, 0);
+  EXPECT_EQ(empty.low, 0);
+
+  std::string text = "The quick brown fox jumps over the lazy dog";
+  HashCode128 hash_code = StreamHasher().Update(text.data(), text.size()).Finish();
+  EXPECT_EQ(hash_code.high, 0xe34bbc7bbc071b6cULL);
+  EXPECT_EQ(hash_code.low, 0x7a433ca9c49a9347ULL);
+
+  // result does not depend on how bytes are split
+  StreamHasher hasher;
+  hasher.Update(text.data(), 3).Update(text.data() + 3, 20).Update(text.data() + 23, text.size() - 23);
+  EXPECT_EQ(hasher.Finish(), hash_code);
+
+  HashCode128 hello = StreamHasher().Update("hello", 5).Finish();
+  EXPECT_EQ(hello.high, 0xcbd8a7b341bd9b02ULL);
+  EXPECT_EQ(hello.low, 0x5b1e906a48ae1d19ULL);
+}
+
+TEST_F(UtestGraphHasher, hash_code_to_string) {
+  HashCode128 hash_code;
+  hash_code.high = 0x0123456789abcdefULL;
+  hash_code.low = 0xfedcba9876543210ULL;
+  EXPECT_EQ(hash_code.ToString(), "0123456789abcdeffedcba9876543210");
+
+  HashCode128 parsed;
+  EXPECT_TRUE(HashCode128::FromString(hash_code.ToString(), parsed));
+  EXPECT_EQ(parsed, hash_code);
+  EXPECT_FALSE(HashCode128::FromString("0123", parsed));
+  EXPECT_FALSE(HashCode128::FromString("0123456789abcdeffedcba987654321g", parsed));
+  EXPECT_FALSE(HashCode128::FromString("134714827475991356", parsed));
+}
+
+TEST_F(UtestGraphHasher, equivalent_graphs_same_hash) {
+  auto graph1 = BuildGraph("graph1", false);
+  auto graph2 = BuildGraph("graph_2", true);
+
+  std::map<std::string, HashCode128> node_hash_codes1;
+  std::map<std::string, HashCode128> node_hash_codes2;
+  HashCode128 hash_code1;
+  HashCode128 hash_code2;
+  EXPECT_EQ(GraphHasher::HashGraph(graph1, node_hash_codes1, hash_code1), GRAPH_SUCCESS);
+  EXPECT_EQ(GraphHasher::HashGraph(graph2, node_hash_codes2, hash_code2), GRAPH_SUCCESS);
+  EXPECT_EQ(node_hash_codes1.size(), 5);
+  EXPECT_EQ(node_hash_codes1, node_hash_codes2);
+  EXPECT_EQ(hash_code1, hash_code2);
+
+  // weights of constant are not part of the structure
+  GeTensorDesc weight_desc(GeShape({1}), FORMAT_ND, DT_INT32);
+  int32_t weight = 1;
+  auto tensor = std::make_shared<GeTensor>(weight_desc, reinterpret_cast<uint8_t *>(&weight), sizeof(weight));
+  AttrUtils::SetTensor(graph1->FindNode("const")->GetOpDesc(), ATTR_NAME_WEIGHTS, tensor);
+  EXPECT_EQ(GetGraphHash(graph1), hash_code2);
+}
+
+TEST_F(UtestGraphHasher, hash_code_stable_between_runs) {
+  ut::GraphBuilder builder("graph");
+  auto data = builder.AddNode("data", DATA, 1, 1);
+  auto relu = builder.AddNode("relu", RELU, 1, 1);
+  builder.AddDataEdge(data, 0, relu, 0);
+  AttrUtils::SetInt(relu->GetOpDesc(), "mode", 1);
+
+  // the cache manifest saved by an earlier run keeps this value, so it must never change
+  EXPECT_EQ(GetGraphHash(builder.GetGraph()).ToString(), "4a3b4e945f23f492cadacd403b83716c");
+}
+
+TEST_F(UtestGraphHasher, changed_graph_different_hash) {
+  HashCode128 origin_hash_code = GetGraphHash(BuildGraph("graph", false));
+
+  auto graph = BuildGraph("graph", false);
+  AttrUtils::SetInt(graph->FindNode("relu")->GetOpDesc(), "mode", 2);
+  EXPECT_NE(GetGraphHash(graph), origin_hash_code);
+
+  graph = BuildGraph("graph", false);
+  AttrUtils::SetFloat(graph->FindNode("add")->GetOpDesc(), "alpha", 0.25f);
+  EXPECT_NE(GetGraphHash(graph), origin_hash_code);
+
+  graph = BuildGraph("graph", false);
+  graph->FindNode("relu")->GetOpDesc()->MutableOutputDesc(0)->SetShape(GeShape({1, 1, 224, 225}));
+  EXPECT_NE(GetGraphHash(graph), origin_hash_code);
+
+  graph = BuildGraph("graph", false);
+  graph->FindNode("relu")->GetOpDesc()->MutableOutputDesc(0)->SetDataType(DT_FLOAT16);
+  EXPECT_NE(GetGraphHash(graph), origin_hash_code);
+
+  // swap inputs of add
+  graph = BuildGraph("graph", false);
+  auto add = graph->FindNode("add");
+  auto relu_out = add->GetInDataAnchor(0)->GetPeerOutAnchor();
+  auto const_out = add->GetInDataAnchor(1)->GetPeerOutAnchor();
+  EXPECT_EQ(GraphUtils::RemoveEdge(relu_out, add->GetInDataAnchor(0)), GRAPH_SUCCESS);
+  EXPECT_EQ(GraphUtils::RemoveEdge(const_out, add->GetInDataAnchor(1)), GRAPH_SUCCESS);
+  EXPECT_EQ(GraphUtils::AddEdge(relu_out, add->GetInDataAnchor(1)), GRAPH_SUCCESS);
+  EXPECT_EQ(GraphUtils::AddEdge(const_out, add->GetInDataAnchor(0)), GRAPH_SUCCESS);
+  EXPECT_NE(GetGraphHash(graph), origin_hash_code);
+
+  graph = BuildGraph("graph", false);
+  EXPECT_EQ(GraphUtils::AddEdge(graph->FindNode("data")->GetOutControlAnchor(),
+                                graph->FindNode("const")->GetInControlAnchor()),
+            GRAPH_SUCCESS);
+  EXPECT_NE(GetGraphHash(graph), origin_hash_code);
+}
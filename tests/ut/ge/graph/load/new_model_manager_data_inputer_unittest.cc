@@ -61,4 +61,20 @@ TEST_F(UtestModelManagerDataInputer, success_inputdatawrapper_init) {
   input_data_wrapper = NULL;
 }
 
+/// DataInputer
+/// IsDataEmpty after push and pop
+TEST_F(UtestModelManagerDataInputer, data_empty_after_push_and_pop) {
+  DataInputer data_inputer;
+  EXPECT_TRUE(data_inputer.IsDataEmpty());
+
+  auto input_data_wrapper = std::make_shared<InputDataWrapper>();
+  EXPECT_EQ(data_inputer.Push(input_data_wrapper), SUCCESS);
+  EXPECT_FALSE(data_inputer.IsDataEmpty());
+
+  std::shared_ptr<InputDataWrapper> data;
+  EXPECT_EQ(data_inputer.Pop(data), SUCCESS);
+  EXPECT_EQ(data, input_data_wrapper);
+  EXPECT_TRUE(data_inputer.IsDataEmpty());
+}
+
 }  // namespace ge
@@ -0,0 +1,236 @@
+/**
+ * Copyright 2019-2020 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <gtest/gtest.h>
+
+#include <map>
+#include <memory>
+#include <utility>
+#include <vector>
+
+#define protected public
+#define private public
+#include "graph/load/new_model_manager/davinci_model.h"
+#include "graph/load/new_model_manager/task_info/task_info.h"
+#include "graph/load/new_model_manager/zero_copy_offset.h"
+#undef protected
+#undef private
+
+namespace ge {
+namespace {
+const int kTaskNum = 32;
+const size_t kAddrNum = 2;
+uint8_t g_input_data[64];
+
+// sets zero copy addrs in Init like kernel tasks, info is released once Init returns
+class ZeroCopyTestTaskInfo : public TaskInfo {
+ public:
+  explicit ZeroCopyTestTaskInfo(Status init_ret = SUCCESS) : init_ret_(init_ret) {}
+
+  Status Init(const domi::TaskDef &task_def, DavinciModel *davinci_model) override {
+    ++init_count_;
+    // index of the task is kept in stream id of task def
+    task_index_ = task_def.stream_id();
+    if (init_ret_ != SUCCESS) {
+      return init_ret_;
+    }
+    // like kernel tasks using Data addr, args are taken from zero copy args arena if reserved for the task
+    std::vector<void *> outside_addrs(kAddrNum, g_input_data);
+    arena_args_ = davinci_model->MallocZeroCopyArgs(outside_addrs, sizeof(args_));
+    auto op_desc = std::make_shared<OpDesc>("task_" + std::to_string(task_index_), "Some");
+    std::vector<uint64_t> info(kAddrNum + 1, task_index_);
+    davinci_model->SetZeroCopyAddr(op_desc, outside_addrs, info.data(), args_, sizeof(args_), sizeof(uint64_t));
+    return SUCCESS;
+  }
+
+  Status Distribute() override { return SUCCESS; }
+
+  Status init_ret_;
+  uint32_t init_count_ = 0;
+  uint32_t task_index_ = 0;
+  uint64_t args_[kAddrNum + 1] = {0};
+  void *arena_args_ = nullptr;
+};
+
+// zero copy state of model, args are given by index of the task and offset
+struct ZeroCopyState {
+  std::vector<std::pair<int, size_t>> input_args;
+  std::vector<std::pair<int, std::map<uintptr_t, std::vector<size_t>>>> task_offsets;
+  std::vector<std::vector<uint8_t>> task_args_info;
+};
+
+int GetTaskIndex(const DavinciModel &model, const void *args) {
+  for (size_t i = 0; i < model.task_list_.size(); ++i) {
+    auto task = std::dynamic_pointer_cast<ZeroCopyTestTaskInfo>(model.task_list_[i]);
+    auto begin = reinterpret_cast<const uint8_t *>(task->args_);
+    if ((args >= begin) && (args < begin + sizeof(task->args_))) {
+      return static_cast<int>(i);
+    }
+  }
+  return -1;
+}
+
+ZeroCopyState GetZeroCopyState(const DavinciModel &model) {
+  ZeroCopyState state;
+  for (auto args : model.new_input_outside_addrs_.at(g_input_data).outside_addrs_[0].at(g_input_data)) {
+    int index = GetTaskIndex(model, args);
+    auto task = std::dynamic_pointer_cast<ZeroCopyTestTaskInfo>(model.task_list_[index]);
+    state.input_args.emplace_back(index, static_cast<uint8_t *>(args) - reinterpret_cast<uint8_t *>(task->args_));
+  }
+  for (const auto &zero_copy_task : model.zero_copy_tasks_) {
+    state.task_offsets.emplace_back(GetTaskIndex(model, zero_copy_task.GetArgsAddr()),
+                                    zero_copy_task.GetTaskArgsOffset());
+    state.task_args_info.emplace_back(zero_copy_task.args_info_);
+  }
+  return state;
+}
+
+// kernel tasks are initialized in parallel, the event tasks between them are not
+void InitTestModel(DavinciModel &model, domi::ModelTaskDef &model_task_def, int fail_index = -1) {
+  for (int i = 0; i < kTaskNum; ++i) {
+    domi::TaskDef *task_def = model_task_def.add_task();
+    task_def->set_type((i % 4 == 3) ? RT_MODEL_TASK_EVENT_RECORD : RT_MODEL_TASK_KERNEL);
+    task_def->set_stream_id(i);
+    model.task_list_.emplace_back(std::make_shared<ZeroCopyTestTaskInfo>((i == fail_index) ? FAILED : SUCCESS));
+  }
+  ZeroCopyOffset &input_outside = model.new_input_outside_addrs_[g_input_data];
+  input_outside.addr_count_ = 1;
+  input_outside.outside_addrs_.resize(1);
+  input_outside.outside_addrs_[0][g_input_data] = {};
+}
+
+// args of kernel tasks are reserved in zero copy args arena, in task order
+void ReserveZeroCopyArgs(DavinciModel &model) {
+  model.zero_copy_virtual_addrs_.insert(g_input_data);
+  for (int i = 0; i < kTaskNum; ++i) {
+    if (i % 4 != 3) {
+      model.zero_copy_args_offsets_[i] = model.zero_copy_args_arena_.Reserve(sizeof(ZeroCopyTestTaskInfo::args_));
+    }
+  }
+  EXPECT_EQ(model.zero_copy_args_arena_.Init(), SUCCESS);
+}
+}  // namespace
+
+class UtestDavinciModelInitTask : public testing::Test {
+ protected:
+  void SetUp() {}
+  void TearDown() {}
+};
+
+TEST_F(UtestDavinciModelInitTask, parallel_init_same_as_serial) {
+  DavinciModel serial_model(0, nullptr);
+  domi::ModelTaskDef serial_task_def;
+  InitTestModel(serial_model, serial_task_def);
+  serial_model.init_thread_num_ = 0;
+  EXPECT_EQ(serial_model.InitTaskInfo(serial_task_def), SUCCESS);
+
+  DavinciModel parallel_model(0, nullptr);
+  domi::ModelTaskDef parallel_task_def;
+  InitTestModel(parallel_model, parallel_task_def);
+  parallel_model.init_thread_num_ = 4;
+  EXPECT_EQ(parallel_model.InitTaskInfo(parallel_task_def), SUCCESS);
+
+  ASSERT_EQ(serial_model.task_list_.size(), kTaskNum);
+  ASSERT_EQ(parallel_model.task_list_.size(), kTaskNum);
+  for (int i = 0; i < kTaskNum; ++i) {
+    auto serial_task = std::dynamic_pointer_cast<ZeroCopyTestTaskInfo>(serial_model.task_list_[i]);
+    auto parallel_task = std::dynamic_pointer_cast<ZeroCopyTestTaskInfo>(parallel_model.task_list_[i]);
+    EXPECT_EQ(serial_task->init_count_, 1);
+    EXPECT_EQ(parallel_task->init_count_, 1);
+    EXPECT_EQ(serial_task->task_index_, i);
+    EXPECT_EQ(parallel_task->task_index_, i);
+  }
+
+  ZeroCopyState serial_state = GetZeroCopyState(serial_model);
+  ZeroCopyState parallel_state = GetZeroCopyState(parallel_model);
+  EXPECT_EQ(serial_state.input_args.size(), kTaskNum * kAddrNum);
+  EXPECT_EQ(serial_state.task_offsets.size(), kTaskNum);
+  EXPECT_EQ(parallel_state.input_args, serial_state.input_args);
+  EXPECT_EQ(parallel_state.task_offsets, serial_state.task_offsets);
+  // info of tasks initialized in parallel is kept until it is applied
+  EXPECT_EQ(parallel_state.task_args_info, serial_state.task_args_info);
+  for (size_t i = 0; i < serial_state.task_offsets.size(); ++i) {
+    EXPECT_EQ(serial_state.task_offsets[i].first, i);
+  }
+}
+
+TEST_F(UtestDavinciModelInitTask, parallel_init_args_in_task_order) {
+  DavinciModel serial_model(0, nullptr);
+  domi::ModelTaskDef serial_task_def;
+  InitTestModel(serial_model, serial_task_def);
+  ReserveZeroCopyArgs(serial_model);
+  serial_model.init_thread_num_ = 0;
+  EXPECT_EQ(serial_model.InitTaskInfo(serial_task_def), SUCCESS);
+
+  DavinciModel parallel_model(0, nullptr);
+  domi::ModelTaskDef parallel_task_def;
+  InitTestModel(parallel_model, parallel_task_def);
+  ReserveZeroCopyArgs(parallel_model);
+  parallel_model.init_thread_num_ = 4;
+  EXPECT_EQ(parallel_model.InitTaskInfo(parallel_task_def), SUCCESS);
+
+  // whatever order tasks are initialized in, args of each task are at the same offset in arena
+  size_t offset = 0;
+  for (int i = 0; i < kTaskNum; ++i) {
+    auto serial_task = std::dynamic_pointer_cast<ZeroCopyTestTaskInfo>(serial_model.task_list_[i]);
+    auto parallel_task = std::dynamic_pointer_cast<ZeroCopyTestTaskInfo>(parallel_model.task_list_[i]);
+    if (i % 4 == 3) {
+      EXPECT_EQ(serial_task->arena_args_, nullptr);
+      EXPECT_EQ(parallel_task->arena_args_, nullptr);
+      continue;
+    }
+    EXPECT_EQ(serial_task->arena_args_, serial_model.zero_copy_args_arena_.dev_args_ + offset);
+    EXPECT_EQ(parallel_task->arena_args_, parallel_model.zero_copy_args_arena_.dev_args_ + offset);
+    offset += ZeroCopyArgsArena::GetAlignedSize(sizeof(serial_task->args_));
+  }
+  EXPECT_EQ(offset, parallel_model.zero_copy_args_arena_.size_);
+}
+
+TEST_F(UtestDavinciModelInitTask, parallel_init_task_failed) {
+  const int fail_index = 13;
+  DavinciModel model(0, nullptr);
+  domi::ModelTaskDef model_task_def;
+  InitTestModel(model, model_task_def, fail_index);
+  model.init_thread_num_ = 4;
+  EXPECT_EQ(model.InitTaskInfo(model_task_def), FAILED);
+
+  // nothing initialized in parallel is applied, and serial tasks are not initialized at all
+  EXPECT_TRUE(model.zero_copy_tasks_.empty());
+  EXPECT_TRUE(model.new_input_outside_addrs_.at(g_input_data).outside_addrs_[0].at(g_input_data).empty());
+  for (int i = 0; i < kTaskNum; ++i) {
+    auto task = std::dynamic_pointer_cast<ZeroCopyTestTaskInfo>(model.task_list_[i]);
+    if (i % 4 == 3) {
+      EXPECT_EQ(task->init_count_, 0);
+    } else {
+      EXPECT_LE(task->init_count_, 1);
+    }
+  }
+  EXPECT_EQ(std::dynamic_pointer_cast<ZeroCopyTestTaskInfo>(model.task_list_[fail_index])->init_count_, 1);
+}
+
+TEST_F(UtestDavinciModelInitTask, serial_init_task_failed) {
+  const int fail_index = 13;
+  DavinciModel model(0, nullptr);
+  domi::ModelTaskDef model_task_def;
+  InitTestModel(model, model_task_def, fail_index);
+  model.init_thread_num_ = 0;
+  EXPECT_EQ(model.InitTaskInfo(model_task_def), FAILED);
+  for (int i = 0; i < kTaskNum; ++i) {
+    auto task = std::dynamic_pointer_cast<ZeroCopyTestTaskInfo>(model.task_list_[i]);
+    EXPECT_EQ(task->init_count_, (i <= fail_index) ? 1 : 0);
+  }
+}
+}  // namespace ge
@@ -0,0 +1,149 @@
+/**
+ * Copyright 2019-2020 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <chrono>
+#include <condition_variable>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#define protected public
+#define private public
+#include "graph/load/new_model_manager/data_inputer.h"
+#include "graph/load/new_model_manager/davinci_model.h"
+#include "graph/load/new_model_manager/zero_copy_offset.h"
+#undef protected
+#undef private
+
+extern uint64_t g_rt_memcpy_async_num;
+
+namespace ge {
+namespace {
+const uint32_t kSlotNum = 3;
+const uint32_t kRequestNum = 8;
+const uint32_t kDataSize = 16;
+// copies of each request: upload and stage input, stage and download output 0, outputs 1 and 2 are skipped
+const uint64_t kCopyNumPerRequest = 4;
+
+// keeps the order of results, and how many copies were submitted when each result came back
+class PipelineTestListener : public ModelListener {
+ public:
+  Status OnComputeDone(uint32_t model_id, uint32_t data_index, uint32_t result_code,
+                       std::vector<ge::OutputTensorInfo> &outputs) override {
+    std::lock_guard<std::mutex> lock(mutex_);
+    data_indexes_.emplace_back(data_index);
+    result_codes_.emplace_back(result_code);
+    copy_nums_.emplace_back(g_rt_memcpy_async_num);
+    cond_.notify_all();
+    return SUCCESS;
+  }
+
+  bool WaitForResults(size_t num) {
+    std::unique_lock<std::mutex> lock(mutex_);
+    return cond_.wait_for(lock, std::chrono::seconds(10), [this, num]() { return data_indexes_.size() >= num; });
+  }
+
+  std::mutex mutex_;
+  std::condition_variable cond_;
+  std::vector<uint32_t> data_indexes_;
+  std::vector<uint32_t> result_codes_;
+  std::vector<uint64_t> copy_nums_;
+};
+
+void SetDataInfo(ZeroCopyOffset &zero_copy_offset, void *addr, int64_t size) {
+  zero_copy_offset.basic_addr_ = addr;
+  zero_copy_offset.data_size_ = size;
+}
+}  // namespace
+
+class UtestDavinciModelPipeline : public testing::Test {
+ protected:
+  void SetUp() {}
+  void TearDown() {}
+};
+
+TEST_F(UtestDavinciModelPipeline, run_requests_in_flight) {
+  std::vector<uint8_t> model_input(kDataSize);
+  std::vector<uint8_t> model_output(kDataSize);
+  auto listener = std::make_shared<PipelineTestListener>();
+  DavinciModel model(0, listener);
+  model.data_inputer_ = new DataInputer();
+  model.pipeline_slot_num_ = kSlotNum;
+  model.run_flg_ = true;
+  model.output_op_list_.emplace_back(std::make_shared<OpDesc>("output", "NetOutput"));
+  SetDataInfo(model.new_input_data_info_[0], model_input.data(), kDataSize);
+  SetDataInfo(model.new_output_data_info_[0], model_output.data(), kDataSize);
+  // output of zero size, and output not wanted by user
+  SetDataInfo(model.new_output_data_info_[1], nullptr, 0);
+  SetDataInfo(model.new_output_data_info_[2], model_output.data(), kDataSize);
+  ASSERT_TRUE(model.CanRunPipelined());
+
+  std::vector<std::vector<uint8_t>> inputs(kRequestNum, std::vector<uint8_t>(kDataSize));
+  std::vector<std::vector<uint8_t>> outputs(kRequestNum, std::vector<uint8_t>(kDataSize, 0xff));
+  for (uint32_t i = 0; i < kRequestNum; ++i) {
+    inputs[i].assign(kDataSize, static_cast<uint8_t>(i));
+    InputData input_data;
+    input_data.index = i;
+    input_data.blobs.emplace_back(DataBuffer(inputs[i].data(), kDataSize, false));
+    OutputData output_data;
+    output_data.blobs.emplace_back(DataBuffer(outputs[i].data(), kDataSize, false));
+    output_data.blobs.emplace_back(DataBuffer(nullptr, 0, false));
+    output_data.blobs.emplace_back(DataBuffer(nullptr, 0, false));
+    auto data_wrapper = std::make_shared<InputDataWrapper>();
+    ASSERT_EQ(data_wrapper->Init(input_data, output_data), SUCCESS);
+    ASSERT_EQ(model.data_inputer_->Push(data_wrapper), SUCCESS);
+  }
+
+  ASSERT_EQ(model.InitPipeline(), SUCCESS);
+  ASSERT_EQ(model.pipeline_slots_.size(), kSlotNum);
+  // device copies are not done by runtime stub, mark the pinned output buffer of each slot instead
+  for (uint32_t i = 0; i < kSlotNum; ++i) {
+    memset(model.pipeline_slots_[i].output_host_buffers[0], 0x10 + i, kDataSize);
+  }
+  g_rt_memcpy_async_num = 0;
+  std::thread run_thread([&model]() { model.RunPipelined(); });
+  bool all_done = listener->WaitForResults(kRequestNum);
+  model.run_flg_ = false;
+  model.data_inputer_->Stop();
+  run_thread.join();
+  ASSERT_TRUE(all_done);
+
+  // results come back in order of requests
+  ASSERT_EQ(listener->data_indexes_.size(), kRequestNum);
+  for (uint32_t i = 0; i < kRequestNum; ++i) {
+    EXPECT_EQ(listener->data_indexes_[i], i);
+    EXPECT_EQ(listener->result_codes_[i], SUCCESS);
+    EXPECT_EQ(outputs[i], std::vector<uint8_t>(kDataSize, 0x10 + i % kSlotNum));
+  }
+  // a result is returned when its slot is reused, so the following requests are already in flight
+  for (uint32_t i = 0; i < kRequestNum; ++i) {
+    EXPECT_EQ(listener->copy_nums_[i], std::min(i + kSlotNum, kRequestNum) * kCopyNumPerRequest);
+  }
+  EXPECT_EQ(g_rt_memcpy_async_num, kRequestNum * kCopyNumPerRequest);
+
+  // inputs are staged in pinned buffers of the slot, the latest request of each slot stays there
+  for (uint32_t i = kRequestNum - kSlotNum; i < kRequestNum; ++i) {
+    auto host_buffer = static_cast<uint8_t *>(model.pipeline_slots_[i % kSlotNum].input_host_buffers[0]);
+    EXPECT_EQ(std::vector<uint8_t>(host_buffer, host_buffer + kDataSize), inputs[i]);
+  }
+  model.ReleasePipeline();
+  EXPECT_TRUE(model.pipeline_slots_.empty());
+}
+}  // namespace ge
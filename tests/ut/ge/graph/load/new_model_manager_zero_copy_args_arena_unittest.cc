@@ -0,0 +1,141 @@
+/**
+ * Copyright 2019-2020 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <gtest/gtest.h>
+
+#define protected public
+#define private public
+#include "graph/load/new_model_manager/zero_copy_args_arena.h"
+#include "graph/load/new_model_manager/zero_copy_task.h"
+#undef protected
+#undef private
+
+extern uint64_t g_rt_memcpy_num;
+extern uint64_t g_rt_memcpy_async_num;
+
+namespace ge {
+namespace {
+const size_t kArgsSize = 24;
+const size_t kTaskNum = 100;
+}  // namespace
+
+class UtestZeroCopyArgsArena : public testing::Test {
+ protected:
+  void SetUp() {}
+  void TearDown() {}
+};
+
+TEST_F(UtestZeroCopyArgsArena, reserve_in_arena) {
+  ZeroCopyArgsArena arena;
+  size_t offset1 = arena.Reserve(kArgsSize);
+  size_t offset2 = arena.Reserve(kArgsSize);
+  EXPECT_EQ(offset1, 0);
+  EXPECT_EQ(offset2, ZeroCopyArgsArena::GetAlignedSize(kArgsSize));
+  EXPECT_EQ(arena.GetArgs(offset1, kArgsSize), nullptr);
+
+  EXPECT_EQ(arena.Init(), SUCCESS);
+  EXPECT_NE(arena.Init(), SUCCESS);
+  void *args1 = arena.GetArgs(offset1, kArgsSize);
+  void *args2 = arena.GetArgs(offset2, kArgsSize);
+  EXPECT_EQ(args1, arena.dev_args_);
+  EXPECT_EQ(args2, arena.dev_args_ + offset2);
+  EXPECT_EQ(arena.GetArgs(offset2 + ZeroCopyArgsArena::GetAlignedSize(kArgsSize), kArgsSize), nullptr);
+  EXPECT_EQ(arena.GetArgs(offset2, ZeroCopyArgsArena::GetAlignedSize(kArgsSize) + 1), nullptr);
+  EXPECT_TRUE(arena.Contains(args1));
+  EXPECT_TRUE(arena.Contains(args2));
+
+  uint8_t args[kArgsSize];
+  EXPECT_FALSE(arena.Contains(args));
+  ZeroCopyTask task("task", args, kArgsSize);
+  EXPECT_EQ(task.SetTaskArgsOffset(0x1000, 0), SUCCESS);
+  EXPECT_NE(arena.AddTask(task), SUCCESS);
+}
+
+TEST_F(UtestZeroCopyArgsArena, one_copy_per_run) {
+  ZeroCopyArgsArena arena;
+  std::vector<size_t> offsets;
+  for (size_t i = 0; i < kTaskNum; ++i) {
+    offsets.emplace_back(arena.Reserve(kArgsSize));
+  }
+  EXPECT_EQ(arena.Init(), SUCCESS);
+
+  // task i takes input 0x1000 + i and all of them write output 0x2000
+  const uintptr_t output_addr = 0x2000;
+  std::vector<uint8_t *> task_args;
+  for (size_t i = 0; i < kTaskNum; ++i) {
+    auto args = static_cast<uint8_t *>(arena.GetArgs(offsets[i], kArgsSize));
+    ASSERT_NE(args, nullptr);
+    ZeroCopyTask task("task" + std::to_string(i), args, kArgsSize);
+    EXPECT_EQ(task.SetTaskArgsOffset(0x1000 + i, 0), SUCCESS);
+    EXPECT_EQ(task.SetTaskArgsOffset(output_addr, sizeof(uintptr_t)), SUCCESS);
+    EXPECT_EQ(arena.AddTask(task), SUCCESS);
+    task_args.emplace_back(args);
+  }
+  EXPECT_EQ(arena.Build(), SUCCESS);
+  EXPECT_EQ(arena.GetPatchNum(), kTaskNum * 2);
+
+  // nothing to refresh before any update
+  uint64_t memcpy_num = g_rt_memcpy_num;
+  uint64_t memcpy_async_num = g_rt_memcpy_async_num;
+  EXPECT_EQ(arena.DistributeParam(nullptr), SUCCESS);
+  EXPECT_EQ(g_rt_memcpy_num, memcpy_num);
+
+  std::map<std::string, std::set<uintptr_t>> batch_addrs;
+  std::vector<uint8_t> output(64);
+  for (size_t i = 0; i < kTaskNum; ++i) {
+    EXPECT_EQ(arena.UpdateTaskParam(0x1000 + i, reinterpret_cast<void *>(0x8000 + i), batch_addrs, ""), SUCCESS);
+  }
+  EXPECT_EQ(arena.UpdateTaskParam(output_addr, output.data(), batch_addrs, ""), SUCCESS);
+  for (size_t i = 0; i < kTaskNum; ++i) {
+    size_t base = task_args[i] - arena.dev_args_;
+    EXPECT_EQ(*reinterpret_cast<uintptr_t *>(arena.host_args_.data() + base), 0x8000 + i);
+    EXPECT_EQ(*reinterpret_cast<uintptr_t *>(arena.host_args_.data() + base + sizeof(uintptr_t)),
+              reinterpret_cast<uintptr_t>(output.data()));
+  }
+
+  EXPECT_EQ(arena.DistributeParam(nullptr), SUCCESS);
+  EXPECT_EQ(g_rt_memcpy_num, memcpy_num + 1);
+
+  int stream = 0;
+  EXPECT_EQ(arena.UpdateTaskParam(output_addr, output.data(), batch_addrs, ""), SUCCESS);
+  EXPECT_EQ(arena.DistributeParam(&stream), SUCCESS);
+  EXPECT_EQ(g_rt_memcpy_async_num, memcpy_async_num + 1);
+  EXPECT_EQ(g_rt_memcpy_num, memcpy_num + 1);
+}
+
+TEST_F(UtestZeroCopyArgsArena, skip_addr_of_other_batch) {
+  ZeroCopyArgsArena arena;
+  size_t offset1 = arena.Reserve(kArgsSize);
+  size_t offset2 = arena.Reserve(kArgsSize);
+  EXPECT_EQ(arena.Init(), SUCCESS);
+  auto args1 = static_cast<uint8_t *>(arena.GetArgs(offset1, kArgsSize));
+  auto args2 = static_cast<uint8_t *>(arena.GetArgs(offset2, kArgsSize));
+  ZeroCopyTask task1("batch_0", args1, kArgsSize);
+  ZeroCopyTask task2("batch_1", args2, kArgsSize);
+  EXPECT_EQ(task1.SetTaskArgsOffset(0x1000, 0), SUCCESS);
+  EXPECT_EQ(task2.SetTaskArgsOffset(0x1000, 0), SUCCESS);
+  EXPECT_EQ(arena.AddTask(task1), SUCCESS);
+  EXPECT_EQ(arena.AddTask(task2), SUCCESS);
+  EXPECT_EQ(arena.Build(), SUCCESS);
+
+  std::map<std::string, std::set<uintptr_t>> batch_addrs;
+  batch_addrs["Batch_0"].insert(reinterpret_cast<uintptr_t>(args1));
+  batch_addrs["Batch_1"].insert(reinterpret_cast<uintptr_t>(args2));
+  EXPECT_EQ(arena.UpdateTaskParam(0x1000, reinterpret_cast<void *>(0x8000), batch_addrs, "Batch_1"), SUCCESS);
+  EXPECT_EQ(*reinterpret_cast<uintptr_t *>(arena.host_args_.data() + (args1 - arena.dev_args_)), 0);
+  EXPECT_EQ(*reinterpret_cast<uintptr_t *>(arena.host_args_.data() + (args2 - arena.dev_args_)), 0x8000);
+}
+}  // namespace ge
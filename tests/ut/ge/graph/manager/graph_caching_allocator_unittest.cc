@@ -0,0 +1,286 @@
+/**
+ * Copyright 2019-2020 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <gtest/gtest.h>
+#include <thread>
+#include <vector>
+
+#include "runtime/rt.h"
+
+#define protected public
+#define private public
+#include "graph/manager/graph_caching_allocator.h"
+#include "graph/manager/graph_mem_allocator.h"
+#undef private
+#undef protected
+
+using namespace std;
+using namespace testing;
+using namespace ge;
+
+namespace {
+// one record of an alloc/free trace, free records refer to the slot of an earlier alloc
+struct TraceRecord {
+  bool is_alloc;
+  size_t slot;
+  size_t size;
+};
+
+// trace shaped like the hybrid executor: mostly small outputs released soon, few long-lived large buffers
+vector<TraceRecord> GenerateTrace(size_t op_count, size_t slot_count) {
+  vector<TraceRecord> trace;
+  vector<bool> in_use(slot_count, false);
+  uint64_t seed = 20200601;
+  for (size_t i = 0; i < op_count; ++i) {
+    seed = seed * 6364136223846793005ULL + 1442695040888963407ULL;
+    size_t slot = (seed >> 33) % slot_count;
+    if (in_use[slot]) {
+      trace.push_back({false, slot, 0});
+      in_use[slot] = false;
+      continue;
+    }
+    size_t size = ((seed >> 17) % 16 == 0) ? ((seed >> 8) % (16 * kMByteSize)) : ((seed >> 8) % (32 * kKByteSize));
+    trace.push_back({true, slot, size});
+    in_use[slot] = true;
+  }
+  for (size_t slot = 0; slot < slot_count; ++slot) {
+    if (in_use[slot]) {
+      trace.push_back({false, slot, 0});
+    }
+  }
+  return trace;
+}
+
+bool ReplayTrace(CachingAllocator &allocator, const vector<TraceRecord> &trace, size_t slot_count) {
+  vector<uint8_t *> slots(slot_count, nullptr);
+  for (const auto &record : trace) {
+    if (record.is_alloc) {
+      slots[record.slot] = allocator.Malloc(record.size);
+      if (slots[record.slot] == nullptr) {
+        return false;
+      }
+    } else if (allocator.Free(slots[record.slot]) != SUCCESS) {
+      return false;
+    }
+  }
+  return true;
+}
+}  // namespace
+
+class UtestGraphCachingAllocator : public testing::Test {
+ protected:
+  void SetUp() { EXPECT_EQ(MemManager::Instance().Initialize({RT_MEMORY_HBM}), SUCCESS); }
+
+  void TearDown() { MemManager::Instance().Finalize(); }
+};
+
+TEST_F(UtestGraphCachingAllocator, size_class) {
+  EXPECT_EQ(CachingBlockBin::GetSizeClass(kRoundBlockSize), 1);
+  EXPECT_EQ(CachingBlockBin::GetSizeClass(kRoundBlockSize * (kExactSizeClasses - 1)), kExactSizeClasses - 1);
+  uint32_t last_class = 0;
+  for (size_t size = kRoundBlockSize; size <= 64 * kMByteSize; size += 7 * kRoundBlockSize) {
+    uint32_t size_class = CachingBlockBin::GetSizeClass(size);
+    EXPECT_GE(size_class, last_class);
+    EXPECT_LT(size_class, kNumSizeClasses);
+    last_class = size_class;
+  }
+  EXPECT_LT(CachingBlockBin::GetSizeClass(26 * kGByteSize), kNumSizeClasses);
+}
+
+TEST_F(UtestGraphCachingAllocator, block_bin_take_fit) {
+  CachingBlockBin bin;
+  vector<CachingBlock> blocks;
+  for (size_t i = 1; i <= 64; ++i) {
+    blocks.emplace_back(0, i * 3 * kRoundBlockSize, &bin, reinterpret_cast<uint8_t *>(i * kMByteSize));
+  }
+  for (auto &block : blocks) {
+    bin.Insert(&block);
+  }
+  EXPECT_EQ(bin.BlockCount(), 64);
+
+  CachingBlock *block = bin.TakeFit(100 * kRoundBlockSize, nullptr);
+  ASSERT_NE(block, nullptr);
+  EXPECT_GE(block->size, 100 * kRoundBlockSize);
+
+  CachingBlock *reuse = bin.TakeFit(30 * kRoundBlockSize, blocks[9].ptr);
+  EXPECT_EQ(reuse, &blocks[9]);
+
+  CachingBlock *largest = bin.TakeFit(190 * kRoundBlockSize, nullptr);
+  ASSERT_NE(largest, nullptr);
+  EXPECT_EQ(largest->size, 192 * kRoundBlockSize);
+
+  // no larger size class is left, the block is found by scanning the size class of the request
+  CachingBlock *last = bin.TakeFit(188 * kRoundBlockSize, nullptr);
+  ASSERT_NE(last, nullptr);
+  EXPECT_EQ(last->size, 189 * kRoundBlockSize);
+  EXPECT_EQ(bin.TakeFit(188 * kRoundBlockSize, nullptr), nullptr);
+  EXPECT_EQ(bin.BlockCount(), 60);
+}
+
+TEST_F(UtestGraphCachingAllocator, malloc_and_free) {
+  auto &allocator = MemManager::CachingInstance(RT_MEMORY_HBM);
+  uint8_t *ptr = allocator.Malloc(kMByteSize);
+  ASSERT_NE(ptr, nullptr);
+  EXPECT_EQ(allocator.Free(ptr), SUCCESS);
+  EXPECT_NE(allocator.Free(ptr), SUCCESS);
+
+  uint8_t *reuse = allocator.Malloc(kMByteSize, ptr);
+  EXPECT_EQ(reuse, ptr);
+  EXPECT_EQ(allocator.Free(reuse), SUCCESS);
+
+  // small blocks are served from the magazine
+  uint8_t *small = allocator.Malloc(kKByteSize);
+  ASSERT_NE(small, nullptr);
+  EXPECT_EQ(allocator.Free(small), SUCCESS);
+  EXPECT_EQ(allocator.Malloc(kKByteSize), small);
+  EXPECT_EQ(allocator.Free(small), SUCCESS);
+}
+
+TEST_F(UtestGraphCachingAllocator, free_cached_blocks) {
+  auto &allocator = MemManager::CachingInstance(RT_MEMORY_HBM);
+  vector<uint8_t *> ptrs;
+  for (int i = 0; i < 100; ++i) {
+    ptrs.push_back(allocator.Malloc(4 * kKByteSize));
+    ASSERT_NE(ptrs.back(), nullptr);
+  }
+  for (auto ptr : ptrs) {
+    EXPECT_EQ(allocator.Free(ptr), SUCCESS);
+  }
+  allocator.FreeCachedBlocks();
+  for (uint32_t i = 0; i < kNumBins; ++i) {
+    EXPECT_TRUE(allocator.free_block_bins_[i]->Empty());
+  }
+}
+
+TEST_F(UtestGraphCachingAllocator, stats) {
+  auto &allocator = MemManager::CachingInstance(RT_MEMORY_HBM);
+  uint8_t *large = allocator.Malloc(2 * kMByteSize);
+  uint8_t *small = allocator.Malloc(kKByteSize);
+  ASSERT_NE(large, nullptr);
+  ASSERT_NE(small, nullptr);
+
+  CachingAllocatorStats stats;
+  EXPECT_EQ(MemManager::Instance().GetCachingStats(RT_MEMORY_HBM, stats), SUCCESS);
+  EXPECT_EQ(stats.malloc_count, 2);
+  EXPECT_EQ(stats.miss_count, 2);
+  EXPECT_EQ(stats.extend_count, 2);
+  EXPECT_EQ(stats.allocated_bytes, 2 * kMByteSize + kKByteSize);
+  EXPECT_EQ(stats.cached_bytes, 8 * kMByteSize + kRoundBlockSize * kKByteSize);
+  EXPECT_EQ(stats.bins[1].free_bytes, 6 * kMByteSize);
+  EXPECT_EQ(stats.bins[1].largest_free_block, 6 * kMByteSize);
+
+  EXPECT_EQ(allocator.Free(small), SUCCESS);
+  EXPECT_EQ(allocator.Free(large), SUCCESS);
+  EXPECT_EQ(allocator.Malloc(kKByteSize), small);
+  allocator.GetStats(stats);
+  EXPECT_EQ(stats.free_count, 2);
+  EXPECT_EQ(stats.hit_count, 1);
+  EXPECT_EQ(stats.magazine_hit_count, 1);
+  EXPECT_EQ(stats.allocated_bytes, kKByteSize);
+  EXPECT_EQ(stats.peak_allocated_bytes, 2 * kMByteSize + kKByteSize);
+  EXPECT_EQ(stats.bins[1].free_block_count, 1);
+  EXPECT_EQ(stats.bins[1].largest_free_block, 8 * kMByteSize);
+  EXPECT_EQ(allocator.Free(small), SUCCESS);
+
+  CachingAllocatorStats invalid_stats;
+  EXPECT_NE(MemManager::Instance().GetCachingStats(RT_MEMORY_DDR, invalid_stats), SUCCESS);
+}
+
+TEST_F(UtestGraphCachingAllocator, free_on_stream) {
+  auto &allocator = MemManager::CachingInstance(RT_MEMORY_HBM);
+  int stream_a = 0;
+  int stream_b = 0;
+  uint8_t *ptr = allocator.MallocOnStream(kMByteSize, &stream_a);
+  ASSERT_NE(ptr, nullptr);
+  EXPECT_EQ(allocator.FreeOnStream(ptr, &stream_a), SUCCESS);
+  EXPECT_NE(allocator.FreeOnStream(ptr, &stream_a), SUCCESS);
+
+  CachingAllocatorStats stats;
+  allocator.GetStats(stats);
+  EXPECT_EQ(stats.pending_bytes, kMByteSize);
+  EXPECT_EQ(stats.allocated_bytes, 0);
+
+  // other streams must wait for the event, the same stream reuses the block at once
+  {
+    std::lock_guard<std::recursive_mutex> lock(allocator.mutex_);
+    EXPECT_EQ(allocator.TakePendingBlock(kMByteSize, &stream_b), nullptr);
+    CachingBlock *block = allocator.TakePendingBlock(kMByteSize, &stream_a);
+    ASSERT_NE(block, nullptr);
+    EXPECT_EQ(block->ptr, ptr);
+    allocator.AddAllocatedBlock(block);
+  }
+  EXPECT_EQ(allocator.FreeOnStream(ptr, &stream_a), SUCCESS);
+
+  // completed events return pending blocks to bins
+  uint8_t *other = allocator.MallocOnStream(kMByteSize, &stream_b);
+  ASSERT_NE(other, nullptr);
+  allocator.GetStats(stats);
+  EXPECT_EQ(stats.pending_bytes, 0);
+  EXPECT_EQ(allocator.FreeOnStream(other, &stream_b), SUCCESS);
+  allocator.FreeCachedBlocks();
+  allocator.GetStats(stats);
+  EXPECT_EQ(stats.pending_bytes, 0);
+  EXPECT_EQ(stats.cached_bytes, 0);
+}
+
+TEST_F(UtestGraphCachingAllocator, release_stream) {
+  auto &allocator = MemManager::CachingInstance(RT_MEMORY_HBM);
+  int stream = 0;
+  uint8_t *ptr = allocator.MallocOnStream(kMByteSize, &stream);
+  ASSERT_NE(ptr, nullptr);
+  EXPECT_EQ(allocator.FreeOnStream(ptr, &stream), SUCCESS);
+
+  // a stream created later with the same handle must not take blocks freed on the destroyed one
+  allocator.ReleaseStream(&stream);
+  CachingAllocatorStats stats;
+  allocator.GetStats(stats);
+  EXPECT_EQ(stats.pending_bytes, 0);
+  {
+    std::lock_guard<std::recursive_mutex> lock(allocator.mutex_);
+    EXPECT_TRUE(allocator.pending_blocks_.empty());
+    EXPECT_EQ(allocator.TakePendingBlock(kMByteSize, &stream), nullptr);
+  }
+  allocator.ReleaseStream(&stream);
+  allocator.FreeCachedBlocks();
+  allocator.GetStats(stats);
+  EXPECT_EQ(stats.cached_bytes, 0);
+}
+
+TEST_F(UtestGraphCachingAllocator, multi_thread) {
+  auto &allocator = MemManager::CachingInstance(RT_MEMORY_HBM);
+  vector<thread> threads;
+  // vector<bool> is bit-packed, each thread writes its own int
+  vector<int> results(4, 0);
+  for (size_t i = 0; i < results.size(); ++i) {
+    threads.emplace_back([&allocator, &results, i]() {
+      auto trace = GenerateTrace(2000, 32);
+      results[i] = ReplayTrace(allocator, trace, 32) ? 1 : 0;
+    });
+  }
+  for (auto &t : threads) {
+    t.join();
+  }
+  for (auto result : results) {
+    EXPECT_EQ(result, 1);
+  }
+}
+
+TEST_F(UtestGraphCachingAllocator, replay_trace) {
+  const size_t kSlotCount = 256;
+  auto trace = GenerateTrace(200000, kSlotCount);
+  auto &allocator = MemManager::CachingInstance(RT_MEMORY_HBM);
+  ASSERT_TRUE(ReplayTrace(allocator, trace, kSlotCount));
+}
@@ -14,6 +14,7 @@
  * limitations under the License.
  */
 
+#include <cstdlib>
 #include <iostream>
 #include <map>
 #include <set>
@@ -49,7 +50,7 @@ class UtestTestPass : public BaseNodePass {
       for (const auto &node_name : iter->second) {
         auto del_node = node->GetOwnerComputeGraph()->FindNode(node_name);
         GraphUtils::IsolateNode(del_node, {0});
-        AddNodeDeleted(del_node.get());
+        AddNodeDeleted(del_node);
       }
     }
     iter = names_to_add_repass_.find(node->GetName());
@@ -93,6 +94,17 @@ class TestDelPass : public BaseNodePass {
   Status Run(NodePtr &node) override { return SUCCESS; }
 };
 
+class TestRemoveReshapePass : public BaseNodePass {
+ public:
+  Status Run(NodePtr &node) override {
+    if (node->GetType() != RESHAPE) {
+      return SUCCESS;
+    }
+    return IsolateAndDeleteNode(node, {0});
+  }
+  bool NeedRun(const NodePtr &node) const override { return node->GetType() == RESHAPE; }
+};
+
 class UTESTGraphPassesBasePass : public testing::Test {
  protected:
   UTESTGraphPassesBasePass() {
@@ -438,4 +450,52 @@ TEST_F(UTESTGraphPassesBasePass, while_loop) {
   auto ge_pass = GEPass(graph);
   EXPECT_EQ(ge_pass.Run(names_to_pass), SUCCESS);
 }
+
+///  reshape0  ...  reshape{n-1}
+///     |                |
+///   data0    ...  data{n-1}
+ComputeGraphPtr BuildWideGraph(int n) {
+  auto builder = ut::GraphBuilder("g_wide");
+  for (int i = 0; i < n; ++i) {
+    auto data = builder.AddNode("data" + std::to_string(i), DATA, 0, 1);
+    auto reshape = builder.AddNode("reshape" + std::to_string(i), RESHAPE, 1, 1);
+    builder.AddDataEdge(data, 0, reshape, 0);
+  }
+  return builder.GetGraph();
+}
+
+TEST_F(UTESTGraphPassesBasePass, statistics) {
+  NamesToPass names_to_pass;
+  auto test_pass = UtestTestPass();
+  names_to_pass.push_back(std::make_pair("test", &test_pass));
+  test_pass.AddRePassNodeName("add1", "sum1");
+
+  auto graph = BuildGraph2();
+  auto ge_pass = GEPass(graph);
+  EXPECT_EQ(ge_pass.Run(names_to_pass), SUCCESS);
+  ASSERT_EQ(ge_pass.GetStatistics().size(), 1);
+  // 7 nodes and sum1 re-passed
+  EXPECT_EQ(ge_pass.GetStatistics()[0].run_times, 8);
+  EXPECT_EQ(ge_pass.GetStatistics()[0].skip_times, 0);
+  EXPECT_EQ(ge_pass.GetStatistics()[0].change_times, 1);
+}
+
+TEST_F(UTESTGraphPassesBasePass, skip_passes_with_nothing_to_do) {
+  const int kWidth = 30;
+  TestRemoveReshapePass pass;
+  NamesToPass names_to_pass = {std::make_pair("remove_reshape", &pass)};
+  auto graph = BuildWideGraph(kWidth);
+  auto ge_pass = GEPass(graph);
+  EXPECT_EQ(ge_pass.Run(names_to_pass), SUCCESS);
+
+  EXPECT_EQ(graph->GetDirectNodesSize(), kWidth);
+  for (const auto &node : graph->GetDirectNode()) {
+    EXPECT_EQ(node->GetType(), DATA);
+  }
+  // data nodes are skipped at the first time and after re-passed, reshape nodes are removed
+  const auto &statistic = ge_pass.GetStatistics()[0];
+  EXPECT_EQ(statistic.run_times, kWidth);
+  EXPECT_EQ(statistic.change_times, kWidth);
+  EXPECT_EQ(statistic.skip_times, kWidth * 2);
+}
 }  // namespace ge
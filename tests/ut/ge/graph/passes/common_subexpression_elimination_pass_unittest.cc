@@ -0,0 +1,179 @@
+/**
+ * Copyright 2019-2020 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <gtest/gtest.h>
+
+#define protected public
+#define private public
+#include "graph/passes/common_subexpression_elimination_pass.h"
+#undef protected
+#undef private
+
+#include "framework/common/types.h"
+#include "graph/utils/attr_utils.h"
+#include "graph/utils/graph_utils.h"
+#include "graph_builder_utils.h"
+
+namespace ge {
+class UtestCommonSubexpressionEliminationPass : public testing::Test {
+ protected:
+  void SetUp() {}
+  void TearDown() {}
+};
+
+namespace {
+///   netoutput1
+///    /     \
+///  add1   add2
+///   | \   / |
+///   |  \ /  |
+///   |  / \  |
+///  data1  data2
+ComputeGraphPtr BuildGraph(bool swap_inputs) {
+  auto builder = ut::GraphBuilder("g1");
+  auto data1 = builder.AddNode("data1", DATA, 0, 1);
+  auto data2 = builder.AddNode("data2", DATA, 0, 1);
+  auto add1 = builder.AddNode("add1", ADD, 2, 1);
+  auto add2 = builder.AddNode("add2", ADD, 2, 1);
+  auto netoutput1 = builder.AddNode("netoutput1", NETOUTPUT, 2, 0);
+
+  builder.AddDataEdge(data1, 0, add1, 0);
+  builder.AddDataEdge(data2, 0, add1, 1);
+  builder.AddDataEdge(swap_inputs ? data2 : data1, 0, add2, 0);
+  builder.AddDataEdge(swap_inputs ? data1 : data2, 0, add2, 1);
+  builder.AddDataEdge(add1, 0, netoutput1, 0);
+  builder.AddDataEdge(add2, 0, netoutput1, 1);
+  return builder.GetGraph();
+}
+
+// all nodes get the same key, as if every hash code collided
+class CollidingCsePass : public CommonSubexpressionEliminationPass {
+ protected:
+  HashCode128 GetCseKey(const NodePtr &node) const override { return HashCode128(); }
+};
+}  // namespace
+
+TEST_F(UtestCommonSubexpressionEliminationPass, same_nodes_eliminated) {
+  auto graph = BuildGraph(false);
+  CommonSubexpressionEliminationPass pass;
+  EXPECT_EQ(pass.Run(graph), SUCCESS);
+
+  EXPECT_EQ(graph->GetDirectNodesSize(), 4);
+  auto netoutput1 = graph->FindNode("netoutput1");
+  ASSERT_NE(netoutput1, nullptr);
+  auto add = netoutput1->GetInDataNodes().at(0);
+  EXPECT_EQ(add->GetType(), ADD);
+  EXPECT_EQ(netoutput1->GetInDataNodes().at(1), add);
+  EXPECT_EQ(add->GetOutDataAnchor(0)->GetPeerInDataAnchors().size(), 2);
+}
+
+TEST_F(UtestCommonSubexpressionEliminationPass, different_attrs_not_eliminated) {
+  auto graph = BuildGraph(false);
+  AttrUtils::SetInt(graph->FindNode("add1")->GetOpDesc(), "test_attr", 1);
+  AttrUtils::SetInt(graph->FindNode("add2")->GetOpDesc(), "test_attr", 2);
+  CommonSubexpressionEliminationPass pass;
+  EXPECT_EQ(pass.Run(graph), SUCCESS);
+  EXPECT_EQ(graph->GetDirectNodesSize(), 5);
+
+  AttrUtils::SetInt(graph->FindNode("add2")->GetOpDesc(), "test_attr", 1);
+  EXPECT_EQ(pass.Run(graph), SUCCESS);
+  EXPECT_EQ(graph->GetDirectNodesSize(), 4);
+}
+
+TEST_F(UtestCommonSubexpressionEliminationPass, different_inputs_not_eliminated) {
+  auto graph = BuildGraph(true);
+  CommonSubexpressionEliminationPass pass;
+  EXPECT_EQ(pass.Run(graph), SUCCESS);
+  EXPECT_EQ(graph->GetDirectNodesSize(), 5);
+}
+
+TEST_F(UtestCommonSubexpressionEliminationPass, different_control_inputs_not_eliminated) {
+  auto graph = BuildGraph(false);
+  auto data1 = graph->FindNode("data1");
+  auto add2 = graph->FindNode("add2");
+  GraphUtils::AddEdge(data1->GetOutControlAnchor(), add2->GetInControlAnchor());
+  CommonSubexpressionEliminationPass pass;
+  EXPECT_EQ(pass.Run(graph), SUCCESS);
+  EXPECT_EQ(graph->GetDirectNodesSize(), 5);
+
+  auto add1 = graph->FindNode("add1");
+  GraphUtils::AddEdge(data1->GetOutControlAnchor(), add1->GetInControlAnchor());
+  EXPECT_EQ(pass.Run(graph), SUCCESS);
+  EXPECT_EQ(graph->GetDirectNodesSize(), 4);
+}
+
+TEST_F(UtestCommonSubexpressionEliminationPass, same_key_checked_on_collision) {
+  // nodes with the same hash code are not trusted to be the same, each difference must be caught by the full check
+  auto graph = BuildGraph(false);
+  auto add1 = graph->FindNode("add1");
+  auto add2 = graph->FindNode("add2");
+  CommonSubexpressionEliminationPass pass;
+  EXPECT_EQ(pass.GetCseKey(add1), pass.GetCseKey(add2));
+  EXPECT_TRUE(CommonSubexpressionEliminationPass::IsSameCseKey(add1, add2));
+
+  AttrUtils::SetStr(add2->GetOpDesc(), "test_attr", "a");
+  EXPECT_FALSE(CommonSubexpressionEliminationPass::IsSameCseKey(add1, add2));
+  AttrUtils::SetStr(add1->GetOpDesc(), "test_attr", "b");
+  EXPECT_FALSE(CommonSubexpressionEliminationPass::IsSameCseKey(add1, add2));
+  AttrUtils::SetStr(add1->GetOpDesc(), "test_attr", "a");
+  EXPECT_TRUE(CommonSubexpressionEliminationPass::IsSameCseKey(add1, add2));
+
+  auto swapped_graph = BuildGraph(true);
+  EXPECT_FALSE(CommonSubexpressionEliminationPass::IsSameCseKey(swapped_graph->FindNode("add1"),
+                                                                swapped_graph->FindNode("add2")));
+  EXPECT_NE(pass.GetCseKey(swapped_graph->FindNode("add1")), pass.GetCseKey(swapped_graph->FindNode("add2")));
+
+  // same inputs and attrs, but from another graph
+  auto other_graph = BuildGraph(false);
+  EXPECT_FALSE(CommonSubexpressionEliminationPass::IsSameCseKey(add1, other_graph->FindNode("add1")));
+
+  auto data1 = graph->FindNode("data1");
+  EXPECT_FALSE(CommonSubexpressionEliminationPass::IsSameCseKey(add1, data1));
+  GraphUtils::AddEdge(data1->GetOutControlAnchor(), add2->GetInControlAnchor());
+  EXPECT_FALSE(CommonSubexpressionEliminationPass::IsSameCseKey(add1, add2));
+}
+
+TEST_F(UtestCommonSubexpressionEliminationPass, different_nodes_not_merged_on_collision) {
+  CollidingCsePass pass;
+  auto swapped_graph = BuildGraph(true);
+  EXPECT_EQ(pass.Run(swapped_graph), SUCCESS);
+  EXPECT_EQ(swapped_graph->GetDirectNodesSize(), 5);
+
+  // add2 and add3 are the same, add1 differs from them in attrs only
+  auto builder = ut::GraphBuilder("g2");
+  auto data1 = builder.AddNode("data1", DATA, 0, 1);
+  auto data2 = builder.AddNode("data2", DATA, 0, 1);
+  auto netoutput1 = builder.AddNode("netoutput1", NETOUTPUT, 3, 0);
+  for (int i = 0; i < 3; ++i) {
+    auto add = builder.AddNode("add" + std::to_string(i + 1), ADD, 2, 1);
+    AttrUtils::SetInt(add->GetOpDesc(), "test_attr", i == 0 ? 1 : 2);
+    builder.AddDataEdge(data1, 0, add, 0);
+    builder.AddDataEdge(data2, 0, add, 1);
+    builder.AddDataEdge(add, 0, netoutput1, i);
+  }
+  auto graph = builder.GetGraph();
+  EXPECT_EQ(pass.Run(graph), SUCCESS);
+  EXPECT_EQ(graph->GetDirectNodesSize(), 5);
+  auto add1 = graph->FindNode("add1");
+  ASSERT_NE(add1, nullptr);
+  EXPECT_NE(graph->FindNode("add2") == nullptr, graph->FindNode("add3") == nullptr);
+  auto in_nodes = graph->FindNode("netoutput1")->GetInDataNodes();
+  ASSERT_EQ(in_nodes.size(), 3);
+  EXPECT_EQ(in_nodes.at(0), add1);
+  EXPECT_NE(in_nodes.at(1), add1);
+  EXPECT_EQ(in_nodes.at(1), in_nodes.at(2));
+}
+}  // namespace ge
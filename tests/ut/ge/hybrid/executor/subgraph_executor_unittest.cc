@@ -0,0 +1,361 @@
+/**
+ * Copyright 2019-2020 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <gtest/gtest.h>
+#include <algorithm>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+#include "graph/passes/graph_builder_utils.h"
+#include "graph/utils/tensor_utils.h"
+
+#define protected public
+#define private public
+#include "graph/manager/graph_caching_allocator.h"
+#include "graph/manager/graph_mem_allocator.h"
+#include "hybrid/executor/hybrid_execution_context.h"
+#include "hybrid/executor/subgraph_executor.h"
+#include "hybrid/model/graph_item.h"
+#include "hybrid/model/node_item.h"
+#include "hybrid/node_executor/node_executor.h"
+#include "hybrid/node_executor/task_context.h"
+#undef private
+#undef protected
+
+using namespace std;
+using namespace testing;
+using namespace ge;
+using namespace ge::hybrid;
+
+namespace {
+const int kChainLength = 16;
+const int kBranchNum = 8;
+const int kRunCount = 1000;
+
+// does nothing on device, the done callback is invoked at once
+class FakeNodeTask : public NodeTask {
+ public:
+  Status UpdateArgs(TaskContext &context) override { return SUCCESS; }
+
+  Status ExecuteAsync(TaskContext &context, std::function<void()> done_callback) override {
+    {
+      std::lock_guard<std::mutex> lk(mu);
+      launched_nodes.emplace_back(context.GetNodeName());
+    }
+    if (fail_node == context.GetNodeName()) {
+      return FAILED;
+    }
+    if (done_callback != nullptr) {
+      done_callback();
+    }
+    return SUCCESS;
+  }
+
+  std::mutex mu;
+  vector<string> launched_nodes;
+  string fail_node;
+};
+
+class FakeNodeExecutor : public NodeExecutor {};
+}  // namespace
+
+class UtestSubgraphExecutor : public testing::Test {
+ protected:
+  void SetUp() {
+    EXPECT_EQ(MemManager::Instance().Initialize({RT_MEMORY_HBM}), SUCCESS);
+    BuildGraphItem();
+    context_.allocator = NpuMemoryAllocator::GetAllocator(0);
+    input_buffer_.resize(kTensorSize);
+    vector<int64_t> dims = {kTensorSize / static_cast<int64_t>(sizeof(float))};
+    input_desc_ = std::make_shared<GeTensorDesc>(GeShape(dims), FORMAT_ND, DT_FLOAT);
+  }
+
+  void TearDown() {
+    node_items_.clear();
+    MemManager::Instance().Finalize();
+  }
+
+  // data -> add_0 -> ... -> add_n -> net_output
+  void BuildGraphItem() {
+    ut::GraphBuilder builder("g1");
+    vector<int64_t> shape = {kTensorSize / static_cast<int64_t>(sizeof(float))};
+    auto data = builder.AddNode("data", DATA, 1, 1, FORMAT_ND, DT_FLOAT, shape);
+    auto src = data;
+    for (int i = 0; i < kChainLength; ++i) {
+      auto add = builder.AddNode("add_" + std::to_string(i), "Add", 1, 1, FORMAT_ND, DT_FLOAT, shape);
+      builder.AddDataEdge(src, 0, add, 0);
+      src = add;
+    }
+    auto net_output = builder.AddNode("net_output", NETOUTPUT, 1, 0, FORMAT_ND, DT_FLOAT, shape);
+    builder.AddDataEdge(src, 0, net_output, 0);
+    graph_ = builder.GetGraph();
+    InitGraphItem(graph_, graph_item_);
+  }
+
+  //         -> add_0_0 -> ... -> add_0_n
+  // data -> ...                          -> net_output
+  //         -> add_m_0 -> ... -> add_m_n
+  ComputeGraphPtr BuildWideGraph() {
+    ut::GraphBuilder builder("g2");
+    vector<int64_t> shape = {kTensorSize / static_cast<int64_t>(sizeof(float))};
+    auto data = builder.AddNode("data", DATA, 1, 1, FORMAT_ND, DT_FLOAT, shape);
+    auto net_output = builder.AddNode("net_output", NETOUTPUT, kBranchNum, 0, FORMAT_ND, DT_FLOAT, shape);
+    for (int i = 0; i < kBranchNum; ++i) {
+      auto src = data;
+      for (int j = 0; j < kChainLength; ++j) {
+        auto name = "add_" + std::to_string(i) + "_" + std::to_string(j);
+        auto add = builder.AddNode(name, "Add", 1, 1, FORMAT_ND, DT_FLOAT, shape);
+        builder.AddDataEdge(src, 0, add, 0);
+        src = add;
+      }
+      builder.AddDataEdge(src, 0, net_output, i);
+    }
+    return builder.GetGraph();
+  }
+
+  void InitGraphItem(const ComputeGraphPtr &graph, GraphItem &graph_item) {
+    int input_start = 0;
+    int output_start = 0;
+    for (auto &node : graph->GetDirectNode()) {
+      auto node_item = std::unique_ptr<NodeItem>(new NodeItem(node));
+      ASSERT_EQ(node_item->Init(), SUCCESS);
+      node_item->input_start = input_start;
+      node_item->output_start = output_start;
+      input_start += node_item->num_inputs;
+      output_start += node_item->num_outputs;
+      node_item->outputs.resize(node_item->num_outputs);
+      node_item->kernel_task = task_;
+      node_item->node_executor = &executor_;
+      if (node->GetType() == DATA) {
+        node_item->reuse_inputs.emplace(0, 0);
+        graph_item.input_nodes_.emplace_back(node_item.get());
+      } else if (node->GetType() == NETOUTPUT) {
+        graph_item.output_node_ = node_item.get();
+      }
+      item_map_[node.get()] = node_item.get();
+      graph_item.node_items_.emplace_back(node_item.get());
+      node_items_.emplace_back(std::move(node_item));
+    }
+
+    for (auto node_item : graph_item.node_items_) {
+      for (auto &out_anchor : node_item->node->GetAllOutDataAnchors()) {
+        for (auto &peer_in_anchor : out_anchor->GetPeerInDataAnchors()) {
+          auto dst_node_item = item_map_[peer_in_anchor->GetOwnerNode().get()];
+          node_item->outputs[out_anchor->GetIdx()].emplace_back(peer_in_anchor->GetIdx(), dst_node_item);
+        }
+      }
+    }
+
+    graph_item.total_inputs_ = input_start;
+    graph_item.total_outputs_ = output_start;
+    graph_item.is_dynamic_ = true;
+    ASSERT_EQ(graph_item.InitExecutionPlan(), SUCCESS);
+  }
+
+  Status ExecuteOnce(SubgraphExecutor &executor, size_t num_outputs = 1) {
+    vector<TensorValue> inputs = {TensorValue(input_buffer_.data(), input_buffer_.size())};
+    vector<ConstGeTensorDescPtr> input_desc = {input_desc_};
+    GE_CHK_STATUS_RET_NOLOG(executor.ExecuteAsync(inputs, input_desc));
+    GE_CHK_STATUS_RET_NOLOG(executor.Synchronize());
+    vector<TensorValue> outputs;
+    GE_CHK_STATUS_RET_NOLOG(executor.GetOutputs(outputs));
+    if (outputs.size() != num_outputs) {
+      return FAILED;
+    }
+    for (auto &output : outputs) {
+      if (output.GetData() == nullptr) {
+        return FAILED;
+      }
+    }
+    return SUCCESS;
+  }
+
+  static const int64_t kTensorSize = 1024;
+  ComputeGraphPtr graph_;
+  GraphItem graph_item_;
+  vector<std::unique_ptr<NodeItem>> node_items_;
+  map<const Node *, NodeItem *> item_map_;
+  std::shared_ptr<FakeNodeTask> task_ = std::make_shared<FakeNodeTask>();
+  FakeNodeExecutor executor_;
+  GraphExecutionContext context_;
+  vector<uint8_t> input_buffer_;
+  GeTensorDescPtr input_desc_;
+};
+
+TEST_F(UtestSubgraphExecutor, execution_plan) {
+  EXPECT_EQ(graph_item_.GetNumPredecessors(0), 0);
+  for (size_t i = 0; i + 1 < graph_item_.GetAllNodes().size(); ++i) {
+    ASSERT_EQ(graph_item_.GetSuccessors(i).size(), 1);
+    auto dst_index = graph_item_.GetSuccessors(i)[0];
+    EXPECT_EQ(graph_item_.GetNumPredecessors(dst_index), 1);
+    EXPECT_EQ(graph_item_.GetNodeIndex(graph_item_.GetAllNodes()[i]), static_cast<int>(i));
+  }
+
+  NodeItem other_node_item(graph_->GetDirectNode().at(0));
+  EXPECT_LT(graph_item_.GetNodeIndex(&other_node_item), 0);
+}
+
+TEST_F(UtestSubgraphExecutor, reuse_context) {
+  SubgraphExecutor executor(&graph_item_, &context_);
+  ASSERT_EQ(ExecuteOnce(executor), SUCCESS);
+  auto subgraph_context = executor.subgraph_context_.get();
+  vector<NodeState *> node_states;
+  vector<TaskContext *> task_contexts;
+  for (auto node_item : graph_item_.GetAllNodes()) {
+    auto node_state = subgraph_context->GetNodeState(node_item);
+    ASSERT_NE(node_state, nullptr);
+    node_states.emplace_back(node_state.get());
+    task_contexts.emplace_back(node_state->GetTaskContext().get());
+  }
+
+  // all tensors allocated by the execution are released, while the execution plan is kept
+  executor.ReleaseContext();
+  CachingAllocatorStats stats;
+  ASSERT_EQ(MemManager::Instance().GetCachingStats(RT_MEMORY_HBM, stats), SUCCESS);
+  EXPECT_EQ(stats.allocated_bytes, 0);
+
+  for (int i = 0; i < 3; ++i) {
+    ASSERT_EQ(ExecuteOnce(executor), SUCCESS);
+    executor.ReleaseContext();
+  }
+
+  // nothing of the execution plan is rebuilt
+  EXPECT_EQ(executor.subgraph_context_.get(), subgraph_context);
+  for (size_t i = 0; i < graph_item_.GetAllNodes().size(); ++i) {
+    auto node_state = subgraph_context->GetNodeState(graph_item_.GetAllNodes()[i]);
+    EXPECT_EQ(node_state.get(), node_states[i]);
+    EXPECT_EQ(node_state->GetTaskContext().get(), task_contexts[i]);
+  }
+}
+
+TEST_F(UtestSubgraphExecutor, steady_state_allocation) {
+  SubgraphExecutor executor(&graph_item_, &context_);
+  ASSERT_EQ(ExecuteOnce(executor), SUCCESS);
+  executor.ReleaseContext();
+  auto subgraph_context = executor.subgraph_context_.get();
+  CachingAllocatorStats first_stats;
+  ASSERT_EQ(MemManager::Instance().GetCachingStats(RT_MEMORY_HBM, first_stats), SUCCESS);
+
+  // later executions reuse the plan, and their tensors are served by memory cached by the first one
+  for (int i = 0; i < kRunCount; ++i) {
+    ASSERT_EQ(ExecuteOnce(executor), SUCCESS);
+    executor.ReleaseContext();
+  }
+  EXPECT_EQ(executor.subgraph_context_.get(), subgraph_context);
+  CachingAllocatorStats stats;
+  ASSERT_EQ(MemManager::Instance().GetCachingStats(RT_MEMORY_HBM, stats), SUCCESS);
+  EXPECT_EQ(stats.miss_count, first_stats.miss_count);
+  EXPECT_EQ(stats.extend_count, first_stats.extend_count);
+  EXPECT_EQ(stats.cached_bytes, first_stats.cached_bytes);
+  EXPECT_EQ(stats.allocated_bytes, 0);
+  EXPECT_GT(stats.hit_count, first_stats.hit_count);
+}
+
+TEST_F(UtestSubgraphExecutor, dataflow_schedule) {
+  GraphItem graph_item;
+  auto graph = BuildWideGraph();
+  InitGraphItem(graph, graph_item);
+  context_.dataflow_schedule = true;
+  SubgraphExecutor executor(&graph_item, &context_);
+  for (int i = 0; i < 3; ++i) {
+    task_->launched_nodes.clear();
+    ASSERT_EQ(ExecuteOnce(executor, kBranchNum), SUCCESS);
+    executor.ReleaseContext();
+
+    // every node except net_output is launched once, after all its predecessors
+    ASSERT_EQ(task_->launched_nodes.size(), graph_item.GetAllNodes().size() - 1);
+    map<string, size_t> launch_order;
+    for (size_t j = 0; j < task_->launched_nodes.size(); ++j) {
+      launch_order[task_->launched_nodes[j]] = j;
+    }
+    for (auto &node : graph->GetDirectNode()) {
+      if (node->GetType() == NETOUTPUT) {
+        continue;
+      }
+      ASSERT_EQ(launch_order.count(node->GetName()), 1);
+      for (auto &src_node : node->GetInDataNodes()) {
+        EXPECT_LT(launch_order[src_node->GetName()], launch_order[node->GetName()]);
+      }
+    }
+  }
+}
+
+TEST_F(UtestSubgraphExecutor, dataflow_schedule_failed) {
+  GraphItem graph_item;
+  auto graph = BuildWideGraph();
+  InitGraphItem(graph, graph_item);
+  context_.dataflow_schedule = true;
+  SubgraphExecutor executor(&graph_item, &context_);
+  task_->fail_node = "add_3_5";
+  EXPECT_NE(ExecuteOnce(executor, kBranchNum), SUCCESS);
+  executor.ReleaseContext();
+
+  // the executor is still usable after failure
+  task_->fail_node.clear();
+  EXPECT_EQ(ExecuteOnce(executor, kBranchNum), SUCCESS);
+  executor.ReleaseContext();
+}
+
+TEST_F(UtestSubgraphExecutor, dataflow_same_as_topological) {
+  GraphItem graph_item;
+  auto graph = BuildWideGraph();
+  InitGraphItem(graph, graph_item);
+  SubgraphExecutor topo_executor(&graph_item, &context_);
+  ASSERT_EQ(ExecuteOnce(topo_executor, kBranchNum), SUCCESS);
+  topo_executor.ReleaseContext();
+  vector<string> topo_nodes = task_->launched_nodes;
+
+  // every node except net_output is launched once
+  vector<string> expected_nodes;
+  for (auto node_item : graph_item.GetAllNodes()) {
+    if (node_item->NodeType() != NETOUTPUT) {
+      expected_nodes.emplace_back(node_item->NodeName());
+    }
+  }
+  std::sort(expected_nodes.begin(), expected_nodes.end());
+  std::sort(topo_nodes.begin(), topo_nodes.end());
+  EXPECT_EQ(topo_nodes, expected_nodes);
+
+  // dataflow schedule launches the same nodes and gives all outputs
+  task_->launched_nodes.clear();
+  context_.dataflow_schedule = true;
+  SubgraphExecutor dataflow_executor(&graph_item, &context_);
+  ASSERT_EQ(ExecuteOnce(dataflow_executor, kBranchNum), SUCCESS);
+  dataflow_executor.ReleaseContext();
+  vector<string> dataflow_nodes = task_->launched_nodes;
+  std::sort(dataflow_nodes.begin(), dataflow_nodes.end());
+  EXPECT_EQ(dataflow_nodes, topo_nodes);
+}
+
+TEST_F(UtestSubgraphExecutor, skip_shape_inference) {
+  ASSERT_TRUE(graph_item_.IsShapeDeterminedByInputs());
+  SubgraphExecutor executor(&graph_item_, &context_);
+  ASSERT_EQ(ExecuteOnce(executor), SUCCESS);
+  executor.ReleaseContext();
+  EXPECT_FALSE(executor.skip_shape_inference_);
+
+  // shapes inferred by last execution are reused
+  ASSERT_EQ(ExecuteOnce(executor), SUCCESS);
+  executor.ReleaseContext();
+  EXPECT_TRUE(executor.skip_shape_inference_);
+
+  // shapes are changed by others
+  graph_item_.ClearInferredInputSignature();
+  ASSERT_EQ(ExecuteOnce(executor), SUCCESS);
+  executor.ReleaseContext();
+  EXPECT_FALSE(executor.skip_shape_inference_);
+}
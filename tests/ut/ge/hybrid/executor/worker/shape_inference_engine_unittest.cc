@@ -0,0 +1,109 @@
+/**
+ * Copyright 2019-2020 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <gtest/gtest.h>
+#include <memory>
+#include <vector>
+
+#include "graph/passes/graph_builder_utils.h"
+
+#define protected public
+#define private public
+#include "hybrid/executor/worker/shape_inference_engine.h"
+#include "hybrid/model/node_item.h"
+#undef private
+#undef protected
+
+using namespace std;
+using namespace testing;
+using namespace ge;
+using namespace ge::hybrid;
+
+class UtestShapeInferenceEngine : public testing::Test {
+ protected:
+  void SetUp() {
+    ut::GraphBuilder builder("g1");
+    auto data = builder.AddNode("data", DATA, 1, 1, FORMAT_ND, DT_FLOAT, {-1, 16});
+    auto add = builder.AddNode("add", "Add", 1, 1, FORMAT_ND, DT_FLOAT, {-1, 16});
+    builder.AddDataEdge(data, 0, add, 0);
+    graph_ = builder.GetGraph();
+    node_item_.reset(new NodeItem(graph_->FindNode("add")));
+    ASSERT_EQ(node_item_->Init(), SUCCESS);
+  }
+
+  void SetShapes(int64_t input_dim, int64_t output_dim) {
+    node_item_->op_desc->MutableInputDesc(0)->SetShape(GeShape({input_dim, 16}));
+    node_item_->op_desc->MutableOutputDesc(0)->SetShape(GeShape({output_dim, 16}));
+  }
+
+  int64_t GetOutputDim() { return node_item_->op_desc->MutableOutputDesc(0)->GetShape().GetDim(0); }
+
+  ComputeGraphPtr graph_;
+  std::unique_ptr<NodeItem> node_item_;
+  GraphExecutionContext context_;
+  ShapeInferenceEngine engine_{&context_, nullptr};
+};
+
+TEST_F(UtestShapeInferenceEngine, replay_output_shapes) {
+  ShapeInferenceMemo memo;
+  SetShapes(2, 2);
+  ASSERT_TRUE(engine_.BuildSignature(*node_item_, memo));
+  EXPECT_FALSE(ShapeInferenceEngine::ReplayOutputShapes(*node_item_, memo));
+  ShapeInferenceEngine::SaveOutputShapes(*node_item_, memo);
+
+  SetShapes(4, 4);
+  ASSERT_TRUE(engine_.BuildSignature(*node_item_, memo));
+  EXPECT_FALSE(ShapeInferenceEngine::ReplayOutputShapes(*node_item_, memo));
+  ShapeInferenceEngine::SaveOutputShapes(*node_item_, memo);
+
+  // output shape is restored by input shape
+  SetShapes(2, -1);
+  ASSERT_TRUE(engine_.BuildSignature(*node_item_, memo));
+  ASSERT_TRUE(ShapeInferenceEngine::ReplayOutputShapes(*node_item_, memo));
+  EXPECT_EQ(GetOutputDim(), 2);
+  // hit entry becomes the most recently used one
+  EXPECT_EQ(memo.entries.front().outputs[0].shape.GetDim(0), 2);
+
+  SetShapes(4, -1);
+  ASSERT_TRUE(engine_.BuildSignature(*node_item_, memo));
+  ASSERT_TRUE(ShapeInferenceEngine::ReplayOutputShapes(*node_item_, memo));
+  EXPECT_EQ(GetOutputDim(), 4);
+
+  // data type is part of the signature
+  node_item_->op_desc->MutableInputDesc(0)->SetDataType(DT_FLOAT16);
+  ASSERT_TRUE(engine_.BuildSignature(*node_item_, memo));
+  EXPECT_FALSE(ShapeInferenceEngine::ReplayOutputShapes(*node_item_, memo));
+}
+
+TEST_F(UtestShapeInferenceEngine, memo_eviction) {
+  ShapeInferenceMemo memo;
+  const int kNumShapes = 16;
+  for (int i = 1; i <= kNumShapes; ++i) {
+    SetShapes(i, i);
+    ASSERT_TRUE(engine_.BuildSignature(*node_item_, memo));
+    ShapeInferenceEngine::SaveOutputShapes(*node_item_, memo);
+  }
+  EXPECT_LT(memo.entries.size(), static_cast<size_t>(kNumShapes));
+
+  // least recently used shapes are evicted
+  SetShapes(1, -1);
+  ASSERT_TRUE(engine_.BuildSignature(*node_item_, memo));
+  EXPECT_FALSE(ShapeInferenceEngine::ReplayOutputShapes(*node_item_, memo));
+  SetShapes(kNumShapes, -1);
+  ASSERT_TRUE(engine_.BuildSignature(*node_item_, memo));
+  EXPECT_TRUE(ShapeInferenceEngine::ReplayOutputShapes(*node_item_, memo));
+  EXPECT_EQ(GetOutputDim(), kNumShapes);
+}
@@ -0,0 +1,191 @@
+/**
+ * Copyright 2019-2020 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <gtest/gtest.h>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "graph/compute_graph.h"
+#include "graph/utils/tensor_utils.h"
+#include "hybrid/executor/hybrid_model_executor.h"
+#include "hybrid/executor/worker/task_compile_cache.h"
+#include "hybrid/node_executor/node_executor.h"
+
+using namespace std;
+using namespace testing;
+using namespace ge;
+using namespace ge::hybrid;
+
+namespace {
+class FakeNodeTask : public NodeTask {
+ public:
+  Status UpdateArgs(TaskContext &context) override { return SUCCESS; }
+  Status ExecuteAsync(TaskContext &context, std::function<void()> done_callback) override { return SUCCESS; }
+};
+
+OpDescPtr CreateOpDesc(const vector<int64_t> &dims, DataType data_type = DT_FLOAT, Format format = FORMAT_ND) {
+  auto op_desc = std::make_shared<OpDesc>("add", "Add");
+  op_desc->SetId(1);
+  GeTensorDesc tensor_desc(GeShape(dims), format, data_type);
+  op_desc->AddInputDesc(tensor_desc);
+  op_desc->AddInputDesc(tensor_desc);
+  op_desc->AddOutputDesc(tensor_desc);
+  return op_desc;
+}
+}  // namespace
+
+class UtestTaskCompileCache : public testing::Test {
+ protected:
+  void SetUp() {
+    TaskCompileCache::GetInstance().GetStats(origin_stats_);
+    TaskCompileCache::GetInstance().Clear();
+  }
+
+  void TearDown() {
+    TaskCompileCache::GetInstance().SetCapacity(origin_stats_.capacity);
+    TaskCompileCache::GetInstance().Clear();
+  }
+
+  TaskCompileCacheStats origin_stats_;
+};
+
+TEST_F(UtestTaskCompileCache, generate_key) {
+  string key;
+  string other_key;
+  ASSERT_EQ(TaskCompileCache::GenerateKey(0, *CreateOpDesc({2, 3}), key), SUCCESS);
+  ASSERT_EQ(TaskCompileCache::GenerateKey(0, *CreateOpDesc({2, 3}), other_key), SUCCESS);
+  EXPECT_EQ(key, other_key);
+
+  ASSERT_EQ(TaskCompileCache::GenerateKey(1, *CreateOpDesc({2, 3}), other_key), SUCCESS);
+  EXPECT_NE(key, other_key);
+  ASSERT_EQ(TaskCompileCache::GenerateKey(0, *CreateOpDesc({23}), other_key), SUCCESS);
+  EXPECT_NE(key, other_key);
+  ASSERT_EQ(TaskCompileCache::GenerateKey(0, *CreateOpDesc({2, 3}, DT_FLOAT16), other_key), SUCCESS);
+  EXPECT_NE(key, other_key);
+  ASSERT_EQ(TaskCompileCache::GenerateKey(0, *CreateOpDesc({2, 3}, DT_FLOAT, FORMAT_NCHW), other_key), SUCCESS);
+  EXPECT_NE(key, other_key);
+}
+
+TEST_F(UtestTaskCompileCache, lru_eviction) {
+  auto &cache = TaskCompileCache::GetInstance();
+  cache.SetCapacity(2);
+  auto task_a = std::make_shared<FakeNodeTask>();
+  auto task_b = std::make_shared<FakeNodeTask>();
+  auto task_c = std::make_shared<FakeNodeTask>();
+  cache.PutTask("a", task_a);
+  cache.PutTask("b", task_b);
+  // "a" becomes the most recently used one, "b" is evicted
+  EXPECT_EQ(cache.GetTask("a"), task_a);
+  cache.PutTask("c", task_c);
+  EXPECT_EQ(cache.GetTask("b"), nullptr);
+  EXPECT_EQ(cache.GetTask("a"), task_a);
+  EXPECT_EQ(cache.GetTask("c"), task_c);
+
+  TaskCompileCacheStats stats;
+  cache.GetStats(stats);
+  EXPECT_EQ(stats.size, 2);
+  EXPECT_EQ(stats.capacity, 2);
+  EXPECT_EQ(stats.task_hits, 3);
+  EXPECT_EQ(stats.task_misses, 1);
+  EXPECT_EQ(stats.evictions, 1);
+
+  cache.SetCapacity(1);
+  EXPECT_EQ(cache.GetTask("a"), nullptr);
+  EXPECT_EQ(cache.GetTask("c"), task_c);
+
+  // caching is disabled
+  cache.SetCapacity(0);
+  cache.PutTask("a", task_a);
+  EXPECT_EQ(cache.GetTask("a"), nullptr);
+}
+
+TEST_F(UtestTaskCompileCache, running_param) {
+  auto &cache = TaskCompileCache::GetInstance();
+  auto op_desc = CreateOpDesc({2, 3});
+  TensorUtils::SetSize(*op_desc->MutableOutputDesc(0), 512);
+  op_desc->SetWorkspaceBytes({1024, 32});
+
+  OpRunningParam running_param;
+  EXPECT_FALSE(cache.GetRunningParam("add", running_param));
+  ASSERT_EQ(TaskCompileCache::SaveRunningParam(*op_desc, running_param), SUCCESS);
+  cache.PutRunningParam("add", running_param);
+  // running param does not make the task present
+  EXPECT_EQ(cache.GetTask("add"), nullptr);
+
+  auto other_op_desc = CreateOpDesc({2, 3});
+  OpRunningParam cached_param;
+  ASSERT_TRUE(cache.GetRunningParam("add", cached_param));
+  ASSERT_EQ(TaskCompileCache::ApplyRunningParam(cached_param, *other_op_desc), SUCCESS);
+  int64_t size = 0;
+  TensorUtils::GetSize(*other_op_desc->GetOutputDescPtr(0), size);
+  EXPECT_EQ(size, 512);
+  EXPECT_EQ(other_op_desc->GetWorkspaceBytes(), vector<int64_t>({1024, 32}));
+
+  TaskCompileCacheStats stats;
+  cache.GetStats(stats);
+  EXPECT_EQ(stats.running_param_hits, 1);
+  EXPECT_EQ(stats.running_param_misses, 1);
+}
+
+TEST_F(UtestTaskCompileCache, parse_shape_list) {
+  vector<vector<GeShape>> shape_list;
+  ASSERT_EQ(HybridModelExecutor::ParseShapeList("1,3,224,224;1|2,3,224,224;2", shape_list), SUCCESS);
+  ASSERT_EQ(shape_list.size(), 2);
+  ASSERT_EQ(shape_list[0].size(), 2);
+  EXPECT_EQ(shape_list[0][0].GetDims(), vector<int64_t>({1, 3, 224, 224}));
+  EXPECT_EQ(shape_list[1][1].GetDims(), vector<int64_t>({2}));
+
+  shape_list.clear();
+  EXPECT_NE(HybridModelExecutor::ParseShapeList("1,a", shape_list), SUCCESS);
+  EXPECT_NE(HybridModelExecutor::ParseShapeList("1,-1", shape_list), SUCCESS);
+}
+
+TEST_F(UtestTaskCompileCache, clear_model) {
+  auto &cache = TaskCompileCache::GetInstance();
+  auto task = std::make_shared<FakeNodeTask>();
+  string key_of_model_1;
+  string key_of_model_11;
+  ASSERT_EQ(TaskCompileCache::GenerateKey(1, *CreateOpDesc({2, 3}), key_of_model_1), SUCCESS);
+  ASSERT_EQ(TaskCompileCache::GenerateKey(11, *CreateOpDesc({2, 3}), key_of_model_11), SUCCESS);
+  cache.PutTask(key_of_model_1, task);
+  cache.PutTask(key_of_model_11, task);
+
+  cache.ClearModel(1);
+  EXPECT_EQ(cache.GetTask(key_of_model_1), nullptr);
+  EXPECT_EQ(cache.GetTask(key_of_model_11), task);
+  TaskCompileCacheStats stats;
+  cache.GetStats(stats);
+  EXPECT_EQ(stats.size, 1);
+}
+
+TEST_F(UtestTaskCompileCache, is_running_param_cacheable) {
+  auto graph = std::make_shared<ComputeGraph>("graph");
+  auto node = graph->AddNode(CreateOpDesc({2, 3}));
+  auto shape_node = graph->AddNode(CreateOpDesc({2}));
+  ASSERT_NE(node, nullptr);
+  NodeItem node_item(node);
+  EXPECT_TRUE(TaskCompileCache::IsRunningParamCacheable(node_item));
+
+  // output shapes depend on values of inputs
+  node_item.dependents_for_shape_inference.emplace_back(shape_node);
+  EXPECT_FALSE(TaskCompileCache::IsRunningParamCacheable(node_item));
+  node_item.dependents_for_shape_inference.clear();
+  node_item.shape_inference_type = DEPEND_SHAPE_RANGE;
+  EXPECT_FALSE(TaskCompileCache::IsRunningParamCacheable(node_item));
+  node_item.shape_inference_type = DEPEND_COMPUTE;
+  EXPECT_FALSE(TaskCompileCache::IsRunningParamCacheable(node_item));
+}
@@ -0,0 +1,86 @@
+/**
+ * Copyright 2019-2020 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <gtest/gtest.h>
+#include <atomic>
+#include <condition_variable>
+#include <mutex>
+
+#include "hybrid/executor/worker/work_stealing_pool.h"
+
+using namespace std;
+using namespace testing;
+using namespace ge;
+using namespace ge::hybrid;
+
+class UtestWorkStealingPool : public testing::Test {
+ protected:
+  void SetUp() {}
+  void TearDown() {}
+};
+
+TEST_F(UtestWorkStealingPool, run_all_tasks) {
+  const int kTaskNum = 1000;
+  std::atomic<int> count{0};
+  {
+    WorkStealingPool pool(4);
+    EXPECT_EQ(pool.GetThreadNum(), 4);
+    for (int i = 0; i < kTaskNum; ++i) {
+      ASSERT_EQ(pool.Submit([&count]() { ++count; }), SUCCESS);
+    }
+  }
+  // pending tasks are drained before the pool is destroyed
+  EXPECT_EQ(count, kTaskNum);
+}
+
+TEST_F(UtestWorkStealingPool, submit_from_worker) {
+  const int kDepth = 100;
+  const int kFanOut = 8;
+  std::atomic<int> count{0};
+  std::mutex mu;
+  std::condition_variable cv;
+  std::unique_ptr<WorkStealingPool> pool(new WorkStealingPool(3));
+
+  // each root task spawns a chain of tasks on the worker thread, idle workers steal from it
+  std::function<void(int)> task = [&](int depth) {
+    if (depth < kDepth) {
+      EXPECT_EQ(pool->Submit([&task, depth]() { task(depth + 1); }), SUCCESS);
+    }
+    if (++count == kDepth * kFanOut) {
+      std::lock_guard<std::mutex> lk(mu);
+      cv.notify_all();
+    }
+  };
+  for (int i = 0; i < kFanOut; ++i) {
+    ASSERT_EQ(pool->Submit([&task]() { task(1); }), SUCCESS);
+  }
+
+  {
+    std::unique_lock<std::mutex> lk(mu);
+    EXPECT_TRUE(cv.wait_for(lk, std::chrono::seconds(10), [&count]() { return count == kDepth * kFanOut; }));
+  }
+  pool.reset();
+}
+
+TEST_F(UtestWorkStealingPool, single_thread) {
+  std::atomic<int> count{0};
+  {
+    WorkStealingPool pool(0);
+    EXPECT_EQ(pool.GetThreadNum(), 1);
+    ASSERT_EQ(pool.Submit([&count]() { ++count; }), SUCCESS);
+  }
+  EXPECT_EQ(count, 1);
+}